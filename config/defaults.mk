@@ -204,6 +204,9 @@ OPENMP_LIB =
 # Used when MFEM_TIMER_TYPE = 2
 POSIX_CLOCKS_LIB = -lrt
 
+# Thread library, used by the ThreadPool of Backend::THREADS
+THREADS_LIB = -pthread
+
 # SUNDIALS library configuration
 # For sundials_nvecmpiplusx and nvecparallel remember to build with MPI_ENABLE=ON
 # and modify cmake variables for hypre for sundials
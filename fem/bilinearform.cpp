@@ -140,6 +140,13 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
    }
 }
 
+void BilinearForm::EnableFusedPA(bool enable)
+{
+   MFEM_VERIFY(assembly == AssemblyLevel::PARTIAL,
+               "the fused action requires AssemblyLevel::PARTIAL!");
+   static_cast<PABilinearFormExtension*>(ext)->EnableFusedMult(enable);
+}
+
 void BilinearForm::EnableStaticCondensation()
 {
    delete static_cond;
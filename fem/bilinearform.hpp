@@ -169,6 +169,20 @@ public:
    /// Returns the assembly level
    AssemblyLevel GetAssemblyLevel() const { return assembly; }
 
+   /** @brief Enable the fused partial assembly action, in which the element
+       restriction is applied inside the kernels of the domain integrators.
+
+       Every element is gathered from the L-vector, processed and scattered
+       back to the L-vector in one kernel, so no E-vectors are allocated or
+       streamed through memory. The elements are processed one color at a time,
+       see ElementRestriction::GetElementColors(), so the scatter needs no
+       atomics. The fused action is used only if all domain integrators support
+       it (see BilinearFormIntegrator::SupportsFusedPA()) for a scalar space
+       with tensor product elements; otherwise the standard partial assembly
+       action is used. Requires AssemblyLevel::PARTIAL and must be called
+       before assembly. */
+   void EnableFusedPA(bool enable = true);
+
    /** @brief Enable the use of static condensation. For details see the
        description for class StaticCondensation in fem/staticcond.hpp This method
        should be called before assembly. If the number of unknowns after static
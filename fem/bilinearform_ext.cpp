@@ -49,6 +49,7 @@ MFBilinearFormExtension::MFBilinearFormExtension(BilinearForm *form)
 
 void MFBilinearFormExtension::Assemble()
 {
+   MFEM_PROFILE_REGION("MFBilinearFormExtension::Assemble");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int integratorCount = integrators.Size();
    for (int i = 0; i < integratorCount; ++i)
@@ -124,6 +125,7 @@ void MFBilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
 
 void MFBilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("MFBilinearFormExtension::Mult");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
@@ -182,6 +184,7 @@ void MFBilinearFormExtension::Mult(const Vector &x, Vector &y) const
 
 void MFBilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("MFBilinearFormExtension::MultTranspose");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
    if (elem_restrict)
@@ -246,6 +249,23 @@ PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
    elem_restrict = NULL;
    int_face_restrict_lex = NULL;
    bdr_face_restrict_lex = NULL;
+   int_face_nbr_restrict = NULL;
+   bdr_face_nbr_restrict = NULL;
+   fused = false;
+   fused_restrict = NULL;
+}
+
+// Count the integrators that use (or do not use) the dofs of the neighboring
+// elements of the faces.
+static int CountFaceNeighborIntegrators(
+   const Array<BilinearFormIntegrator*> &integrators, const bool nbr)
+{
+   int count = 0;
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (integrators[i]->UsesFaceNeighborDofs() == nbr) { count++; }
+   }
+   return count;
 }
 
 void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
@@ -254,16 +274,14 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
                                  ElementDofOrdering::LEXICOGRAPHIC:
                                  ElementDofOrdering::NATIVE;
    elem_restrict = trialFes->GetElementRestriction(ordering);
-   if (elem_restrict)
-   {
-      localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
-      localY.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
-      localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
-   }
+   // With the fused element action, the element vectors are allocated only
+   // when they are needed, see SetupElementVectors().
+   if (!fused) { SetupElementVectors(); }
 
    // Construct face restriction operators only if the bilinear form has
    // interior or boundary face integrators
-   if (int_face_restrict_lex == NULL && a->GetFBFI()->Size() > 0)
+   if (int_face_restrict_lex == NULL &&
+       CountFaceNeighborIntegrators(*a->GetFBFI(), false) > 0)
    {
       int_face_restrict_lex = trialFes->GetFaceRestriction(
                                  ElementDofOrdering::LEXICOGRAPHIC,
@@ -273,7 +291,8 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
       faceIntY.UseDevice(true); // ensure 'faceIntY = 0.0' is done on device
    }
 
-   if (bdr_face_restrict_lex == NULL && a->GetBFBFI()->Size() > 0)
+   if (bdr_face_restrict_lex == NULL &&
+       CountFaceNeighborIntegrators(*a->GetBFBFI(), false) > 0)
    {
       bdr_face_restrict_lex = trialFes->GetFaceRestriction(
                                  ElementDofOrdering::LEXICOGRAPHIC,
@@ -283,10 +302,95 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
       faceBdrY.SetSize(bdr_face_restrict_lex->Height(), Device::GetMemoryType());
       faceBdrY.UseDevice(true); // ensure 'faceBoundY = 0.0' is done on device
    }
+
+   if (int_face_nbr_restrict == NULL &&
+       CountFaceNeighborIntegrators(*a->GetFBFI(), true) > 0)
+   {
+      int_face_nbr_restrict =
+         trialFes->GetFaceNeighborRestriction(FaceType::Interior);
+      faceIntNbrX.SetSize(int_face_nbr_restrict->Height(),
+                          Device::GetMemoryType());
+      faceIntNbrY.SetSize(int_face_nbr_restrict->Height(),
+                          Device::GetMemoryType());
+      faceIntNbrY.UseDevice(true);
+   }
+
+   if (bdr_face_nbr_restrict == NULL &&
+       CountFaceNeighborIntegrators(*a->GetBFBFI(), true) > 0)
+   {
+      bdr_face_nbr_restrict =
+         trialFes->GetFaceNeighborRestriction(FaceType::Boundary);
+      faceBdrNbrX.SetSize(bdr_face_nbr_restrict->Height(),
+                          Device::GetMemoryType());
+      faceBdrNbrY.SetSize(bdr_face_nbr_restrict->Height(),
+                          Device::GetMemoryType());
+      faceBdrNbrY.UseDevice(true);
+   }
+}
+
+void PABilinearFormExtension::AddMultFaceNeighbors(const Vector &x, Vector &y,
+                                                   const bool transpose) const
+{
+   for (int k = 0; k < 2; k++)
+   {
+      const Operator *restr = k ? bdr_face_nbr_restrict : int_face_nbr_restrict;
+      if (restr == NULL || restr->Height() == 0) { continue; }
+      Array<BilinearFormIntegrator*> &integrators =
+         k ? *a->GetBFBFI() : *a->GetFBFI();
+      Vector &faceX = k ? faceBdrNbrX : faceIntNbrX;
+      Vector &faceY = k ? faceBdrNbrY : faceIntNbrY;
+      restr->Mult(x, faceX);
+      faceY = 0.0;
+      for (int i = 0; i < integrators.Size(); ++i)
+      {
+         if (!integrators[i]->UsesFaceNeighborDofs()) { continue; }
+         if (transpose)
+         {
+            integrators[i]->AddMultTransposePA(faceX, faceY);
+         }
+         else
+         {
+            integrators[i]->AddMultPA(faceX, faceY);
+         }
+      }
+      restr->MultTranspose(faceY, y);
+   }
+}
+
+void PABilinearFormExtension::AddDiagonalFaceNeighbors(Vector &y) const
+{
+   for (int k = 0; k < 2; k++)
+   {
+      const Operator *restr = k ? bdr_face_nbr_restrict : int_face_nbr_restrict;
+      if (restr == NULL || restr->Height() == 0) { continue; }
+      Array<BilinearFormIntegrator*> &integrators =
+         k ? *a->GetBFBFI() : *a->GetFBFI();
+      Vector &faceY = k ? faceBdrNbrY : faceIntNbrY;
+      faceY = 0.0;
+      for (int i = 0; i < integrators.Size(); ++i)
+      {
+         if (integrators[i]->UsesFaceNeighborDofs())
+         {
+            integrators[i]->AssembleDiagonalPA(faceY);
+         }
+      }
+      restr->MultTranspose(faceY, y);
+   }
+}
+
+void PABilinearFormExtension::SetupElementVectors() const
+{
+   if (elem_restrict && localX.Size() != elem_restrict->Height())
+   {
+      localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
+   }
 }
 
 void PABilinearFormExtension::Assemble()
 {
+   MFEM_PROFILE_REGION("PABilinearFormExtension::Assemble");
    SetupRestrictionOperators(L2FaceValues::DoubleValued);
 
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -296,6 +400,25 @@ void PABilinearFormExtension::Assemble()
       integrators[i]->AssemblePA(*a->FESpace());
    }
 
+   // The fused element action requires scalar tensor product elements and
+   // domain integrators that all support it.
+   fused_restrict = NULL;
+   if (fused && elem_restrict && !DeviceCanUseCeed() &&
+       trialFes->GetVDim() == 1 && UsesTensorBasis(*trialFes))
+   {
+      bool supported = true;
+      for (int i = 0; i < integratorCount; ++i)
+      {
+         supported = supported && integrators[i]->SupportsFusedPA();
+      }
+      if (supported)
+      {
+         fused_restrict =
+            dynamic_cast<const ElementRestriction*>(elem_restrict);
+      }
+   }
+   if (!fused_restrict) { SetupElementVectors(); }
+
    MFEM_VERIFY(a->GetBBFI()->Size() == 0,
                "Partial assembly does not support AddBoundaryIntegrator yet.");
 
@@ -321,6 +444,7 @@ void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
    const int iSz = integrators.Size();
    if (elem_restrict && !DeviceCanUseCeed())
    {
+      SetupElementVectors();
       localY = 0.0;
       for (int i = 0; i < iSz; ++i)
       {
@@ -346,6 +470,7 @@ void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
          integrators[i]->AssembleDiagonalPA(y);
       }
    }
+   AddDiagonalFaceNeighbors(y);
 }
 
 void PABilinearFormExtension::Update()
@@ -358,6 +483,9 @@ void PABilinearFormExtension::Update()
    elem_restrict = nullptr;
    int_face_restrict_lex = nullptr;
    bdr_face_restrict_lex = nullptr;
+   int_face_nbr_restrict = nullptr;
+   bdr_face_nbr_restrict = nullptr;
+   fused_restrict = nullptr;
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
@@ -381,6 +509,7 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
 
 void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("PABilinearFormExtension::Mult");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
@@ -393,6 +522,15 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
          integrators[i]->AddMultPA(x, y);
       }
    }
+   else if (fused_restrict)
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultFusedPA(*fused_restrict, x, y);
+      }
+   }
    else
    {
       elem_restrict->Mult(x, localX);
@@ -414,6 +552,7 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
          faceIntY = 0.0;
          for (int i = 0; i < iFISz; ++i)
          {
+            if (intFaceIntegrators[i]->UsesFaceNeighborDofs()) { continue; }
             intFaceIntegrators[i]->AddMultPA(faceIntX, faceIntY);
          }
          int_face_restrict_lex->MultTranspose(faceIntY, y);
@@ -430,19 +569,24 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
          faceBdrY = 0.0;
          for (int i = 0; i < bFISz; ++i)
          {
+            if (bdrFaceIntegrators[i]->UsesFaceNeighborDofs()) { continue; }
             bdrFaceIntegrators[i]->AddMultPA(faceBdrX, faceBdrY);
          }
          bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
       }
    }
+
+   AddMultFaceNeighbors(x, y, false);
 }
 
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("PABilinearFormExtension::MultTranspose");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
    if (elem_restrict)
    {
+      SetupElementVectors();
       elem_restrict->Mult(x, localX);
       localY = 0.0;
       for (int i = 0; i < iSz; ++i)
@@ -471,6 +615,7 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
          faceIntY = 0.0;
          for (int i = 0; i < iFISz; ++i)
          {
+            if (intFaceIntegrators[i]->UsesFaceNeighborDofs()) { continue; }
             intFaceIntegrators[i]->AddMultTransposePA(faceIntX, faceIntY);
          }
          int_face_restrict_lex->MultTranspose(faceIntY, y);
@@ -487,11 +632,14 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
          faceBdrY = 0.0;
          for (int i = 0; i < bFISz; ++i)
          {
+            if (bdrFaceIntegrators[i]->UsesFaceNeighborDofs()) { continue; }
             bdrFaceIntegrators[i]->AddMultTransposePA(faceBdrX, faceBdrY);
          }
          bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
       }
    }
+
+   AddMultFaceNeighbors(x, y, true);
 }
 
 // Data and methods for element-assembled bilinear forms
@@ -503,10 +651,15 @@ EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
 
 void EABilinearFormExtension::Assemble()
 {
+   MFEM_PROFILE_REGION("EABilinearFormExtension::Assemble");
    SetupRestrictionOperators(L2FaceValues::SingleValued);
 
    ne = trialFes->GetMesh()->GetNE();
    elemDofs = trialFes->GetFE(0)->GetDof();
+   MFEM_VERIFY(ne == 0 || trialFes->GetMesh()->GetNumGeometries(
+                  trialFes->GetMesh()->Dimension()) == 1,
+               "element assembly does not support meshes with mixed element "
+               "types");
 
    ea_data.SetSize(ne*elemDofs*elemDofs, Device::GetMemoryType());
    ea_data.UseDevice(true);
@@ -568,6 +721,7 @@ void EABilinearFormExtension::Assemble()
 
 void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("EABilinearFormExtension::Mult");
    // Apply the Element Restriction
    const bool useRestrict = !DeviceCanUseCeed() && elem_restrict;
    if (!useRestrict)
@@ -694,8 +848,9 @@ void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 
 void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("EABilinearFormExtension::MultTranspose");
    // Apply the Element Restriction
-   const bool useRestrict = DeviceCanUseCeed() || !elem_restrict;
+   const bool useRestrict = !DeviceCanUseCeed() && elem_restrict;
    if (!useRestrict)
    {
       y.UseDevice(true); // typically this is a large vector, so store on device
@@ -841,6 +996,7 @@ FABilinearFormExtension::FABilinearFormExtension(BilinearForm *form)
 
 void FABilinearFormExtension::Assemble()
 {
+   MFEM_PROFILE_REGION("FABilinearFormExtension::Assemble");
    EABilinearFormExtension::Assemble();
    FiniteElementSpace &fes = *a->FESpace();
    if (fes.IsDGSpace())
@@ -918,6 +1074,7 @@ void FABilinearFormExtension::Assemble()
 
 void FABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("FABilinearFormExtension::Mult");
    mat.Mult(x, y);
 #ifdef MFEM_USE_MPI
    if (const ParFiniteElementSpace *pfes =
@@ -935,6 +1092,7 @@ void FABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 
 void FABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("FABilinearFormExtension::MultTranspose");
    mat.MultTranspose(x, y);
 #ifdef MFEM_USE_MPI
    if (const ParFiniteElementSpace *pfes =
@@ -992,6 +1150,7 @@ PAMixedBilinearFormExtension::PAMixedBilinearFormExtension(
 
 void PAMixedBilinearFormExtension::Assemble()
 {
+   MFEM_PROFILE_REGION("PAMixedBilinearFormExtension::Assemble");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int integratorCount = integrators.Size();
    for (int i = 0; i < integratorCount; ++i)
@@ -1096,6 +1255,7 @@ void PAMixedBilinearFormExtension::SetupMultInputs(
 
 void PAMixedBilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("PAMixedBilinearFormExtension::Mult");
    y = 0.0;
    AddMult(x, y);
 }
@@ -1128,6 +1288,7 @@ void PAMixedBilinearFormExtension::AddMult(const Vector &x, Vector &y,
 void PAMixedBilinearFormExtension::MultTranspose(const Vector &x,
                                                  Vector &y) const
 {
+   MFEM_PROFILE_REGION("PAMixedBilinearFormExtension::MultTranspose");
    y = 0.0;
    AddMultTranspose(x, y);
 }
@@ -73,10 +73,23 @@ protected:
    const Operator *elem_restrict; // Not owned
    const Operator *int_face_restrict_lex; // Not owned
    const Operator *bdr_face_restrict_lex; // Not owned
+   // Face restrictions for face integrators using the dofs of the neighboring
+   // elements, see BilinearFormIntegrator::UsesFaceNeighborDofs()
+   mutable Vector faceIntNbrX, faceIntNbrY;
+   mutable Vector faceBdrNbrX, faceBdrNbrY;
+   const Operator *int_face_nbr_restrict; // Not owned
+   const Operator *bdr_face_nbr_restrict; // Not owned
+   // Fused element action, see BilinearForm::EnableFusedPA(). The restriction
+   // is set by Assemble() if all domain integrators support the fused action.
+   bool fused;
+   const ElementRestriction *fused_restrict; // Not owned
 
 public:
    PABilinearFormExtension(BilinearForm*);
 
+   /// Enable the fused element action, see BilinearForm::EnableFusedPA().
+   void EnableFusedMult(bool enable) { fused = enable; }
+
    void Assemble();
    void AssembleDiagonal(Vector &diag) const;
    void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A);
@@ -90,6 +103,14 @@ public:
 
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
+   /// Allocate the element vectors localX and localY, if not done yet.
+   void SetupElementVectors() const;
+   /** Add the action, or its transpose, of the face integrators using the dofs
+       of the neighboring elements. */
+   void AddMultFaceNeighbors(const Vector &x, Vector &y,
+                             const bool transpose) const;
+   /// Add the diagonal of the face integrators using neighboring element dofs.
+   void AddDiagonalFaceNeighbors(Vector &y) const;
 };
 
 /// Data and methods for element-assembled bilinear forms
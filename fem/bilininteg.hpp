@@ -15,6 +15,7 @@
 #include "../config/config.hpp"
 #include "nonlininteg.hpp"
 #include "fespace.hpp"
+#include "kernel_registry.hpp"
 #include "libceed/ceed.hpp"
 
 namespace mfem
@@ -34,6 +35,16 @@ protected:
    BilinearFormIntegrator(const IntegrationRule *ir = NULL)
       : NonlinearFormIntegrator(ir) { }
 
+   /** @brief Compute the element matrices of AssembleEA() by applying
+       AddMultPA() to the unit E-vectors of the space @a fes.
+
+       The element matrices are expressed in the basis of the E-vectors, i.e.
+       they include the dof signs and permutations applied by the element
+       restriction. This method can be called only after the method
+       AssemblePA() has been called. */
+   void AssembleEAFromPA(const FiniteElementSpace &fes, Vector &emat,
+                         const bool add) const;
+
 public:
    // TODO: add support for other assembly levels (in addition to PA) and their
    // actions.
@@ -61,6 +72,13 @@ public:
 
    virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
 
+   /** @brief Return true if the partial assembly face kernels of this
+       integrator act on all the dofs of the elements sharing each face. */
+   /** In this case, the face E-vectors given to AddMultPA(),
+       AddMultTransposePA() and AssembleDiagonalPA() have the layout of
+       L2FaceNeighborRestriction, instead of containing only the face dofs. */
+   virtual bool UsesFaceNeighborDofs() const { return false; }
+
    /// Assemble diagonal and add it to Vector @a diag.
    virtual void AssembleDiagonalPA(Vector &diag);
 
@@ -85,6 +103,23 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /** @brief Return true if the integrator implements AddMultFusedPA() for
+       the data computed by the last call to AssemblePA(). */
+   virtual bool SupportsFusedPA() const { return false; }
+
+   /// Method for fused partially assembled action.
+   /** Perform the action of integrator on the input @a x and add the result to
+       the output @a y. Both @a x and @a y are L-vectors: the gather of the
+       element dofs through the element restriction @a R, the element action
+       and the scatter of the result are done in a single kernel for each
+       element color of @a R, see ElementRestriction::GetElementColors(), so
+       that no E-vectors are needed.
+
+       This method can be called only after the method AssemblePA() has been
+       called, and only if SupportsFusedPA() returns true. */
+   virtual void AddMultFusedPA(const ElementRestriction &R,
+                               const Vector &x, Vector &y) const;
+
    /// Method defining element assembly.
    /** The result of the element assembly is added to the @a emat Vector if
        @a add is true. Otherwise, if @a add is false, we set @a emat. */
@@ -1917,9 +1952,16 @@ private:
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
    bool symmetric = true; ///< False if using a nonsymmetric matrix coefficient
+   // PA extension for non-tensor elements and meshes with mixed element types:
+   // one kernel per group of elements with the same geometry
+   Array<int> group_offsets;           ///< Element offsets of the groups
+   Array<const DofToQuad*> group_maps; ///< Not owned, empty for tensor PA
    // CEED extension
    CeedData* ceedDataPtr;
 
+   /// PA setup for non-tensor elements, see GetElementGeometryGroups().
+   void AssemblePANonTensor(const FiniteElementSpace &fes);
+
 public:
    /// Construct a diffusion integrator with coefficient Q = 1
    DiffusionIntegrator()
@@ -1994,6 +2036,33 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   /// Supported for tensor product elements in 2D and 3D.
+   virtual bool SupportsFusedPA() const;
+
+   virtual void AddMultFusedPA(const ElementRestriction &R,
+                               const Vector &x, Vector &y) const;
+
+   /// Registry of the specialized kernels of the tensor PA action.
+   typedef PAKernelRegistry<const int, const bool,
+           const Array<double>&, const Array<double>&,
+           const Array<double>&, const Array<double>&,
+           const Vector&, const Vector&> ApplyKernelRegistry;
+
+   /** @brief Return the registry of the specialized kernels of the tensor PA
+       action, used by AddMultPA(). Other orders use slower generic kernels. */
+   static ApplyKernelRegistry &ApplyPAKernels();
+
+   /** @brief Register the specialized tensor PA action kernels for dimension
+       @a DIM with @a D1D dofs and @a Q1D quadrature points in 1D.
+
+       The 2D shared memory kernels process @a NBZ elements per thread block;
+       with @a NBZ = 0, a default depending on @a Q1D is used. The autotuning
+       (see PAKernelTuning) also considers half and twice that value. This
+       function is defined in fem/bilininteg_diffusion_kernels.hpp, which has to
+       be included to call it. */
+   template <int DIM, int D1D, int Q1D, int NBZ = 0>
+   static void AddSpecialization();
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 };
@@ -2012,10 +2081,17 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   // PA extension for non-tensor elements and meshes with mixed element types:
+   // one kernel per group of elements with the same geometry
+   Array<int> group_offsets;           ///< Element offsets of the groups
+   Array<const DofToQuad*> group_maps; ///< Not owned, empty for tensor PA
 
    // CEED extension
    CeedData* ceedDataPtr;
 
+   /// PA setup for non-tensor elements, see GetElementGeometryGroups().
+   void AssemblePANonTensor(const FiniteElementSpace &fes);
+
 public:
    MassIntegrator(const IntegrationRule *ir = NULL)
       : BilinearFormIntegrator(ir), Q(NULL), maps(NULL), geom(NULL),
@@ -2057,6 +2133,30 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   /// Supported for tensor product elements in 2D and 3D.
+   virtual bool SupportsFusedPA() const;
+
+   virtual void AddMultFusedPA(const ElementRestriction &R,
+                               const Vector &x, Vector &y) const;
+
+   /// Registry of the specialized kernels of the tensor PA action.
+   typedef PAKernelRegistry<const int, const Array<double>&,
+           const Array<double>&, const Vector&, const Vector&>
+           ApplyKernelRegistry;
+
+   /** @brief Return the registry of the specialized kernels of the tensor PA
+       action, used by AddMultPA(). Other orders use slower generic kernels. */
+   static ApplyKernelRegistry &ApplyPAKernels();
+
+   /** @brief Register the specialized tensor PA action kernels for dimension
+       @a DIM with @a D1D dofs and @a Q1D quadrature points in 1D.
+
+       See DiffusionIntegrator::AddSpecialization() for the meaning of @a NBZ.
+       This function is defined in fem/bilininteg_mass_kernels.hpp, which has
+       to be included to call it. */
+   template <int DIM, int D1D, int Q1D, int NBZ = 0>
+   static void AddSpecialization();
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
@@ -2388,6 +2488,8 @@ public:
    virtual void AssemblePA(const FiniteElementSpace &fes);
    virtual void AddMultPA(const Vector &x, Vector &y) const;
    virtual void AssembleDiagonalPA(Vector& diag);
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
+                           const bool add);
 };
 
 /** Integrator for (curl u, curl v) for FE spaces defined by 'dim' copies of a
@@ -2478,6 +2580,8 @@ public:
                            const FiniteElementSpace &test_fes);
    virtual void AddMultPA(const Vector &x, Vector &y) const;
    virtual void AssembleDiagonalPA(Vector& diag);
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
+                           const bool add);
 };
 
 /** Integrator for (Q div u, p) where u=(v1,...,vn) and all vi are in the same
@@ -2558,6 +2662,8 @@ public:
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
                                       DenseMatrix &elmat);
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
+                           const bool add);
 };
 
 /** Integrator for
@@ -2706,8 +2812,6 @@ public:
                                    FaceElementTransformations &Trans,
                                    DenseMatrix &elmat);
 
-   using BilinearFormIntegrator::AssemblePA;
-
    virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes);
 
    virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
@@ -2755,6 +2859,16 @@ protected:
    Vector shape1, shape2, dshape1dn, dshape2dn, nor, nh, ni;
    DenseMatrix jmat, dshape1, dshape2, mq, adjJ;
 
+   // PA extension
+   int dim, nf, nq, ndofs;
+   /// Values and reference gradients of the element basis at the face
+   /// quadrature points, for every local face (and orientation) in use.
+   Vector pa_shape, pa_dshape;
+   /// For each face, the index in pa_shape of its two sides (-1 if none).
+   Array<int> pa_face_maps;
+   /// Scaled reference normals of the two sides and jump penalty.
+   Vector pa_data;
+
 public:
    DGDiffusionIntegrator(const double s, const double k)
       : Q(NULL), MQ(NULL), sigma(s), kappa(k) { }
@@ -2767,6 +2881,23 @@ public:
                                    const FiniteElement &el2,
                                    FaceElementTransformations &Trans,
                                    DenseMatrix &elmat);
+
+   virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes);
+
+   virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
+
+   /// The face terms need the normal derivatives, i.e. all the element dofs.
+   virtual bool UsesFaceNeighborDofs() const { return true; }
+
+   virtual void AssembleDiagonalPA(Vector &diag);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
+
+private:
+   void SetupPA(const FiniteElementSpace &fes, FaceType type);
+   void ApplyPA(const Vector &x, Vector &y, const bool transpose) const;
 };
 
 /** Integrator for the "BR2" diffusion stabilization term
@@ -38,14 +38,6 @@ static void EAConvectionAssemble1D(const int NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      double r_Gi[MQ1];
-      double r_Bj[MQ1];
-      for (int q = 0; q < Q1D; q++)
-      {
-         r_Gi[q] = G(q,MFEM_THREAD_ID(x));
-         r_Bj[q] = B(q,MFEM_THREAD_ID(y));
-      }
       MFEM_FOREACH_THREAD(i1,x,D1D)
       {
          MFEM_FOREACH_THREAD(j1,y,D1D)
@@ -53,7 +45,7 @@ static void EAConvectionAssemble1D(const int NE,
             double val = 0.0;
             for (int k1 = 0; k1 < Q1D; ++k1)
             {
-               val += r_Bj[k1] * D(k1, e) * r_Gi[k1];
+               val += B(k1,j1) * D(k1, e) * G(k1,i1);
             }
             if (add)
             {
@@ -12,6 +12,7 @@
 #include "../general/forall.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
+#include "pa_simd.hpp"
 
 using namespace std;
 
@@ -20,6 +21,30 @@ namespace mfem
 
 // PA Convection Integrator
 
+// PA Convection Assemble 1D kernel
+static void PAConvectionSetup1D(const int Q1D,
+                                const int ne,
+                                const Array<double> &w,
+                                const Vector &vel,
+                                const double alpha,
+                                Vector &op)
+{
+   const int NE = ne;
+   auto W = w.Read();
+   const bool const_v = vel.Size() == 1;
+   auto V = const_v ? Reshape(vel.Read(), 1,1) : Reshape(vel.Read(), Q1D,NE);
+   auto y = Reshape(op.Write(), Q1D, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < Q1D; ++q)
+      {
+         // w*det(J)*J^-1 = w
+         y(q,e) = alpha * W[q] * (const_v ? V(0,0) : V(q,e));
+      }
+   });
+}
+
 // PA Convection Assemble 2D kernel
 static void PAConvectionSetup2D(const int Q1D,
                                 const int ne,
@@ -123,7 +148,10 @@ static void PAConvectionSetup(const int dim,
                               const double alpha,
                               Vector &op)
 {
-   if (dim == 1) { MFEM_ABORT("dim==1 not supported in PAConvectionSetup"); }
+   if (dim == 1)
+   {
+      PAConvectionSetup1D(Q1D, NE, W, coeff, alpha, op);
+   }
    if (dim == 2)
    {
       PAConvectionSetup2D(Q1D, NE, W, J, coeff, alpha, op);
@@ -134,13 +162,12 @@ static void PAConvectionSetup(const int dim,
    }
 }
 
-// PA Convection Apply 2D kernel
+// PA Convection Apply 1D kernel: it needs no temporary storage per element, so
+// it is not limited by MAX_D1D and MAX_Q1D.
 template<int T_D1D = 0, int T_Q1D = 0> static
-void PAConvectionApply2D(const int ne,
-                         const Array<double> &b,
+void PAConvectionApply1D(const int ne,
                          const Array<double> &g,
                          const Array<double> &bt,
-                         const Array<double> &gt,
                          const Vector &_op,
                          const Vector &_x,
                          Vector &_y,
@@ -150,106 +177,164 @@ void PAConvectionApply2D(const int ne,
    const int NE = ne;
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
    auto G = Reshape(g.Read(), Q1D, D1D);
    auto Bt = Reshape(bt.Read(), D1D, Q1D);
-   auto op = Reshape(_op.Read(), Q1D, Q1D, 2, NE);
-   auto x = Reshape(_x.Read(), D1D, D1D, NE);
-   auto y = Reshape(_y.ReadWrite(), D1D, D1D, NE);
+   auto op = Reshape(_op.Read(), Q1D, NE);
+   auto x = Reshape(_x.Read(), D1D, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, NE);
    MFEM_FORALL(e, NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-
-      double u[max_D1D][max_D1D];
-      for (int dy = 0; dy < D1D; ++dy)
+      for (int qx = 0; qx < Q1D; ++qx)
       {
+         double du = 0.0;
          for (int dx = 0; dx < D1D; ++dx)
          {
-            u[dy][dx] = x(dx,dy,e);
+            du += G(qx, dx) * x(dx, e);
          }
-      }
-      double Bu[max_D1D][max_Q1D];
-      double Gu[max_D1D][max_Q1D];
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
+         du *= op(qx, e);
+         for (int dx = 0; dx < D1D; ++dx)
          {
-            Bu[dy][qx] = 0.0;
-            Gu[dy][qx] = 0.0;
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double bx  = B(qx,dx);
-               const double gx  = G(qx,dx);
-               const double x = u[dy][dx];
-               Bu[dy][qx] += bx * x;
-               Gu[dy][qx] += gx * x;
-            }
+            y(dx, e) += Bt(dx, qx) * du;
          }
       }
-      double GBu[max_Q1D][max_Q1D];
-      double BGu[max_Q1D][max_Q1D];
+   });
+}
+
+// PA Convection Apply 2D kernel for the element e
+template<int T_D1D = 0, int T_Q1D = 0, typename real_t = double>
+static MFEM_HOST_DEVICE inline
+void PAConvectionApply2DElement(const int e,
+                                const DeviceTensor<2,const double> &B,
+                                const DeviceTensor<2,const double> &G,
+                                const DeviceTensor<2,const double> &Bt,
+                                const DeviceTensor<4,const real_t> &op,
+                                const DeviceTensor<3,const real_t> &x,
+                                const DeviceTensor<3,real_t> &y,
+                                const int d1d,
+                                const int q1d)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   // the following variables are evaluated at compile time
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+   real_t u[max_D1D][max_D1D];
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         u[dy][dx] = x(dx,dy,e);
+      }
+   }
+   real_t Bu[max_D1D][max_Q1D];
+   real_t Gu[max_D1D][max_Q1D];
+   for (int dy = 0; dy < D1D; ++dy)
+   {
       for (int qx = 0; qx < Q1D; ++qx)
       {
-         for (int qy = 0; qy < Q1D; ++qy)
+         Bu[dy][qx] = 0.0;
+         Gu[dy][qx] = 0.0;
+         for (int dx = 0; dx < D1D; ++dx)
          {
-            GBu[qy][qx] = 0.0;
-            BGu[qy][qx] = 0.0;
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const double bx  = B(qy,dy);
-               const double gx  = G(qy,dy);
-               GBu[qy][qx] += gx * Bu[dy][qx];
-               BGu[qy][qx] += bx * Gu[dy][qx];
-            }
+            const double bx  = B(qx,dx);
+            const double gx  = G(qx,dx);
+            const real_t x = u[dy][dx];
+            Bu[dy][qx] += bx * x;
+            Gu[dy][qx] += gx * x;
          }
       }
-      // Calculate Dxy, xDy in plane
-      double DGu[max_Q1D][max_Q1D];
+   }
+   real_t GBu[max_Q1D][max_Q1D];
+   real_t BGu[max_Q1D][max_Q1D];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
       for (int qy = 0; qy < Q1D; ++qy)
       {
-         for (int qx = 0; qx < Q1D; ++qx)
+         GBu[qy][qx] = 0.0;
+         BGu[qy][qx] = 0.0;
+         for (int dy = 0; dy < D1D; ++dy)
          {
-            const double O1 = op(qx,qy,0,e);
-            const double O2 = op(qx,qy,1,e);
-
-            const double gradX = BGu[qy][qx];
-            const double gradY = GBu[qy][qx];
-
-            DGu[qy][qx] = (O1 * gradX) + (O2 * gradY);
+            const double bx  = B(qy,dy);
+            const double gx  = G(qy,dy);
+            GBu[qy][qx] += gx * Bu[dy][qx];
+            BGu[qy][qx] += bx * Gu[dy][qx];
          }
       }
-      double BDGu[max_D1D][max_Q1D];
+   }
+   // Calculate Dxy, xDy in plane
+   real_t DGu[max_Q1D][max_Q1D];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
       for (int qx = 0; qx < Q1D; ++qx)
       {
-         for (int dy = 0; dy < D1D; ++dy)
+         const real_t O1 = op(qx,qy,0,e);
+         const real_t O2 = op(qx,qy,1,e);
+
+         const real_t gradX = BGu[qy][qx];
+         const real_t gradY = GBu[qy][qx];
+
+         DGu[qy][qx] = (O1 * gradX) + (O2 * gradY);
+      }
+   }
+   real_t BDGu[max_D1D][max_Q1D];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         BDGu[dy][qx] = 0.0;
+         for (int qy = 0; qy < Q1D; ++qy)
          {
-            BDGu[dy][qx] = 0.0;
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const double w  = Bt(dy,qy);
-               BDGu[dy][qx] += w * DGu[qy][qx];
-            }
+            const double w  = Bt(dy,qy);
+            BDGu[dy][qx] += w * DGu[qy][qx];
          }
       }
-      for (int dx = 0; dx < D1D; ++dx)
+   }
+   for (int dx = 0; dx < D1D; ++dx)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
       {
-         for (int dy = 0; dy < D1D; ++dy)
+         real_t BBDGu;
+         BBDGu = 0.0;
+         for (int qx = 0; qx < Q1D; ++qx)
          {
-            double BBDGu = 0.0;
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double w  = Bt(dx,qx);
-               BBDGu += w * BDGu[dy][qx];
-            }
-            y(dx,dy,e) += BBDGu;
+            const double w  = Bt(dx,qx);
+            BBDGu += w * BDGu[dy][qx];
          }
+         y(dx,dy,e) += BBDGu;
       }
+   }
+}
+
+// PA Convection Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAConvectionApply2D(const int ne,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &_op,
+                         const Vector &_x,
+                         Vector &_y,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   const int NE = ne;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, 2, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      PAConvectionApply2DElement<T_D1D,T_Q1D>(e, B, G, Bt, op, x, y, d1d, q1d);
    });
 }
 
@@ -381,184 +466,201 @@ void SmemPAConvectionApply2D(const int ne,
    });
 }
 
-// PA Convection Apply 3D kernel
-template<int T_D1D = 0, int T_Q1D = 0> static
-void PAConvectionApply3D(const int ne,
-                         const Array<double> &b,
-                         const Array<double> &g,
-                         const Array<double> &bt,
-                         const Array<double> &gt,
-                         const Vector &_op,
-                         const Vector &_x,
-                         Vector &_y,
-                         const int d1d = 0,
-                         const int q1d = 0)
+// PA Convection Apply 3D kernel for the element e
+template<int T_D1D = 0, int T_Q1D = 0, typename real_t = double>
+static MFEM_HOST_DEVICE inline
+void PAConvectionApply3DElement(const int e,
+                                const DeviceTensor<2,const double> &B,
+                                const DeviceTensor<2,const double> &G,
+                                const DeviceTensor<2,const double> &Bt,
+                                const DeviceTensor<5,const real_t> &op,
+                                const DeviceTensor<4,const real_t> &x,
+                                const DeviceTensor<4,real_t> &y,
+                                const int d1d,
+                                const int q1d)
 {
-   const int NE = ne;
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto G = Reshape(g.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt.Read(), D1D, Q1D);
-   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, 3, NE);
-   auto x = Reshape(_x.Read(), D1D, D1D, D1D, NE);
-   auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
-   {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+   // the following variables are evaluated at compile time
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
 
-      double u[max_D1D][max_D1D][max_D1D];
-      for (int dz = 0; dz < D1D; ++dz)
+   real_t u[max_D1D][max_D1D][max_D1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
       {
-         for (int dy = 0; dy < D1D; ++dy)
+         for (int dx = 0; dx < D1D; ++dx)
          {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               u[dz][dy][dx] = x(dx,dy,dz,e);
-            }
+            u[dz][dy][dx] = x(dx,dy,dz,e);
          }
       }
-      double Bu[max_D1D][max_D1D][max_Q1D];
-      double Gu[max_D1D][max_D1D][max_Q1D];
-      for (int dz = 0; dz < D1D; ++dz)
+   }
+   real_t Bu[max_D1D][max_D1D][max_Q1D];
+   real_t Gu[max_D1D][max_D1D][max_Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
       {
-         for (int dy = 0; dy < D1D; ++dy)
+         for (int qx = 0; qx < Q1D; ++qx)
          {
-            for (int qx = 0; qx < Q1D; ++qx)
+            Bu[dz][dy][qx] = 0.0;
+            Gu[dz][dy][qx] = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
             {
-               Bu[dz][dy][qx] = 0.0;
-               Gu[dz][dy][qx] = 0.0;
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  const double bx  = B(qx,dx);
-                  const double gx  = G(qx,dx);
-                  const double x = u[dz][dy][dx];
-                  Bu[dz][dy][qx] += bx * x;
-                  Gu[dz][dy][qx] += gx * x;
-               }
+               const double bx  = B(qx,dx);
+               const double gx  = G(qx,dx);
+               const real_t x = u[dz][dy][dx];
+               Bu[dz][dy][qx] += bx * x;
+               Gu[dz][dy][qx] += gx * x;
             }
          }
       }
-      double BBu[max_D1D][max_Q1D][max_Q1D];
-      double GBu[max_D1D][max_Q1D][max_Q1D];
-      double BGu[max_D1D][max_Q1D][max_Q1D];
-      for (int dz = 0; dz < D1D; ++dz)
+   }
+   real_t BBu[max_D1D][max_Q1D][max_Q1D];
+   real_t GBu[max_D1D][max_Q1D][max_Q1D];
+   real_t BGu[max_D1D][max_Q1D][max_Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
       {
-         for (int qx = 0; qx < Q1D; ++qx)
+         for (int qy = 0; qy < Q1D; ++qy)
          {
-            for (int qy = 0; qy < Q1D; ++qy)
+            BBu[dz][qy][qx] = 0.0;
+            GBu[dz][qy][qx] = 0.0;
+            BGu[dz][qy][qx] = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
             {
-               BBu[dz][qy][qx] = 0.0;
-               GBu[dz][qy][qx] = 0.0;
-               BGu[dz][qy][qx] = 0.0;
-               for (int dy = 0; dy < D1D; ++dy)
-               {
-                  const double bx  = B(qy,dy);
-                  const double gx  = G(qy,dy);
-                  BBu[dz][qy][qx] += bx * Bu[dz][dy][qx];
-                  GBu[dz][qy][qx] += gx * Bu[dz][dy][qx];
-                  BGu[dz][qy][qx] += bx * Gu[dz][dy][qx];
-               }
+               const double bx  = B(qy,dy);
+               const double gx  = G(qy,dy);
+               BBu[dz][qy][qx] += bx * Bu[dz][dy][qx];
+               GBu[dz][qy][qx] += gx * Bu[dz][dy][qx];
+               BGu[dz][qy][qx] += bx * Gu[dz][dy][qx];
             }
          }
       }
-      double GBBu[max_Q1D][max_Q1D][max_Q1D];
-      double BGBu[max_Q1D][max_Q1D][max_Q1D];
-      double BBGu[max_Q1D][max_Q1D][max_Q1D];
-      for (int qx = 0; qx < Q1D; ++qx)
+   }
+   real_t GBBu[max_Q1D][max_Q1D][max_Q1D];
+   real_t BGBu[max_Q1D][max_Q1D][max_Q1D];
+   real_t BBGu[max_Q1D][max_Q1D][max_Q1D];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
       {
-         for (int qy = 0; qy < Q1D; ++qy)
+         for (int qz = 0; qz < Q1D; ++qz)
          {
-            for (int qz = 0; qz < Q1D; ++qz)
+            GBBu[qz][qy][qx] = 0.0;
+            BGBu[qz][qy][qx] = 0.0;
+            BBGu[qz][qy][qx] = 0.0;
+            for (int dz = 0; dz < D1D; ++dz)
             {
-               GBBu[qz][qy][qx] = 0.0;
-               BGBu[qz][qy][qx] = 0.0;
-               BBGu[qz][qy][qx] = 0.0;
-               for (int dz = 0; dz < D1D; ++dz)
-               {
-                  const double bx  = B(qz,dz);
-                  const double gx  = G(qz,dz);
-                  GBBu[qz][qy][qx] += gx * BBu[dz][qy][qx];
-                  BGBu[qz][qy][qx] += bx * GBu[dz][qy][qx];
-                  BBGu[qz][qy][qx] += bx * BGu[dz][qy][qx];
-               }
+               const double bx  = B(qz,dz);
+               const double gx  = G(qz,dz);
+               GBBu[qz][qy][qx] += gx * BBu[dz][qy][qx];
+               BGBu[qz][qy][qx] += bx * GBu[dz][qy][qx];
+               BBGu[qz][qy][qx] += bx * BGu[dz][qy][qx];
             }
          }
       }
-      // Calculate Dxy, xDy in plane
-      double DGu[max_Q1D][max_Q1D][max_Q1D];
-      for (int qz = 0; qz < Q1D; ++qz)
+   }
+   // Calculate Dxy, xDy in plane
+   real_t DGu[max_Q1D][max_Q1D][max_Q1D];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
       {
-         for (int qy = 0; qy < Q1D; ++qy)
+         for (int qx = 0; qx < Q1D; ++qx)
          {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double O1 = op(qx,qy,qz,0,e);
-               const double O2 = op(qx,qy,qz,1,e);
-               const double O3 = op(qx,qy,qz,2,e);
+            const real_t O1 = op(qx,qy,qz,0,e);
+            const real_t O2 = op(qx,qy,qz,1,e);
+            const real_t O3 = op(qx,qy,qz,2,e);
 
-               const double gradX = BBGu[qz][qy][qx];
-               const double gradY = BGBu[qz][qy][qx];
-               const double gradZ = GBBu[qz][qy][qx];
+            const real_t gradX = BBGu[qz][qy][qx];
+            const real_t gradY = BGBu[qz][qy][qx];
+            const real_t gradZ = GBBu[qz][qy][qx];
 
-               DGu[qz][qy][qx] = (O1 * gradX) + (O2 * gradY) + (O3 * gradZ);
-            }
+            DGu[qz][qy][qx] = (O1 * gradX) + (O2 * gradY) + (O3 * gradZ);
          }
       }
-      double BDGu[max_D1D][max_Q1D][max_Q1D];
-      for (int qx = 0; qx < Q1D; ++qx)
+   }
+   real_t BDGu[max_D1D][max_Q1D][max_Q1D];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
       {
-         for (int qy = 0; qy < Q1D; ++qy)
+         for (int dz = 0; dz < D1D; ++dz)
          {
-            for (int dz = 0; dz < D1D; ++dz)
+            BDGu[dz][qy][qx] = 0.0;
+            for (int qz = 0; qz < Q1D; ++qz)
             {
-               BDGu[dz][qy][qx] = 0.0;
-               for (int qz = 0; qz < Q1D; ++qz)
-               {
-                  const double w  = Bt(dz,qz);
-                  BDGu[dz][qy][qx] += w * DGu[qz][qy][qx];
-               }
+               const double w  = Bt(dz,qz);
+               BDGu[dz][qy][qx] += w * DGu[qz][qy][qx];
             }
          }
       }
-      double BBDGu[max_D1D][max_D1D][max_Q1D];
-      for (int dz = 0; dz < D1D; ++dz)
+   }
+   real_t BBDGu[max_D1D][max_D1D][max_Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
       {
-         for (int qx = 0; qx < Q1D; ++qx)
+         for (int dy = 0; dy < D1D; ++dy)
          {
-            for (int dy = 0; dy < D1D; ++dy)
+            BBDGu[dz][dy][qx] = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
             {
-               BBDGu[dz][dy][qx] = 0.0;
-               for (int qy = 0; qy < Q1D; ++qy)
-               {
-                  const double w  = Bt(dy,qy);
-                  BBDGu[dz][dy][qx] += w * BDGu[dz][qy][qx];
-               }
+               const double w  = Bt(dy,qy);
+               BBDGu[dz][dy][qx] += w * BDGu[dz][qy][qx];
             }
          }
       }
-      for (int dz = 0; dz < D1D; ++dz)
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
       {
-         for (int dy = 0; dy < D1D; ++dy)
+         for (int dx = 0; dx < D1D; ++dx)
          {
-            for (int dx = 0; dx < D1D; ++dx)
+            real_t BBBDGu;
+            BBBDGu = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
             {
-               double BBBDGu = 0.0;
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  const double w  = Bt(dx,qx);
-                  BBBDGu += w * BBDGu[dz][dy][qx];
-               }
-               y(dx,dy,dz,e) += BBBDGu;
+               const double w  = Bt(dx,qx);
+               BBBDGu += w * BBDGu[dz][dy][qx];
             }
+            y(dx,dy,dz,e) += BBBDGu;
          }
       }
+   }
+}
+
+// PA Convection Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAConvectionApply3D(const int ne,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &_op,
+                         const Vector &_x,
+                         Vector &_y,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   const int NE = ne;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, 3, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, D1D, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      PAConvectionApply3DElement<T_D1D,T_Q1D>(e, B, G, Bt, op, x, y, d1d, q1d);
    });
 }
 
@@ -824,6 +926,106 @@ void ConvectionIntegrator::AssemblePA(const FiniteElementSpace &fes)
                      vel, alpha, pa_data);
 }
 
+#ifdef MFEM_PA_SIMD
+// PA Convection Apply 2D kernel with PA_SIMD_SIZE elements in the SIMD lanes
+template<int T_D1D, int T_Q1D>
+static void PAConvectionApply2DSimd(const int NE,
+                                    const Array<double> &b,
+                                    const Array<double> &g,
+                                    const Array<double> &bt,
+                                    const Vector &_op,
+                                    const Vector &_x,
+                                    Vector &_y)
+{
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   const auto B = Reshape(b.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g.HostRead(), Q1D, D1D);
+   const auto Bt = Reshape(bt.HostRead(), D1D, Q1D);
+   PASimdApply<Q1D*Q1D*2, D1D*D1D, D1D*D1D>(
+      NE, _op, _x, _y, [&](const pa_simd_t *d, const pa_simd_t *x, pa_simd_t *y)
+   {
+      const auto op = Reshape(d, Q1D, Q1D, 2, 1);
+      const auto X = Reshape(x, D1D, D1D, 1);
+      const auto Y = Reshape(y, D1D, D1D, 1);
+      PAConvectionApply2DElement<D1D,Q1D,pa_simd_t>(0, B, G, Bt, op, X, Y,
+                                                    D1D, Q1D);
+   });
+}
+
+// PA Convection Apply 3D kernel with PA_SIMD_SIZE elements in the SIMD lanes
+template<int T_D1D, int T_Q1D>
+static void PAConvectionApply3DSimd(const int NE,
+                                    const Array<double> &b,
+                                    const Array<double> &g,
+                                    const Array<double> &bt,
+                                    const Vector &_op,
+                                    const Vector &_x,
+                                    Vector &_y)
+{
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   const auto B = Reshape(b.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g.HostRead(), Q1D, D1D);
+   const auto Bt = Reshape(bt.HostRead(), D1D, Q1D);
+   PASimdApply<Q1D*Q1D*Q1D*3, D1D*D1D*D1D, D1D*D1D*D1D>(
+      NE, _op, _x, _y, [&](const pa_simd_t *d, const pa_simd_t *x, pa_simd_t *y)
+   {
+      const auto op = Reshape(d, Q1D, Q1D, Q1D, 3, 1);
+      const auto X = Reshape(x, D1D, D1D, D1D, 1);
+      const auto Y = Reshape(y, D1D, D1D, D1D, 1);
+      PAConvectionApply3DElement<D1D,Q1D,pa_simd_t>(0, B, G, Bt, op, X, Y,
+                                                    D1D, Q1D);
+   });
+}
+
+// Returns false if there is no SIMD kernel for the given dimension and sizes
+static bool PAConvectionApplySimd(const int dim,
+                                  const int D1D,
+                                  const int Q1D,
+                                  const int NE,
+                                  const Array<double> &B,
+                                  const Array<double> &G,
+                                  const Array<double> &Bt,
+                                  const Vector &op,
+                                  const Vector &x,
+                                  Vector &y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: PAConvectionApply2DSimd<2,2>(NE,B,G,Bt,op,x,y); break;
+         case 0x33: PAConvectionApply2DSimd<3,3>(NE,B,G,Bt,op,x,y); break;
+         case 0x44: PAConvectionApply2DSimd<4,4>(NE,B,G,Bt,op,x,y); break;
+         case 0x55: PAConvectionApply2DSimd<5,5>(NE,B,G,Bt,op,x,y); break;
+         case 0x66: PAConvectionApply2DSimd<6,6>(NE,B,G,Bt,op,x,y); break;
+         case 0x77: PAConvectionApply2DSimd<7,7>(NE,B,G,Bt,op,x,y); break;
+         case 0x88: PAConvectionApply2DSimd<8,8>(NE,B,G,Bt,op,x,y); break;
+         case 0x99: PAConvectionApply2DSimd<9,9>(NE,B,G,Bt,op,x,y); break;
+         default: return false;
+      }
+      return true;
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: PAConvectionApply3DSimd<2,3>(NE,B,G,Bt,op,x,y); break;
+         case 0x34: PAConvectionApply3DSimd<3,4>(NE,B,G,Bt,op,x,y); break;
+         case 0x45: PAConvectionApply3DSimd<4,5>(NE,B,G,Bt,op,x,y); break;
+         case 0x56: PAConvectionApply3DSimd<5,6>(NE,B,G,Bt,op,x,y); break;
+         case 0x67: PAConvectionApply3DSimd<6,7>(NE,B,G,Bt,op,x,y); break;
+         case 0x78: PAConvectionApply3DSimd<7,8>(NE,B,G,Bt,op,x,y); break;
+         case 0x89: PAConvectionApply3DSimd<8,9>(NE,B,G,Bt,op,x,y); break;
+         default: return false;
+      }
+      return true;
+   }
+   return false;
+}
+#endif // MFEM_PA_SIMD
+
 static void PAConvectionApply(const int dim,
                               const int D1D,
                               const int Q1D,
@@ -836,7 +1038,35 @@ static void PAConvectionApply(const int dim,
                               const Vector &x,
                               Vector &y)
 {
-   if (dim == 2)
+   MFEM_PROFILE_REGION("PAConvectionApply");
+   // Read the E-vectors x and y, write y and read the quadrature vectors op.
+   MFEM_PROFILE_COUNTERS(
+      8.0*NE*(3*std::pow(D1D, dim) + dim*std::pow(Q1D, dim)),
+      NE*((dim+1)*SumFactorizationFlops(dim, D1D, Q1D) +
+          2*dim*std::pow(Q1D, dim)));
+#ifdef MFEM_PA_SIMD
+   if (DeviceCanUsePASimd() &&
+       PAConvectionApplySimd(dim,D1D,Q1D,NE,B,G,Bt,op,x,y))
+   {
+      return;
+   }
+#endif // MFEM_PA_SIMD
+   if (dim == 1)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAConvectionApply1D<2,2>(NE,G,Bt,op,x,y);
+         case 0x33: return PAConvectionApply1D<3,3>(NE,G,Bt,op,x,y);
+         case 0x44: return PAConvectionApply1D<4,4>(NE,G,Bt,op,x,y);
+         case 0x55: return PAConvectionApply1D<5,5>(NE,G,Bt,op,x,y);
+         case 0x66: return PAConvectionApply1D<6,6>(NE,G,Bt,op,x,y);
+         case 0x77: return PAConvectionApply1D<7,7>(NE,G,Bt,op,x,y);
+         case 0x88: return PAConvectionApply1D<8,8>(NE,G,Bt,op,x,y);
+         case 0x99: return PAConvectionApply1D<9,9>(NE,G,Bt,op,x,y);
+         default:   return PAConvectionApply1D(NE,G,Bt,op,x,y,D1D,Q1D);
+      }
+   }
+   else if (dim == 2)
    {
       switch ((D1D << 4 ) | Q1D)
       {
@@ -0,0 +1,346 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+#include "restriction.hpp"
+#ifdef MFEM_USE_MPI
+#include "../mesh/pmesh.hpp"
+#endif
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA DG Diffusion Integrator
+//
+// The face terms need the normal derivatives of the solution, so the kernels
+// act on all the dofs of the (one or two) elements sharing each face, see
+// L2FaceNeighborRestriction. For every face and quadrature point we store the
+// scaled normals n_s = w/2 adj(J_s) Q^T nor / det(J_s) of the two sides, so
+// that n_s.grad(phi) is the scaled physical normal derivative of phi computed
+// from its reference gradient, and the jump penalty kappa (n_1 + n_2).nor. The
+// basis values and reference gradients at the face quadrature points only
+// depend on the local face and its orientation, so they are computed once for
+// every such combination that appears in the mesh.
+
+void DGDiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
+                                    FaceType type)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   nf = fes.GetNFbyType(type);
+   nq = 0;
+   ndofs = 0;
+   pa_face_maps.SetSize(2*nf);
+   if (nf == 0) { return; }
+
+   MFEM_VERIFY(fes.GetVDim() == 1, "only scalar spaces are supported");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim,
+               "meshes embedded in higher dimension are not supported");
+   MFEM_VERIFY(mesh->GetNumGeometries(dim) == 1,
+               "meshes with mixed element types are not supported");
+   const FiniteElement &el = *fes.GetFE(0);
+   const Geometry::Type face_geom = mesh->GetFaceBaseGeometry(0);
+   const IntegrationRule *ir =
+      IntRule ? IntRule : &IntRules.Get(face_geom, 2*el.GetOrder());
+   nq = ir->GetNPoints();
+   ndofs = el.GetDof();
+
+#ifdef MFEM_USE_MPI
+   // Map from local faces to shared faces
+   ParMesh *pmesh = dynamic_cast<ParMesh*>(mesh);
+   Array<int> shared_face;
+   if (pmesh && type == FaceType::Interior)
+   {
+      shared_face.SetSize(mesh->GetNumFaces());
+      shared_face = -1;
+      for (int sf = 0; sf < pmesh->GetNSharedFaces(); sf++)
+      {
+         shared_face[pmesh->GetSharedFace(sf)] = sf;
+      }
+   }
+#endif
+
+   // The local face (and its orientation) of side s is given by the face info
+   // inf_s; map_index converts (s, inf_s) to an index in pa_shape.
+   const int max_info = 64*8;
+   Array<int> map_index(2*max_info);
+   map_index = -1;
+   Array<double> shape_data, dshape_data;
+   int nmaps = 0;
+
+   const int nsides = (type == FaceType::Interior) ? 2 : 1;
+   const int PD = 2*dim + 1;
+   pa_data.SetSize(PD*nq*nf, Device::GetMemoryType());
+   auto D = Reshape(pa_data.HostWrite(), PD, nq, nf);
+   int *face_maps = pa_face_maps.HostWrite();
+   Vector shape(ndofs);
+   DenseMatrix dshape(ndofs, dim);
+   nor.SetSize(dim);
+   nh.SetSize(dim);
+   ni.SetSize(dim);
+   adjJ.SetSize(dim);
+   if (MQ) { mq.SetSize(dim); }
+   int f_ind = 0;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      int e1, e2, inf1, inf2;
+      mesh->GetFaceElements(f, &e1, &e2);
+      mesh->GetFaceInfos(f, &inf1, &inf2);
+      if (!((type==FaceType::Interior && (e2>=0 || (e2<0 && inf2>=0))) ||
+            (type==FaceType::Boundary && e2<0 && inf2<0)))
+      {
+         continue;
+      }
+      MFEM_VERIFY(mesh->GetFaceBaseGeometry(f) == face_geom,
+                  "meshes with mixed face types are not supported");
+      FaceElementTransformations *T;
+#ifdef MFEM_USE_MPI
+      if (e2 < 0 && inf2 >= 0)
+      {
+         T = pmesh->GetSharedFaceTransformations(shared_face[f]);
+      }
+      else
+#endif
+      {
+         T = mesh->GetFaceElementTransformations(f);
+      }
+
+      bool new_map[2] = { false, false };
+      face_maps[2*f_ind + 1] = -1;
+      for (int s = 0; s < nsides; s++)
+      {
+         const int key = s*max_info + (s ? inf2 : inf1);
+         if (map_index[key] < 0)
+         {
+            map_index[key] = nmaps++;
+            new_map[s] = true;
+            shape_data.SetSize(nmaps*nq*ndofs);
+            dshape_data.SetSize(nmaps*nq*dim*ndofs);
+         }
+         face_maps[2*f_ind + s] = map_index[key];
+      }
+
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(q);
+         T->SetAllIntPoints(&ip);
+         if (dim == 1)
+         {
+            nor(0) = 2*T->GetElement1IntPoint().x - 1.0;
+         }
+         else
+         {
+            CalcOrtho(T->Jacobian(), nor);
+         }
+         double wq = 0.0;
+         for (int k = 0; k < dim; k++) { D(dim + k, q, f_ind) = 0.0; }
+         for (int s = 0; s < nsides; s++)
+         {
+            ElementTransformation &Ts = s ? *T->Elem2 : *T->Elem1;
+            const IntegrationPoint &eip =
+               s ? T->GetElement2IntPoint() : T->GetElement1IntPoint();
+            double w = ip.weight/Ts.Weight()/nsides;
+            if (!MQ)
+            {
+               if (Q) { w *= Q->Eval(Ts, eip); }
+               ni.Set(w, nor);
+            }
+            else
+            {
+               nh.Set(w, nor);
+               MQ->Eval(mq, Ts, eip);
+               mq.MultTranspose(nh, ni);
+            }
+            CalcAdjugate(Ts.Jacobian(), adjJ);
+            adjJ.Mult(ni, nh);
+            wq += ni * nor;
+            for (int k = 0; k < dim; k++) { D(s*dim + k, q, f_ind) = nh(k); }
+
+            if (new_map[s])
+            {
+               const int m = face_maps[2*f_ind + s];
+               el.CalcShape(eip, shape);
+               el.CalcDShape(eip, dshape);
+               for (int i = 0; i < ndofs; i++)
+               {
+                  shape_data[q + nq*(i + ndofs*m)] = shape(i);
+                  for (int k = 0; k < dim; k++)
+                  {
+                     dshape_data[q + nq*(k + dim*(i + ndofs*m))] = dshape(i,k);
+                  }
+               }
+            }
+         }
+         D(2*dim, q, f_ind) = kappa * wq;
+      }
+      f_ind++;
+   }
+   MFEM_VERIFY(f_ind==nf, "Incorrect number of faces.");
+
+   pa_shape.SetSize(shape_data.Size(), Device::GetMemoryType());
+   pa_dshape.SetSize(dshape_data.Size(), Device::GetMemoryType());
+   std::copy(shape_data.begin(), shape_data.end(), pa_shape.HostWrite());
+   std::copy(dshape_data.begin(), dshape_data.end(), pa_dshape.HostWrite());
+}
+
+void DGDiffusionIntegrator::AssemblePAInteriorFaces(
+   const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Interior);
+}
+
+void DGDiffusionIntegrator::AssemblePABoundaryFaces(
+   const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Boundary);
+}
+
+// Apply the face terms, (-A + sigma A^T + J) or its transpose, where A is the
+// consistency term and J is the penalty term: cA and cAt are the coefficients
+// of A and A^T, respectively.
+static void PADGDiffusionApply(const int NF,
+                               const int NQ,
+                               const int ND,
+                               const int DIM,
+                               const double cA,
+                               const double cAt,
+                               const Array<int> &face_maps,
+                               const Vector &b,
+                               const Vector &g,
+                               const Vector &d,
+                               const Vector &x,
+                               Vector &y)
+{
+   const int NM = b.Size() / (NQ*ND);
+   auto M = Reshape(face_maps.Read(), 2, NF);
+   auto B = Reshape(b.Read(), NQ, ND, NM);
+   auto G = Reshape(g.Read(), NQ, DIM, ND, NM);
+   auto D = Reshape(d.Read(), 2*DIM + 1, NQ, NF);
+   auto X = Reshape(x.Read(), ND, 2, NF);
+   auto Y = Reshape(y.ReadWrite(), ND, 2, NF);
+   MFEM_FORALL(f, NF,
+   {
+      const int ns = (M(1,f) < 0) ? 1 : 2;
+      for (int q = 0; q < NQ; q++)
+      {
+         // Jump of u and average of the normal flux
+         double jump = 0.0, dn = 0.0;
+         for (int s = 0; s < ns; s++)
+         {
+            const int m = M(s,f);
+            double u = 0.0;
+            for (int i = 0; i < ND; i++)
+            {
+               double gn = 0.0;
+               for (int k = 0; k < DIM; k++)
+               {
+                  gn += G(q,k,i,m) * D(s*DIM + k,q,f);
+               }
+               u += B(q,i,m) * X(i,s,f);
+               dn += gn * X(i,s,f);
+            }
+            jump += s ? -u : u;
+         }
+         const double rv = cA*dn + D(2*DIM,q,f)*jump;
+         const double rg = cAt*jump;
+         for (int s = 0; s < ns; s++)
+         {
+            const int m = M(s,f);
+            for (int i = 0; i < ND; i++)
+            {
+               double gn = 0.0;
+               for (int k = 0; k < DIM; k++)
+               {
+                  gn += G(q,k,i,m) * D(s*DIM + k,q,f);
+               }
+               Y(i,s,f) += (s ? -rv : rv)*B(q,i,m) + rg*gn;
+            }
+         }
+      }
+   });
+}
+
+static void PADGDiffusionDiagonal(const int NF,
+                                  const int NQ,
+                                  const int ND,
+                                  const int DIM,
+                                  const double sigma,
+                                  const Array<int> &face_maps,
+                                  const Vector &b,
+                                  const Vector &g,
+                                  const Vector &d,
+                                  Vector &y)
+{
+   const int NM = b.Size() / (NQ*ND);
+   auto M = Reshape(face_maps.Read(), 2, NF);
+   auto B = Reshape(b.Read(), NQ, ND, NM);
+   auto G = Reshape(g.Read(), NQ, DIM, ND, NM);
+   auto D = Reshape(d.Read(), 2*DIM + 1, NQ, NF);
+   auto Y = Reshape(y.ReadWrite(), ND, 2, NF);
+   MFEM_FORALL(f, NF,
+   {
+      const int ns = (M(1,f) < 0) ? 1 : 2;
+      for (int s = 0; s < ns; s++)
+      {
+         const int m = M(s,f);
+         for (int i = 0; i < ND; i++)
+         {
+            double val = 0.0;
+            for (int q = 0; q < NQ; q++)
+            {
+               double gn = 0.0;
+               for (int k = 0; k < DIM; k++)
+               {
+                  gn += G(q,k,i,m) * D(s*DIM + k,q,f);
+               }
+               const double bi = B(q,i,m);
+               val += (s ? 1.0 - sigma : sigma - 1.0)*bi*gn
+                      + D(2*DIM,q,f)*bi*bi;
+            }
+            Y(i,s,f) += val;
+         }
+      }
+   });
+}
+
+void DGDiffusionIntegrator::ApplyPA(const Vector &x, Vector &y,
+                                    const bool transpose) const
+{
+   if (nf == 0) { return; }
+   const double cA = transpose ? sigma : -1.0;
+   const double cAt = transpose ? -1.0 : sigma;
+   PADGDiffusionApply(nf, nq, ndofs, dim, cA, cAt, pa_face_maps,
+                      pa_shape, pa_dshape, pa_data, x, y);
+}
+
+void DGDiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   ApplyPA(x, y, false);
+}
+
+void DGDiffusionIntegrator::AddMultTransposePA(const Vector &x,
+                                               Vector &y) const
+{
+   ApplyPA(x, y, true);
+}
+
+void DGDiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
+{
+   if (nf == 0) { return; }
+   PADGDiffusionDiagonal(nf, nq, ndofs, dim, sigma, pa_face_maps,
+                         pa_shape, pa_dshape, pa_data, diag);
+}
+
+} // namespace mfem
@@ -19,6 +19,39 @@ using namespace std;
 namespace mfem
 {
 // PA DG Trace Integrator
+static void PADGTraceSetup1D(const int NF,
+                             const Array<double> &w,
+                             const Vector &det,
+                             const Vector &nor,
+                             const Vector &rho,
+                             const Vector &vel,
+                             const double alpha,
+                             const double beta,
+                             Vector &op)
+{
+   auto d = Reshape(det.Read(), NF);
+   auto n = Reshape(nor.Read(), NF);
+   const bool const_r = rho.Size() == 1;
+   auto R = const_r ? Reshape(rho.Read(), 1) : Reshape(rho.Read(), NF);
+   const bool const_v = vel.Size() == 1;
+   auto V = const_v ? Reshape(vel.Read(), 1) : Reshape(vel.Read(), NF);
+   auto W = w.Read();
+   auto qd = Reshape(op.Write(), 2, 2, NF);
+
+   MFEM_FORALL(f, NF,
+   {
+      const double r = const_r ? R(0) : R(f);
+      const double v = const_v ? V(0) : V(f);
+      const double dot = n(f) * v;
+      const double abs = dot > 0.0 ? dot : -dot;
+      const double w = W[0]*r*d(f);
+      qd(0,0,f) = w*( alpha/2 * dot + beta * abs );
+      qd(1,0,f) = w*( alpha/2 * dot - beta * abs );
+      qd(0,1,f) = w*(-alpha/2 * dot - beta * abs );
+      qd(1,1,f) = w*(-alpha/2 * dot + beta * abs );
+   });
+}
+
 static void PADGTraceSetup2D(const int Q1D,
                              const int NF,
                              const Array<double> &w,
@@ -121,7 +154,10 @@ static void PADGTraceSetup(const int dim,
                            const double beta,
                            Vector &op)
 {
-   if (dim == 1) { MFEM_ABORT("dim==1 not supported in PADGTraceSetup"); }
+   if (dim == 1)
+   {
+      PADGTraceSetup1D(NF, W, det, nor, rho, u, alpha, beta, op);
+   }
    if (dim == 2)
    {
       PADGTraceSetup2D(Q1D, NF, W, det, nor, rho, u, alpha, beta, op);
@@ -152,7 +188,10 @@ void DGTraceIntegrator::SetupPA(const FiniteElementSpace &fes, FaceType type)
              *ir,
              FaceGeometricFactors::DETERMINANTS |
              FaceGeometricFactors::NORMALS, type);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   // In 1D, the faces are points: the trace element is not a tensor element
+   // and the 1D maps are the (trivial) full maps.
+   maps = &el.GetDofToQuad(*ir, dim == 1 ? DofToQuad::FULL :
+                           DofToQuad::TENSOR);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    pa_data.SetSize(symmDims * nq * nf, Device::GetMemoryType());
@@ -300,6 +339,23 @@ void DGTraceIntegrator::AssemblePABoundaryFaces(const FiniteElementSpace& fes)
    SetupPA(fes, FaceType::Boundary);
 }
 
+// PA DGTrace Apply 1D kernel: the faces are points with one dof on each side
+static void PADGTraceApply1D(const int NF,
+                             const Vector &_op,
+                             const Vector &_x,
+                             Vector &_y)
+{
+   auto op = Reshape(_op.Read(), 2, 2, NF);
+   auto x = Reshape(_x.Read(), 2, NF);
+   auto y = Reshape(_y.ReadWrite(), 2, NF);
+   MFEM_FORALL(f, NF,
+   {
+      const double DBu = op(0,0,f)*x(0,f) + op(1,0,f)*x(1,f);
+      y(0,f) +=  DBu;
+      y(1,f) += -DBu;
+   });
+}
+
 // PA DGTrace Apply 2D kernel for Gauss-Lobatto/Bernstein
 template<int T_D1D = 0, int T_Q1D = 0> static
 void PADGTraceApply2D(const int NF,
@@ -668,7 +724,11 @@ static void PADGTraceApply(const int dim,
                            const Vector &x,
                            Vector &y)
 {
-   if (dim == 2)
+   if (dim == 1)
+   {
+      return PADGTraceApply1D(NF,op,x,y);
+   }
+   else if (dim == 2)
    {
       switch ((D1D << 4 ) | Q1D)
       {
@@ -700,6 +760,24 @@ static void PADGTraceApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA DGTrace Apply Transpose 1D kernel
+static void PADGTraceApplyTranspose1D(const int NF,
+                                      const Vector &_op,
+                                      const Vector &_x,
+                                      Vector &_y)
+{
+   auto op = Reshape(_op.Read(), 2, 2, NF);
+   auto x = Reshape(_x.Read(), 2, NF);
+   auto y = Reshape(_y.ReadWrite(), 2, NF);
+   MFEM_FORALL(f, NF,
+   {
+      const double u0 = x(0,f);
+      const double u1 = x(1,f);
+      y(0,f) += op(0,0,f)*u0 + op(0,1,f)*u1;
+      y(1,f) += op(1,0,f)*u0 + op(1,1,f)*u1;
+   });
+}
+
 // PA DGTrace Apply 2D kernel for Gauss-Lobatto/Bernstein
 template<int T_D1D = 0, int T_Q1D = 0> static
 void PADGTraceApplyTranspose2D(const int NF,
@@ -1097,7 +1175,11 @@ static void PADGTraceApplyTranspose(const int dim,
                                     const Vector &x,
                                     Vector &y)
 {
-   if (dim == 2)
+   if (dim == 1)
+   {
+      return PADGTraceApplyTranspose1D(NF,op,x,y);
+   }
+   else if (dim == 2)
    {
       switch ((D1D << 4 ) | Q1D)
       {
@@ -37,14 +37,6 @@ static void EADiffusionAssemble1D(const int NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      double r_Gi[MQ1];
-      double r_Gj[MQ1];
-      for (int q = 0; q < Q1D; q++)
-      {
-         r_Gi[q] = G(q,MFEM_THREAD_ID(x));
-         r_Gj[q] = G(q,MFEM_THREAD_ID(y));
-      }
       MFEM_FOREACH_THREAD(i1,x,D1D)
       {
          MFEM_FOREACH_THREAD(j1,y,D1D)
@@ -52,7 +44,7 @@ static void EADiffusionAssemble1D(const int NE,
             double val = 0.0;
             for (int k1 = 0; k1 < Q1D; ++k1)
             {
-               val += r_Gj[k1] * D(k1, e) * r_Gi[k1];
+               val += G(k1,j1) * D(k1, e) * G(k1,i1);
             }
             if (add)
             {
@@ -0,0 +1,1035 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BILININTEG_DIFFUSION_KERNELS_HPP
+#define MFEM_BILININTEG_DIFFUSION_KERNELS_HPP
+
+#include "../config/config.hpp"
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "pa_simd.hpp"
+
+// Tensor partial assembly action kernels of the DiffusionIntegrator. Include
+// this header to register specializations for additional orders with
+// DiffusionIntegrator::AddSpecialization().
+
+namespace mfem
+{
+
+// PA Diffusion Apply 2D kernel for the element e, where x and y are the
+// (lexicographic) dofs of the element
+template<int T_D1D = 0, int T_Q1D = 0, typename real_t = double>
+MFEM_HOST_DEVICE inline
+void PADiffusionApply2DElement(const int e,
+                               const bool symmetric,
+                               const DeviceTensor<2,const double> &B,
+                               const DeviceTensor<2,const double> &G,
+                               const DeviceTensor<2,const double> &Bt,
+                               const DeviceTensor<2,const double> &Gt,
+                               const DeviceTensor<3,const real_t> &D,
+                               const real_t *x,
+                               real_t *y,
+                               const int d1d,
+                               const int q1d)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   // the following variables are evaluated at compile time
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+   real_t grad[max_Q1D][max_Q1D][2];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         grad[qy][qx][0] = 0.0;
+         grad[qy][qx][1] = 0.0;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      real_t gradX[max_Q1D][2];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         gradX[qx][0] = 0.0;
+         gradX[qx][1] = 0.0;
+      }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         const real_t s = x[dx + D1D*dy];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] += s * B(qx,dx);
+            gradX[qx][1] += s * G(qx,dx);
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         const double wy  = B(qy,dy);
+         const double wDy = G(qy,dy);
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][0] += gradX[qx][1] * wy;
+            grad[qy][qx][1] += gradX[qx][0] * wDy;
+         }
+      }
+   }
+   // Calculate Dxy, xDy in plane
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const int q = qx + qy * Q1D;
+
+         const real_t O11 = D(q,0,e);
+         const real_t O21 = D(q,1,e);
+         const real_t O12 = symmetric ? O21 : D(q,2,e);
+         const real_t O22 = symmetric ? D(q,2,e) : D(q,3,e);
+
+         const real_t gradX = grad[qy][qx][0];
+         const real_t gradY = grad[qy][qx][1];
+
+         grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+         grad[qy][qx][1] = (O21 * gradX) + (O22 * gradY);
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      real_t gradX[max_D1D][2];
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         gradX[dx][0] = 0;
+         gradX[dx][1] = 0;
+      }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const real_t gX = grad[qy][qx][0];
+         const real_t gY = grad[qy][qx][1];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double wx  = Bt(dx,qx);
+            const double wDx = Gt(dx,qx);
+            gradX[dx][0] += gX * wDx;
+            gradX[dx][1] += gY * wx;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         const double wy  = Bt(dy,qy);
+         const double wDy = Gt(dy,qy);
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            y[dx + D1D*dy] += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+         }
+      }
+   }
+}
+
+// PA Diffusion Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+void PADiffusionApply2D(const int NE,
+                        const bool symmetric,
+                        const Array<double> &b_,
+                        const Array<double> &g_,
+                        const Array<double> &bt_,
+                        const Array<double> &gt_,
+                        const Vector &d_,
+                        const Vector &x_,
+                        Vector &y_,
+                        const int d1d = 0,
+                        const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      PADiffusionApply2DElement<T_D1D,T_Q1D>(e, symmetric, B, G, Bt, Gt, D,
+                                             &X(0,0,e), &Y(0,0,e), d1d, q1d);
+   });
+}
+
+// Shared memory PA Diffusion Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+void SmemPADiffusionApply2D(const int NE,
+                            const bool symmetric,
+                            const Array<double> &b_,
+                            const Array<double> &g_,
+                            const Vector &d_,
+                            const Vector &x_,
+                            Vector &y_,
+                            const int d1d = 0,
+                            const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   constexpr int NBZ = T_NBZ ? T_NBZ : 1;
+   constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+   constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+   MFEM_VERIFY(D1D <= MD1, "");
+   MFEM_VERIFY(Q1D <= MQ1, "");
+   auto b = Reshape(b_.Read(), Q1D, D1D);
+   auto g = Reshape(g_.Read(), Q1D, D1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   {
+      const int tidz = MFEM_THREAD_ID(z);
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int NBZ = T_NBZ ? T_NBZ : 1;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      MFEM_SHARED double sBG[2][MQ1*MD1];
+      double (*B)[MD1] = (double (*)[MD1]) (sBG+0);
+      double (*G)[MD1] = (double (*)[MD1]) (sBG+1);
+      double (*Bt)[MQ1] = (double (*)[MQ1]) (sBG+0);
+      double (*Gt)[MQ1] = (double (*)[MQ1]) (sBG+1);
+      MFEM_SHARED double Xz[NBZ][MD1][MD1];
+      MFEM_SHARED double GD[2][NBZ][MD1][MQ1];
+      MFEM_SHARED double GQ[2][NBZ][MD1][MQ1];
+      double (*X)[MD1] = (double (*)[MD1])(Xz + tidz);
+      double (*DQ0)[MD1] = (double (*)[MD1])(GD[0] + tidz);
+      double (*DQ1)[MD1] = (double (*)[MD1])(GD[1] + tidz);
+      double (*QQ0)[MD1] = (double (*)[MD1])(GQ[0] + tidz);
+      double (*QQ1)[MD1] = (double (*)[MD1])(GQ[1] + tidz);
+      MFEM_FOREACH_THREAD(dy,y,D1D)
+      {
+         MFEM_FOREACH_THREAD(dx,x,D1D)
+         {
+            X[dy][dx] = x(dx,dy,e);
+         }
+      }
+      if (tidz == 0)
+      {
+         MFEM_FOREACH_THREAD(dy,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(q,x,Q1D)
+            {
+               B[q][dy] = b(q,dy);
+               G[q][dy] = g(q,dy);
+            }
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(dy,y,D1D)
+      {
+         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         {
+            double u = 0.0;
+            double v = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double coords = X[dy][dx];
+               u += B[qx][dx] * coords;
+               v += G[qx][dx] * coords;
+            }
+            DQ0[dy][qx] = u;
+            DQ1[dy][qx] = v;
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(qy,y,Q1D)
+      {
+         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         {
+            double u = 0.0;
+            double v = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               u += DQ1[dy][qx] * B[qy][dy];
+               v += DQ0[dy][qx] * G[qy][dy];
+            }
+            QQ0[qy][qx] = u;
+            QQ1[qy][qx] = v;
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(qy,y,Q1D)
+      {
+         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         {
+            const int q = (qx + ((qy) * Q1D));
+            const double O11 = D(q,0,e);
+            const double O21 = D(q,1,e);
+            const double O12 = symmetric ? O21 : D(q,2,e);
+            const double O22 = symmetric ? D(q,2,e) : D(q,3,e);
+            const double gX = QQ0[qy][qx];
+            const double gY = QQ1[qy][qx];
+            QQ0[qy][qx] = (O11 * gX) + (O12 * gY);
+            QQ1[qy][qx] = (O21 * gX) + (O22 * gY);
+         }
+      }
+      MFEM_SYNC_THREAD;
+      if (tidz == 0)
+      {
+         MFEM_FOREACH_THREAD(dy,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(q,x,Q1D)
+            {
+               Bt[dy][q] = b(q,dy);
+               Gt[dy][q] = g(q,dy);
+            }
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(qy,y,Q1D)
+      {
+         MFEM_FOREACH_THREAD(dx,x,D1D)
+         {
+            double u = 0.0;
+            double v = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               u += Gt[dx][qx] * QQ0[qy][qx];
+               v += Bt[dx][qx] * QQ1[qy][qx];
+            }
+            DQ0[qy][dx] = u;
+            DQ1[qy][dx] = v;
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(dy,y,D1D)
+      {
+         MFEM_FOREACH_THREAD(dx,x,D1D)
+         {
+            double u = 0.0;
+            double v = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               u += DQ0[qy][dx] * Bt[dy][qy];
+               v += DQ1[qy][dx] * Gt[dy][qy];
+            }
+            Y(dx,dy,e) += (u + v);
+         }
+      }
+   });
+}
+
+// PA Diffusion Apply 3D kernel
+// PA Diffusion Apply 3D kernel for the element e, where x and y are the
+// (lexicographic) dofs of the element
+template<int T_D1D = 0, int T_Q1D = 0, typename real_t = double>
+MFEM_HOST_DEVICE inline
+void PADiffusionApply3DElement(const int e,
+                               const bool symmetric,
+                               const DeviceTensor<2,const double> &B,
+                               const DeviceTensor<2,const double> &G,
+                               const DeviceTensor<2,const double> &Bt,
+                               const DeviceTensor<2,const double> &Gt,
+                               const DeviceTensor<3,const real_t> &D,
+                               const real_t *x,
+                               real_t *y,
+                               const int d1d,
+                               const int q1d)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+   real_t grad[max_Q1D][max_Q1D][max_Q1D][3];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qz][qy][qx][0] = 0.0;
+            grad[qz][qy][qx][1] = 0.0;
+            grad[qz][qy][qx][2] = 0.0;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      real_t gradXY[max_Q1D][max_Q1D][3];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradXY[qy][qx][0] = 0.0;
+            gradXY[qy][qx][1] = 0.0;
+            gradXY[qy][qx][2] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         real_t gradX[max_Q1D][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const real_t s = x[dx + D1D*(dy + D1D*dz)];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] += s * B(qx,dx);
+               gradX[qx][1] += s * G(qx,dx);
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B(qy,dy);
+            const double wDy = G(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const real_t wx  = gradX[qx][0];
+               const real_t wDx = gradX[qx][1];
+               gradXY[qy][qx][0] += wDx * wy;
+               gradXY[qy][qx][1] += wx  * wDy;
+               gradXY[qy][qx][2] += wx  * wy;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         const double wz  = B(qz,dz);
+         const double wDz = G(qz,dz);
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+               grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+               grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+            }
+         }
+      }
+   }
+   // Calculate Dxyz, xDyz, xyDz in plane
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + (qy + qz * Q1D) * Q1D;
+            const real_t O11 = D(q,0,e);
+            const real_t O12 = D(q,1,e);
+            const real_t O13 = D(q,2,e);
+            const real_t O21 = symmetric ? O12 : D(q,3,e);
+            const real_t O22 = symmetric ? D(q,3,e) : D(q,4,e);
+            const real_t O23 = symmetric ? D(q,4,e) : D(q,5,e);
+            const real_t O31 = symmetric ? O13 : D(q,6,e);
+            const real_t O32 = symmetric ? O23 : D(q,7,e);
+            const real_t O33 = symmetric ? D(q,5,e) : D(q,8,e);
+            const real_t gradX = grad[qz][qy][qx][0];
+            const real_t gradY = grad[qz][qy][qx][1];
+            const real_t gradZ = grad[qz][qy][qx][2];
+            grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+            grad[qz][qy][qx][1] = (O21*gradX)+(O22*gradY)+(O23*gradZ);
+            grad[qz][qy][qx][2] = (O31*gradX)+(O32*gradY)+(O33*gradZ);
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      real_t gradXY[max_D1D][max_D1D][3];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradXY[dy][dx][0] = 0;
+            gradXY[dy][dx][1] = 0;
+            gradXY[dy][dx][2] = 0;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         real_t gradX[max_D1D][3];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0;
+            gradX[dx][1] = 0;
+            gradX[dx][2] = 0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const real_t gX = grad[qz][qy][qx][0];
+            const real_t gY = grad[qz][qy][qx][1];
+            const real_t gZ = grad[qz][qy][qx][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = Bt(dx,qx);
+               const double wDx = Gt(dx,qx);
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+               gradX[dx][2] += gZ * wx;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = Bt(dy,qy);
+            const double wDy = Gt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradXY[dy][dx][0] += gradX[dx][0] * wy;
+               gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+               gradXY[dy][dx][2] += gradX[dx][2] * wy;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         const double wz  = Bt(dz,qz);
+         const double wDz = Gt(dz,qz);
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               y[dx + D1D*(dy + D1D*dz)] +=
+                  ((gradXY[dy][dx][0] * wz) +
+                   (gradXY[dy][dx][1] * wz) +
+                   (gradXY[dy][dx][2] * wDz));
+            }
+         }
+      }
+   }
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+void PADiffusionApply3D(const int NE,
+                        const bool symmetric,
+                        const Array<double> &b,
+                        const Array<double> &g,
+                        const Array<double> &bt,
+                        const Array<double> &gt,
+                        const Vector &d_,
+                        const Vector &x_,
+                        Vector &y_,
+                        int d1d = 0, int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      PADiffusionApply3DElement<T_D1D,T_Q1D>(e, symmetric, B, G, Bt, Gt, D,
+                                             &X(0,0,0,e), &Y(0,0,0,e),
+                                             d1d, q1d);
+   });
+}
+
+namespace internal
+{
+
+// Half of B and G are stored in shared to get B, Bt, G and Gt.
+// Indices computation for SmemPADiffusionApply3D.
+MFEM_HOST_DEVICE inline int qi(const int q, const int d, const int Q)
+{
+   return (q<=d) ? q : Q-1-q;
+}
+
+MFEM_HOST_DEVICE inline int dj(const int q, const int d, const int D)
+{
+   return (q<=d) ? d : D-1-d;
+}
+
+MFEM_HOST_DEVICE inline int qk(const int q, const int d, const int Q)
+{
+   return (q<=d) ? Q-1-q : q;
+}
+
+MFEM_HOST_DEVICE inline int dl(const int q, const int d, const int D)
+{
+   return (q<=d) ? D-1-d : d;
+}
+
+MFEM_HOST_DEVICE inline double sign(const int q, const int d)
+{
+   return (q<=d) ? -1.0 : 1.0;
+}
+
+} // namespace mfem::internal
+
+template<int T_D1D = 0, int T_Q1D = 0>
+void SmemPADiffusionApply3D(const int NE,
+                            const bool symmetric,
+                            const Array<double> &b_,
+                            const Array<double> &g_,
+                            const Vector &d_,
+                            const Vector &x_,
+                            Vector &y_,
+                            const int d1d = 0,
+                            const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   constexpr int M1Q = T_Q1D ? T_Q1D : MAX_Q1D;
+   constexpr int M1D = T_D1D ? T_D1D : MAX_D1D;
+   MFEM_VERIFY(D1D <= M1D, "");
+   MFEM_VERIFY(Q1D <= M1Q, "");
+   auto b = Reshape(b_.Read(), Q1D, D1D);
+   auto g = Reshape(g_.Read(), Q1D, D1D);
+   auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, symmetric ? 6 : 9, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL_3D(e, NE, Q1D, Q1D, 1,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MDQ = (MQ1 > MD1) ? MQ1 : MD1;
+      MFEM_SHARED double sBG[MQ1*MD1];
+      double (*B)[MD1] = (double (*)[MD1]) sBG;
+      double (*G)[MD1] = (double (*)[MD1]) sBG;
+      double (*Bt)[MQ1] = (double (*)[MQ1]) sBG;
+      double (*Gt)[MQ1] = (double (*)[MQ1]) sBG;
+      MFEM_SHARED double sm0[3][MDQ*MDQ*MDQ];
+      MFEM_SHARED double sm1[3][MDQ*MDQ*MDQ];
+      double (*X)[MD1][MD1]    = (double (*)[MD1][MD1]) (sm0+2);
+      double (*DDQ0)[MD1][MQ1] = (double (*)[MD1][MQ1]) (sm0+0);
+      double (*DDQ1)[MD1][MQ1] = (double (*)[MD1][MQ1]) (sm0+1);
+      double (*DQQ0)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm1+0);
+      double (*DQQ1)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm1+1);
+      double (*DQQ2)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm1+2);
+      double (*QQQ0)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm0+0);
+      double (*QQQ1)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm0+1);
+      double (*QQQ2)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm0+2);
+      double (*QQD0)[MQ1][MD1] = (double (*)[MQ1][MD1]) (sm1+0);
+      double (*QQD1)[MQ1][MD1] = (double (*)[MQ1][MD1]) (sm1+1);
+      double (*QQD2)[MQ1][MD1] = (double (*)[MQ1][MD1]) (sm1+2);
+      double (*QDD0)[MD1][MD1] = (double (*)[MD1][MD1]) (sm0+0);
+      double (*QDD1)[MD1][MD1] = (double (*)[MD1][MD1]) (sm0+1);
+      double (*QDD2)[MD1][MD1] = (double (*)[MD1][MD1]) (sm0+2);
+      MFEM_FOREACH_THREAD(dy,y,D1D)
+      {
+         MFEM_FOREACH_THREAD(dx,x,D1D)
+         {
+            MFEM_UNROLL(MD1)
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               X[dz][dy][dx] = x(dx,dy,dz,e);
+            }
+         }
+         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         {
+            const int i = internal::qi(qx,dy,Q1D);
+            const int j = internal::dj(qx,dy,D1D);
+            const int k = internal::qk(qx,dy,Q1D);
+            const int l = internal::dl(qx,dy,D1D);
+            B[i][j] = b(qx,dy);
+            G[k][l] = g(qx,dy) * internal::sign(qx,dy);
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(dy,y,D1D)
+      {
+         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         {
+            double u[D1D], v[D1D];
+            MFEM_UNROLL(MD1)
+            for (int dz = 0; dz < D1D; dz++) { u[dz] = v[dz] = 0.0; }
+            MFEM_UNROLL(MD1)
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const int i = internal::qi(qx,dx,Q1D);
+               const int j = internal::dj(qx,dx,D1D);
+               const int k = internal::qk(qx,dx,Q1D);
+               const int l = internal::dl(qx,dx,D1D);
+               const double s = internal::sign(qx,dx);
+               MFEM_UNROLL(MD1)
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  const double coords = X[dz][dy][dx];
+                  u[dz] += coords * B[i][j];
+                  v[dz] += coords * G[k][l] * s;
+               }
+            }
+            MFEM_UNROLL(MD1)
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               DDQ0[dz][dy][qx] = u[dz];
+               DDQ1[dz][dy][qx] = v[dz];
+            }
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(qy,y,Q1D)
+      {
+         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         {
+            double u[D1D], v[D1D], w[D1D];
+            MFEM_UNROLL(MD1)
+            for (int dz = 0; dz < D1D; dz++) { u[dz] = v[dz] = w[dz] = 0.0; }
+            MFEM_UNROLL(MD1)
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const int i = internal::qi(qy,dy,Q1D);
+               const int j = internal::dj(qy,dy,D1D);
+               const int k = internal::qk(qy,dy,Q1D);
+               const int l = internal::dl(qy,dy,D1D);
+               const double s = internal::sign(qy,dy);
+               MFEM_UNROLL(MD1)
+               for (int dz = 0; dz < D1D; dz++)
+               {
+                  u[dz] += DDQ1[dz][dy][qx] * B[i][j];
+                  v[dz] += DDQ0[dz][dy][qx] * G[k][l] * s;
+                  w[dz] += DDQ0[dz][dy][qx] * B[i][j];
+               }
+            }
+            MFEM_UNROLL(MD1)
+            for (int dz = 0; dz < D1D; dz++)
+            {
+               DQQ0[dz][qy][qx] = u[dz];
+               DQQ1[dz][qy][qx] = v[dz];
+               DQQ2[dz][qy][qx] = w[dz];
+            }
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(qy,y,Q1D)
+      {
+         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         {
+            double u[Q1D], v[Q1D], w[Q1D];
+            MFEM_UNROLL(MQ1)
+            for (int qz = 0; qz < Q1D; qz++) { u[qz] = v[qz] = w[qz] = 0.0; }
+            MFEM_UNROLL(MD1)
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               MFEM_UNROLL(MQ1)
+               for (int qz = 0; qz < Q1D; qz++)
+               {
+                  const int i = internal::qi(qz,dz,Q1D);
+                  const int j = internal::dj(qz,dz,D1D);
+                  const int k = internal::qk(qz,dz,Q1D);
+                  const int l = internal::dl(qz,dz,D1D);
+                  const double s = internal::sign(qz,dz);
+                  u[qz] += DQQ0[dz][qy][qx] * B[i][j];
+                  v[qz] += DQQ1[dz][qy][qx] * B[i][j];
+                  w[qz] += DQQ2[dz][qy][qx] * G[k][l] * s;
+               }
+            }
+            MFEM_UNROLL(MQ1)
+            for (int qz = 0; qz < Q1D; qz++)
+            {
+               const double O11 = d(qx,qy,qz,0,e);
+               const double O12 = d(qx,qy,qz,1,e);
+               const double O13 = d(qx,qy,qz,2,e);
+               const double O21 = symmetric ? O12 : d(qx,qy,qz,3,e);
+               const double O22 = symmetric ? d(qx,qy,qz,3,e) : d(qx,qy,qz,4,e);
+               const double O23 = symmetric ? d(qx,qy,qz,4,e) : d(qx,qy,qz,5,e);
+               const double O31 = symmetric ? O13 : d(qx,qy,qz,6,e);
+               const double O32 = symmetric ? O23 : d(qx,qy,qz,7,e);
+               const double O33 = symmetric ? d(qx,qy,qz,5,e) : d(qx,qy,qz,8,e);
+               const double gX = u[qz];
+               const double gY = v[qz];
+               const double gZ = w[qz];
+               QQQ0[qz][qy][qx] = (O11*gX) + (O12*gY) + (O13*gZ);
+               QQQ1[qz][qy][qx] = (O21*gX) + (O22*gY) + (O23*gZ);
+               QQQ2[qz][qy][qx] = (O31*gX) + (O32*gY) + (O33*gZ);
+            }
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(d,y,D1D)
+      {
+         MFEM_FOREACH_THREAD(q,x,Q1D)
+         {
+            const int i = internal::qi(q,d,Q1D);
+            const int j = internal::dj(q,d,D1D);
+            const int k = internal::qk(q,d,Q1D);
+            const int l = internal::dl(q,d,D1D);
+            Bt[j][i] = b(q,d);
+            Gt[l][k] = g(q,d) * internal::sign(q,d);
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(qy,y,Q1D)
+      {
+         MFEM_FOREACH_THREAD(dx,x,D1D)
+         {
+            double u[Q1D], v[Q1D], w[Q1D];
+            MFEM_UNROLL(MQ1)
+            for (int qz = 0; qz < Q1D; ++qz) { u[qz] = v[qz] = w[qz] = 0.0; }
+            MFEM_UNROLL(MQ1)
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int i = internal::qi(qx,dx,Q1D);
+               const int j = internal::dj(qx,dx,D1D);
+               const int k = internal::qk(qx,dx,Q1D);
+               const int l = internal::dl(qx,dx,D1D);
+               const double s = internal::sign(qx,dx);
+               MFEM_UNROLL(MQ1)
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  u[qz] += QQQ0[qz][qy][qx] * Gt[l][k] * s;
+                  v[qz] += QQQ1[qz][qy][qx] * Bt[j][i];
+                  w[qz] += QQQ2[qz][qy][qx] * Bt[j][i];
+               }
+            }
+            MFEM_UNROLL(MQ1)
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               QQD0[qz][qy][dx] = u[qz];
+               QQD1[qz][qy][dx] = v[qz];
+               QQD2[qz][qy][dx] = w[qz];
+            }
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(dy,y,D1D)
+      {
+         MFEM_FOREACH_THREAD(dx,x,D1D)
+         {
+            double u[Q1D], v[Q1D], w[Q1D];
+            MFEM_UNROLL(MQ1)
+            for (int qz = 0; qz < Q1D; ++qz) { u[qz] = v[qz] = w[qz] = 0.0; }
+            MFEM_UNROLL(MQ1)
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const int i = internal::qi(qy,dy,Q1D);
+               const int j = internal::dj(qy,dy,D1D);
+               const int k = internal::qk(qy,dy,Q1D);
+               const int l = internal::dl(qy,dy,D1D);
+               const double s = internal::sign(qy,dy);
+               MFEM_UNROLL(MQ1)
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  u[qz] += QQD0[qz][qy][dx] * Bt[j][i];
+                  v[qz] += QQD1[qz][qy][dx] * Gt[l][k] * s;
+                  w[qz] += QQD2[qz][qy][dx] * Bt[j][i];
+               }
+            }
+            MFEM_UNROLL(MQ1)
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               QDD0[qz][dy][dx] = u[qz];
+               QDD1[qz][dy][dx] = v[qz];
+               QDD2[qz][dy][dx] = w[qz];
+            }
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(dy,y,D1D)
+      {
+         MFEM_FOREACH_THREAD(dx,x,D1D)
+         {
+            double u[D1D], v[D1D], w[D1D];
+            MFEM_UNROLL(MD1)
+            for (int dz = 0; dz < D1D; ++dz) { u[dz] = v[dz] = w[dz] = 0.0; }
+            MFEM_UNROLL(MQ1)
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               MFEM_UNROLL(MD1)
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  const int i = internal::qi(qz,dz,Q1D);
+                  const int j = internal::dj(qz,dz,D1D);
+                  const int k = internal::qk(qz,dz,Q1D);
+                  const int l = internal::dl(qz,dz,D1D);
+                  const double s = internal::sign(qz,dz);
+                  u[dz] += QDD0[qz][dy][dx] * Bt[j][i];
+                  v[dz] += QDD1[qz][dy][dx] * Bt[j][i];
+                  w[dz] += QDD2[qz][dy][dx] * Gt[l][k] * s;
+               }
+            }
+            MFEM_UNROLL(MD1)
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               y(dx,dy,dz,e) += (u[dz] + v[dz] + w[dz]);
+            }
+         }
+      }
+   });
+}
+
+#ifdef MFEM_PA_SIMD
+// PA Diffusion Apply 2D kernel with PA_SIMD_SIZE elements in the SIMD lanes
+template<int T_D1D, int T_Q1D, bool T_SYMM>
+void PADiffusionApply2DSimd(const int NE,
+                            const Array<double> &b_,
+                            const Array<double> &g_,
+                            const Array<double> &bt_,
+                            const Array<double> &gt_,
+                            const Vector &d_,
+                            const Vector &x_,
+                            Vector &y_)
+{
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int NC = T_SYMM ? 3 : 4;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g_.HostRead(), Q1D, D1D);
+   const auto Bt = Reshape(bt_.HostRead(), D1D, Q1D);
+   const auto Gt = Reshape(gt_.HostRead(), D1D, Q1D);
+   PASimdApply<Q1D*Q1D*NC, D1D*D1D, D1D*D1D>(
+      NE, d_, x_, y_, [&](const pa_simd_t *d, const pa_simd_t *x, pa_simd_t *y)
+   {
+      const auto D = Reshape(d, Q1D*Q1D, NC, 1);
+      PADiffusionApply2DElement<D1D,Q1D,pa_simd_t>(0, T_SYMM, B, G, Bt, Gt, D,
+                                                   x, y, D1D, Q1D);
+   });
+}
+
+// PA Diffusion Apply 3D kernel with PA_SIMD_SIZE elements in the SIMD lanes
+template<int T_D1D, int T_Q1D, bool T_SYMM>
+void PADiffusionApply3DSimd(const int NE,
+                            const Array<double> &b_,
+                            const Array<double> &g_,
+                            const Array<double> &bt_,
+                            const Array<double> &gt_,
+                            const Vector &d_,
+                            const Vector &x_,
+                            Vector &y_)
+{
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int NC = T_SYMM ? 6 : 9;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g_.HostRead(), Q1D, D1D);
+   const auto Bt = Reshape(bt_.HostRead(), D1D, Q1D);
+   const auto Gt = Reshape(gt_.HostRead(), D1D, Q1D);
+   PASimdApply<Q1D*Q1D*Q1D*NC, D1D*D1D*D1D, D1D*D1D*D1D>(
+      NE, d_, x_, y_, [&](const pa_simd_t *d, const pa_simd_t *x, pa_simd_t *y)
+   {
+      const auto D = Reshape(d, Q1D*Q1D*Q1D, NC, 1);
+      PADiffusionApply3DElement<D1D,Q1D,pa_simd_t>(0, T_SYMM, B, G, Bt, Gt, D,
+                                                   x, y, D1D, Q1D);
+   });
+}
+#endif // MFEM_PA_SIMD
+
+namespace internal
+{
+
+// Registration of the tensor PA action kernels of DiffusionIntegrator, see
+// DiffusionIntegrator::AddSpecialization().
+template<int DIM, int D1D, int Q1D, int NBZ> struct DiffusionApplyKernels;
+
+template<int D1D, int Q1D, int T_NBZ>
+struct DiffusionApplyKernels<2,D1D,Q1D,T_NBZ>
+{
+   static constexpr int NBZ = PAKernelNBZ(Q1D, T_NBZ);
+   static constexpr int NBZ_2 = NBZ > 1 ? NBZ/2 : 1;
+   static constexpr int NBZx2 = PAKernelNBZx2(Q1D, NBZ);
+
+   template<int NB>
+   static void Smem(const int NE, const bool symm,
+                    const Array<double> &B, const Array<double> &G,
+                    const Array<double> &Bt, const Array<double> &Gt,
+                    const Vector &D, const Vector &X, Vector &Y)
+   {
+      MFEM_CONTRACT_VAR(Bt);
+      MFEM_CONTRACT_VAR(Gt);
+      SmemPADiffusionApply2D<D1D,Q1D,NB>(NE,symm,B,G,D,X,Y);
+   }
+
+   static void Basic(const int NE, const bool symm,
+                     const Array<double> &B, const Array<double> &G,
+                     const Array<double> &Bt, const Array<double> &Gt,
+                     const Vector &D, const Vector &X, Vector &Y)
+   {
+      PADiffusionApply2D<D1D,Q1D>(NE,symm,B,G,Bt,Gt,D,X,Y);
+   }
+
+#ifdef MFEM_PA_SIMD
+   static void Simd(const int NE, const bool symm,
+                    const Array<double> &B, const Array<double> &G,
+                    const Array<double> &Bt, const Array<double> &Gt,
+                    const Vector &D, const Vector &X, Vector &Y)
+   {
+      if (symm) { PADiffusionApply2DSimd<D1D,Q1D,true>(NE,B,G,Bt,Gt,D,X,Y); }
+      else { PADiffusionApply2DSimd<D1D,Q1D,false>(NE,B,G,Bt,Gt,D,X,Y); }
+   }
+#endif
+
+   static void Add(DiffusionIntegrator::ApplyKernelRegistry &kernels)
+   {
+#ifdef MFEM_PA_SIMD
+      kernels.Add(2, D1D, Q1D, "simd", Simd,
+                  Backend::CPU | Backend::OMP | Backend::THREADS);
+#endif
+      const std::string smem = "smem-nbz";
+      kernels.Add(2, D1D, Q1D, smem + std::to_string(NBZ), Smem<NBZ>);
+      kernels.Add(2, D1D, Q1D, smem + std::to_string(NBZ_2), Smem<NBZ_2>);
+      kernels.Add(2, D1D, Q1D, smem + std::to_string(NBZx2), Smem<NBZx2>);
+      kernels.Add(2, D1D, Q1D, "basic", Basic);
+   }
+};
+
+template<int D1D, int Q1D, int NBZ>
+struct DiffusionApplyKernels<3,D1D,Q1D,NBZ>
+{
+   static void Smem(const int NE, const bool symm,
+                    const Array<double> &B, const Array<double> &G,
+                    const Array<double> &Bt, const Array<double> &Gt,
+                    const Vector &D, const Vector &X, Vector &Y)
+   {
+      MFEM_CONTRACT_VAR(Bt);
+      MFEM_CONTRACT_VAR(Gt);
+      SmemPADiffusionApply3D<D1D,Q1D>(NE,symm,B,G,D,X,Y);
+   }
+
+   static void Basic(const int NE, const bool symm,
+                     const Array<double> &B, const Array<double> &G,
+                     const Array<double> &Bt, const Array<double> &Gt,
+                     const Vector &D, const Vector &X, Vector &Y)
+   {
+      PADiffusionApply3D<D1D,Q1D>(NE,symm,B,G,Bt,Gt,D,X,Y);
+   }
+
+#ifdef MFEM_PA_SIMD
+   static void Simd(const int NE, const bool symm,
+                    const Array<double> &B, const Array<double> &G,
+                    const Array<double> &Bt, const Array<double> &Gt,
+                    const Vector &D, const Vector &X, Vector &Y)
+   {
+      if (symm) { PADiffusionApply3DSimd<D1D,Q1D,true>(NE,B,G,Bt,Gt,D,X,Y); }
+      else { PADiffusionApply3DSimd<D1D,Q1D,false>(NE,B,G,Bt,Gt,D,X,Y); }
+   }
+#endif
+
+   static void Add(DiffusionIntegrator::ApplyKernelRegistry &kernels)
+   {
+#ifdef MFEM_PA_SIMD
+      kernels.Add(3, D1D, Q1D, "simd", Simd,
+                  Backend::CPU | Backend::OMP | Backend::THREADS);
+#endif
+      kernels.Add(3, D1D, Q1D, "smem", Smem);
+      kernels.Add(3, D1D, Q1D, "basic", Basic);
+   }
+};
+
+} // namespace mfem::internal
+
+template<int DIM, int D1D, int Q1D, int NBZ>
+void DiffusionIntegrator::AddSpecialization()
+{
+   static_assert(DIM == 2 || DIM == 3, "invalid dimension");
+   internal::DiffusionApplyKernels<DIM,D1D,Q1D,NBZ>::Add(ApplyPAKernels());
+}
+
+} // namespace mfem
+
+#endif // MFEM_BILININTEG_DIFFUSION_KERNELS_HPP
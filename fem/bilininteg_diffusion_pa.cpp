@@ -12,6 +12,7 @@
 #include "../general/forall.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
+#include "bilininteg_diffusion_kernels.hpp"
 #include "libceed/diffusion.hpp"
 
 using namespace std;
@@ -310,6 +311,30 @@ void PADiffusionSetup3D(const int Q1D,
    });
 }
 
+// PA Diffusion Assemble 1D kernel: in 1D, all the coefficient types reduce to
+// a scalar per quadrature point.
+static void PADiffusionSetup1D(const int Q1D,
+                               const int NE,
+                               const Array<double> &w,
+                               const Vector &j,
+                               const Vector &c,
+                               Vector &d)
+{
+   const bool const_c = c.Size() == 1;
+   const auto W = Reshape(w.Read(), Q1D);
+   const auto J = Reshape(j.Read(), Q1D, NE);
+   const auto C = const_c ? Reshape(c.Read(), 1,1) : Reshape(c.Read(), Q1D,NE);
+   auto D = Reshape(d.Write(), Q1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < Q1D; ++q)
+      {
+         const double coeff = const_c ? C(0,0) : C(q,e);
+         D(q,e) = W(q) * coeff / J(q,e);
+      }
+   });
+}
+
 static void PADiffusionSetup(const int dim,
                              const int sdim,
                              const int D1D,
@@ -321,7 +346,12 @@ static void PADiffusionSetup(const int dim,
                              const Vector &C,
                              Vector &D)
 {
-   if (dim == 1) { MFEM_ABORT("dim==1 not supported in PADiffusionSetup"); }
+   if (dim == 1)
+   {
+      MFEM_VERIFY(sdim == 1, "PA diffusion on 1D meshes embedded in higher "
+                  "dimensions is not supported");
+      PADiffusionSetup1D(Q1D, NE, W, J, C, D);
+   }
    if (dim == 2)
    {
 #ifdef MFEM_USE_OCCA
@@ -353,6 +383,7 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
    // Assuming the same element type
    fespace = &fes;
+   group_maps.SetSize(0);
    Mesh *mesh = fes.GetMesh();
    if (mesh->GetNE() == 0) { return; }
    const FiniteElement &el = *fes.GetFE(0);
@@ -364,6 +395,7 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
       InitCeedCoeff(Q, *mesh, *ir, ceedDataPtr);
       return CeedPADiffusionAssemble(fes, *ir, *ceedDataPtr);
    }
+   if (!UsesTensorBasis(fes)) { return AssemblePANonTensor(fes); }
    const int dims = el.GetDim();
    const int symmDims = (dims * (dims + 1)) / 2; // 1x1: 1, 2x2: 3, 3x3: 6
    const int nq = ir->GetNPoints();
@@ -492,6 +524,244 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
                     geom->J, coeff, pa_data);
 }
 
+// PA Diffusion Integrator for non-tensor elements (e.g. triangles, tetrahedra)
+// and meshes with mixed element types: the elements are processed in groups of
+// elements with the same geometry, using the full (non-tensor) DofToQuad maps.
+
+void DiffusionIntegrator::AssemblePANonTensor(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   maps = NULL;
+   geom = NULL;
+   const int sdim = mesh->SpaceDimension();
+   symmetric = (MQ == NULL);
+   const int pdim = symmetric ? (dim * (dim + 1)) / 2 : dim * dim;
+
+   Array<int> group_elements;
+   GetElementGeometryGroups(fes, group_offsets, group_elements);
+   const int ngroups = group_offsets.Size() - 1;
+   group_maps.SetSize(ngroups);
+   Array<const IntegrationRule*> irs(ngroups);
+   int size = 0;
+   for (int g = 0; g < ngroups; g++)
+   {
+      const FiniteElement &el = *fes.GetFE(group_elements[group_offsets[g]]);
+      irs[g] = IntRule ? IntRule : &GetRule(el, el);
+      group_maps[g] = &el.GetDofToQuad(*irs[g], DofToQuad::FULL);
+      size += pdim*irs[g]->GetNPoints()*(group_offsets[g+1] - group_offsets[g]);
+   }
+
+   // The data at the quadrature points, w J^{-1} C J^{-T}, is computed on the
+   // host, including the coefficient C; its layout is PD x NQ x NE for every
+   // group, where PD is the number of stored entries of the dim x dim matrix.
+   pa_data.SetSize(size, Device::GetDeviceMemoryType());
+   double *D = pa_data.HostWrite();
+   DenseMatrix C(sdim), JinvC(dim, sdim), A(dim);
+   DenseSymmetricMatrix SC(sdim);
+   Vector VC(sdim);
+   for (int g = 0; g < ngroups; g++)
+   {
+      const IntegrationRule &ir = *irs[g];
+      for (int k = group_offsets[g]; k < group_offsets[g+1]; k++)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(
+                                       group_elements[k]);
+         for (int q = 0; q < ir.GetNPoints(); q++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            const DenseMatrix &Jinv = T.InverseJacobian();
+            const double w = ip.weight * T.Weight();
+            if (MQ || SMQ || VQ)
+            {
+               if (MQ) { MQ->Eval(C, T, ip); }
+               else if (SMQ)
+               {
+                  SMQ->Eval(SC, T, ip);
+                  for (int i = 0; i < sdim; i++)
+                  {
+                     for (int j = 0; j < sdim; j++) { C(i,j) = SC(i,j); }
+                  }
+               }
+               else
+               {
+                  VQ->Eval(VC, T, ip);
+                  C.Diag(VC.GetData(), sdim);
+               }
+               Mult(Jinv, C, JinvC);
+               MultABt(JinvC, Jinv, A);
+               A *= w;
+            }
+            else
+            {
+               MultAAt(Jinv, A);
+               A *= w * (Q ? Q->Eval(T, ip) : 1.0);
+            }
+            for (int i = 0; i < dim; i++)
+            {
+               for (int j = symmetric ? i : 0; j < dim; j++)
+               {
+                  *(D++) = A(i,j);
+               }
+            }
+         }
+      }
+   }
+}
+
+// Compute v = A g, where A is a DIM x DIM matrix stored at d: the upper
+// triangle by rows if symm is true, and the full matrix by rows otherwise.
+MFEM_HOST_DEVICE static inline
+void PADiffusionQuadApply(const int DIM, const bool symm, const double *d,
+                          const double *g, double *v)
+{
+   for (int i = 0; i < DIM; i++)
+   {
+      double s = 0.0;
+      for (int j = 0; j < DIM; j++)
+      {
+         const int r = (i <= j) ? i : j, c = (i <= j) ? j : i;
+         const int ij = symm ? r*DIM - (r*(r-1))/2 + c - r : i*DIM + j;
+         s += d[ij] * g[j];
+      }
+      v[i] = s;
+   }
+}
+
+static void PADiffusionAssembleDiagonalNonTensor(const int NE,
+                                                 const bool symm,
+                                                 const int DIM,
+                                                 const DofToQuad &maps,
+                                                 const Vector &D,
+                                                 Vector &Y)
+{
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   const int PD = symm ? (DIM * (DIM + 1)) / 2 : DIM * DIM;
+   const auto G = Reshape(maps.G.Read(), NQ, DIM, ND);
+   const auto d = Reshape(D.Read(), PD, NQ, NE);
+   auto y = Reshape(Y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; i++)
+      {
+         double val = 0.0;
+         for (int q = 0; q < NQ; q++)
+         {
+            double g[3], v[3];
+            for (int k = 0; k < DIM; k++) { g[k] = G(q,k,i); }
+            PADiffusionQuadApply(DIM, symm, &d(0,q,e), g, v);
+            for (int k = 0; k < DIM; k++) { val += g[k] * v[k]; }
+         }
+         y(i,e) += val;
+      }
+   });
+}
+
+// Number of elements processed together by the host non-tensor kernels.
+static const int PA_NONTENSOR_BATCH = 32;
+
+static void PADiffusionApplyNonTensor(const int NE,
+                                      const bool symm,
+                                      const int DIM,
+                                      const DofToQuad &maps,
+                                      const Vector &D,
+                                      const Vector &X,
+                                      Vector &Y)
+{
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   const int PD = symm ? (DIM * (DIM + 1)) / 2 : DIM * DIM;
+   if (Device::Allows(Backend::DEVICE_MASK))
+   {
+      const auto G = Reshape(maps.G.Read(), NQ, DIM, ND);
+      const auto d = Reshape(D.Read(), PD, NQ, NE);
+      const auto x = Reshape(X.Read(), ND, NE);
+      auto y = Reshape(Y.ReadWrite(), ND, NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; q++)
+         {
+            double g[3] = {0.0, 0.0, 0.0}, v[3];
+            for (int i = 0; i < ND; i++)
+            {
+               for (int k = 0; k < DIM; k++) { g[k] += G(q,k,i) * x(i,e); }
+            }
+            PADiffusionQuadApply(DIM, symm, &d(0,q,e), g, v);
+            for (int i = 0; i < ND; i++)
+            {
+               double s = 0.0;
+               for (int k = 0; k < DIM; k++) { s += G(q,k,i) * v[k]; }
+               y(i,e) += s;
+            }
+         }
+      });
+      return;
+   }
+
+   // On the host, a batch of elements is a contiguous ND x nb block of the
+   // E-vector, so the reference gradients at the quadrature points and their
+   // transpose are two small dense matrix-matrix products per batch.
+   DenseMatrix G(const_cast<double*>(maps.G.HostRead()), NQ*DIM, ND);
+   DenseMatrix Gt(const_cast<double*>(maps.Gt.HostRead()), ND, NQ*DIM);
+   const double *d = D.HostRead();
+   const double *x = X.HostRead();
+   double *y = Y.HostReadWrite();
+   DenseMatrix Gq;
+   for (int e0 = 0; e0 < NE; e0 += PA_NONTENSOR_BATCH)
+   {
+      const int nb = std::min(PA_NONTENSOR_BATCH, NE - e0);
+      DenseMatrix Xe(const_cast<double*>(x + e0*ND), ND, nb);
+      DenseMatrix Ye(y + e0*ND, ND, nb);
+      Gq.SetSize(NQ*DIM, nb);
+      Mult(G, Xe, Gq);
+      for (int b = 0; b < nb; b++)
+      {
+         for (int q = 0; q < NQ; q++)
+         {
+            double g[3], v[3];
+            for (int k = 0; k < DIM; k++) { g[k] = Gq(q + NQ*k, b); }
+            PADiffusionQuadApply(DIM, symm, d + PD*(q + NQ*(e0 + b)), g, v);
+            for (int k = 0; k < DIM; k++) { Gq(q + NQ*k, b) = v[k]; }
+         }
+      }
+      AddMult(Gt, Gq, Ye);
+   }
+}
+
+// In 1D, the PA kernels need no temporary storage per element, so they are
+// not limited by MAX_D1D and MAX_Q1D and can be used with very high orders.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PADiffusionDiagonal1D(const int NE,
+                                  const Array<double> &g,
+                                  const Vector &d,
+                                  Vector &y,
+                                  const int d1d = 0,
+                                  const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         double t = 0.0;
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            t += G(qx, dx) * G(qx, dx) * D(qx, e);
+         }
+         Y(dx, e) += t;
+      }
+   });
+}
+
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PADiffusionDiagonal2D(const int NE,
                                   const bool symmetric,
@@ -881,7 +1151,22 @@ static void PADiffusionAssembleDiagonal(const int dim,
                                         const Vector &D,
                                         Vector &Y)
 {
-   if (dim == 2)
+   if (dim == 1)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PADiffusionDiagonal1D<2,2>(NE,G,D,Y);
+         case 0x33: return PADiffusionDiagonal1D<3,3>(NE,G,D,Y);
+         case 0x44: return PADiffusionDiagonal1D<4,4>(NE,G,D,Y);
+         case 0x55: return PADiffusionDiagonal1D<5,5>(NE,G,D,Y);
+         case 0x66: return PADiffusionDiagonal1D<6,6>(NE,G,D,Y);
+         case 0x77: return PADiffusionDiagonal1D<7,7>(NE,G,D,Y);
+         case 0x88: return PADiffusionDiagonal1D<8,8>(NE,G,D,Y);
+         case 0x99: return PADiffusionDiagonal1D<9,9>(NE,G,D,Y);
+         default: return PADiffusionDiagonal1D(NE,G,D,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 2)
    {
       switch ((D1D << 4 ) | Q1D)
       {
@@ -923,6 +1208,24 @@ void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
    else
    {
       if (pa_data.Size()==0) { AssemblePA(*fespace); }
+      if (group_maps.Size() > 0)
+      {
+         const int pdim = symmetric ? (dim * (dim + 1)) / 2 : dim * dim;
+         int d_offset = 0, e_offset = 0;
+         for (int g = 0; g < group_maps.Size(); g++)
+         {
+            const DofToQuad &g_maps = *group_maps[g];
+            const int g_ne = group_offsets[g+1] - group_offsets[g];
+            Vector g_data, g_diag;
+            g_data.MakeRef(pa_data, d_offset, pdim*g_maps.nqpt*g_ne);
+            g_diag.MakeRef(diag, e_offset, g_maps.ndof*g_ne);
+            PADiffusionAssembleDiagonalNonTensor(g_ne, symmetric, dim, g_maps,
+                                                 g_data, g_diag);
+            d_offset += pdim*g_maps.nqpt*g_ne;
+            e_offset += g_maps.ndof*g_ne;
+         }
+         return;
+      }
       PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne, symmetric,
                                   maps->B, maps->G, pa_data, diag);
    }
@@ -1029,14 +1332,42 @@ static void OccaPADiffusionApply3D(const int D1D,
 }
 #endif // MFEM_USE_OCCA
 
-// PA Diffusion Apply 2D kernel
+// Default specializations of the tensor PA action kernels
+static DiffusionIntegrator::ApplyKernelRegistry MakeDiffusionApplyKernels()
+{
+   using internal::DiffusionApplyKernels;
+   DiffusionIntegrator::ApplyKernelRegistry kernels("DiffusionApply");
+   DiffusionApplyKernels<2,2,2,16>::Add(kernels);
+   DiffusionApplyKernels<2,3,3,16>::Add(kernels);
+   DiffusionApplyKernels<2,4,4,8>::Add(kernels);
+   DiffusionApplyKernels<2,5,5,8>::Add(kernels);
+   DiffusionApplyKernels<2,6,6,4>::Add(kernels);
+   DiffusionApplyKernels<2,7,7,4>::Add(kernels);
+   DiffusionApplyKernels<2,8,8,2>::Add(kernels);
+   DiffusionApplyKernels<2,9,9,2>::Add(kernels);
+   DiffusionApplyKernels<3,2,3,0>::Add(kernels);
+   DiffusionApplyKernels<3,3,4,0>::Add(kernels);
+   DiffusionApplyKernels<3,4,5,0>::Add(kernels);
+   DiffusionApplyKernels<3,4,6,0>::Add(kernels);
+   DiffusionApplyKernels<3,5,6,0>::Add(kernels);
+   DiffusionApplyKernels<3,5,8,0>::Add(kernels);
+   DiffusionApplyKernels<3,6,7,0>::Add(kernels);
+   DiffusionApplyKernels<3,7,8,0>::Add(kernels);
+   DiffusionApplyKernels<3,8,9,0>::Add(kernels);
+   return kernels;
+}
+
+DiffusionIntegrator::ApplyKernelRegistry &DiffusionIntegrator::ApplyPAKernels()
+{
+   static ApplyKernelRegistry kernels = MakeDiffusionApplyKernels();
+   return kernels;
+}
+
+// PA Diffusion Apply 1D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
-static void PADiffusionApply2D(const int NE,
-                               const bool symmetric,
-                               const Array<double> &b_,
-                               const Array<double> &g_,
-                               const Array<double> &bt_,
-                               const Array<double> &gt_,
+static void PADiffusionApply1D(const int NE,
+                               const Array<double> &g,
+                               const Array<double> &gt,
                                const Vector &d_,
                                const Vector &x_,
                                Vector &y_,
@@ -1045,845 +1376,254 @@ static void PADiffusionApply2D(const int NE,
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b_.Read(), Q1D, D1D);
-   auto G = Reshape(g_.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
-   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, NE);
    MFEM_FORALL(e, NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-
-      double grad[max_Q1D][max_Q1D][2];
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            grad[qy][qx][0] = 0.0;
-            grad[qy][qx][1] = 0.0;
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
+      for (int qx = 0; qx < Q1D; ++qx)
       {
-         double gradX[max_Q1D][2];
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            gradX[qx][0] = 0.0;
-            gradX[qx][1] = 0.0;
-         }
+         double du = 0.0;
          for (int dx = 0; dx < D1D; ++dx)
          {
-            const double s = X(dx,dy,e);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradX[qx][0] += s * B(qx,dx);
-               gradX[qx][1] += s * G(qx,dx);
-            }
+            du += G(qx, dx) * X(dx, e);
          }
-         for (int qy = 0; qy < Q1D; ++qy)
+         du *= D(qx, e);
+         for (int dx = 0; dx < D1D; ++dx)
          {
-            const double wy  = B(qy,dy);
-            const double wDy = G(qy,dy);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               grad[qy][qx][0] += gradX[qx][1] * wy;
-               grad[qy][qx][1] += gradX[qx][0] * wDy;
-            }
+            Y(dx, e) += Gt(dx, qx) * du;
          }
       }
-      // Calculate Dxy, xDy in plane
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const int q = qx + qy * Q1D;
-
-            const double O11 = D(q,0,e);
-            const double O21 = D(q,1,e);
-            const double O12 = symmetric ? O21 : D(q,2,e);
-            const double O22 = symmetric ? D(q,2,e) : D(q,3,e);
-
-            const double gradX = grad[qy][qx][0];
-            const double gradY = grad[qy][qx][1];
+   });
+}
 
-            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
-            grad[qy][qx][1] = (O21 * gradX) + (O22 * gradY);
-         }
+static void PADiffusionApply(const int dim,
+                             const int D1D,
+                             const int Q1D,
+                             const int NE,
+                             const bool symm,
+                             const Array<double> &B,
+                             const Array<double> &G,
+                             const Array<double> &Bt,
+                             const Array<double> &Gt,
+                             const Vector &D,
+                             const Vector &X,
+                             Vector &Y)
+{
+   MFEM_PROFILE_REGION("PADiffusionApply");
+   // Read the E-vectors X and Y, write Y and read the symmetric or full
+   // quadrature matrices D.
+   MFEM_PROFILE_COUNTERS(
+      8.0*NE*(3*std::pow(D1D, dim) +
+              (symm ? dim*(dim+1)/2 : dim*dim)*std::pow(Q1D, dim)),
+      NE*(2*dim*SumFactorizationFlops(dim, D1D, Q1D) +
+          2*dim*dim*std::pow(Q1D, dim)));
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca())
+   {
+      if (dim == 2)
+      {
+         OccaPADiffusionApply2D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
+         return;
       }
-      for (int qy = 0; qy < Q1D; ++qy)
+      if (dim == 3)
       {
-         double gradX[max_D1D][2];
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            gradX[dx][0] = 0;
-            gradX[dx][1] = 0;
-         }
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const double gX = grad[qy][qx][0];
-            const double gY = grad[qy][qx][1];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double wx  = Bt(dx,qx);
-               const double wDx = Gt(dx,qx);
-               gradX[dx][0] += gX * wDx;
-               gradX[dx][1] += gY * wx;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            const double wy  = Bt(dy,qy);
-            const double wDy = Gt(dy,qy);
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
-            }
-         }
+         OccaPADiffusionApply3D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
+         return;
       }
-   });
+      MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
+   }
+#endif // MFEM_USE_OCCA
+   if (dim == 1)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PADiffusionApply1D<2,2>(NE,G,Gt,D,X,Y);
+         case 0x33: return PADiffusionApply1D<3,3>(NE,G,Gt,D,X,Y);
+         case 0x44: return PADiffusionApply1D<4,4>(NE,G,Gt,D,X,Y);
+         case 0x55: return PADiffusionApply1D<5,5>(NE,G,Gt,D,X,Y);
+         case 0x66: return PADiffusionApply1D<6,6>(NE,G,Gt,D,X,Y);
+         case 0x77: return PADiffusionApply1D<7,7>(NE,G,Gt,D,X,Y);
+         case 0x88: return PADiffusionApply1D<8,8>(NE,G,Gt,D,X,Y);
+         case 0x99: return PADiffusionApply1D<9,9>(NE,G,Gt,D,X,Y);
+         default:   return PADiffusionApply1D(NE,G,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   if (DiffusionIntegrator::ApplyPAKernels().Run(dim,D1D,Q1D,
+                                                 NE,symm,B,G,Bt,Gt,D,X,Y))
+   {
+      return;
+   }
+   if (dim == 2) { return PADiffusionApply2D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D); }
+   if (dim == 3) { return PADiffusionApply3D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D); }
+   MFEM_ABORT("Unknown kernel.");
 }
 
-// Shared memory PA Diffusion Apply 2D kernel
-template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
-static void SmemPADiffusionApply2D(const int NE,
-                                   const bool symmetric,
-                                   const Array<double> &b_,
-                                   const Array<double> &g_,
-                                   const Vector &d_,
-                                   const Vector &x_,
-                                   Vector &y_,
-                                   const int d1d = 0,
-                                   const int q1d = 0)
+// Fused PA Diffusion Apply 2D kernel: the element dofs are gathered from and
+// scattered to the L-vectors, one element color after the other.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PADiffusionApplyFused2D(const ElementRestriction &R,
+                                    const int NE,
+                                    const bool symmetric,
+                                    const Array<double> &b_,
+                                    const Array<double> &g_,
+                                    const Array<double> &bt_,
+                                    const Array<double> &gt_,
+                                    const Vector &d_,
+                                    const Vector &x_,
+                                    Vector &y_,
+                                    const int d1d = 0,
+                                    const int q1d = 0)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   constexpr int NBZ = T_NBZ ? T_NBZ : 1;
-   constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-   constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-   MFEM_VERIFY(D1D <= MD1, "");
-   MFEM_VERIFY(Q1D <= MQ1, "");
-   auto b = Reshape(b_.Read(), Q1D, D1D);
-   auto g = Reshape(g_.Read(), Q1D, D1D);
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const Array<int> *color_offsets, *color_elems;
+   R.GetElementColors(color_offsets, color_elems);
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   auto M = Reshape(R.GatherMap().Read(), D1D*D1D, NE);
+   auto E = color_elems->Read();
+   auto X = x_.Read();
+   auto Y = y_.ReadWrite();
+   for (int c = 0; c < color_offsets->Size() - 1; c++)
    {
-      const int tidz = MFEM_THREAD_ID(z);
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int NBZ = T_NBZ ? T_NBZ : 1;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-      MFEM_SHARED double sBG[2][MQ1*MD1];
-      double (*B)[MD1] = (double (*)[MD1]) (sBG+0);
-      double (*G)[MD1] = (double (*)[MD1]) (sBG+1);
-      double (*Bt)[MQ1] = (double (*)[MQ1]) (sBG+0);
-      double (*Gt)[MQ1] = (double (*)[MQ1]) (sBG+1);
-      MFEM_SHARED double Xz[NBZ][MD1][MD1];
-      MFEM_SHARED double GD[2][NBZ][MD1][MQ1];
-      MFEM_SHARED double GQ[2][NBZ][MD1][MQ1];
-      double (*X)[MD1] = (double (*)[MD1])(Xz + tidz);
-      double (*DQ0)[MD1] = (double (*)[MD1])(GD[0] + tidz);
-      double (*DQ1)[MD1] = (double (*)[MD1])(GD[1] + tidz);
-      double (*QQ0)[MD1] = (double (*)[MD1])(GQ[0] + tidz);
-      double (*QQ1)[MD1] = (double (*)[MD1])(GQ[1] + tidz);
-      MFEM_FOREACH_THREAD(dy,y,D1D)
+      const int offset = (*color_offsets)[c];
+      const int NC = (*color_offsets)[c+1] - offset;
+      MFEM_FORALL(i, NC,
       {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
+         const int e = E[offset + i];
+         const int D1D = T_D1D ? T_D1D : d1d;
+         constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+         double xe[max_D1D*max_D1D], ye[max_D1D*max_D1D];
+         for (int j = 0; j < D1D*D1D; ++j)
          {
-            X[dy][dx] = x(dx,dy,e);
+            const int gid = M(j,e);
+            xe[j] = (gid >= 0) ? X[gid] : -X[-1-gid];
+            ye[j] = 0.0;
          }
-      }
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
+         PADiffusionApply2DElement<T_D1D,T_Q1D>(e, symmetric, B, G, Bt, Gt, D,
+                                                xe, ye, d1d, q1d);
+         for (int j = 0; j < D1D*D1D; ++j)
          {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
-            {
-               B[q][dy] = b(q,dy);
-               G[q][dy] = g(q,dy);
-            }
+            const int gid = M(j,e);
+            if (gid >= 0) { Y[gid] += ye[j]; }
+            else { Y[-1-gid] -= ye[j]; }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
+      });
+   }
+}
+
+// Fused PA Diffusion Apply 3D kernel, see PADiffusionApplyFused2D().
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PADiffusionApplyFused3D(const ElementRestriction &R,
+                                    const int NE,
+                                    const bool symmetric,
+                                    const Array<double> &b_,
+                                    const Array<double> &g_,
+                                    const Array<double> &bt_,
+                                    const Array<double> &gt_,
+                                    const Vector &d_,
+                                    const Vector &x_,
+                                    Vector &y_,
+                                    const int d1d = 0,
+                                    const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const Array<int> *color_offsets, *color_elems;
+   R.GetElementColors(color_offsets, color_elems);
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
+   auto M = Reshape(R.GatherMap().Read(), D1D*D1D*D1D, NE);
+   auto E = color_elems->Read();
+   auto X = x_.Read();
+   auto Y = y_.ReadWrite();
+   for (int c = 0; c < color_offsets->Size() - 1; c++)
+   {
+      const int offset = (*color_offsets)[c];
+      const int NC = (*color_offsets)[c+1] - offset;
+      MFEM_FORALL(i, NC,
       {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         const int e = E[offset + i];
+         const int D1D = T_D1D ? T_D1D : d1d;
+         constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+         double xe[max_D1D*max_D1D*max_D1D], ye[max_D1D*max_D1D*max_D1D];
+         for (int j = 0; j < D1D*D1D*D1D; ++j)
          {
-            double u = 0.0;
-            double v = 0.0;
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double coords = X[dy][dx];
-               u += B[qx][dx] * coords;
-               v += G[qx][dx] * coords;
-            }
-            DQ0[dy][qx] = u;
-            DQ1[dy][qx] = v;
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            double u = 0.0;
-            double v = 0.0;
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               u += DQ1[dy][qx] * B[qy][dy];
-               v += DQ0[dy][qx] * G[qy][dy];
-            }
-            QQ0[qy][qx] = u;
-            QQ1[qy][qx] = v;
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            const int q = (qx + ((qy) * Q1D));
-            const double O11 = D(q,0,e);
-            const double O21 = D(q,1,e);
-            const double O12 = symmetric ? O21 : D(q,2,e);
-            const double O22 = symmetric ? D(q,2,e) : D(q,3,e);
-            const double gX = QQ0[qy][qx];
-            const double gY = QQ1[qy][qx];
-            QQ0[qy][qx] = (O11 * gX) + (O12 * gY);
-            QQ1[qy][qx] = (O21 * gX) + (O22 * gY);
-         }
-      }
-      MFEM_SYNC_THREAD;
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
-         {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
-            {
-               Bt[dy][q] = b(q,dy);
-               Gt[dy][q] = g(q,dy);
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double u = 0.0;
-            double v = 0.0;
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               u += Gt[dx][qx] * QQ0[qy][qx];
-               v += Bt[dx][qx] * QQ1[qy][qx];
-            }
-            DQ0[qy][dx] = u;
-            DQ1[qy][dx] = v;
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double u = 0.0;
-            double v = 0.0;
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               u += DQ0[qy][dx] * Bt[dy][qy];
-               v += DQ1[qy][dx] * Gt[dy][qy];
-            }
-            Y(dx,dy,e) += (u + v);
-         }
-      }
-   });
-}
-
-// PA Diffusion Apply 3D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
-static void PADiffusionApply3D(const int NE,
-                               const bool symmetric,
-                               const Array<double> &b,
-                               const Array<double> &g,
-                               const Array<double> &bt,
-                               const Array<double> &gt,
-                               const Vector &d_,
-                               const Vector &x_,
-                               Vector &y_,
-                               int d1d = 0, int q1d = 0)
-{
-   const int D1D = T_D1D ? T_D1D : d1d;
-   const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto G = Reshape(g.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt.Read(), D1D, Q1D);
-   auto Gt = Reshape(gt.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
-   {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double grad[max_Q1D][max_Q1D][max_Q1D][3];
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               grad[qz][qy][qx][0] = 0.0;
-               grad[qz][qy][qx][1] = 0.0;
-               grad[qz][qy][qx][2] = 0.0;
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         double gradXY[max_Q1D][max_Q1D][3];
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradXY[qy][qx][0] = 0.0;
-               gradXY[qy][qx][1] = 0.0;
-               gradXY[qy][qx][2] = 0.0;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            double gradX[max_Q1D][2];
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradX[qx][0] = 0.0;
-               gradX[qx][1] = 0.0;
-            }
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double s = X(dx,dy,dz,e);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  gradX[qx][0] += s * B(qx,dx);
-                  gradX[qx][1] += s * G(qx,dx);
-               }
-            }
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const double wy  = B(qy,dy);
-               const double wDy = G(qy,dy);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  const double wx  = gradX[qx][0];
-                  const double wDx = gradX[qx][1];
-                  gradXY[qy][qx][0] += wDx * wy;
-                  gradXY[qy][qx][1] += wx  * wDy;
-                  gradXY[qy][qx][2] += wx  * wy;
-               }
-            }
+            const int gid = M(j,e);
+            xe[j] = (gid >= 0) ? X[gid] : -X[-1-gid];
+            ye[j] = 0.0;
          }
-         for (int qz = 0; qz < Q1D; ++qz)
+         PADiffusionApply3DElement<T_D1D,T_Q1D>(e, symmetric, B, G, Bt, Gt, D,
+                                                xe, ye, d1d, q1d);
+         for (int j = 0; j < D1D*D1D*D1D; ++j)
          {
-            const double wz  = B(qz,dz);
-            const double wDz = G(qz,dz);
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
-                  grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
-                  grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
-               }
-            }
-         }
-      }
-      // Calculate Dxyz, xDyz, xyDz in plane
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const int q = qx + (qy + qz * Q1D) * Q1D;
-               const double O11 = D(q,0,e);
-               const double O12 = D(q,1,e);
-               const double O13 = D(q,2,e);
-               const double O21 = symmetric ? O12 : D(q,3,e);
-               const double O22 = symmetric ? D(q,3,e) : D(q,4,e);
-               const double O23 = symmetric ? D(q,4,e) : D(q,5,e);
-               const double O31 = symmetric ? O13 : D(q,6,e);
-               const double O32 = symmetric ? O23 : D(q,7,e);
-               const double O33 = symmetric ? D(q,5,e) : D(q,8,e);
-               const double gradX = grad[qz][qy][qx][0];
-               const double gradY = grad[qz][qy][qx][1];
-               const double gradZ = grad[qz][qy][qx][2];
-               grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
-               grad[qz][qy][qx][1] = (O21*gradX)+(O22*gradY)+(O23*gradZ);
-               grad[qz][qy][qx][2] = (O31*gradX)+(O32*gradY)+(O33*gradZ);
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         double gradXY[max_D1D][max_D1D][3];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradXY[dy][dx][0] = 0;
-               gradXY[dy][dx][1] = 0;
-               gradXY[dy][dx][2] = 0;
-            }
+            const int gid = M(j,e);
+            if (gid >= 0) { Y[gid] += ye[j]; }
+            else { Y[-1-gid] -= ye[j]; }
          }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            double gradX[max_D1D][3];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradX[dx][0] = 0;
-               gradX[dx][1] = 0;
-               gradX[dx][2] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double gX = grad[qz][qy][qx][0];
-               const double gY = grad[qz][qy][qx][1];
-               const double gZ = grad[qz][qy][qx][2];
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  const double wx  = Bt(dx,qx);
-                  const double wDx = Gt(dx,qx);
-                  gradX[dx][0] += gX * wDx;
-                  gradX[dx][1] += gY * wx;
-                  gradX[dx][2] += gZ * wx;
-               }
-            }
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const double wy  = Bt(dy,qy);
-               const double wDy = Gt(dy,qy);
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
-                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
-                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
-               }
-            }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            const double wz  = Bt(dz,qz);
-            const double wDz = Gt(dz,qz);
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  Y(dx,dy,dz,e) +=
-                     ((gradXY[dy][dx][0] * wz) +
-                      (gradXY[dy][dx][1] * wz) +
-                      (gradXY[dy][dx][2] * wDz));
-               }
-            }
-         }
-      }
-   });
-}
-
-// Half of B and G are stored in shared to get B, Bt, G and Gt.
-// Indices computation for SmemPADiffusionApply3D.
-static MFEM_HOST_DEVICE inline int qi(const int q, const int d, const int Q)
-{
-   return (q<=d) ? q : Q-1-q;
-}
-
-static MFEM_HOST_DEVICE inline int dj(const int q, const int d, const int D)
-{
-   return (q<=d) ? d : D-1-d;
-}
-
-static MFEM_HOST_DEVICE inline int qk(const int q, const int d, const int Q)
-{
-   return (q<=d) ? Q-1-q : q;
-}
-
-static MFEM_HOST_DEVICE inline int dl(const int q, const int d, const int D)
-{
-   return (q<=d) ? D-1-d : d;
-}
-
-static MFEM_HOST_DEVICE inline double sign(const int q, const int d)
-{
-   return (q<=d) ? -1.0 : 1.0;
-}
-
-template<int T_D1D = 0, int T_Q1D = 0>
-static void SmemPADiffusionApply3D(const int NE,
-                                   const bool symmetric,
-                                   const Array<double> &b_,
-                                   const Array<double> &g_,
-                                   const Vector &d_,
-                                   const Vector &x_,
-                                   Vector &y_,
-                                   const int d1d = 0,
-                                   const int q1d = 0)
-{
-   const int D1D = T_D1D ? T_D1D : d1d;
-   const int Q1D = T_Q1D ? T_Q1D : q1d;
-   constexpr int M1Q = T_Q1D ? T_Q1D : MAX_Q1D;
-   constexpr int M1D = T_D1D ? T_D1D : MAX_D1D;
-   MFEM_VERIFY(D1D <= M1D, "");
-   MFEM_VERIFY(Q1D <= M1Q, "");
-   auto b = Reshape(b_.Read(), Q1D, D1D);
-   auto g = Reshape(g_.Read(), Q1D, D1D);
-   auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, symmetric ? 6 : 9, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, 1,
-   {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int MDQ = (MQ1 > MD1) ? MQ1 : MD1;
-      MFEM_SHARED double sBG[MQ1*MD1];
-      double (*B)[MD1] = (double (*)[MD1]) sBG;
-      double (*G)[MD1] = (double (*)[MD1]) sBG;
-      double (*Bt)[MQ1] = (double (*)[MQ1]) sBG;
-      double (*Gt)[MQ1] = (double (*)[MQ1]) sBG;
-      MFEM_SHARED double sm0[3][MDQ*MDQ*MDQ];
-      MFEM_SHARED double sm1[3][MDQ*MDQ*MDQ];
-      double (*X)[MD1][MD1]    = (double (*)[MD1][MD1]) (sm0+2);
-      double (*DDQ0)[MD1][MQ1] = (double (*)[MD1][MQ1]) (sm0+0);
-      double (*DDQ1)[MD1][MQ1] = (double (*)[MD1][MQ1]) (sm0+1);
-      double (*DQQ0)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm1+0);
-      double (*DQQ1)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm1+1);
-      double (*DQQ2)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm1+2);
-      double (*QQQ0)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm0+0);
-      double (*QQQ1)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm0+1);
-      double (*QQQ2)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) (sm0+2);
-      double (*QQD0)[MQ1][MD1] = (double (*)[MQ1][MD1]) (sm1+0);
-      double (*QQD1)[MQ1][MD1] = (double (*)[MQ1][MD1]) (sm1+1);
-      double (*QQD2)[MQ1][MD1] = (double (*)[MQ1][MD1]) (sm1+2);
-      double (*QDD0)[MD1][MD1] = (double (*)[MD1][MD1]) (sm0+0);
-      double (*QDD1)[MD1][MD1] = (double (*)[MD1][MD1]) (sm0+1);
-      double (*QDD2)[MD1][MD1] = (double (*)[MD1][MD1]) (sm0+2);
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               X[dz][dy][dx] = x(dx,dy,dz,e);
-            }
-         }
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            const int i = qi(qx,dy,Q1D);
-            const int j = dj(qx,dy,D1D);
-            const int k = qk(qx,dy,Q1D);
-            const int l = dl(qx,dy,D1D);
-            B[i][j] = b(qx,dy);
-            G[k][l] = g(qx,dy) * sign(qx,dy);
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            double u[D1D], v[D1D];
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; dz++) { u[dz] = v[dz] = 0.0; }
-            MFEM_UNROLL(MD1)
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const int i = qi(qx,dx,Q1D);
-               const int j = dj(qx,dx,D1D);
-               const int k = qk(qx,dx,Q1D);
-               const int l = dl(qx,dx,D1D);
-               const double s = sign(qx,dx);
-               MFEM_UNROLL(MD1)
-               for (int dz = 0; dz < D1D; ++dz)
-               {
-                  const double coords = X[dz][dy][dx];
-                  u[dz] += coords * B[i][j];
-                  v[dz] += coords * G[k][l] * s;
-               }
-            }
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               DDQ0[dz][dy][qx] = u[dz];
-               DDQ1[dz][dy][qx] = v[dz];
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            double u[D1D], v[D1D], w[D1D];
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; dz++) { u[dz] = v[dz] = w[dz] = 0.0; }
-            MFEM_UNROLL(MD1)
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const int i = qi(qy,dy,Q1D);
-               const int j = dj(qy,dy,D1D);
-               const int k = qk(qy,dy,Q1D);
-               const int l = dl(qy,dy,D1D);
-               const double s = sign(qy,dy);
-               MFEM_UNROLL(MD1)
-               for (int dz = 0; dz < D1D; dz++)
-               {
-                  u[dz] += DDQ1[dz][dy][qx] * B[i][j];
-                  v[dz] += DDQ0[dz][dy][qx] * G[k][l] * s;
-                  w[dz] += DDQ0[dz][dy][qx] * B[i][j];
-               }
-            }
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; dz++)
-            {
-               DQQ0[dz][qy][qx] = u[dz];
-               DQQ1[dz][qy][qx] = v[dz];
-               DQQ2[dz][qy][qx] = w[dz];
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            double u[Q1D], v[Q1D], w[Q1D];
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; qz++) { u[qz] = v[qz] = w[qz] = 0.0; }
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               MFEM_UNROLL(MQ1)
-               for (int qz = 0; qz < Q1D; qz++)
-               {
-                  const int i = qi(qz,dz,Q1D);
-                  const int j = dj(qz,dz,D1D);
-                  const int k = qk(qz,dz,Q1D);
-                  const int l = dl(qz,dz,D1D);
-                  const double s = sign(qz,dz);
-                  u[qz] += DQQ0[dz][qy][qx] * B[i][j];
-                  v[qz] += DQQ1[dz][qy][qx] * B[i][j];
-                  w[qz] += DQQ2[dz][qy][qx] * G[k][l] * s;
-               }
-            }
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; qz++)
-            {
-               const double O11 = d(qx,qy,qz,0,e);
-               const double O12 = d(qx,qy,qz,1,e);
-               const double O13 = d(qx,qy,qz,2,e);
-               const double O21 = symmetric ? O12 : d(qx,qy,qz,3,e);
-               const double O22 = symmetric ? d(qx,qy,qz,3,e) : d(qx,qy,qz,4,e);
-               const double O23 = symmetric ? d(qx,qy,qz,4,e) : d(qx,qy,qz,5,e);
-               const double O31 = symmetric ? O13 : d(qx,qy,qz,6,e);
-               const double O32 = symmetric ? O23 : d(qx,qy,qz,7,e);
-               const double O33 = symmetric ? d(qx,qy,qz,5,e) : d(qx,qy,qz,8,e);
-               const double gX = u[qz];
-               const double gY = v[qz];
-               const double gZ = w[qz];
-               QQQ0[qz][qy][qx] = (O11*gX) + (O12*gY) + (O13*gZ);
-               QQQ1[qz][qy][qx] = (O21*gX) + (O22*gY) + (O23*gZ);
-               QQQ2[qz][qy][qx] = (O31*gX) + (O32*gY) + (O33*gZ);
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(d,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(q,x,Q1D)
-         {
-            const int i = qi(q,d,Q1D);
-            const int j = dj(q,d,D1D);
-            const int k = qk(q,d,Q1D);
-            const int l = dl(q,d,D1D);
-            Bt[j][i] = b(q,d);
-            Gt[l][k] = g(q,d) * sign(q,d);
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double u[Q1D], v[Q1D], w[Q1D];
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz) { u[qz] = v[qz] = w[qz] = 0.0; }
-            MFEM_UNROLL(MQ1)
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const int i = qi(qx,dx,Q1D);
-               const int j = dj(qx,dx,D1D);
-               const int k = qk(qx,dx,Q1D);
-               const int l = dl(qx,dx,D1D);
-               const double s = sign(qx,dx);
-               MFEM_UNROLL(MQ1)
-               for (int qz = 0; qz < Q1D; ++qz)
-               {
-                  u[qz] += QQQ0[qz][qy][qx] * Gt[l][k] * s;
-                  v[qz] += QQQ1[qz][qy][qx] * Bt[j][i];
-                  w[qz] += QQQ2[qz][qy][qx] * Bt[j][i];
-               }
-            }
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               QQD0[qz][qy][dx] = u[qz];
-               QQD1[qz][qy][dx] = v[qz];
-               QQD2[qz][qy][dx] = w[qz];
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double u[Q1D], v[Q1D], w[Q1D];
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz) { u[qz] = v[qz] = w[qz] = 0.0; }
-            MFEM_UNROLL(MQ1)
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const int i = qi(qy,dy,Q1D);
-               const int j = dj(qy,dy,D1D);
-               const int k = qk(qy,dy,Q1D);
-               const int l = dl(qy,dy,D1D);
-               const double s = sign(qy,dy);
-               MFEM_UNROLL(MQ1)
-               for (int qz = 0; qz < Q1D; ++qz)
-               {
-                  u[qz] += QQD0[qz][qy][dx] * Bt[j][i];
-                  v[qz] += QQD1[qz][qy][dx] * Gt[l][k] * s;
-                  w[qz] += QQD2[qz][qy][dx] * Bt[j][i];
-               }
-            }
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               QDD0[qz][dy][dx] = u[qz];
-               QDD1[qz][dy][dx] = v[qz];
-               QDD2[qz][dy][dx] = w[qz];
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double u[D1D], v[D1D], w[D1D];
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz) { u[dz] = v[dz] = w[dz] = 0.0; }
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               MFEM_UNROLL(MD1)
-               for (int dz = 0; dz < D1D; ++dz)
-               {
-                  const int i = qi(qz,dz,Q1D);
-                  const int j = dj(qz,dz,D1D);
-                  const int k = qk(qz,dz,Q1D);
-                  const int l = dl(qz,dz,D1D);
-                  const double s = sign(qz,dz);
-                  u[dz] += QDD0[qz][dy][dx] * Bt[j][i];
-                  v[dz] += QDD1[qz][dy][dx] * Bt[j][i];
-                  w[dz] += QDD2[qz][dy][dx] * Gt[l][k] * s;
-               }
-            }
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               y(dx,dy,dz,e) += (u[dz] + v[dz] + w[dz]);
-            }
-         }
-      }
-   });
+      });
+   }
 }
 
-static void PADiffusionApply(const int dim,
-                             const int D1D,
-                             const int Q1D,
-                             const int NE,
-                             const bool symm,
-                             const Array<double> &B,
-                             const Array<double> &G,
-                             const Array<double> &Bt,
-                             const Array<double> &Gt,
-                             const Vector &D,
-                             const Vector &X,
-                             Vector &Y)
+static void PADiffusionApplyFused(const ElementRestriction &R,
+                                  const int dim,
+                                  const int D1D,
+                                  const int Q1D,
+                                  const int NE,
+                                  const bool symm,
+                                  const Array<double> &B,
+                                  const Array<double> &G,
+                                  const Array<double> &Bt,
+                                  const Array<double> &Gt,
+                                  const Vector &D,
+                                  const Vector &X,
+                                  Vector &Y)
 {
-#ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
-   {
-      if (dim == 2)
-      {
-         OccaPADiffusionApply2D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
-         return;
-      }
-      if (dim == 3)
-      {
-         OccaPADiffusionApply3D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
-         return;
-      }
-      MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
-   }
-#endif // MFEM_USE_OCCA
    const int ID = (D1D << 4) | Q1D;
-
    if (dim == 2)
    {
       switch (ID)
       {
-         case 0x22: return SmemPADiffusionApply2D<2,2,16>(NE,symm,B,G,D,X,Y);
-         case 0x33: return SmemPADiffusionApply2D<3,3,16>(NE,symm,B,G,D,X,Y);
-         case 0x44: return SmemPADiffusionApply2D<4,4,8>(NE,symm,B,G,D,X,Y);
-         case 0x55: return SmemPADiffusionApply2D<5,5,8>(NE,symm,B,G,D,X,Y);
-         case 0x66: return SmemPADiffusionApply2D<6,6,4>(NE,symm,B,G,D,X,Y);
-         case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,symm,B,G,D,X,Y);
-         case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,symm,B,G,D,X,Y);
-         case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,symm,B,G,D,X,Y);
-         default:   return PADiffusionApply2D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x22: return PADiffusionApplyFused2D<2,2>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x33: return PADiffusionApplyFused2D<3,3>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x44: return PADiffusionApplyFused2D<4,4>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x55: return PADiffusionApplyFused2D<5,5>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x66: return PADiffusionApplyFused2D<6,6>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x77: return PADiffusionApplyFused2D<7,7>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x88: return PADiffusionApplyFused2D<8,8>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x99: return PADiffusionApplyFused2D<9,9>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         default:
+            return PADiffusionApplyFused2D(R,NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
       }
    }
-
    if (dim == 3)
    {
       switch (ID)
       {
-         case 0x23: return SmemPADiffusionApply3D<2,3>(NE,symm,B,G,D,X,Y);
-         case 0x34: return SmemPADiffusionApply3D<3,4>(NE,symm,B,G,D,X,Y);
-         case 0x45: return SmemPADiffusionApply3D<4,5>(NE,symm,B,G,D,X,Y);
-         case 0x46: return SmemPADiffusionApply3D<4,6>(NE,symm,B,G,D,X,Y);
-         case 0x56: return SmemPADiffusionApply3D<5,6>(NE,symm,B,G,D,X,Y);
-         case 0x58: return SmemPADiffusionApply3D<5,8>(NE,symm,B,G,D,X,Y);
-         case 0x67: return SmemPADiffusionApply3D<6,7>(NE,symm,B,G,D,X,Y);
-         case 0x78: return SmemPADiffusionApply3D<7,8>(NE,symm,B,G,D,X,Y);
-         case 0x89: return SmemPADiffusionApply3D<8,9>(NE,symm,B,G,D,X,Y);
-         default:   return PADiffusionApply3D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x23: return PADiffusionApplyFused3D<2,3>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x34: return PADiffusionApplyFused3D<3,4>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x45: return PADiffusionApplyFused3D<4,5>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x56: return PADiffusionApplyFused3D<5,6>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x67: return PADiffusionApplyFused3D<6,7>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x78: return PADiffusionApplyFused3D<7,8>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         case 0x89: return PADiffusionApplyFused3D<8,9>(R,NE,symm,B,G,Bt,Gt,D,X,Y);
+         default:
+            return PADiffusionApplyFused3D(R,NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -1896,6 +1636,25 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    {
       CeedAddMult(ceedDataPtr, x, y);
    }
+   else if (group_maps.Size() > 0)
+   {
+      const int pdim = symmetric ? (dim * (dim + 1)) / 2 : dim * dim;
+      int d_offset = 0, e_offset = 0;
+      for (int g = 0; g < group_maps.Size(); g++)
+      {
+         const DofToQuad &g_maps = *group_maps[g];
+         const int g_ne = group_offsets[g+1] - group_offsets[g];
+         Vector g_data, g_x, g_y;
+         g_data.MakeRef(const_cast<Vector&>(pa_data), d_offset,
+                        pdim*g_maps.nqpt*g_ne);
+         g_x.MakeRef(const_cast<Vector&>(x), e_offset, g_maps.ndof*g_ne);
+         g_y.MakeRef(y, e_offset, g_maps.ndof*g_ne);
+         PADiffusionApplyNonTensor(g_ne, symmetric, dim, g_maps, g_data, g_x,
+                                   g_y);
+         d_offset += pdim*g_maps.nqpt*g_ne;
+         e_offset += g_maps.ndof*g_ne;
+      }
+   }
    else
    {
       PADiffusionApply(dim, dofs1D, quad1D, ne, symmetric,
@@ -1904,4 +1663,18 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+bool DiffusionIntegrator::SupportsFusedPA() const
+{
+   return !DeviceCanUseCeed() && group_maps.Size() == 0 &&
+          (dim == 2 || dim == 3);
+}
+
+void DiffusionIntegrator::AddMultFusedPA(const ElementRestriction &R,
+                                         const Vector &x, Vector &y) const
+{
+   PADiffusionApplyFused(R, dim, dofs1D, quad1D, ne, symmetric,
+                         maps->B, maps->G, maps->Bt, maps->Gt,
+                         pa_data, x, y);
+}
+
 } // namespace mfem
@@ -36,14 +36,6 @@ static void EAMassAssemble1D(const int NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      double r_Bi[MQ1];
-      double r_Bj[MQ1];
-      for (int q = 0; q < Q1D; q++)
-      {
-         r_Bi[q] = B(q,MFEM_THREAD_ID(x));
-         r_Bj[q] = B(q,MFEM_THREAD_ID(y));
-      }
       MFEM_FOREACH_THREAD(i1,x,D1D)
       {
          MFEM_FOREACH_THREAD(j1,y,D1D)
@@ -51,7 +43,7 @@ static void EAMassAssemble1D(const int NE,
             double val = 0.0;
             for (int k1 = 0; k1 < Q1D; ++k1)
             {
-               val += r_Bi[k1] * r_Bj[k1] * D(k1, e);
+               val += B(k1,i1) * B(k1,j1) * D(k1, e);
             }
             if (add)
             {
@@ -12,6 +12,7 @@
 #include "../general/forall.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
+#include "bilininteg_mass_kernels.hpp"
 #include "libceed/mass.hpp"
 
 using namespace std;
@@ -27,6 +28,7 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
    // Assuming the same element type
    fespace = &fes;
+   group_maps.SetSize(0);
    Mesh *mesh = fes.GetMesh();
    if (mesh->GetNE() == 0) { return; }
    const FiniteElement &el = *fes.GetFE(0);
@@ -39,6 +41,7 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
       InitCeedCoeff(Q, *mesh, *ir, ceedDataPtr);
       return CeedPAMassAssemble(fes, *ir, *ceedDataPtr);
    }
+   if (!UsesTensorBasis(fes)) { return AssemblePANonTensor(fes); }
    dim = mesh->Dimension();
    ne = fes.GetMesh()->GetNE();
    nq = ir->GetNPoints();
@@ -85,7 +88,25 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
          }
       }
    }
-   if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
+   if (dim==1)
+   {
+      const int NE = ne;
+      const int Q1D = quad1D;
+      const bool const_c = coeff.Size() == 1;
+      const auto W = Reshape(ir->GetWeights().Read(), Q1D);
+      const auto J = Reshape(geom->J.Read(), Q1D,1,1,NE);
+      const auto C = const_c ? Reshape(coeff.Read(), 1,1) :
+                     Reshape(coeff.Read(), Q1D,NE);
+      auto v = Reshape(pa_data.Write(), Q1D, NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double coeff = const_c ? C(0,0) : C(qx,e);
+            v(qx,e) = W(qx) * coeff * J(qx,0,0,e);
+         }
+      });
+   }
    if (dim==2)
    {
       const int NE = ne;
@@ -152,6 +173,164 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
 }
 
+// PA Mass Integrator for non-tensor elements (e.g. triangles, tetrahedra) and
+// meshes with mixed element types: the elements are processed in groups of
+// elements with the same geometry, using the full (non-tensor) DofToQuad maps.
+
+void MassIntegrator::AssemblePANonTensor(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   maps = NULL;
+   geom = NULL;
+
+   Array<int> group_elements;
+   GetElementGeometryGroups(fes, group_offsets, group_elements);
+   const int ngroups = group_offsets.Size() - 1;
+   group_maps.SetSize(ngroups);
+   Array<const IntegrationRule*> irs(ngroups);
+   int size = 0;
+   for (int g = 0; g < ngroups; g++)
+   {
+      const int e = group_elements[group_offsets[g]];
+      const FiniteElement &el = *fes.GetFE(e);
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      irs[g] = IntRule ? IntRule : &GetRule(el, el, T);
+      group_maps[g] = &el.GetDofToQuad(*irs[g], DofToQuad::FULL);
+      size += irs[g]->GetNPoints()*(group_offsets[g+1] - group_offsets[g]);
+   }
+
+   // The data at the quadrature points is computed on the host, including the
+   // coefficient; its layout is NQ x NE for every group.
+   pa_data.SetSize(size, Device::GetDeviceMemoryType());
+   double *D = pa_data.HostWrite();
+   for (int g = 0; g < ngroups; g++)
+   {
+      const IntegrationRule &ir = *irs[g];
+      for (int k = group_offsets[g]; k < group_offsets[g+1]; k++)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(
+                                       group_elements[k]);
+         for (int q = 0; q < ir.GetNPoints(); q++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            const double coeff = Q ? Q->Eval(T, ip) : 1.0;
+            *(D++) = ip.weight * T.Weight() * coeff;
+         }
+      }
+   }
+}
+
+static void PAMassAssembleDiagonalNonTensor(const int NE,
+                                            const DofToQuad &maps,
+                                            const Vector &D,
+                                            Vector &Y)
+{
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   const auto B = Reshape(maps.B.Read(), NQ, ND);
+   const auto d = Reshape(D.Read(), NQ, NE);
+   auto y = Reshape(Y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; i++)
+      {
+         double val = 0.0;
+         for (int q = 0; q < NQ; q++)
+         {
+            val += B(q,i) * B(q,i) * d(q,e);
+         }
+         y(i,e) += val;
+      }
+   });
+}
+
+// Number of elements processed together by the host non-tensor kernels.
+static const int PA_NONTENSOR_BATCH = 32;
+
+static void PAMassApplyNonTensor(const int NE,
+                                 const DofToQuad &maps,
+                                 const Vector &D,
+                                 const Vector &X,
+                                 Vector &Y)
+{
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   if (Device::Allows(Backend::DEVICE_MASK))
+   {
+      const auto B = Reshape(maps.B.Read(), NQ, ND);
+      const auto d = Reshape(D.Read(), NQ, NE);
+      const auto x = Reshape(X.Read(), ND, NE);
+      auto y = Reshape(Y.ReadWrite(), ND, NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; q++)
+         {
+            double u = 0.0;
+            for (int i = 0; i < ND; i++) { u += B(q,i) * x(i,e); }
+            u *= d(q,e);
+            for (int i = 0; i < ND; i++) { y(i,e) += B(q,i) * u; }
+         }
+      });
+      return;
+   }
+
+   // On the host, a batch of elements is a contiguous ND x nb block of the
+   // E-vector, so the interpolation to the quadrature points and its transpose
+   // are two small dense matrix-matrix products per batch.
+   DenseMatrix B(const_cast<double*>(maps.B.HostRead()), NQ, ND);
+   DenseMatrix Bt(const_cast<double*>(maps.Bt.HostRead()), ND, NQ);
+   const double *d = D.HostRead();
+   const double *x = X.HostRead();
+   double *y = Y.HostReadWrite();
+   DenseMatrix Uq;
+   for (int e0 = 0; e0 < NE; e0 += PA_NONTENSOR_BATCH)
+   {
+      const int nb = std::min(PA_NONTENSOR_BATCH, NE - e0);
+      DenseMatrix Xe(const_cast<double*>(x + e0*ND), ND, nb);
+      DenseMatrix Ye(y + e0*ND, ND, nb);
+      Uq.SetSize(NQ, nb);
+      Mult(B, Xe, Uq);
+      const double *de = d + e0*NQ;
+      double *uq = Uq.Data();
+      for (int j = 0; j < NQ*nb; j++) { uq[j] *= de[j]; }
+      AddMult(Bt, Uq, Ye);
+   }
+}
+
+// In 1D, the PA kernels need no temporary storage per element, so they are
+// not limited by MAX_D1D and MAX_Q1D and can be used with very high orders.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAMassAssembleDiagonal1D(const int NE,
+                                     const Array<double> &b,
+                                     const Vector &d,
+                                     Vector &y,
+                                     const int d1d = 0,
+                                     const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         double t = 0.0;
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            t += B(qx, dx) * B(qx, dx) * D(qx, e);
+         }
+         Y(dx, e) += t;
+      }
+   });
+}
+
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PAMassAssembleDiagonal2D(const int NE,
                                      const Array<double> &b,
@@ -425,7 +604,22 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
                                    const Vector &D,
                                    Vector &Y)
 {
-   if (dim == 2)
+   if (dim == 1)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAMassAssembleDiagonal1D<2,2>(NE,B,D,Y);
+         case 0x33: return PAMassAssembleDiagonal1D<3,3>(NE,B,D,Y);
+         case 0x44: return PAMassAssembleDiagonal1D<4,4>(NE,B,D,Y);
+         case 0x55: return PAMassAssembleDiagonal1D<5,5>(NE,B,D,Y);
+         case 0x66: return PAMassAssembleDiagonal1D<6,6>(NE,B,D,Y);
+         case 0x77: return PAMassAssembleDiagonal1D<7,7>(NE,B,D,Y);
+         case 0x88: return PAMassAssembleDiagonal1D<8,8>(NE,B,D,Y);
+         case 0x99: return PAMassAssembleDiagonal1D<9,9>(NE,B,D,Y);
+         default:   return PAMassAssembleDiagonal1D(NE,B,D,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 2)
    {
       switch ((D1D << 4 ) | Q1D)
       {
@@ -463,6 +657,21 @@ void MassIntegrator::AssembleDiagonalPA(Vector &diag)
    {
       CeedAssembleDiagonal(ceedDataPtr, diag);
    }
+   else if (group_maps.Size() > 0)
+   {
+      int d_offset = 0, e_offset = 0;
+      for (int g = 0; g < group_maps.Size(); g++)
+      {
+         const DofToQuad &g_maps = *group_maps[g];
+         const int g_ne = group_offsets[g+1] - group_offsets[g];
+         Vector g_data, g_diag;
+         g_data.MakeRef(pa_data, d_offset, g_maps.nqpt*g_ne);
+         g_diag.MakeRef(diag, e_offset, g_maps.ndof*g_ne);
+         PAMassAssembleDiagonalNonTensor(g_ne, g_maps, g_data, g_diag);
+         d_offset += g_maps.nqpt*g_ne;
+         e_offset += g_maps.ndof*g_ne;
+      }
+   }
    else
    {
       PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
@@ -562,8 +771,49 @@ static void OccaPAMassApply3D(const int D1D,
 }
 #endif // MFEM_USE_OCCA
 
+// Default specializations of the tensor PA action kernels
+static MassIntegrator::ApplyKernelRegistry MakeMassApplyKernels()
+{
+   using internal::MassApplyKernels;
+   MassIntegrator::ApplyKernelRegistry kernels("MassApply");
+   MassApplyKernels<2,2,2,16>::Add(kernels);
+   MassApplyKernels<2,2,4,16>::Add(kernels);
+   MassApplyKernels<2,3,3,16>::Add(kernels);
+   MassApplyKernels<2,3,4,16>::Add(kernels);
+   MassApplyKernels<2,3,6,16>::Add(kernels);
+   MassApplyKernels<2,4,4,8>::Add(kernels);
+   MassApplyKernels<2,4,8,4>::Add(kernels);
+   MassApplyKernels<2,5,5,8>::Add(kernels);
+   MassApplyKernels<2,5,8,2>::Add(kernels);
+   MassApplyKernels<2,6,6,4>::Add(kernels);
+   MassApplyKernels<2,7,7,4>::Add(kernels);
+   MassApplyKernels<2,8,8,2>::Add(kernels);
+   MassApplyKernels<2,9,9,2>::Add(kernels);
+   MassApplyKernels<3,2,3,0>::Add(kernels);
+   MassApplyKernels<3,2,4,0>::Add(kernels);
+   MassApplyKernels<3,3,4,0>::Add(kernels);
+   MassApplyKernels<3,3,6,0>::Add(kernels);
+   MassApplyKernels<3,4,5,0>::Add(kernels);
+   MassApplyKernels<3,4,6,0>::Add(kernels);
+   MassApplyKernels<3,4,8,0>::Add(kernels);
+   MassApplyKernels<3,5,6,0>::Add(kernels);
+   MassApplyKernels<3,5,8,0>::Add(kernels);
+   MassApplyKernels<3,6,7,0>::Add(kernels);
+   MassApplyKernels<3,7,8,0>::Add(kernels);
+   MassApplyKernels<3,8,9,0>::Add(kernels);
+   MassApplyKernels<3,9,10,0>::Add(kernels);
+   return kernels;
+}
+
+MassIntegrator::ApplyKernelRegistry &MassIntegrator::ApplyPAKernels()
+{
+   static ApplyKernelRegistry kernels = MakeMassApplyKernels();
+   return kernels;
+}
+
+// PA Mass Apply 1D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
-static void PAMassApply2D(const int NE,
+static void PAMassApply1D(const int NE,
                           const Array<double> &b_,
                           const Array<double> &bt_,
                           const Vector &d_,
@@ -574,640 +824,238 @@ static void PAMassApply2D(const int NE,
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(b_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   auto D = Reshape(d_.Read(), Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, NE);
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xy[max_Q1D][max_Q1D];
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            sol_xy[qy][qx] = 0.0;
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
+      for (int qx = 0; qx < Q1D; ++qx)
       {
-         double sol_x[max_Q1D];
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            sol_x[qy] = 0.0;
-         }
+         double u = 0.0;
          for (int dx = 0; dx < D1D; ++dx)
          {
-            const double s = X(dx,dy,e);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_x[qx] += B(qx,dx)* s;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            const double d2q = B(qy,dy);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xy[qy][qx] += d2q * sol_x[qx];
-            }
+            u += B(qx, dx) * X(dx, e);
          }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            sol_xy[qy][qx] *= D(qx,qy,e);
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         double sol_x[max_D1D];
+         u *= D(qx, e);
          for (int dx = 0; dx < D1D; ++dx)
          {
-            sol_x[dx] = 0.0;
-         }
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const double s = sol_xy[qy][qx];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_x[dx] += Bt(dx,qx) * s;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            const double q2d = Bt(dy,qy);
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               Y(dx,dy,e) += q2d * sol_x[dx];
-            }
+            Y(dx, e) += Bt(dx, qx) * u;
          }
       }
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
-static void SmemPAMassApply2D(const int NE,
-                              const Array<double> &b_,
-                              const Array<double> &bt_,
-                              const Vector &d_,
-                              const Vector &x_,
-                              Vector &y_,
-                              const int d1d = 0,
-                              const int q1d = 0)
+static void PAMassApply(const int dim,
+                        const int D1D,
+                        const int Q1D,
+                        const int NE,
+                        const Array<double> &B,
+                        const Array<double> &Bt,
+                        const Vector &D,
+                        const Vector &X,
+                        Vector &Y)
 {
-   MFEM_CONTRACT_VAR(bt_);
-   const int D1D = T_D1D ? T_D1D : d1d;
-   const int Q1D = T_Q1D ? T_Q1D : q1d;
-   constexpr int NBZ = T_NBZ ? T_NBZ : 1;
-   constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-   constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-   MFEM_VERIFY(D1D <= MD1, "");
-   MFEM_VERIFY(Q1D <= MQ1, "");
-   auto b = Reshape(b_.Read(), Q1D, D1D);
-   auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   MFEM_PROFILE_REGION("PAMassApply");
+   // Read the E-vectors X and Y, write Y and read the quadrature data D.
+   MFEM_PROFILE_COUNTERS(
+      8.0*NE*(3*std::pow(D1D, dim) + std::pow(Q1D, dim)),
+      NE*(2*SumFactorizationFlops(dim, D1D, Q1D) + std::pow(Q1D, dim)));
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca())
    {
-      const int tidz = MFEM_THREAD_ID(z);
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int NBZ = T_NBZ ? T_NBZ : 1;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int MDQ = (MQ1 > MD1) ? MQ1 : MD1;
-      MFEM_SHARED double BBt[MQ1*MD1];
-      double (*B)[MD1] = (double (*)[MD1]) BBt;
-      double (*Bt)[MQ1] = (double (*)[MQ1]) BBt;
-      MFEM_SHARED double sm0[NBZ][MDQ*MDQ];
-      MFEM_SHARED double sm1[NBZ][MDQ*MDQ];
-      double (*X)[MD1] = (double (*)[MD1]) (sm0 + tidz);
-      double (*DQ)[MQ1] = (double (*)[MQ1]) (sm1 + tidz);
-      double (*QQ)[MQ1] = (double (*)[MQ1]) (sm0 + tidz);
-      double (*QD)[MD1] = (double (*)[MD1]) (sm1 + tidz);
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            X[dy][dx] = x(dx,dy,e);
-         }
-      }
-      if (tidz == 0)
-      {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
-         {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
-            {
-               B[q][dy] = b(q,dy);
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            double dq = 0.0;
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               dq += X[dy][dx] * B[qx][dx];
-            }
-            DQ[dy][qx] = dq;
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            double qq = 0.0;
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               qq += DQ[dy][qx] * B[qy][dy];
-            }
-            QQ[qy][qx] = qq * D(qx, qy, e);
-         }
-      }
-      MFEM_SYNC_THREAD;
-      if (tidz == 0)
+      if (dim == 2)
       {
-         MFEM_FOREACH_THREAD(dy,y,D1D)
-         {
-            MFEM_FOREACH_THREAD(q,x,Q1D)
-            {
-               Bt[dy][q] = b(q,dy);
-            }
-         }
+         return OccaPAMassApply2D(D1D,Q1D,NE,B,Bt,D,X,Y);
       }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
+      if (dim == 3)
       {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double dq = 0.0;
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               dq += QQ[qy][qx] * Bt[dx][qx];
-            }
-            QD[qy][dx] = dq;
-         }
+         return OccaPAMassApply3D(D1D,Q1D,NE,B,Bt,D,X,Y);
       }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
+      MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
+   }
+#endif // MFEM_USE_OCCA
+   if (dim == 1)
+   {
+      switch ((D1D << 4 ) | Q1D)
       {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double dd = 0.0;
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               dd += (QD[qy][dx] * Bt[dy][qy]);
-            }
-            Y(dx, dy, e) += dd;
-         }
+         case 0x22: return PAMassApply1D<2,2>(NE,B,Bt,D,X,Y);
+         case 0x33: return PAMassApply1D<3,3>(NE,B,Bt,D,X,Y);
+         case 0x44: return PAMassApply1D<4,4>(NE,B,Bt,D,X,Y);
+         case 0x55: return PAMassApply1D<5,5>(NE,B,Bt,D,X,Y);
+         case 0x66: return PAMassApply1D<6,6>(NE,B,Bt,D,X,Y);
+         case 0x77: return PAMassApply1D<7,7>(NE,B,Bt,D,X,Y);
+         case 0x88: return PAMassApply1D<8,8>(NE,B,Bt,D,X,Y);
+         case 0x99: return PAMassApply1D<9,9>(NE,B,Bt,D,X,Y);
+         default:   return PAMassApply1D(NE,B,Bt,D,X,Y,D1D,Q1D);
       }
-   });
+   }
+   if (MassIntegrator::ApplyPAKernels().Run(dim,D1D,Q1D,NE,B,Bt,D,X,Y))
+   {
+      return;
+   }
+   if (dim == 2) { return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D); }
+   if (dim == 3) { return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D); }
+   MFEM_ABORT("Unknown kernel.");
 }
 
+// Fused PA Mass Apply 2D kernel: the element dofs are gathered from and
+// scattered to the L-vectors, one element color after the other.
 template<int T_D1D = 0, int T_Q1D = 0>
-static void PAMassApply3D(const int NE,
-                          const Array<double> &b_,
-                          const Array<double> &bt_,
-                          const Vector &d_,
-                          const Vector &x_,
-                          Vector &y_,
-                          const int d1d = 0,
-                          const int q1d = 0)
+static void PAMassApplyFused2D(const ElementRestriction &R,
+                               const int NE,
+                               const Array<double> &b_,
+                               const Array<double> &bt_,
+                               const Vector &d_,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int d1d = 0,
+                               const int q1d = 0)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const Array<int> *color_offsets, *color_elems;
+   R.GetElementColors(color_offsets, color_elems);
    auto B = Reshape(b_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
+   auto M = Reshape(R.GatherMap().Read(), D1D*D1D, NE);
+   auto E = color_elems->Read();
+   auto X = x_.Read();
+   auto Y = y_.ReadWrite();
+   for (int c = 0; c < color_offsets->Size() - 1; c++)
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xyz[qz][qy][qx] = 0.0;
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         double sol_xy[max_Q1D][max_Q1D];
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xy[qy][qx] = 0.0;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            double sol_x[max_Q1D];
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_x[qx] = 0;
-            }
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double s = X(dx,dy,dz,e);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  sol_x[qx] += B(qx,dx) * s;
-               }
-            }
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const double wy = B(qy,dy);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  sol_xy[qy][qx] += wy * sol_x[qx];
-               }
-            }
-         }
-         for (int qz = 0; qz < Q1D; ++qz)
-         {
-            const double wz = B(qz,dz);
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
-               }
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
+      const int offset = (*color_offsets)[c];
+      const int NC = (*color_offsets)[c+1] - offset;
+      MFEM_FORALL(i, NC,
       {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xyz[qz][qy][qx] *= D(qx,qy,qz,e);
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         double sol_xy[max_D1D][max_D1D];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_xy[dy][dx] = 0;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
+         const int e = E[offset + i];
+         const int D1D = T_D1D ? T_D1D : d1d;
+         constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+         double xe[max_D1D*max_D1D], ye[max_D1D*max_D1D];
+         for (int j = 0; j < D1D*D1D; ++j)
          {
-            double sol_x[max_D1D];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_x[dx] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double s = sol_xyz[qz][qy][qx];
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  sol_x[dx] += Bt(dx,qx) * s;
-               }
-            }
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const double wy = Bt(dy,qy);
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  sol_xy[dy][dx] += wy * sol_x[dx];
-               }
-            }
+            const int gid = M(j,e);
+            xe[j] = (gid >= 0) ? X[gid] : -X[-1-gid];
+            ye[j] = 0.0;
          }
-         for (int dz = 0; dz < D1D; ++dz)
+         PAMassApply2DElement<T_D1D,T_Q1D>(e, B, Bt, D, xe, ye, d1d, q1d);
+         for (int j = 0; j < D1D*D1D; ++j)
          {
-            const double wz = Bt(dz,qz);
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  Y(dx,dy,dz,e) += wz * sol_xy[dy][dx];
-               }
-            }
+            const int gid = M(j,e);
+            if (gid >= 0) { Y[gid] += ye[j]; }
+            else { Y[-1-gid] -= ye[j]; }
          }
-      }
-   });
+      });
+   }
 }
 
+// Fused PA Mass Apply 3D kernel, see PAMassApplyFused2D().
 template<int T_D1D = 0, int T_Q1D = 0>
-static void SmemPAMassApply3D(const int NE,
-                              const Array<double> &b_,
-                              const Array<double> &bt_,
-                              const Vector &d_,
-                              const Vector &x_,
-                              Vector &y_,
-                              const int d1d = 0,
-                              const int q1d = 0)
+static void PAMassApplyFused3D(const ElementRestriction &R,
+                               const int NE,
+                               const Array<double> &b_,
+                               const Array<double> &bt_,
+                               const Vector &d_,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int d1d = 0,
+                               const int q1d = 0)
 {
-   MFEM_CONTRACT_VAR(bt_);
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   constexpr int M1Q = T_Q1D ? T_Q1D : MAX_Q1D;
-   constexpr int M1D = T_D1D ? T_D1D : MAX_D1D;
-   MFEM_VERIFY(D1D <= M1D, "");
-   MFEM_VERIFY(Q1D <= M1Q, "");
-   auto b = Reshape(b_.Read(), Q1D, D1D);
-   auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, 1,
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const Array<int> *color_offsets, *color_elems;
+   R.GetElementColors(color_offsets, color_elems);
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
+   auto M = Reshape(R.GatherMap().Read(), D1D*D1D*D1D, NE);
+   auto E = color_elems->Read();
+   auto X = x_.Read();
+   auto Y = y_.ReadWrite();
+   for (int c = 0; c < color_offsets->Size() - 1; c++)
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int MDQ = (MQ1 > MD1) ? MQ1 : MD1;
-      MFEM_SHARED double sDQ[MQ1*MD1];
-      double (*B)[MD1] = (double (*)[MD1]) sDQ;
-      double (*Bt)[MQ1] = (double (*)[MQ1]) sDQ;
-      MFEM_SHARED double sm0[MDQ*MDQ*MDQ];
-      MFEM_SHARED double sm1[MDQ*MDQ*MDQ];
-      double (*X)[MD1][MD1]   = (double (*)[MD1][MD1]) sm0;
-      double (*DDQ)[MD1][MQ1] = (double (*)[MD1][MQ1]) sm1;
-      double (*DQQ)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) sm0;
-      double (*QQQ)[MQ1][MQ1] = (double (*)[MQ1][MQ1]) sm1;
-      double (*QQD)[MQ1][MD1] = (double (*)[MQ1][MD1]) sm0;
-      double (*QDD)[MD1][MD1] = (double (*)[MD1][MD1]) sm1;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
+      const int offset = (*color_offsets)[c];
+      const int NC = (*color_offsets)[c+1] - offset;
+      MFEM_FORALL(i, NC,
       {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
+         const int e = E[offset + i];
+         const int D1D = T_D1D ? T_D1D : d1d;
+         constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+         double xe[max_D1D*max_D1D*max_D1D], ye[max_D1D*max_D1D*max_D1D];
+         for (int j = 0; j < D1D*D1D*D1D; ++j)
          {
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               X[dz][dy][dx] = x(dx,dy,dz,e);
-            }
-         }
-         MFEM_FOREACH_THREAD(dx,x,Q1D)
-         {
-            B[dx][dy] = b(dx,dy);
+            const int gid = M(j,e);
+            xe[j] = (gid >= 0) ? X[gid] : -X[-1-gid];
+            ye[j] = 0.0;
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
+         PAMassApply3DElement<T_D1D,T_Q1D>(e, B, Bt, D, xe, ye, d1d, q1d);
+         for (int j = 0; j < D1D*D1D*D1D; ++j)
          {
-            double u[D1D];
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; dz++)
-            {
-               u[dz] = 0;
-            }
-            MFEM_UNROLL(MD1)
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               MFEM_UNROLL(MD1)
-               for (int dz = 0; dz < D1D; ++dz)
-               {
-                  u[dz] += X[dz][dy][dx] * B[qx][dx];
-               }
-            }
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               DDQ[dz][dy][qx] = u[dz];
-            }
+            const int gid = M(j,e);
+            if (gid >= 0) { Y[gid] += ye[j]; }
+            else { Y[-1-gid] -= ye[j]; }
          }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            double u[D1D];
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; dz++)
-            {
-               u[dz] = 0;
-            }
-            MFEM_UNROLL(MD1)
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               MFEM_UNROLL(MD1)
-               for (int dz = 0; dz < D1D; dz++)
-               {
-                  u[dz] += DDQ[dz][dy][qx] * B[qy][dy];
-               }
-            }
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; dz++)
-            {
-               DQQ[dz][qy][qx] = u[dz];
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(qx,x,Q1D)
-         {
-            double u[Q1D];
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; qz++)
-            {
-               u[qz] = 0;
-            }
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               MFEM_UNROLL(MQ1)
-               for (int qz = 0; qz < Q1D; qz++)
-               {
-                  u[qz] += DQQ[dz][qy][qx] * B[qz][dz];
-               }
-            }
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; qz++)
-            {
-               QQQ[qz][qy][qx] = u[qz] * d(qx,qy,qz,e);
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(d,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(q,x,Q1D)
-         {
-            Bt[d][q] = b(q,d);
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(qy,y,Q1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double u[Q1D];
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               u[qz] = 0;
-            }
-            MFEM_UNROLL(MQ1)
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               MFEM_UNROLL(MQ1)
-               for (int qz = 0; qz < Q1D; ++qz)
-               {
-                  u[qz] += QQQ[qz][qy][qx] * Bt[dx][qx];
-               }
-            }
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               QQD[qz][qy][dx] = u[qz];
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double u[Q1D];
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               u[qz] = 0;
-            }
-            MFEM_UNROLL(MQ1)
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               MFEM_UNROLL(MQ1)
-               for (int qz = 0; qz < Q1D; ++qz)
-               {
-                  u[qz] += QQD[qz][qy][dx] * Bt[dy][qy];
-               }
-            }
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               QDD[qz][dy][dx] = u[qz];
-            }
-         }
-      }
-      MFEM_SYNC_THREAD;
-      MFEM_FOREACH_THREAD(dy,y,D1D)
-      {
-         MFEM_FOREACH_THREAD(dx,x,D1D)
-         {
-            double u[D1D];
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               u[dz] = 0;
-            }
-            MFEM_UNROLL(MQ1)
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               MFEM_UNROLL(MD1)
-               for (int dz = 0; dz < D1D; ++dz)
-               {
-                  u[dz] += QDD[qz][dy][dx] * Bt[dz][qz];
-               }
-            }
-            MFEM_UNROLL(MD1)
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               y(dx,dy,dz,e) += u[dz];
-            }
-         }
-      }
-   });
+      });
+   }
 }
 
-static void PAMassApply(const int dim,
-                        const int D1D,
-                        const int Q1D,
-                        const int NE,
-                        const Array<double> &B,
-                        const Array<double> &Bt,
-                        const Vector &D,
-                        const Vector &X,
-                        Vector &Y)
+static void PAMassApplyFused(const ElementRestriction &R,
+                             const int dim,
+                             const int D1D,
+                             const int Q1D,
+                             const int NE,
+                             const Array<double> &B,
+                             const Array<double> &Bt,
+                             const Vector &D,
+                             const Vector &X,
+                             Vector &Y)
 {
-#ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
-   {
-      if (dim == 2)
-      {
-         return OccaPAMassApply2D(D1D,Q1D,NE,B,Bt,D,X,Y);
-      }
-      if (dim == 3)
-      {
-         return OccaPAMassApply3D(D1D,Q1D,NE,B,Bt,D,X,Y);
-      }
-      MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
-   }
-#endif // MFEM_USE_OCCA
    const int id = (D1D << 4) | Q1D;
    if (dim == 2)
    {
       switch (id)
       {
-         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply2D<2,4,16>(NE,B,Bt,D,X,Y);
-         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply2D<3,4,16>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply2D<3,6,16>(NE,B,Bt,D,X,Y);
-         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply2D<4,8,4>(NE,B,Bt,D,X,Y);
-         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply2D<5,8,2>(NE,B,Bt,D,X,Y);
-         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y);
-         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
-         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
-         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x22: return PAMassApplyFused2D<2,2>(R,NE,B,Bt,D,X,Y);
+         case 0x24: return PAMassApplyFused2D<2,4>(R,NE,B,Bt,D,X,Y);
+         case 0x33: return PAMassApplyFused2D<3,3>(R,NE,B,Bt,D,X,Y);
+         case 0x34: return PAMassApplyFused2D<3,4>(R,NE,B,Bt,D,X,Y);
+         case 0x36: return PAMassApplyFused2D<3,6>(R,NE,B,Bt,D,X,Y);
+         case 0x44: return PAMassApplyFused2D<4,4>(R,NE,B,Bt,D,X,Y);
+         case 0x48: return PAMassApplyFused2D<4,8>(R,NE,B,Bt,D,X,Y);
+         case 0x55: return PAMassApplyFused2D<5,5>(R,NE,B,Bt,D,X,Y);
+         case 0x58: return PAMassApplyFused2D<5,8>(R,NE,B,Bt,D,X,Y);
+         case 0x66: return PAMassApplyFused2D<6,6>(R,NE,B,Bt,D,X,Y);
+         case 0x77: return PAMassApplyFused2D<7,7>(R,NE,B,Bt,D,X,Y);
+         case 0x88: return PAMassApplyFused2D<8,8>(R,NE,B,Bt,D,X,Y);
+         case 0x99: return PAMassApplyFused2D<9,9>(R,NE,B,Bt,D,X,Y);
+         default:   return PAMassApplyFused2D(R,NE,B,Bt,D,X,Y,D1D,Q1D);
       }
    }
    else if (dim == 3)
    {
       switch (id)
       {
-         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply3D<2,4>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply3D<3,6>(NE,B,Bt,D,X,Y);
-         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y);
-         case 0x46: return SmemPAMassApply3D<4,6>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply3D<4,8>(NE,B,Bt,D,X,Y);
-         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply3D<5,8>(NE,B,Bt,D,X,Y);
-         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y);
-         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
-         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
-         case 0x9A: return SmemPAMassApply3D<9,10>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x23: return PAMassApplyFused3D<2,3>(R,NE,B,Bt,D,X,Y);
+         case 0x24: return PAMassApplyFused3D<2,4>(R,NE,B,Bt,D,X,Y);
+         case 0x34: return PAMassApplyFused3D<3,4>(R,NE,B,Bt,D,X,Y);
+         case 0x36: return PAMassApplyFused3D<3,6>(R,NE,B,Bt,D,X,Y);
+         case 0x45: return PAMassApplyFused3D<4,5>(R,NE,B,Bt,D,X,Y);
+         case 0x46: return PAMassApplyFused3D<4,6>(R,NE,B,Bt,D,X,Y);
+         case 0x48: return PAMassApplyFused3D<4,8>(R,NE,B,Bt,D,X,Y);
+         case 0x56: return PAMassApplyFused3D<5,6>(R,NE,B,Bt,D,X,Y);
+         case 0x58: return PAMassApplyFused3D<5,8>(R,NE,B,Bt,D,X,Y);
+         case 0x67: return PAMassApplyFused3D<6,7>(R,NE,B,Bt,D,X,Y);
+         case 0x78: return PAMassApplyFused3D<7,8>(R,NE,B,Bt,D,X,Y);
+         case 0x89: return PAMassApplyFused3D<8,9>(R,NE,B,Bt,D,X,Y);
+         default:   return PAMassApplyFused3D(R,NE,B,Bt,D,X,Y,D1D,Q1D);
       }
    }
    mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
@@ -1220,10 +1068,40 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    {
       CeedAddMult(ceedDataPtr, x, y);
    }
+   else if (group_maps.Size() > 0)
+   {
+      int d_offset = 0, e_offset = 0;
+      for (int g = 0; g < group_maps.Size(); g++)
+      {
+         const DofToQuad &g_maps = *group_maps[g];
+         const int g_ne = group_offsets[g+1] - group_offsets[g];
+         Vector g_data, g_x, g_y;
+         g_data.MakeRef(const_cast<Vector&>(pa_data), d_offset,
+                        g_maps.nqpt*g_ne);
+         g_x.MakeRef(const_cast<Vector&>(x), e_offset, g_maps.ndof*g_ne);
+         g_y.MakeRef(y, e_offset, g_maps.ndof*g_ne);
+         PAMassApplyNonTensor(g_ne, g_maps, g_data, g_x, g_y);
+         d_offset += g_maps.nqpt*g_ne;
+         e_offset += g_maps.ndof*g_ne;
+      }
+   }
    else
    {
       PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
    }
 }
 
+bool MassIntegrator::SupportsFusedPA() const
+{
+   return !DeviceCanUseCeed() && group_maps.Size() == 0 &&
+          (dim == 2 || dim == 3);
+}
+
+void MassIntegrator::AddMultFusedPA(const ElementRestriction &R,
+                                    const Vector &x, Vector &y) const
+{
+   PAMassApplyFused(R, dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data,
+                    x, y);
+}
+
 } // namespace mfem
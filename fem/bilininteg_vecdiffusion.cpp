@@ -12,6 +12,7 @@
 #include "../general/forall.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
+#include "pa_simd.hpp"
 #include "libceed/diffusion.hpp"
 
 using namespace std;
@@ -195,6 +196,115 @@ void VectorDiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
 }
 
+// PA Diffusion Apply 2D kernel for the element e
+template<int T_D1D = 0, int T_Q1D = 0, int T_VDIM = 0,
+         typename real_t = double>
+static MFEM_HOST_DEVICE inline
+void PAVectorDiffusionApply2DElement(const int e,
+                                     const DeviceTensor<2,const double> &B,
+                                     const DeviceTensor<2,const double> &G,
+                                     const DeviceTensor<2,const double> &Bt,
+                                     const DeviceTensor<2,const double> &Gt,
+                                     const DeviceTensor<3,const real_t> &D,
+                                     const DeviceTensor<4,const real_t> &x,
+                                     const DeviceTensor<4,real_t> &y,
+                                     const int d1d,
+                                     const int q1d,
+                                     const int vdim)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+   real_t grad[max_Q1D][max_Q1D][2];
+   for (int c = 0; c < VDIM; c++)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][0] = 0.0;
+            grad[qy][qx][1] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         real_t gradX[max_Q1D][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const real_t s = x(dx,dy,c,e);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] += s * B(qx,dx);
+               gradX[qx][1] += s * G(qx,dx);
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B(qy,dy);
+            const double wDy = G(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][0] += gradX[qx][1] * wy;
+               grad[qy][qx][1] += gradX[qx][0] * wDy;
+            }
+         }
+      }
+      // Calculate Dxy, xDy in plane
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            const real_t O11 = D(q,0,e);
+            const real_t O12 = D(q,1,e);
+            const real_t O22 = D(q,2,e);
+            const real_t gradX = grad[qy][qx][0];
+            const real_t gradY = grad[qy][qx][1];
+            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+            grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         real_t gradX[max_D1D][2];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0.0;
+            gradX[dx][1] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const real_t gX = grad[qy][qx][0];
+            const real_t gY = grad[qy][qx][1];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = Bt(dx,qx);
+               const double wDx = Gt(dx,qx);
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = Bt(dy,qy);
+            const double wDy = Gt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+            }
+         }
+      }
+   }
+}
+
 // PA Diffusion Apply 2D kernel
 template<int T_D1D = 0, int T_Q1D = 0, int T_VDIM = 0> static
 void PAVectorDiffusionApply2D(const int NE,
@@ -223,26 +333,61 @@ void PAVectorDiffusionApply2D(const int NE,
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, VDIM, NE);
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      const int VDIM = T_VDIM ? T_VDIM : vdim;
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      PAVectorDiffusionApply2DElement<T_D1D,T_Q1D,T_VDIM>(e, B, G, Bt, Gt, D,
+                                                          x, y, d1d, q1d,
+                                                          vdim);
+   });
+}
 
-      double grad[max_Q1D][max_Q1D][2];
-      for (int c = 0; c < VDIM; c++)
+// PA Diffusion Apply 3D kernel for the element e
+template<int T_D1D = 0, int T_Q1D = 0, typename real_t = double>
+static MFEM_HOST_DEVICE inline
+void PAVectorDiffusionApply3DElement(const int e,
+                                     const DeviceTensor<2,const double> &B,
+                                     const DeviceTensor<2,const double> &G,
+                                     const DeviceTensor<2,const double> &Bt,
+                                     const DeviceTensor<2,const double> &Gt,
+                                     const DeviceTensor<3,const real_t> &op,
+                                     const DeviceTensor<5,const real_t> &x,
+                                     const DeviceTensor<5,real_t> &y,
+                                     const int d1d,
+                                     const int q1d)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+   constexpr int VDIM = 3;
+   for (int c = 0; c < VDIM; ++ c)
+   {
+      real_t grad[max_Q1D][max_Q1D][max_Q1D][3];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qz][qy][qx][0] = 0.0;
+               grad[qz][qy][qx][1] = 0.0;
+               grad[qz][qy][qx][2] = 0.0;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
       {
+         real_t gradXY[max_Q1D][max_Q1D][3];
          for (int qy = 0; qy < Q1D; ++qy)
          {
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               grad[qy][qx][0] = 0.0;
-               grad[qy][qx][1] = 0.0;
+               gradXY[qy][qx][0] = 0.0;
+               gradXY[qy][qx][1] = 0.0;
+               gradXY[qy][qx][2] = 0.0;
             }
          }
          for (int dy = 0; dy < D1D; ++dy)
          {
-            double gradX[max_Q1D][2];
+            real_t gradX[max_Q1D][2];
             for (int qx = 0; qx < Q1D; ++qx)
             {
                gradX[qx][0] = 0.0;
@@ -250,7 +395,7 @@ void PAVectorDiffusionApply2D(const int NE,
             }
             for (int dx = 0; dx < D1D; ++dx)
             {
-               const double s = x(dx,dy,c,e);
+               const real_t s = x(dx,dy,dz,c,e);
                for (int qx = 0; qx < Q1D; ++qx)
                {
                   gradX[qx][0] += s * B(qx,dx);
@@ -263,44 +408,85 @@ void PAVectorDiffusionApply2D(const int NE,
                const double wDy = G(qy,dy);
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  grad[qy][qx][0] += gradX[qx][1] * wy;
-                  grad[qy][qx][1] += gradX[qx][0] * wDy;
+                  const real_t wx  = gradX[qx][0];
+                  const real_t wDx = gradX[qx][1];
+                  gradXY[qy][qx][0] += wDx * wy;
+                  gradXY[qy][qx][1] += wx  * wDy;
+                  gradXY[qy][qx][2] += wx  * wy;
                }
             }
          }
-         // Calculate Dxy, xDy in plane
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz  = B(qz,dz);
+            const double wDz = G(qz,dz);
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+                  grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+                  grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+               }
+            }
+         }
+      }
+      // Calculate Dxyz, xDyz, xyDz in plane
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
          for (int qy = 0; qy < Q1D; ++qy)
          {
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               const int q = qx + qy * Q1D;
-               const double O11 = D(q,0,e);
-               const double O12 = D(q,1,e);
-               const double O22 = D(q,2,e);
-               const double gradX = grad[qy][qx][0];
-               const double gradY = grad[qy][qx][1];
-               grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
-               grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               const real_t O11 = op(q,0,e);
+               const real_t O12 = op(q,1,e);
+               const real_t O13 = op(q,2,e);
+               const real_t O22 = op(q,3,e);
+               const real_t O23 = op(q,4,e);
+               const real_t O33 = op(q,5,e);
+               const real_t gradX = grad[qz][qy][qx][0];
+               const real_t gradY = grad[qz][qy][qx][1];
+               const real_t gradZ = grad[qz][qy][qx][2];
+               grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+               grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
+               grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         real_t gradXY[max_D1D][max_D1D][3];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradXY[dy][dx][0] = 0;
+               gradXY[dy][dx][1] = 0;
+               gradXY[dy][dx][2] = 0;
             }
          }
          for (int qy = 0; qy < Q1D; ++qy)
          {
-            double gradX[max_D1D][2];
+            real_t gradX[max_D1D][3];
             for (int dx = 0; dx < D1D; ++dx)
             {
-               gradX[dx][0] = 0.0;
-               gradX[dx][1] = 0.0;
+               gradX[dx][0] = 0;
+               gradX[dx][1] = 0;
+               gradX[dx][2] = 0;
             }
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               const double gX = grad[qy][qx][0];
-               const double gY = grad[qy][qx][1];
+               const real_t gX = grad[qz][qy][qx][0];
+               const real_t gY = grad[qz][qy][qx][1];
+               const real_t gZ = grad[qz][qy][qx][2];
                for (int dx = 0; dx < D1D; ++dx)
                {
                   const double wx  = Bt(dx,qx);
                   const double wDx = Gt(dx,qx);
                   gradX[dx][0] += gX * wDx;
                   gradX[dx][1] += gY * wx;
+                  gradX[dx][2] += gZ * wx;
                }
             }
             for (int dy = 0; dy < D1D; ++dy)
@@ -309,12 +495,29 @@ void PAVectorDiffusionApply2D(const int NE,
                const double wDy = Gt(dy,qy);
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz  = Bt(dz,qz);
+            const double wDz = Gt(dz,qz);
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y(dx,dy,dz,c,e) +=
+                     ((gradXY[dy][dx][0] * wz) +
+                      (gradXY[dy][dx][1] * wz) +
+                      (gradXY[dy][dx][2] * wDz));
                }
             }
          }
       }
-   });
+   }
 }
 
 // PA Diffusion Apply 3D kernel
@@ -344,172 +547,123 @@ void PAVectorDiffusionApply3D(const int NE,
    auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, VDIM, NE);
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      for (int c = 0; c < VDIM; ++ c)
+      PAVectorDiffusionApply3DElement<T_D1D,T_Q1D>(e, B, G, Bt, Gt, op, x, y,
+                                                   d1d, q1d);
+   });
+}
+
+#ifdef MFEM_PA_SIMD
+// PA Diffusion Apply 2D kernel with PA_SIMD_SIZE elements in the SIMD lanes
+template<int T_D1D, int T_Q1D, int T_VDIM>
+static void PAVectorDiffusionApply2DSimd(const int NE,
+                                         const Array<double> &b,
+                                         const Array<double> &g,
+                                         const Array<double> &bt,
+                                         const Array<double> &gt,
+                                         const Vector &d_,
+                                         const Vector &x_,
+                                         Vector &y_)
+{
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int VDIM = T_VDIM;
+   const auto B = Reshape(b.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g.HostRead(), Q1D, D1D);
+   const auto Bt = Reshape(bt.HostRead(), D1D, Q1D);
+   const auto Gt = Reshape(gt.HostRead(), D1D, Q1D);
+   PASimdApply<Q1D*Q1D*3, D1D*D1D*VDIM, D1D*D1D*VDIM>(
+      NE, d_, x_, y_, [&](const pa_simd_t *d, const pa_simd_t *x, pa_simd_t *y)
+   {
+      const auto D = Reshape(d, Q1D*Q1D, 3, 1);
+      const auto X = Reshape(x, D1D, D1D, VDIM, 1);
+      const auto Y = Reshape(y, D1D, D1D, VDIM, 1);
+      PAVectorDiffusionApply2DElement<D1D,Q1D,VDIM,pa_simd_t>(
+         0, B, G, Bt, Gt, D, X, Y, D1D, Q1D, VDIM);
+   });
+}
+
+// PA Diffusion Apply 3D kernel with PA_SIMD_SIZE elements in the SIMD lanes
+template<int T_D1D, int T_Q1D>
+static void PAVectorDiffusionApply3DSimd(const int NE,
+                                         const Array<double> &b,
+                                         const Array<double> &g,
+                                         const Array<double> &bt,
+                                         const Array<double> &gt,
+                                         const Vector &op_,
+                                         const Vector &x_,
+                                         Vector &y_)
+{
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   const auto B = Reshape(b.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g.HostRead(), Q1D, D1D);
+   const auto Bt = Reshape(bt.HostRead(), D1D, Q1D);
+   const auto Gt = Reshape(gt.HostRead(), D1D, Q1D);
+   PASimdApply<Q1D*Q1D*Q1D*6, D1D*D1D*D1D*3, D1D*D1D*D1D*3>(
+      NE, op_, x_, y_, [&](const pa_simd_t *d, const pa_simd_t *x, pa_simd_t *y)
+   {
+      const auto op = Reshape(d, Q1D*Q1D*Q1D, 6, 1);
+      const auto X = Reshape(x, D1D, D1D, D1D, 3, 1);
+      const auto Y = Reshape(y, D1D, D1D, D1D, 3, 1);
+      PAVectorDiffusionApply3DElement<D1D,Q1D,pa_simd_t>(
+         0, B, G, Bt, Gt, op, X, Y, D1D, Q1D);
+   });
+}
+
+// Returns false if there is no SIMD kernel for the given dimensions and sizes
+static bool PAVectorDiffusionApplySimd(const int dim,
+                                       const int sdim,
+                                       const int D1D,
+                                       const int Q1D,
+                                       const int NE,
+                                       const Array<double> &B,
+                                       const Array<double> &G,
+                                       const Array<double> &Bt,
+                                       const Array<double> &Gt,
+                                       const Vector &D,
+                                       const Vector &x,
+                                       Vector &y)
+{
+   const int ID = (D1D << 4) | Q1D;
+   if (dim == 2 && sdim == 2)
+   {
+      switch (ID)
       {
-         double grad[max_Q1D][max_Q1D][max_Q1D][3];
-         for (int qz = 0; qz < Q1D; ++qz)
-         {
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  grad[qz][qy][qx][0] = 0.0;
-                  grad[qz][qy][qx][1] = 0.0;
-                  grad[qz][qy][qx][2] = 0.0;
-               }
-            }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            double gradXY[max_Q1D][max_Q1D][3];
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  gradXY[qy][qx][0] = 0.0;
-                  gradXY[qy][qx][1] = 0.0;
-                  gradXY[qy][qx][2] = 0.0;
-               }
-            }
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               double gradX[max_Q1D][2];
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  gradX[qx][0] = 0.0;
-                  gradX[qx][1] = 0.0;
-               }
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  const double s = x(dx,dy,dz,c,e);
-                  for (int qx = 0; qx < Q1D; ++qx)
-                  {
-                     gradX[qx][0] += s * B(qx,dx);
-                     gradX[qx][1] += s * G(qx,dx);
-                  }
-               }
-               for (int qy = 0; qy < Q1D; ++qy)
-               {
-                  const double wy  = B(qy,dy);
-                  const double wDy = G(qy,dy);
-                  for (int qx = 0; qx < Q1D; ++qx)
-                  {
-                     const double wx  = gradX[qx][0];
-                     const double wDx = gradX[qx][1];
-                     gradXY[qy][qx][0] += wDx * wy;
-                     gradXY[qy][qx][1] += wx  * wDy;
-                     gradXY[qy][qx][2] += wx  * wy;
-                  }
-               }
-            }
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               const double wz  = B(qz,dz);
-               const double wDz = G(qz,dz);
-               for (int qy = 0; qy < Q1D; ++qy)
-               {
-                  for (int qx = 0; qx < Q1D; ++qx)
-                  {
-                     grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
-                     grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
-                     grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
-                  }
-               }
-            }
-         }
-         // Calculate Dxyz, xDyz, xyDz in plane
-         for (int qz = 0; qz < Q1D; ++qz)
-         {
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  const int q = qx + (qy + qz * Q1D) * Q1D;
-                  const double O11 = op(q,0,e);
-                  const double O12 = op(q,1,e);
-                  const double O13 = op(q,2,e);
-                  const double O22 = op(q,3,e);
-                  const double O23 = op(q,4,e);
-                  const double O33 = op(q,5,e);
-                  const double gradX = grad[qz][qy][qx][0];
-                  const double gradY = grad[qz][qy][qx][1];
-                  const double gradZ = grad[qz][qy][qx][2];
-                  grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
-                  grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
-                  grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
-               }
-            }
-         }
-         for (int qz = 0; qz < Q1D; ++qz)
-         {
-            double gradXY[max_D1D][max_D1D][3];
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  gradXY[dy][dx][0] = 0;
-                  gradXY[dy][dx][1] = 0;
-                  gradXY[dy][dx][2] = 0;
-               }
-            }
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               double gradX[max_D1D][3];
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  gradX[dx][0] = 0;
-                  gradX[dx][1] = 0;
-                  gradX[dx][2] = 0;
-               }
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  const double gX = grad[qz][qy][qx][0];
-                  const double gY = grad[qz][qy][qx][1];
-                  const double gZ = grad[qz][qy][qx][2];
-                  for (int dx = 0; dx < D1D; ++dx)
-                  {
-                     const double wx  = Bt(dx,qx);
-                     const double wDx = Gt(dx,qx);
-                     gradX[dx][0] += gX * wDx;
-                     gradX[dx][1] += gY * wx;
-                     gradX[dx][2] += gZ * wx;
-                  }
-               }
-               for (int dy = 0; dy < D1D; ++dy)
-               {
-                  const double wy  = Bt(dy,qy);
-                  const double wDy = Gt(dy,qy);
-                  for (int dx = 0; dx < D1D; ++dx)
-                  {
-                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
-                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
-                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
-                  }
-               }
-            }
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               const double wz  = Bt(dz,qz);
-               const double wDz = Gt(dz,qz);
-               for (int dy = 0; dy < D1D; ++dy)
-               {
-                  for (int dx = 0; dx < D1D; ++dx)
-                  {
-                     y(dx,dy,dz,c,e) +=
-                        ((gradXY[dy][dx][0] * wz) +
-                         (gradXY[dy][dx][1] * wz) +
-                         (gradXY[dy][dx][2] * wDz));
-                  }
-               }
-            }
-         }
+         case 0x22: PAVectorDiffusionApply2DSimd<2,2,2>(NE,B,G,Bt,Gt,D,x,y); break;
+         case 0x33: PAVectorDiffusionApply2DSimd<3,3,2>(NE,B,G,Bt,Gt,D,x,y); break;
+         case 0x44: PAVectorDiffusionApply2DSimd<4,4,2>(NE,B,G,Bt,Gt,D,x,y); break;
+         case 0x55: PAVectorDiffusionApply2DSimd<5,5,2>(NE,B,G,Bt,Gt,D,x,y); break;
+         default: return false;
       }
-   });
+      return true;
+   }
+   if (dim == 2 && sdim == 3)
+   {
+      switch (ID)
+      {
+         case 0x22: PAVectorDiffusionApply2DSimd<2,2,3>(NE,B,G,Bt,Gt,D,x,y); break;
+         case 0x33: PAVectorDiffusionApply2DSimd<3,3,3>(NE,B,G,Bt,Gt,D,x,y); break;
+         case 0x44: PAVectorDiffusionApply2DSimd<4,4,3>(NE,B,G,Bt,Gt,D,x,y); break;
+         case 0x55: PAVectorDiffusionApply2DSimd<5,5,3>(NE,B,G,Bt,Gt,D,x,y); break;
+         default: return false;
+      }
+      return true;
+   }
+   if (dim == 3 && sdim == 3)
+   {
+      switch (ID)
+      {
+         case 0x23: PAVectorDiffusionApply3DSimd<2,3>(NE,B,G,Bt,Gt,D,x,y); break;
+         case 0x34: PAVectorDiffusionApply3DSimd<3,4>(NE,B,G,Bt,Gt,D,x,y); break;
+         case 0x45: PAVectorDiffusionApply3DSimd<4,5>(NE,B,G,Bt,Gt,D,x,y); break;
+         case 0x56: PAVectorDiffusionApply3DSimd<5,6>(NE,B,G,Bt,Gt,D,x,y); break;
+         default: return false;
+      }
+      return true;
+   }
+   return false;
 }
+#endif // MFEM_PA_SIMD
 
 // PA Diffusion Apply kernel
 void VectorDiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
@@ -528,6 +682,13 @@ void VectorDiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
       const Array<double> &Gt = maps->Gt;
       const Vector &D = pa_data;
 
+#ifdef MFEM_PA_SIMD
+      if (DeviceCanUsePASimd() &&
+          PAVectorDiffusionApplySimd(dim,sdim,D1D,Q1D,ne,B,G,Bt,Gt,D,x,y))
+      {
+         return;
+      }
+#endif // MFEM_PA_SIMD
       if (dim == 2 && sdim == 3)
       {
          switch ((dofs1D << 4 ) | quad1D)
@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+
+namespace mfem
+{
+
+// The H(curl) and H(div) partial assembly kernels come in many variants
+// (scalar, diagonal and matrix coefficients, open and closed 1D bases per
+// component), so the element matrices are obtained by applying the PA action
+// to the unit E-vectors. The cost is one PA action per element dof, i.e.
+// O(p^(2d+1)) per element, as for a sum factorized element assembly.
+void BilinearFormIntegrator::AssembleEAFromPA(const FiniteElementSpace &fes,
+                                              Vector &ea_data,
+                                              const bool add) const
+{
+   const int ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const int nd = fes.GetFE(0)->GetDof();
+   Vector x(nd*ne), y(nd*ne);
+   x.UseDevice(true);
+   y.UseDevice(true);
+   for (int j = 0; j < nd; j++)
+   {
+      auto X = Reshape(x.Write(), nd, ne);
+      MFEM_FORALL(k, nd*ne,
+      {
+         const int i = k % nd;
+         X(i, k / nd) = (i == j) ? 1.0 : 0.0;
+      });
+      y = 0.0;
+      AddMultPA(x, y);
+      // The column j of the element matrices is the row j of the EA data, see
+      // EABilinearFormExtension::Mult().
+      const auto Y = Reshape(y.Read(), nd, ne);
+      auto A = Reshape(ea_data.ReadWrite(), nd, nd, ne);
+      MFEM_FORALL(k, nd*ne,
+      {
+         const int i = k % nd;
+         const int e = k / nd;
+         if (add)
+         {
+            A(j, i, e) += Y(i, e);
+         }
+         else
+         {
+            A(j, i, e) = Y(i, e);
+         }
+      });
+   }
+}
+
+void CurlCurlIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                    Vector &ea_data,
+                                    const bool add)
+{
+   AssemblePA(fes);
+   AssembleEAFromPA(fes, ea_data, add);
+}
+
+void VectorFEMassIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                        Vector &ea_data,
+                                        const bool add)
+{
+   AssemblePA(fes);
+   AssembleEAFromPA(fes, ea_data, add);
+}
+
+void DivDivIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                  Vector &ea_data,
+                                  const bool add)
+{
+   AssemblePA(fes);
+   AssembleEAFromPA(fes, ea_data, add);
+}
+
+}
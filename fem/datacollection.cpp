@@ -758,6 +758,384 @@ void VisItDataCollection::ParseVisItRootString(const std::string& json)
    }
 }
 
+#ifdef MFEM_USE_MPI
+
+// class CheckpointDataCollection implementation
+
+// Maximum number of bytes transferred by one rank in a single collective MPI-IO
+// call, so that the counts fit in an int.
+static const long long ckpt_max_chunk = 1LL << 30;
+
+// Return the number of collective calls needed to transfer 'size' bytes on
+// every rank of 'comm'.
+static int CheckpointNumChunks(MPI_Comm comm, long long size)
+{
+   int nchunks = (int) ((size + ckpt_max_chunk - 1)/ckpt_max_chunk), glob;
+   MPI_Allreduce(&nchunks, &glob, 1, MPI_INT, MPI_MAX, comm);
+   return glob;
+}
+
+// Read the size and the values of a field saved by SerializeLocalData().
+static bool ReadCheckpointValues(std::istream &is, Vector &v)
+{
+   const long long n = bin_io::read<long long>(is);
+   if (!is || n != v.Size()) { return false; }
+   is.read((char*) v.HostWrite(), n*sizeof(double));
+   return bool(is);
+}
+
+static void WriteCheckpointValues(std::ostream &os, const Vector &v)
+{
+   bin_io::write<long long>(os, v.Size());
+   os.write((const char*) v.HostRead(), v.Size()*sizeof(double));
+}
+
+CheckpointDataCollection::CheckpointDataCollection(
+   MPI_Comm comm, const std::string &collection_name, Mesh *mesh_)
+   : DataCollection(collection_name, mesh_), io_time(0.0), io_bytes(0)
+{
+   m_comm = comm;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &num_procs);
+   serial = false;
+   cycle = 0; // always include cycle in the file name
+}
+
+std::string CheckpointDataCollection::GetCheckpointFileName() const
+{
+   std::string fname = prefix_path + name;
+   if (cycle != -1)
+   {
+      fname += "_" + to_padded_string(cycle, pad_digits_cycle);
+   }
+   return fname + ".mfem_ckpt";
+}
+
+std::string CheckpointDataCollection::GetHeaderString() const
+{
+   std::ostringstream hdr;
+   hdr.precision(17);
+   hdr << "MFEM checkpoint v1.0\n"
+       << "ranks " << num_procs << '\n'
+       << "cycle " << cycle << '\n'
+       << "time " << time << '\n'
+       << "time_step " << time_step << '\n';
+
+   // Each field: FE collection name, vdim, ordering, field name.
+   hdr << "fields " << field_map.NumFields() << '\n';
+   for (FieldMapConstIterator it = field_map.begin(); it != field_map.end();
+        ++it)
+   {
+      const FiniteElementSpace *fes = it->second->FESpace();
+      hdr << fes->FEColl()->Name() << ' ' << fes->GetVDim() << ' '
+          << fes->GetOrdering() << ' ' << it->first << '\n';
+   }
+
+   // Each q-field: vdim, q-field name, QuadratureSpace description.
+   hdr << "qfields " << q_field_map.NumFields() << '\n';
+   for (QFieldMapConstIterator it = q_field_map.begin();
+        it != q_field_map.end(); ++it)
+   {
+      hdr << it->second->GetVDim() << ' ' << it->first << '\n';
+      it->second->GetSpace()->Save(hdr);
+   }
+   hdr << "end_header\n";
+   return hdr.str();
+}
+
+void CheckpointDataCollection::SerializeLocalData(std::string &block) const
+{
+   std::ostringstream mesh_os;
+   mesh_os.precision(17);
+   static_cast<const ParMesh*>(mesh)->ParPrint(mesh_os);
+   const std::string mesh_str = mesh_os.str();
+
+   std::ostringstream os(std::ios::out | std::ios::binary);
+   bin_io::write<long long>(os, mesh_str.size());
+   os.write(mesh_str.data(), mesh_str.size());
+   for (FieldMapConstIterator it = field_map.begin(); it != field_map.end();
+        ++it)
+   {
+      WriteCheckpointValues(os, *it->second);
+   }
+   for (QFieldMapConstIterator it = q_field_map.begin();
+        it != q_field_map.end(); ++it)
+   {
+      WriteCheckpointValues(os, *it->second);
+   }
+   block = os.str();
+}
+
+void CheckpointDataCollection::LoadLocalData(const std::string &header,
+                                             const std::string &block)
+{
+   std::istringstream hdr(header);
+   std::istringstream is(block, std::ios::in | std::ios::binary);
+   std::string ident;
+   int nranks, nfields, nqfields;
+
+   std::getline(hdr, ident); // MFEM checkpoint v1.0
+   hdr >> ident >> nranks;
+   hdr >> ident >> cycle >> ident >> time >> ident >> time_step;
+
+   const long long mesh_size = bin_io::read<long long>(is);
+   std::string mesh_str(mesh_size, '\0');
+   is.read(&mesh_str[0], mesh_size);
+   std::istringstream mesh_is(mesh_str);
+   ParMesh *pmesh = new ParMesh(m_comm, mesh_is);
+   mesh = pmesh;
+   own_data = true;
+
+   hdr >> ident >> nfields;
+   for (int i = 0; i < nfields; i++)
+   {
+      std::string fec_name, field_name;
+      int vdim, ordering;
+      hdr >> fec_name >> vdim >> ordering >> std::ws;
+      std::getline(hdr, field_name);
+
+      FiniteElementCollection *fec =
+         FiniteElementCollection::New(fec_name.c_str());
+      ParFiniteElementSpace *pfes =
+         new ParFiniteElementSpace(pmesh, fec, vdim, ordering);
+      ParGridFunction *gf = new ParGridFunction(pfes);
+      gf->MakeOwner(fec);
+      field_map.Register(field_name, gf, own_data);
+      if (!ReadCheckpointValues(is, *gf))
+      {
+         error = READ_ERROR;
+         MFEM_WARNING("Error reading field: " << field_name);
+         return;
+      }
+   }
+
+   hdr >> ident >> nqfields;
+   for (int i = 0; i < nqfields; i++)
+   {
+      std::string q_field_name;
+      int vdim;
+      hdr >> vdim >> std::ws;
+      std::getline(hdr, q_field_name);
+
+      QuadratureSpace *qspace = new QuadratureSpace(mesh, hdr);
+      QuadratureFunction *qf = new QuadratureFunction(qspace, vdim);
+      qf->SetOwnsSpace(true);
+      q_field_map.Register(q_field_name, qf, own_data);
+      if (!ReadCheckpointValues(is, *qf))
+      {
+         error = READ_ERROR;
+         MFEM_WARNING("Error reading q-field: " << q_field_name);
+         return;
+      }
+   }
+}
+
+void CheckpointDataCollection::Save()
+{
+   MFEM_VERIFY(dynamic_cast<ParMesh*>(mesh) != NULL,
+               "CheckpointDataCollection requires a ParMesh");
+   MFEM_VERIFY(mesh->Conforming() && mesh->NURBSext == NULL,
+               "nonconforming and NURBS meshes are not supported");
+
+   error = NO_ERROR;
+   if (!prefix_path.empty() && create_directory(prefix_path, mesh, myid))
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error creating directory: " << prefix_path);
+      return;
+   }
+
+   StopWatch sw;
+   MPI_Barrier(m_comm);
+   sw.Start();
+
+   std::string block;
+   SerializeLocalData(block);
+   long long my_size = block.size();
+
+   // Rank 0 writes the header, followed by the (offset, size) of every block.
+   std::string header;
+   long long header_size = 0;
+   if (myid == 0)
+   {
+      header = GetHeaderString();
+      header_size = header.size() + 2*sizeof(long long)*num_procs;
+   }
+   MPI_Bcast(&header_size, 1, MPI_LONG_LONG, 0, m_comm);
+
+   long long my_offset = 0;
+   MPI_Exscan(&my_size, &my_offset, 1, MPI_LONG_LONG, MPI_SUM, m_comm);
+   if (myid == 0) { my_offset = 0; }
+   my_offset += header_size;
+
+   long long my_entry[2] = { my_offset, my_size };
+   std::vector<long long> index(myid == 0 ? 2*num_procs : 0);
+   MPI_Gather(my_entry, 2, MPI_LONG_LONG, index.data(), 2, MPI_LONG_LONG, 0,
+              m_comm);
+
+   const std::string fname = GetCheckpointFileName();
+   MPI_File fh;
+   int err = MPI_File_open(m_comm, const_cast<char*>(fname.c_str()),
+                           MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                           &fh);
+   if (err != MPI_SUCCESS)
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error opening checkpoint file: " << fname);
+      return;
+   }
+   err = MPI_File_set_size(fh, 0); // truncate a previous checkpoint
+   if (myid == 0)
+   {
+      header.append((const char*) index.data(), index.size()*sizeof(long long));
+      err |= MPI_File_write_at(fh, 0, &header[0], (int) header.size(),
+                               MPI_BYTE, MPI_STATUS_IGNORE);
+   }
+   const int nchunks = CheckpointNumChunks(m_comm, my_size);
+   for (int c = 0; c < nchunks; c++)
+   {
+      const long long beg = std::min(c*ckpt_max_chunk, my_size);
+      const int count = (int) std::min(ckpt_max_chunk, my_size - beg);
+      err |= MPI_File_write_at_all(fh, (MPI_Offset) (my_offset + beg),
+                                   &block[0] + beg, count, MPI_BYTE,
+                                   MPI_STATUS_IGNORE);
+   }
+   err |= MPI_File_close(&fh);
+
+   int loc_err = (err != MPI_SUCCESS), glob_err;
+   MPI_Allreduce(&loc_err, &glob_err, 1, MPI_INT, MPI_MAX, m_comm);
+   if (glob_err)
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error writing checkpoint file: " << fname);
+   }
+
+   sw.Stop();
+   double my_time = sw.RealTime();
+   MPI_Allreduce(&my_time, &io_time, 1, MPI_DOUBLE, MPI_MAX, m_comm);
+   MPI_Allreduce(&my_size, &io_bytes, 1, MPI_LONG_LONG, MPI_SUM, m_comm);
+   io_bytes += header_size;
+}
+
+void CheckpointDataCollection::Load(int cycle_)
+{
+   DeleteAll();
+   time_step = 0.0;
+   error = NO_ERROR;
+   cycle = cycle_;
+
+   StopWatch sw;
+   MPI_Barrier(m_comm);
+   sw.Start();
+
+   // Rank 0 reads the header and the index, and distributes them.
+   const std::string fname = GetCheckpointFileName();
+   std::string header;
+   std::vector<long long> index;
+   long long info[2] = { -1, 0 }; // header text size, number of ranks
+   if (myid == 0)
+   {
+      std::ifstream ifs(fname.c_str(), std::ios::in | std::ios::binary);
+      std::string line;
+      int nranks = 0;
+      std::getline(ifs, line);
+      if (ifs && line == "MFEM checkpoint v1.0")
+      {
+         header = line + '\n';
+         while (std::getline(ifs, line))
+         {
+            header += line + '\n';
+            if (line.compare(0, 6, "ranks ") == 0)
+            {
+               nranks = to_int(line.substr(6));
+            }
+            if (line == "end_header") { break; }
+         }
+         index.resize(2*nranks);
+         ifs.read((char*) index.data(), index.size()*sizeof(long long));
+      }
+      if (ifs && nranks > 0)
+      {
+         info[0] = header.size();
+         info[1] = nranks;
+      }
+   }
+   MPI_Bcast(info, 2, MPI_LONG_LONG, 0, m_comm);
+   if (info[0] < 0)
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Error reading checkpoint file: " << fname);
+      return;
+   }
+   if (info[1] != num_procs)
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Processor number mismatch: checkpoint file: " << info[1]
+                   << ", MPI_comm: " << num_procs);
+      return;
+   }
+   header.resize(info[0]);
+   MPI_Bcast(&header[0], (int) info[0], MPI_CHAR, 0, m_comm);
+
+   long long my_entry[2];
+   MPI_Scatter(index.data(), 2, MPI_LONG_LONG, my_entry, 2, MPI_LONG_LONG, 0,
+               m_comm);
+   const long long my_offset = my_entry[0], my_size = my_entry[1];
+
+   std::string block(my_size, '\0');
+   MPI_File fh;
+   int err = MPI_File_open(m_comm, const_cast<char*>(fname.c_str()),
+                           MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+   if (err != MPI_SUCCESS)
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Error opening checkpoint file: " << fname);
+      return;
+   }
+   const int nchunks = CheckpointNumChunks(m_comm, my_size);
+   for (int c = 0; c < nchunks; c++)
+   {
+      const long long beg = std::min(c*ckpt_max_chunk, my_size);
+      const int count = (int) std::min(ckpt_max_chunk, my_size - beg);
+      err |= MPI_File_read_at_all(fh, (MPI_Offset) (my_offset + beg),
+                                  &block[0] + beg, count, MPI_BYTE,
+                                  MPI_STATUS_IGNORE);
+   }
+   err |= MPI_File_close(&fh);
+
+   int loc_err = (err != MPI_SUCCESS), glob_err;
+   MPI_Allreduce(&loc_err, &glob_err, 1, MPI_INT, MPI_MAX, m_comm);
+   if (glob_err)
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Error reading checkpoint file: " << fname);
+      return;
+   }
+
+   LoadLocalData(header, block);
+   loc_err = error;
+   MPI_Allreduce(&loc_err, &glob_err, 1, MPI_INT, MPI_MAX, m_comm);
+   if (glob_err)
+   {
+      error = READ_ERROR;
+      DeleteAll();
+   }
+
+   sw.Stop();
+   double my_time = sw.RealTime();
+   MPI_Allreduce(&my_time, &io_time, 1, MPI_DOUBLE, MPI_MAX, m_comm);
+   MPI_Allreduce(&my_size, &io_bytes, 1, MPI_LONG_LONG, MPI_SUM, m_comm);
+   io_bytes += info[0] + 2*sizeof(long long)*num_procs;
+}
+
+void CheckpointDataCollection::PrintIOStatistics(std::ostream &out) const
+{
+   if (myid != 0) { return; }
+   out << "Checkpoint I/O: " << io_bytes << " bytes in " << io_time
+       << " s, " << GetLastIOBandwidth()/1e6 << " MB/s" << std::endl;
+}
+#endif // MFEM_USE_MPI
+
 ParaViewDataCollection::ParaViewDataCollection(const std::string&
                                                collection_name,
                                                Mesh *mesh_)
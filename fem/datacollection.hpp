@@ -480,6 +480,80 @@ public:
 };
 
 
+#ifdef MFEM_USE_MPI
+/// Data collection for parallel checkpoint/restart using collective MPI-IO.
+/** All data of a cycle (the parallel mesh, all registered grid functions and
+    quadrature functions, plus the cycle, time and time step) is written to a
+    single shared binary file, "<prefix_path><name>_<cycle>.mfem_ckpt", instead
+    of one file per rank. The file starts with a short text header, written by
+    rank 0, followed by an index with the offset and size of the block of every
+    rank. The blocks are written and read with collective MPI-IO calls, so
+    aggregation into few large requests is left to the MPI library (e.g. via
+    the collective buffering hints of ROMIO).
+
+    Every rank stores its part of the mesh in the ParMesh::ParPrint() format
+    and the local degrees of freedom of the fields in binary, so a checkpoint
+    can be loaded only on the same number of ranks that wrote it, which gives
+    back the same partitioning without any redistribution. Currently, only
+    conforming, non-NURBS meshes are supported.
+
+    The duration and the total size of the last Save() or Load() are recorded
+    and can be queried with GetLastIOTime(), GetLastIOBytes() and
+    GetLastIOBandwidth(), or printed with PrintIOStatistics(). */
+class CheckpointDataCollection : public DataCollection
+{
+protected:
+   double io_time;      // max time over all ranks of the last Save()/Load()
+   long long io_bytes;  // total number of bytes in the last Save()/Load()
+
+   /// Return the name of the checkpoint file for the current cycle.
+   std::string GetCheckpointFileName() const;
+
+   /// Prepare the header describing the collection (used on rank 0).
+   std::string GetHeaderString() const;
+
+   /// Serialize the local part of the mesh and all fields into @a block.
+   void SerializeLocalData(std::string &block) const;
+
+   /** Parse the header in @a header and the local data in @a block, creating
+       the mesh and the fields. Sets #error on failure. */
+   void LoadLocalData(const std::string &header, const std::string &block);
+
+public:
+   /// Constructor. The collection name is used when saving the data.
+   /** The @a mesh_, if given, must be a ParMesh on the communicator @a comm.
+       Before loading the collection with Load(), some parameters in the
+       collection can be adjusted, e.g. SetPadDigits(), SetPrefixPath(), etc. */
+   CheckpointDataCollection(MPI_Comm comm, const std::string &collection_name,
+                            Mesh *mesh_ = NULL);
+
+   /// Write the collection into a single checkpoint file (collective).
+   virtual void Save();
+
+   /// Load the collection written by Save() for cycle @a cycle_ (collective).
+   /** The number of ranks in the communicator must be the same as when the
+       checkpoint was saved. */
+   virtual void Load(int cycle_ = 0);
+
+   /// Return the time (in seconds) spent in the last Save() or Load().
+   double GetLastIOTime() const { return io_time; }
+
+   /// Return the total number of bytes written/read in the last Save()/Load().
+   long long GetLastIOBytes() const { return io_bytes; }
+
+   /// Return the bandwidth (in bytes/second) of the last Save() or Load().
+   double GetLastIOBandwidth() const
+   { return (io_time > 0.0) ? io_bytes/io_time : 0.0; }
+
+   /// Print the size, time and bandwidth of the last Save() or Load().
+   /** Only rank 0 prints. */
+   void PrintIOStatistics(std::ostream &out = mfem::out) const;
+
+   virtual ~CheckpointDataCollection() {}
+};
+#endif
+
+
 /// Helper class for ParaView visualization data
 class ParaViewDataCollection : public DataCollection
 {
@@ -22,6 +22,7 @@
 #include "convergence.hpp"
 #include "lininteg.hpp"
 #include "nonlininteg.hpp"
+#include "nonlininteg_ad.hpp"
 #include "bilininteg.hpp"
 #include "fespace.hpp"
 #include "gridfunc.hpp"
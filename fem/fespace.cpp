@@ -894,8 +894,9 @@ int FiniteElementSpace::GetNConformingDofs() const
 const Operator *FiniteElementSpace::GetElementRestriction(
    ElementDofOrdering e_ordering) const
 {
-   // Check if we have a discontinuous space using the FE collection:
-   if (IsDGSpace())
+   // Check if we have a discontinuous space using the FE collection. On meshes
+   // with mixed element types, the general ElementRestriction is used.
+   if (IsDGSpace() && mesh->GetNumGeometries(mesh->Dimension()) <= 1)
    {
       if (L2E_nat.Ptr() == NULL)
       {
@@ -947,6 +948,18 @@ const Operator *FiniteElementSpace::GetFaceRestriction(
    }
 }
 
+const Operator *FiniteElementSpace::GetFaceNeighborRestriction(
+   FaceType type) const
+{
+   MFEM_VERIFY(IsDGSpace(), "only discontinuous spaces are supported");
+   OperatorHandle &res = (type == FaceType::Interior) ? L2FN_int : L2FN_bdr;
+   if (res.Ptr() == NULL)
+   {
+      res.Reset(new L2FaceNeighborRestriction(*this, type));
+   }
+   return res.Ptr();
+}
+
 const QuadratureInterpolator *FiniteElementSpace::GetQuadratureInterpolator(
    const IntegrationRule &ir) const
 {
@@ -2123,6 +2136,8 @@ void FiniteElementSpace::Destroy()
    Th.Clear();
    L2E_nat.Clear();
    L2E_lex.Clear();
+   L2FN_int.Clear();
+   L2FN_bdr.Clear();
    for (int i = 0; i < E2Q_array.Size(); i++)
    {
       delete E2Q_array[i];
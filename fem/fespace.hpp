@@ -133,6 +133,8 @@ protected:
 
    /// The element restriction operators, see GetElementRestriction().
    mutable OperatorHandle L2E_nat, L2E_lex;
+   /// The face neighbor restriction operators, see GetFaceNeighborRestriction().
+   mutable OperatorHandle L2FN_int, L2FN_bdr;
    /// The face restriction operators, see GetFaceRestriction().
    using key_face = std::tuple<bool, ElementDofOrdering, FaceType, L2FaceValues>;
    struct key_hash
@@ -358,6 +360,12 @@ public:
       ElementDofOrdering e_ordering, FaceType,
       L2FaceValues mul = L2FaceValues::DoubleValued) const;
 
+   /** @brief Return an Operator that converts L-vectors to E-vectors on each
+       face containing all the dofs of the neighboring elements. */
+   /** See L2FaceNeighborRestriction. Only discontinuous spaces are supported.
+       The returned Operator is owned by the FiniteElementSpace. */
+   virtual const Operator *GetFaceNeighborRestriction(FaceType type) const;
+
    /** @brief Return a QuadratureInterpolator that interpolates E-vectors to
        quadrature point values and/or derivatives (Q-vectors). */
    /** An E-vector represents the element-wise discontinuous version of the FE
@@ -980,9 +988,14 @@ public:
    virtual const Operator &BackwardOperator();
 };
 
+/// Return true if the elements of @a fes use tensor-product basis functions.
+/** Meshes with mixed element types always return false. For parallel spaces,
+    only the local elements are considered. */
 inline bool UsesTensorBasis(const FiniteElementSpace& fes)
 {
-   return dynamic_cast<const mfem::TensorBasisElement *>(fes.GetFE(0))!=nullptr;
+   const Mesh *mesh = fes.GetMesh();
+   return mesh->GetNumGeometries(mesh->Dimension()) <= 1 &&
+          dynamic_cast<const mfem::TensorBasisElement *>(fes.GetFE(0))!=nullptr;
 }
 
 }
@@ -0,0 +1,119 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "kernel_registry.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// State of the PAKernelTuning
+struct PAKernelTuningState
+{
+   bool enabled = false;
+   long sequence = 0;
+   int nrep = 3;
+   std::string cache_file;
+   std::map<std::string, std::string> selections;
+};
+
+static PAKernelTuningState &GetPAKernelTuningState()
+{
+   static PAKernelTuningState state;
+   return state;
+}
+
+} // namespace mfem::internal
+
+void PAKernelTuning::Enable(const char *cache_file)
+{
+   internal::PAKernelTuningState &state = internal::GetPAKernelTuningState();
+   state.enabled = true;
+   state.sequence++;
+   state.cache_file = cache_file ? cache_file : "";
+   if (!cache_file) { return; }
+   std::ifstream in(cache_file);
+   std::string line;
+   while (std::getline(in, line))
+   {
+      std::istringstream fields(line);
+      std::string registry, backend, variant;
+      int dim, d1d, q1d;
+      if (!(fields >> registry >> dim >> d1d >> q1d >> backend >> variant))
+      {
+         continue;
+      }
+      const std::string key = registry + " " + std::to_string(dim) + " " +
+                              std::to_string(d1d) + " " + std::to_string(q1d) +
+                              " " + backend;
+      state.selections[key] = variant;
+   }
+}
+
+void PAKernelTuning::Disable()
+{
+   internal::PAKernelTuningState &state = internal::GetPAKernelTuningState();
+   state.enabled = false;
+   state.cache_file.clear();
+}
+
+bool PAKernelTuning::IsEnabled()
+{
+   return internal::GetPAKernelTuningState().enabled;
+}
+
+void PAKernelTuning::Clear()
+{
+   internal::PAKernelTuningState &state = internal::GetPAKernelTuningState();
+   state.selections.clear();
+   state.sequence++;
+}
+
+long PAKernelTuning::GetSequence()
+{
+   return internal::GetPAKernelTuningState().sequence;
+}
+
+int PAKernelTuning::GetRepetitions()
+{
+   return internal::GetPAKernelTuningState().nrep;
+}
+
+void PAKernelTuning::SetRepetitions(int nrep)
+{
+   MFEM_VERIFY(nrep > 0, "invalid number of repetitions: " << nrep);
+   internal::GetPAKernelTuningState().nrep = nrep;
+}
+
+const char *PAKernelTuning::Find(const std::string &key)
+{
+   const internal::PAKernelTuningState &state =
+      internal::GetPAKernelTuningState();
+   auto it = state.selections.find(key);
+   return (it == state.selections.end()) ? NULL : it->second.c_str();
+}
+
+void PAKernelTuning::Store(const std::string &key, const std::string &variant)
+{
+   internal::PAKernelTuningState &state = internal::GetPAKernelTuningState();
+   state.selections[key] = variant;
+   if (state.cache_file.empty()) { return; }
+   std::ofstream out(state.cache_file, std::ios::app);
+   MFEM_VERIFY(out, "cannot write the kernel cache file " << state.cache_file);
+   out << key << ' ' << variant << '\n';
+}
+
+} // namespace mfem
@@ -0,0 +1,274 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_KERNEL_REGISTRY_HPP
+#define MFEM_KERNEL_REGISTRY_HPP
+
+#include "../config/config.hpp"
+#include "../general/backends.hpp"
+#include "../general/device.hpp"
+#include "../general/tic_toc.hpp"
+#include "../linalg/vector.hpp"
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief Autotuning of the partial assembly kernels registered in the
+    PAKernelRegistry%s.
+
+    When the autotuning is enabled, the first call of a registry for a given
+    dimension, number of 1D dofs and quadrature points, and Device backend,
+    times all the kernel variants registered for it and selects the fastest
+    one. The selections can be cached in a file, so that later runs skip the
+    timings. The lines of the file have the form
+
+        <registry> <dim> <D1D> <Q1D> <backend> <variant>
+
+    When the autotuning is disabled (the default), the variant registered first
+    is used, unless a selection for it was read from the cache file. */
+class PAKernelTuning
+{
+public:
+   /** @brief Enable the autotuning of the registered kernels. If @a cache_file
+       is not NULL, the previous selections are read from it, if it exists, and
+       the new selections are appended to it. */
+   static void Enable(const char *cache_file = NULL);
+
+   /// Disable the autotuning; the selections already made are kept.
+   static void Disable();
+
+   /// Return true if the autotuning is enabled.
+   static bool IsEnabled();
+
+   /** @brief Forget all selections, including the ones read from the cache
+       file. The cache file itself is not modified. */
+   static void Clear();
+
+   /** @brief Return a counter that is incremented every time the selections
+       may have changed. Used by the registries to invalidate their lookups. */
+   static long GetSequence();
+
+   /// Return the number of timed runs of each variant, default: 3.
+   static int GetRepetitions();
+
+   /// Set the number of timed runs of each variant.
+   static void SetRepetitions(int nrep);
+
+   /** @brief Return the cached selection for the given key, or NULL if there
+       is none. */
+   static const char *Find(const std::string &key);
+
+   /// Record the selection of @a variant for the given key.
+   static void Store(const std::string &key, const std::string &variant);
+};
+
+
+/** @brief Registry of partial assembly kernel specializations, keyed on the
+    dimension, the number of 1D dofs and 1D quadrature points, and the Device
+    backend.
+
+    Several variants (e.g. shared memory kernels with different batch sizes, or
+    the SIMD host kernels) can be registered for the same key. The variant that
+    is used is selected once per key and backend, see PAKernelTuning.
+
+    The kernels take the arguments @a Args... followed by the output E-vector,
+    to which they add their result. */
+template <typename... Args>
+class PAKernelRegistry
+{
+public:
+   typedef void (*Kernel)(Args..., Vector &);
+
+private:
+   typedef std::tuple<int,int,int> Key;
+   typedef std::tuple<int,int,int,int> BackendKey;
+
+   struct Variant
+   {
+      std::string name;
+      Kernel kernel;
+      unsigned long backends;
+   };
+
+   const std::string name;
+   std::map<Key, std::vector<Variant>> variants;
+   mutable std::map<BackendKey, int> selected;
+   mutable long sequence;
+
+   void Invalidate() const
+   {
+      const long seq = PAKernelTuning::GetSequence();
+      if (sequence != seq) { selected.clear(); sequence = seq; }
+   }
+
+   std::string TuningKey(int dim, int d1d, int q1d) const
+   {
+      return name + " " + std::to_string(dim) + " " + std::to_string(d1d) +
+             " " + std::to_string(q1d) + " " + Device::GetBackendName();
+   }
+
+   /// Time the variants @a ids and return the index of the fastest one.
+   int Tune(const std::vector<Variant> &vars, const std::vector<int> &ids,
+            Args... args, const Vector &y) const
+   {
+      const int nrep = PAKernelTuning::GetRepetitions();
+      const bool sync = Device::Allows(Backend::DEVICE_MASK);
+      Vector z(y.Size());
+      z.UseDevice(true);
+      z = 0.0;
+      int best = ids[0];
+      double best_time = 0.0;
+      for (int i : ids)
+      {
+         vars[i].kernel(args..., z); // warm-up
+         if (sync) { MFEM_DEVICE_SYNC; }
+         StopWatch sw;
+         sw.Start();
+         for (int r = 0; r < nrep; r++) { vars[i].kernel(args..., z); }
+         if (sync) { MFEM_DEVICE_SYNC; }
+         sw.Stop();
+         const double time = sw.RealTime();
+         if (i == ids[0] || time < best_time) { best = i; best_time = time; }
+      }
+      return best;
+   }
+
+public:
+   /// The @a name identifies the registry in the autotuning cache file.
+   explicit PAKernelRegistry(const char *name) : name(name), sequence(-1) { }
+
+   /// Return the name of the registry.
+   const std::string &GetName() const { return name; }
+
+   /** @brief Register the kernel @a kernel as the variant @a variant for the
+       given dimension and sizes. The kernel can only be used with the backends
+       in the mask @a backends, see Device::GetBackend(). A variant with the
+       same name replaces the one registered before. */
+   void Add(int dim, int d1d, int q1d, const std::string &variant,
+            Kernel kernel, unsigned long backends = ~0UL)
+   {
+      std::vector<Variant> &vars = variants[Key(dim, d1d, q1d)];
+      for (Variant &v : vars)
+      {
+         if (v.name == variant)
+         {
+            v.kernel = kernel;
+            v.backends = backends;
+            selected.clear();
+            return;
+         }
+      }
+      vars.push_back(Variant{variant, kernel, backends});
+      selected.clear();
+   }
+
+   /** @brief Return true if a kernel for the given dimension and sizes can be
+       used with the current Device backend. */
+   bool Has(int dim, int d1d, int q1d) const
+   {
+      auto it = variants.find(Key(dim, d1d, q1d));
+      if (it == variants.end()) { return false; }
+      for (const Variant &v : it->second)
+      {
+         if (v.backends & Device::GetBackend()) { return true; }
+      }
+      return false;
+   }
+
+   /** @brief Return the name of the variant selected for the given dimension
+       and sizes with the current Device backend, or NULL if no selection was
+       made yet. */
+   const char *GetSelection(int dim, int d1d, int q1d) const
+   {
+      Invalidate();
+      auto s = selected.find(BackendKey(dim, d1d, q1d, Device::GetBackend()));
+      if (s == selected.end()) { return NULL; }
+      return variants.at(Key(dim, d1d, q1d))[s->second].name.c_str();
+   }
+
+   /** @brief Apply the kernel selected for the given dimension and sizes.
+       Return false, without doing anything, if no kernel can be used. */
+   bool Run(int dim, int d1d, int q1d, Args... args, Vector &y) const
+   {
+      auto it = variants.find(Key(dim, d1d, q1d));
+      if (it == variants.end()) { return false; }
+      const std::vector<Variant> &vars = it->second;
+      Invalidate();
+      const Backend::Id backend = Device::GetBackend();
+      const BackendKey bkey(dim, d1d, q1d, backend);
+      auto s = selected.find(bkey);
+      if (s != selected.end())
+      {
+         vars[s->second].kernel(args..., y);
+         return true;
+      }
+      std::vector<int> ids;
+      for (int i = 0; i < (int) vars.size(); i++)
+      {
+         if (vars[i].backends & backend) { ids.push_back(i); }
+      }
+      if (ids.empty()) { return false; }
+      int id = ids[0];
+      const std::string tkey = TuningKey(dim, d1d, q1d);
+      const char *cached = PAKernelTuning::Find(tkey);
+      bool found = false;
+      if (cached)
+      {
+         for (int i : ids)
+         {
+            if (vars[i].name == cached) { id = i; found = true; break; }
+         }
+      }
+      if (!found && ids.size() > 1 && PAKernelTuning::IsEnabled())
+      {
+         id = Tune(vars, ids, args..., y);
+         PAKernelTuning::Store(tkey, vars[id].name);
+      }
+      selected[bkey] = id;
+      vars[id].kernel(args..., y);
+      return true;
+   }
+};
+
+namespace internal
+{
+
+/** @brief Default number of elements per thread block of the shared memory 2D
+    partial assembly kernels with @a Q1D quadrature points in 1D. */
+constexpr int PAKernelDefaultNBZ(int Q1D)
+{
+   return Q1D <= 3 ? 16 : Q1D <= 5 ? 8 : Q1D <= 7 ? 4 : Q1D <= 9 ? 2 : 1;
+}
+
+/** @brief Number of elements per thread block of the shared memory 2D partial
+    assembly kernels: @a NBZ, or the default for @a Q1D if @a NBZ is 0. */
+constexpr int PAKernelNBZ(int Q1D, int NBZ)
+{
+   return NBZ ? NBZ : PAKernelDefaultNBZ(Q1D);
+}
+
+/** @brief The largest of 2 @a NBZ and @a NBZ, such that a 2D block of @a Q1D x
+    @a Q1D x NBZ threads has at most 1024 threads. */
+constexpr int PAKernelNBZx2(int Q1D, int NBZ)
+{
+   return 2*NBZ*Q1D*Q1D <= 1024 ? 2*NBZ : NBZ;
+}
+
+} // namespace mfem::internal
+
+} // namespace mfem
+
+#endif // MFEM_KERNEL_REGISTRY_HPP
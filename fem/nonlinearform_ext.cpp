@@ -84,6 +84,7 @@ PANonlinearFormExtension::Gradient::Gradient(const Vector &g,
    ge.UseDevice(true);
    ge.SetSize(elemR->Height(), Device::GetMemoryType());
    elemR->Mult(g, ge);
+   for (int i = 0; i < dnfi.Size(); ++i) { dnfi[i]->AssembleGradPA(ge, fes); }
 
    xe.UseDevice(true);
    xe.SetSize(elemR->Height(), Device::GetMemoryType());
@@ -95,6 +96,12 @@ PANonlinearFormExtension::Gradient::Gradient(const Vector &g,
    ze.SetSize(elemR->Height(), Device::GetMemoryType());
 }
 
+void PANonlinearFormExtension::Gradient::ReInit(const Vector &g)
+{
+   elemR->Mult(g, ge);
+   for (int i = 0; i < dnfi.Size(); ++i) { dnfi[i]->AssembleGradPA(ge, fes); }
+}
+
 void PANonlinearFormExtension::Gradient::Mult(const Vector &x, Vector &y) const
 {
    ze = x;
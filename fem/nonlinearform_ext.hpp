@@ -63,8 +63,9 @@ private:
       /// Assumes that @a x and @a y are ldof Vector%s.
       virtual void Mult(const Vector &x, Vector &y) const;
 
-      /// Assumes that @a g is an ldof Vector.
-      void ReInit(const Vector &g) { elemR->Mult(g, ge); }
+      /** @brief Update the state to @a g and re-assemble the gradient data of
+          the integrators. Assumes that @a g is an ldof Vector. */
+      void ReInit(const Vector &g);
 
       /// Assemble the diagonal of the gradient into the ldof Vector @a diag.
       virtual void AssembleDiagonal(Vector &diag) const;
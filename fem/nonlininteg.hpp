@@ -240,6 +240,8 @@ protected:
 
    inline void EvalCoeffs() const;
 
+   friend class HyperelasticNLFIntegrator; // for the PA quadrature data
+
 public:
    NeoHookeanModel(double _mu, double _K, double _g = 1.0)
       : mu(_mu), K(_K), g(_g), have_coeffs(false) { c_mu = c_K = c_g = NULL; }
@@ -281,9 +283,23 @@ private:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // PA extension
+   const FiniteElementSpace *fespace; ///< Not owned
+   const DofToQuad *maps;             ///< Not owned
+   const IntegrationRule *pa_ir;      ///< Not owned
+   int dim, ne, nq;
+   // Per quadrature point: Jrt (dim x dim), weight * det(Jtr), mu, K, g.
+   Vector pa_data;
+   // Per quadrature point Jpt at the state given to AssembleGradPA().
+   Vector pa_grad;
+   // Q-vector work space: Jpr, and then the quadrature point stress.
+   mutable Vector pa_qvec;
+
 public:
    /** @param[in] m  HyperelasticModel that will be integrated. */
-   HyperelasticNLFIntegrator(HyperelasticModel *m) : model(m) { }
+   HyperelasticNLFIntegrator(HyperelasticModel *m)
+      : model(m), fespace(NULL), maps(NULL), pa_ir(NULL),
+        dim(0), ne(0), nq(0) { }
 
    /** @brief Computes the integral of W(Jacobian(Trt)) over a target zone
        @param[in] el     Type of FiniteElement.
@@ -300,6 +316,28 @@ public:
    virtual void AssembleElementGrad(const FiniteElement &el,
                                     ElementTransformation &Ttr,
                                     const Vector &elfun, DenseMatrix &elmat);
+
+   using NonlinearFormIntegrator::AssemblePA;
+
+   /** @brief Partial assembly: store the target Jacobians, the quadrature
+       weights and the model parameters at all quadrature points.
+
+       Only the NeoHookeanModel and tensor product elements are currently
+       supported. The deformation gradients are computed on the fly with sum
+       factorization and the model is evaluated point-wise. */
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   /// Store the deformation gradients at the state @a x (an E-vector).
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   virtual double GetGridFunctionEnergyPA(const Vector &x) const;
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AddMultGradPA(const Vector &g,
+                              const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradDiagonalPA(const Vector &g, Vector &diag) const;
 };
 
 /** Hyperelastic incompressible Neo-Hookean integrator with the PK1 stress
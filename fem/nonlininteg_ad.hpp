@@ -0,0 +1,514 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_NONLININTEG_AD
+#define MFEM_NONLININTEG_AD
+
+#include "../config/config.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/dual.hpp"
+#include "nonlininteg.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+/** @brief Nonlinear form integrator defined by a point-wise residual, whose
+    gradient is computed with forward mode automatic differentiation.
+
+    The integrator represents the residual
+    @f[ R(u)(v) = \int_\Omega f_0(u, \nabla u) \cdot v
+                  + f_1(u, \nabla u) : \nabla v \, dx @f]
+    for a field u with @a VDIM components in @a DIM dimensions. Only the
+    point-wise functions f_0 and f_1 have to be provided, by the functor
+    @a QFunction, which must have a member
+    @code
+       template <typename T>
+       void operator()(ElementTransformation &Tr, const T *u, const T *du,
+                       T *f0, T *f1) const;
+    @endcode
+    where u[c] and du[c*DIM+d] are the values and the physical derivatives
+    d/dx_d of the components c of the field, and f0[c] and f1[c*DIM+d] are the
+    outputs, initialized to zero. The transformation @a Tr has its integration
+    point set, so that coefficients can be evaluated. The functor is called
+    with T = double, and with T = Dual<double,N> to compute the derivatives;
+    math functions should be called unqualified, see Dual.
+
+    From the residual, the integrator provides the element vector, the element
+    gradient matrix, and the partial assembly action, gradient action and
+    gradient diagonal. The derivatives of the residual at a point with respect
+    to the NI = VDIM*(DIM+1) values and reference derivatives of the field are
+    obtained with a single evaluation with Dual<double,NI> numbers. With
+    partial assembly, these NI x NI point Jacobians are stored by
+    AssembleGradPA(), and the gradient action and diagonal are device kernels.
+    The residual and the point Jacobians are evaluated on the host. */
+template <typename QFunction, int VDIM, int DIM>
+class ADNonlinearFormIntegrator : public NonlinearFormIntegrator
+{
+public:
+   /// Number of point-wise inputs and outputs
+   static constexpr int NI = VDIM*(DIM+1);
+
+   /// The dual number type used to compute the point Jacobians
+   typedef Dual<double,NI> ad_t;
+
+protected:
+   QFunction qf;
+
+#ifndef MFEM_THREAD_SAFE
+   Vector shape;
+   DenseMatrix dshape;
+#endif
+
+   // PA extension
+   const FiniteElementSpace *fespace; ///< Not owned
+   const IntegrationRule *pa_ir;      ///< Not owned
+   int ne, nd, nq;
+   Vector pa_B;    ///< Shape functions, nq x nd (lexicographic dofs)
+   Vector pa_G;    ///< Reference gradients, nq x DIM x nd
+   Vector pa_grad; ///< Point Jacobians, NI x NI x nq x ne
+
+   const IntegrationRule &GetRule(const FiniteElement &el,
+                                  ElementTransformation &Tr) const
+   {
+      if (IntRule) { return *IntRule; }
+      return IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + Tr.OrderW());
+   }
+
+   /** @brief Evaluate the residual at the integration point of @a Tr, with
+       the reference space inputs and outputs @a in and @a out.
+
+       The inputs are the values and the reference derivatives of the field,
+       in[c] and in[VDIM+c*DIM+d], the outputs are the weighted coefficients
+       of the test functions and of their reference derivatives. */
+   template <typename T>
+   void PointResidual(ElementTransformation &Tr, const T *in, T *out) const
+   {
+      const DenseMatrix &Jinv = Tr.InverseJacobian();
+      const double w = Tr.Weight() * Tr.GetIntPoint().weight;
+      T u[VDIM], du[VDIM*DIM], f0[VDIM], f1[VDIM*DIM];
+      for (int c = 0; c < VDIM; c++)
+      {
+         u[c] = in[c];
+         f0[c] = 0.0;
+         for (int d = 0; d < DIM; d++)
+         {
+            T du_cd = 0.0;
+            for (int e = 0; e < DIM; e++)
+            {
+               du_cd += in[VDIM + c*DIM + e] * Jinv(e,d);
+            }
+            du[c*DIM + d] = du_cd;
+            f1[c*DIM + d] = 0.0;
+         }
+      }
+      qf(Tr, static_cast<const T*>(u), static_cast<const T*>(du), f0, f1);
+      for (int c = 0; c < VDIM; c++)
+      {
+         out[c] = w * f0[c];
+         for (int e = 0; e < DIM; e++)
+         {
+            T f1_ce = 0.0;
+            for (int d = 0; d < DIM; d++)
+            {
+               f1_ce += f1[c*DIM + d] * Jinv(e,d);
+            }
+            out[VDIM + c*DIM + e] = w * f1_ce;
+         }
+      }
+   }
+
+   /** @brief Compute the residual @a out and its NI x NI Jacobian @a J
+       (column-major) at the integration point of @a Tr, see PointResidual(). */
+   void PointJacobian(ElementTransformation &Tr, const double *in,
+                      double *out, double *J) const
+   {
+      ad_t in_ad[NI], out_ad[NI];
+      for (int i = 0; i < NI; i++) { in_ad[i] = ad_t(in[i], i); }
+      PointResidual(Tr, static_cast<const ad_t*>(in_ad), out_ad);
+      for (int i = 0; i < NI; i++)
+      {
+         out[i] = out_ad[i].value;
+         for (int j = 0; j < NI; j++) { J[i + NI*j] = out_ad[i].grad[j]; }
+      }
+   }
+
+   void CheckElement(const FiniteElement &el, ElementTransformation &Tr) const
+   {
+      MFEM_VERIFY(el.GetDim() == DIM && Tr.GetSpaceDim() == DIM,
+                  "the dimension must be " << DIM);
+      MFEM_VERIFY(el.GetRangeType() == FiniteElement::SCALAR,
+                  "only scalar finite elements are supported");
+   }
+
+public:
+   ADNonlinearFormIntegrator(const QFunction &qf,
+                             const IntegrationRule *ir = NULL)
+      : NonlinearFormIntegrator(ir), qf(qf), fespace(NULL), pa_ir(NULL),
+        ne(0), nd(0), nq(0) { }
+
+   /// Return the point-wise residual functor.
+   QFunction &GetQFunction() { return qf; }
+
+   virtual void AssembleElementVector(const FiniteElement &el,
+                                      ElementTransformation &Tr,
+                                      const Vector &elfun, Vector &elvect)
+   {
+      CheckElement(el, Tr);
+      const int dof = el.GetDof();
+#ifdef MFEM_THREAD_SAFE
+      Vector shape;
+      DenseMatrix dshape;
+#endif
+      shape.SetSize(dof);
+      dshape.SetSize(dof, DIM);
+      elvect.SetSize(dof*VDIM);
+      elvect = 0.0;
+      const IntegrationRule &ir = GetRule(el, Tr);
+      double in[NI], out[NI];
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         Tr.SetIntPoint(&ip);
+         el.CalcShape(ip, shape);
+         el.CalcDShape(ip, dshape);
+         for (int c = 0; c < VDIM; c++)
+         {
+            const double *x = elfun.GetData() + c*dof;
+            in[c] = shape * x;
+            for (int d = 0; d < DIM; d++)
+            {
+               double s = 0.0;
+               for (int i = 0; i < dof; i++) { s += dshape(i,d) * x[i]; }
+               in[VDIM + c*DIM + d] = s;
+            }
+         }
+         PointResidual(Tr, static_cast<const double*>(in), out);
+         for (int c = 0; c < VDIM; c++)
+         {
+            double *y = elvect.GetData() + c*dof;
+            for (int i = 0; i < dof; i++)
+            {
+               double s = shape(i) * out[c];
+               for (int d = 0; d < DIM; d++)
+               {
+                  s += dshape(i,d) * out[VDIM + c*DIM + d];
+               }
+               y[i] += s;
+            }
+         }
+      }
+   }
+
+   virtual void AssembleElementGrad(const FiniteElement &el,
+                                    ElementTransformation &Tr,
+                                    const Vector &elfun, DenseMatrix &elmat)
+   {
+      CheckElement(el, Tr);
+      constexpr int D1 = DIM + 1;
+      const int dof = el.GetDof();
+#ifdef MFEM_THREAD_SAFE
+      Vector shape;
+      DenseMatrix dshape;
+#endif
+      shape.SetSize(dof);
+      dshape.SetSize(dof, DIM);
+      elmat.SetSize(dof*VDIM);
+      elmat = 0.0;
+      // phi(k,i): the value (k = 0) and the reference derivatives of the
+      // shape function i. JB(a,k,b,i): the Jacobian applied to phi(:,i).
+      DenseMatrix phi(D1, dof);
+      Vector JB(VDIM*D1*VDIM*dof);
+      const IntegrationRule &ir = GetRule(el, Tr);
+      double in[NI], out[NI], J[NI*NI];
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         Tr.SetIntPoint(&ip);
+         el.CalcShape(ip, shape);
+         el.CalcDShape(ip, dshape);
+         for (int i = 0; i < dof; i++)
+         {
+            phi(0,i) = shape(i);
+            for (int d = 0; d < DIM; d++) { phi(1+d,i) = dshape(i,d); }
+         }
+         for (int c = 0; c < VDIM; c++)
+         {
+            const double *x = elfun.GetData() + c*dof;
+            for (int k = 0; k < D1; k++)
+            {
+               double s = 0.0;
+               for (int i = 0; i < dof; i++) { s += phi(k,i) * x[i]; }
+               in[k ? VDIM + c*DIM + k-1 : c] = s;
+            }
+         }
+         PointJacobian(Tr, in, out, J);
+         // JB(a,k,b,j) = sum_l J(in(a,k), in(b,l)) phi(l,j)
+         for (int j = 0; j < dof; j++)
+         {
+            for (int b = 0; b < VDIM; b++)
+            {
+               for (int a = 0; a < VDIM; a++)
+               {
+                  for (int k = 0; k < D1; k++)
+                  {
+                     const int ak = k ? VDIM + a*DIM + k-1 : a;
+                     double s = 0.0;
+                     for (int l = 0; l < D1; l++)
+                     {
+                        const int bl = l ? VDIM + b*DIM + l-1 : b;
+                        s += J[ak + NI*bl] * phi(l,j);
+                     }
+                     JB[k + D1*(a + VDIM*(b + VDIM*j))] = s;
+                  }
+               }
+            }
+         }
+         // elmat(i+dof*a, j+dof*b) += sum_k phi(k,i) JB(a,k,b,j)
+         for (int b = 0; b < VDIM; b++)
+         {
+            for (int j = 0; j < dof; j++)
+            {
+               for (int a = 0; a < VDIM; a++)
+               {
+                  const double *jb = JB.GetData() + D1*(a + VDIM*(b + VDIM*j));
+                  double *A = elmat.GetData() + dof*(a + VDIM*(j + dof*b));
+                  for (int i = 0; i < dof; i++)
+                  {
+                     const double *phi_i = phi.GetColumn(i);
+                     double s = 0.0;
+                     for (int k = 0; k < D1; k++) { s += phi_i[k] * jb[k]; }
+                     A[i] += s;
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   using NonlinearFormIntegrator::AssemblePA;
+
+   /** @brief Partial assembly: store the shape functions and their reference
+       derivatives at the quadrature points. Only meshes with a single element
+       geometry are supported. */
+   virtual void AssemblePA(const FiniteElementSpace &fes)
+   {
+      fespace = &fes;
+      ne = fes.GetNE();
+      if (ne == 0) { return; }
+      MFEM_VERIFY(fes.GetVDim() == VDIM, "the space must have VDIM components");
+      const Mesh *mesh = fes.GetMesh();
+      MFEM_VERIFY(mesh->GetNumGeometries(mesh->Dimension()) == 1,
+                  "mixed meshes are not supported");
+      const FiniteElement &el = *fes.GetFE(0);
+      ElementTransformation &Tr = *fes.GetElementTransformation(0);
+      CheckElement(el, Tr);
+      pa_ir = &GetRule(el, Tr);
+      nd = el.GetDof();
+      nq = pa_ir->GetNPoints();
+      // The E-vectors have lexicographic dofs, see ElementRestriction
+      const TensorBasisElement *tbe =
+         dynamic_cast<const TensorBasisElement*>(&el);
+      const Array<int> *dof_map = tbe ? &tbe->GetDofMap() : NULL;
+      if (dof_map && dof_map->Size() == 0) { dof_map = NULL; }
+      Vector sh(nd);
+      DenseMatrix dsh(nd, DIM);
+      pa_B.SetSize(nq*nd);
+      pa_G.SetSize(nq*DIM*nd);
+      double *B = pa_B.HostWrite(), *G = pa_G.HostWrite();
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = pa_ir->IntPoint(q);
+         el.CalcShape(ip, sh);
+         el.CalcDShape(ip, dsh);
+         for (int i = 0; i < nd; i++)
+         {
+            const int n = dof_map ? (*dof_map)[i] : i;
+            B[q + nq*i] = sh(n);
+            for (int d = 0; d < DIM; d++) { G[q + nq*(d + DIM*i)] = dsh(n,d); }
+         }
+      }
+   }
+
+   /// The residual is evaluated on the host, element by element.
+   virtual void AddMultPA(const Vector &x, Vector &y) const
+   {
+      const double *X = x.HostRead();
+      double *Y = y.HostReadWrite();
+      const double *B = pa_B.HostRead(), *G = pa_G.HostRead();
+      double in[NI], out[NI];
+      for (int e = 0; e < ne; e++)
+      {
+         ElementTransformation &Tr = *fespace->GetElementTransformation(e);
+         for (int q = 0; q < nq; q++)
+         {
+            Tr.SetIntPoint(&pa_ir->IntPoint(q));
+            Interpolate(q, B, G, X + nd*VDIM*e, in);
+            PointResidual(Tr, static_cast<const double*>(in), out);
+            Integrate(q, B, G, out, Y + nd*VDIM*e);
+         }
+      }
+   }
+
+   /** @brief Compute and store the point Jacobians at the state @a x (an
+       E-vector), used by AddMultGradPA() and AssembleGradDiagonalPA(). */
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes)
+   {
+      if (fespace != &fes) { AssemblePA(fes); }
+      const double *X = x.HostRead();
+      const double *B = pa_B.HostRead(), *G = pa_G.HostRead();
+      pa_grad.SetSize(NI*NI*nq*ne, Device::GetDeviceMemoryType());
+      double *D = pa_grad.HostWrite();
+      double in[NI], out[NI];
+      for (int e = 0; e < ne; e++)
+      {
+         ElementTransformation &Tr = *fespace->GetElementTransformation(e);
+         for (int q = 0; q < nq; q++)
+         {
+            Tr.SetIntPoint(&pa_ir->IntPoint(q));
+            Interpolate(q, B, G, X + nd*VDIM*e, in);
+            PointJacobian(Tr, in, out, D + NI*NI*(q + nq*e));
+         }
+      }
+   }
+
+   virtual void AddMultGradPA(const Vector &g,
+                              const Vector &x, Vector &y) const
+   {
+      MFEM_CONTRACT_VAR(g);
+      constexpr int N = NI, VD = VDIM, DM = DIM;
+      const int ND = nd, NQ = nq;
+      const auto B = Reshape(pa_B.Read(), NQ, ND);
+      const auto G = Reshape(pa_G.Read(), NQ, DM, ND);
+      const auto D = Reshape(pa_grad.Read(), N, N, NQ, ne);
+      const auto X = Reshape(x.Read(), ND, VD, ne);
+      auto Y = Reshape(y.ReadWrite(), ND, VD, ne);
+      MFEM_FORALL(e, ne,
+      {
+         for (int q = 0; q < NQ; q++)
+         {
+            double in[N], out[N];
+            for (int c = 0; c < VD; c++)
+            {
+               double u = 0.0;
+               for (int i = 0; i < ND; i++) { u += B(q,i) * X(i,c,e); }
+               in[c] = u;
+               for (int d = 0; d < DM; d++)
+               {
+                  double du = 0.0;
+                  for (int i = 0; i < ND; i++) { du += G(q,d,i) * X(i,c,e); }
+                  in[VD + c*DM + d] = du;
+               }
+            }
+            for (int k = 0; k < N; k++)
+            {
+               double s = 0.0;
+               for (int l = 0; l < N; l++) { s += D(k,l,q,e) * in[l]; }
+               out[k] = s;
+            }
+            for (int c = 0; c < VD; c++)
+            {
+               for (int i = 0; i < ND; i++)
+               {
+                  double s = B(q,i) * out[c];
+                  for (int d = 0; d < DM; d++)
+                  {
+                     s += G(q,d,i) * out[VD + c*DM + d];
+                  }
+                  Y(i,c,e) += s;
+               }
+            }
+         }
+      });
+   }
+
+   virtual void AssembleGradDiagonalPA(const Vector &g, Vector &diag) const
+   {
+      MFEM_CONTRACT_VAR(g);
+      constexpr int N = NI, VD = VDIM, DM = DIM;
+      const int ND = nd, NQ = nq;
+      const auto B = Reshape(pa_B.Read(), NQ, ND);
+      const auto G = Reshape(pa_G.Read(), NQ, DM, ND);
+      const auto D = Reshape(pa_grad.Read(), N, N, NQ, ne);
+      auto Y = Reshape(diag.ReadWrite(), ND, VD, ne);
+      MFEM_FORALL(e, ne,
+      {
+         for (int c = 0; c < VD; c++)
+         {
+            for (int i = 0; i < ND; i++)
+            {
+               double s = 0.0;
+               for (int q = 0; q < NQ; q++)
+               {
+                  for (int k = 0; k <= DM; k++)
+                  {
+                     const int ck = k ? VD + c*DM + k-1 : c;
+                     const double phi_k = k ? G(q,k-1,i) : B(q,i);
+                     for (int l = 0; l <= DM; l++)
+                     {
+                        const int cl = l ? VD + c*DM + l-1 : c;
+                        const double phi_l = l ? G(q,l-1,i) : B(q,i);
+                        s += phi_k * D(ck,cl,q,e) * phi_l;
+                     }
+                  }
+               }
+               Y(i,c,e) += s;
+            }
+         }
+      });
+   }
+
+protected:
+   /// Interpolate the element dofs @a x at the point @a q, see PointResidual().
+   void Interpolate(const int q, const double *B, const double *G,
+                    const double *x, double *in) const
+   {
+      for (int c = 0; c < VDIM; c++)
+      {
+         const double *xc = x + nd*c;
+         double u = 0.0;
+         for (int i = 0; i < nd; i++) { u += B[q + nq*i] * xc[i]; }
+         in[c] = u;
+         for (int d = 0; d < DIM; d++)
+         {
+            double du = 0.0;
+            for (int i = 0; i < nd; i++)
+            {
+               du += G[q + nq*(d + DIM*i)] * xc[i];
+            }
+            in[VDIM + c*DIM + d] = du;
+         }
+      }
+   }
+
+   /// Add the contribution of the outputs @a out at the point @a q to @a y.
+   void Integrate(const int q, const double *B, const double *G,
+                  const double *out, double *y) const
+   {
+      for (int c = 0; c < VDIM; c++)
+      {
+         double *yc = y + nd*c;
+         for (int i = 0; i < nd; i++)
+         {
+            double s = B[q + nq*i] * out[c];
+            for (int d = 0; d < DIM; d++)
+            {
+               s += G[q + nq*(d + DIM*i)] * out[VDIM + c*DIM + d];
+            }
+            yc[i] += s;
+         }
+      }
+   }
+};
+
+} // namespace mfem
+
+#endif // MFEM_NONLININTEG_AD
@@ -0,0 +1,649 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
+#include "nonlininteg.hpp"
+#include "quadinterpolator.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// All dim x dim matrices below are stored column-major: A(i,j) = A[i+dim*j].
+// The quadrature point data, pa_data, is organized as (DIM*DIM+4, NQ, NE) with
+// the entries [Jrt, weight*det(Jtr), mu, K, g] at each point.
+
+// Point-wise Neo-Hookean model, see NeoHookeanModel::EvalW/EvalP/AssembleH.
+
+// Z = adj(F)^t, returns det(F).
+template<int DIM> MFEM_HOST_DEVICE inline
+double NeoHookeanAdjT(const double *F, double *Z)
+{
+   double Finv[DIM*DIM];
+   kernels::CalcInverse<DIM>(F, Finv);
+   const double J = kernels::Det<DIM>(F);
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         Z[i+DIM*j] = J*Finv[j+DIM*i];
+      }
+   }
+   return J;
+}
+
+template<int DIM> MFEM_HOST_DEVICE inline
+double NeoHookeanW(const double *F,
+                   const double mu, const double K, const double g)
+{
+   const double J = kernels::Det<DIM>(F);
+   double I1 = 0.0;
+   for (int i = 0; i < DIM*DIM; i++) { I1 += F[i]*F[i]; }
+   const double sJ = J/g;
+   const double bI1 = pow(J, -2.0/DIM)*I1;
+   return 0.5*(mu*(bI1 - DIM) + K*(sJ - 1.0)*(sJ - 1.0));
+}
+
+template<int DIM> MFEM_HOST_DEVICE inline
+void NeoHookeanP(const double *F,
+                 const double mu, const double K, const double g,
+                 double *P)
+{
+   double Z[DIM*DIM];
+   const double J = NeoHookeanAdjT<DIM>(F, Z);
+   double I1 = 0.0;
+   for (int i = 0; i < DIM*DIM; i++) { I1 += F[i]*F[i]; }
+   const double a = mu*pow(J, -2.0/DIM);
+   const double b = K*(J/g - 1.0)/g - a*I1/(DIM*J);
+   for (int i = 0; i < DIM*DIM; i++) { P[i] = a*F[i] + b*Z[i]; }
+}
+
+// Directional derivative dP = dP/dF(F) : dF.
+template<int DIM> MFEM_HOST_DEVICE inline
+void NeoHookeanDP(const double *F, const double *dF,
+                  const double mu, const double K, const double g,
+                  double *dP)
+{
+   double Z[DIM*DIM];
+   const double J = NeoHookeanAdjT<DIM>(F, Z);
+   double I1 = 0.0, dI1 = 0.0, tr = 0.0;
+   for (int i = 0; i < DIM*DIM; i++)
+   {
+      I1 += F[i]*F[i];
+      dI1 += 2.0*F[i]*dF[i];
+      tr += Z[i]*dF[i];
+   }
+   tr /= J; // dJ = J*tr
+   const double a = mu*pow(J, -2.0/DIM);
+   const double b = K*(J/g - 1.0)/g - a*I1/(DIM*J);
+   const double da = -(2.0/DIM)*a*tr;
+   const double db = K*J*tr/(g*g) - (da*I1 + a*dI1)/(DIM*J)
+                     + a*I1*tr/(DIM*J);
+   // dZ = tr Z - Z dF^t Z / J
+   double M[DIM*DIM];
+   for (int k = 0; k < DIM; k++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         double s = 0.0;
+         for (int l = 0; l < DIM; l++) { s += dF[l+DIM*k]*Z[l+DIM*j]; }
+         M[k+DIM*j] = s;
+      }
+   }
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         double ZM = 0.0;
+         for (int k = 0; k < DIM; k++) { ZM += Z[i+DIM*k]*M[k+DIM*j]; }
+         const int n = i+DIM*j;
+         const double dZ = tr*Z[n] - ZM/J;
+         dP[n] = da*F[n] + a*dF[n] + db*Z[n] + b*dZ;
+      }
+   }
+}
+
+// Compute the quadrature point data: Jrt = J^{-1}, weight*det(J) and the
+// constant model parameters.
+template<int DIM>
+static void HyperelasticSetup(const int NE, const int NQ,
+                              const double *w_, const double *j_,
+                              const double mu, const double K, const double g,
+                              double *d_)
+{
+   constexpr int DD = DIM*DIM;
+   auto W = Reshape(w_, NQ);
+   auto J = Reshape(j_, NQ, DIM, DIM, NE);
+   auto D = Reshape(d_, DD+4, NQ, NE);
+   MFEM_FORALL(i, NE*NQ,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Jtr[DD], Jrt[DD];
+      for (int r = 0; r < DIM; r++)
+      {
+         for (int d = 0; d < DIM; d++) { Jtr[r+DIM*d] = J(q,r,d,e); }
+      }
+      kernels::CalcInverse<DIM>(Jtr, Jrt);
+      for (int n = 0; n < DD; n++) { D(n,q,e) = Jrt[n]; }
+      D(DD,q,e) = W(q)*kernels::Det<DIM>(Jtr);
+      D(DD+1,q,e) = mu;
+      D(DD+2,q,e) = K;
+      D(DD+3,q,e) = g;
+   });
+}
+
+// Jpt = Jpr Jrt at the point (q,e), Jpr(c,r) = Q(c,r,q,e).
+template<int DIM> MFEM_HOST_DEVICE inline
+void HyperelasticJpt(const DeviceTensor<3,const double> &D,
+                     const DeviceTensor<4,const double> &Q,
+                     const int q, const int e, double *Jpt)
+{
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int d = 0; d < DIM; d++)
+      {
+         double s = 0.0;
+         for (int r = 0; r < DIM; r++) { s += Q(c,r,q,e)*D(r+DIM*d,q,e); }
+         Jpt[c+DIM*d] = s;
+      }
+   }
+}
+
+// Pr(c,r) = weight * P(c,d) Jrt(r,d), the stress pulled back to the reference
+// element, written in place of the derivatives in the Q-vector.
+template<int DIM> MFEM_HOST_DEVICE inline
+void HyperelasticPullBack(const DeviceTensor<3,const double> &D,
+                          const DeviceTensor<4,double> &Q,
+                          const int q, const int e, const double *P)
+{
+   const double w = D(DIM*DIM,q,e);
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int r = 0; r < DIM; r++)
+      {
+         double s = 0.0;
+         for (int d = 0; d < DIM; d++) { s += P[c+DIM*d]*D(r+DIM*d,q,e); }
+         Q(c,r,q,e) = w*s;
+      }
+   }
+}
+
+// Replace the reference gradients Jpr in the Q-vector with the pulled back
+// first Piola-Kirchhoff stress.
+template<int DIM>
+static void HyperelasticStress(const int NE, const int NQ,
+                               const double *d_, double *q_)
+{
+   constexpr int DD = DIM*DIM;
+   auto D = Reshape(d_, DD+4, NQ, NE);
+   auto Q = Reshape(q_, DIM, DIM, NQ, NE);
+   auto Qr = Reshape((const double*)q_, DIM, DIM, NQ, NE);
+   MFEM_FORALL(i, NE*NQ,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double F[DD], P[DD];
+      HyperelasticJpt<DIM>(D, Qr, q, e, F);
+      NeoHookeanP<DIM>(F, D(DD+1,q,e), D(DD+2,q,e), D(DD+3,q,e), P);
+      HyperelasticPullBack<DIM>(D, Q, q, e, P);
+   });
+}
+
+// Store Jpt at all quadrature points.
+template<int DIM>
+static void HyperelasticGradSetup(const int NE, const int NQ,
+                                  const double *d_, const double *q_,
+                                  double *f_)
+{
+   constexpr int DD = DIM*DIM;
+   auto D = Reshape(d_, DD+4, NQ, NE);
+   auto Q = Reshape(q_, DIM, DIM, NQ, NE);
+   auto F = Reshape(f_, DD, NQ, NE);
+   MFEM_FORALL(i, NE*NQ,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Jpt[DD];
+      HyperelasticJpt<DIM>(D, Q, q, e, Jpt);
+      for (int n = 0; n < DD; n++) { F(n,q,e) = Jpt[n]; }
+   });
+}
+
+// Replace the reference gradients of the direction in the Q-vector with the
+// pulled back stress increment dP(F; dF).
+template<int DIM>
+static void HyperelasticGradStress(const int NE, const int NQ,
+                                   const double *d_, const double *f_,
+                                   double *q_)
+{
+   constexpr int DD = DIM*DIM;
+   auto D = Reshape(d_, DD+4, NQ, NE);
+   auto F = Reshape(f_, DD, NQ, NE);
+   auto Q = Reshape(q_, DIM, DIM, NQ, NE);
+   auto Qr = Reshape((const double*)q_, DIM, DIM, NQ, NE);
+   MFEM_FORALL(i, NE*NQ,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Fq[DD], dF[DD], dP[DD];
+      for (int n = 0; n < DD; n++) { Fq[n] = F(n,q,e); }
+      HyperelasticJpt<DIM>(D, Qr, q, e, dF);
+      NeoHookeanDP<DIM>(Fq, dF, D(DD+1,q,e), D(DD+2,q,e), D(DD+3,q,e), dP);
+      HyperelasticPullBack<DIM>(D, Q, q, e, dP);
+   });
+}
+
+template<int DIM>
+static void HyperelasticEnergy(const int NE, const int NQ,
+                               const double *d_, const double *q_,
+                               double *en_)
+{
+   constexpr int DD = DIM*DIM;
+   auto D = Reshape(d_, DD+4, NQ, NE);
+   auto Q = Reshape(q_, DIM, DIM, NQ, NE);
+   auto E = Reshape(en_, NQ, NE);
+   MFEM_FORALL(i, NE*NQ,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double F[DD];
+      HyperelasticJpt<DIM>(D, Q, q, e, F);
+      E(q,e) = D(DD,q,e) *
+               NeoHookeanW<DIM>(F, D(DD+1,q,e), D(DD+2,q,e), D(DD+3,q,e));
+   });
+}
+
+// y(i,c) += sum_q sum_r DSh_r(i,q) Pr(c,r,q), with sum factorization.
+static void HyperelasticApplyGradT2D(const int NE,
+                                     const double *b_,
+                                     const double *g_,
+                                     const double *q_,
+                                     double *y_,
+                                     const int d1d,
+                                     const int q1d)
+{
+   const int D1D = d1d;
+   const int Q1D = q1d;
+   auto B = Reshape(b_, Q1D, D1D);
+   auto G = Reshape(g_, Q1D, D1D);
+   auto Q = Reshape(q_, 2, 2, Q1D, Q1D, NE);
+   auto Y = Reshape(y_, D1D, D1D, 2, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = d1d;
+      const int Q1D = q1d;
+      constexpr int MD1 = MAX_D1D;
+      for (int c = 0; c < 2; c++)
+      {
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            double a0[MD1], a1[MD1];
+            for (int dx = 0; dx < D1D; dx++)
+            {
+               a0[dx] = 0.0;
+               a1[dx] = 0.0;
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  a0[dx] += G(qx,dx)*Q(c,0,qx,qy,e);
+                  a1[dx] += B(qx,dx)*Q(c,1,qx,qy,e);
+               }
+            }
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               const double by = B(qy,dy), gy = G(qy,dy);
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  Y(dx,dy,c,e) += by*a0[dx] + gy*a1[dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+static void HyperelasticApplyGradT3D(const int NE,
+                                     const double *b_,
+                                     const double *g_,
+                                     const double *q_,
+                                     double *y_,
+                                     const int d1d,
+                                     const int q1d)
+{
+   const int D1D = d1d;
+   const int Q1D = q1d;
+   auto B = Reshape(b_, Q1D, D1D);
+   auto G = Reshape(g_, Q1D, D1D);
+   auto Q = Reshape(q_, 3, 3, Q1D, Q1D, Q1D, NE);
+   auto Y = Reshape(y_, D1D, D1D, D1D, 3, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = d1d;
+      const int Q1D = q1d;
+      constexpr int MD1 = 8;
+      for (int c = 0; c < 3; c++)
+      {
+         for (int qz = 0; qz < Q1D; qz++)
+         {
+            double b0[MD1][MD1], b1[MD1][MD1], b2[MD1][MD1];
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  b0[dy][dx] = b1[dy][dx] = b2[dy][dx] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               double a0[MD1], a1[MD1], a2[MD1];
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  a0[dx] = a1[dx] = a2[dx] = 0.0;
+                  for (int qx = 0; qx < Q1D; qx++)
+                  {
+                     a0[dx] += G(qx,dx)*Q(c,0,qx,qy,qz,e);
+                     a1[dx] += B(qx,dx)*Q(c,1,qx,qy,qz,e);
+                     a2[dx] += B(qx,dx)*Q(c,2,qx,qy,qz,e);
+                  }
+               }
+               for (int dy = 0; dy < D1D; dy++)
+               {
+                  const double by = B(qy,dy), gy = G(qy,dy);
+                  for (int dx = 0; dx < D1D; dx++)
+                  {
+                     b0[dy][dx] += by*a0[dx];
+                     b1[dy][dx] += gy*a1[dx];
+                     b2[dy][dx] += by*a2[dx];
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; dz++)
+            {
+               const double bz = B(qz,dz), gz = G(qz,dz);
+               for (int dy = 0; dy < D1D; dy++)
+               {
+                  for (int dx = 0; dx < D1D; dx++)
+                  {
+                     Y(dx,dy,dz,c,e) += bz*(b0[dy][dx] + b1[dy][dx]) +
+                                        gz*b2[dy][dx];
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// diag(i,c) += sum_q sum_{r,s} DSh_r(i,q) M_c(r,s,q) DSh_s(i,q), where
+// M_c(r,s) = weight * sum_{d,t} Jrt(r,d) dP(c,d)/dF(c,t) Jrt(s,t).
+template<int DIM>
+static void HyperelasticGradDiagonal(const int NE,
+                                     const double *b_,
+                                     const double *g_,
+                                     const double *d_,
+                                     const double *f_,
+                                     double *y_,
+                                     const int d1d,
+                                     const int q1d)
+{
+   constexpr int DD = DIM*DIM;
+   const int D1D = d1d;
+   const int Q1D = q1d;
+   const int ND = DIM == 2 ? D1D*D1D : D1D*D1D*D1D;
+   const int NQ = DIM == 2 ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   auto B = Reshape(b_, Q1D, D1D);
+   auto G = Reshape(g_, Q1D, D1D);
+   auto D = Reshape(d_, DD+4, NQ, NE);
+   auto F = Reshape(f_, DD, NQ, NE);
+   auto Y = Reshape(y_, ND, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         const int qx = q % Q1D;
+         const int qy = (q / Q1D) % Q1D;
+         const int qz = q / (Q1D*Q1D);
+         const double w = D(DD,q,e);
+         const double mu = D(DD+1,q,e), K = D(DD+2,q,e), g = D(DD+3,q,e);
+         double Fq[DD], dF[DD], dP[DD];
+         for (int n = 0; n < DD; n++) { Fq[n] = F(n,q,e); dF[n] = 0.0; }
+         double M[DIM][DIM][DIM];
+         for (int c = 0; c < DIM; c++)
+         {
+            double H[DIM][DIM];
+            for (int t = 0; t < DIM; t++)
+            {
+               dF[c+DIM*t] = 1.0;
+               NeoHookeanDP<DIM>(Fq, dF, mu, K, g, dP);
+               dF[c+DIM*t] = 0.0;
+               for (int d = 0; d < DIM; d++) { H[d][t] = dP[c+DIM*d]; }
+            }
+            for (int r = 0; r < DIM; r++)
+            {
+               for (int s = 0; s < DIM; s++)
+               {
+                  double m = 0.0;
+                  for (int d = 0; d < DIM; d++)
+                  {
+                     for (int t = 0; t < DIM; t++)
+                     {
+                        m += D(r+DIM*d,q,e)*H[d][t]*D(s+DIM*t,q,e);
+                     }
+                  }
+                  M[c][r][s] = w*m;
+               }
+            }
+         }
+         for (int i = 0; i < ND; i++)
+         {
+            const int dx = i % D1D;
+            const int dy = (i / D1D) % D1D;
+            const int dz = i / (D1D*D1D);
+            double DSh[DIM];
+            if (DIM == 2)
+            {
+               DSh[0] = G(qx,dx)*B(qy,dy);
+               DSh[1] = B(qx,dx)*G(qy,dy);
+            }
+            else
+            {
+               DSh[0] = G(qx,dx)*B(qy,dy)*B(qz,dz);
+               DSh[1] = B(qx,dx)*G(qy,dy)*B(qz,dz);
+               DSh[DIM-1] = B(qx,dx)*B(qy,dy)*G(qz,dz);
+            }
+            for (int c = 0; c < DIM; c++)
+            {
+               double s = 0.0;
+               for (int r = 0; r < DIM; r++)
+               {
+                  for (int t = 0; t < DIM; t++)
+                  {
+                     s += DSh[r]*M[c][r][t]*DSh[t];
+                  }
+               }
+               Y(i,c,e) += s;
+            }
+         }
+      }
+   });
+}
+
+void HyperelasticNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   NeoHookeanModel *nh = dynamic_cast<NeoHookeanModel *>(model);
+   MFEM_VERIFY(nh != NULL, "PA is only implemented for NeoHookeanModel!");
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   fespace = &fes;
+   MFEM_VERIFY(dim == 2 || dim == 3, "dim = " << dim << " is not supported!");
+   MFEM_VERIFY(fes.GetVDim() == dim, "A vector space with vdim = dim is"
+               " required!");
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   MFEM_VERIFY(dynamic_cast<const TensorBasisElement *>(&el) != NULL,
+               "Only tensor product elements are supported!");
+   pa_ir = IntRule ? IntRule :
+           &IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3);
+   nq = pa_ir->GetNPoints();
+   maps = &el.GetDofToQuad(*pa_ir, DofToQuad::TENSOR);
+   MFEM_VERIFY(maps->ndof <= (dim == 2 ? MAX_D1D : 8) &&
+               maps->nqpt <= (dim == 2 ? MAX_Q1D : 8),
+               "Orders or quadrature rules this high are not supported!");
+   const GeometricFactors *geom =
+      mesh->GetGeometricFactors(*pa_ir, GeometricFactors::JACOBIANS);
+
+   const int NE = ne;
+   const int NQ = nq;
+   const int DD = dim*dim;
+   pa_data.SetSize((DD+4)*NQ*NE, Device::GetMemoryType());
+   pa_qvec.SetSize(DD*NQ*NE, Device::GetMemoryType());
+   pa_grad.Destroy();
+   const double *W = pa_ir->GetWeights().Read();
+   const double *J = geom->J.Read();
+   double *D = pa_data.Write();
+   if (dim == 2)
+   {
+      HyperelasticSetup<2>(NE, NQ, W, J, nh->mu, nh->K, nh->g, D);
+   }
+   else
+   {
+      HyperelasticSetup<3>(NE, NQ, W, J, nh->mu, nh->K, nh->g, D);
+   }
+
+   if (nh->have_coeffs)
+   {
+      // General coefficients are evaluated on the host.
+      auto h_D = Reshape(pa_data.HostReadWrite(), DD+4, NQ, NE);
+      for (int e = 0; e < NE; e++)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < NQ; q++)
+         {
+            const IntegrationPoint &ip = pa_ir->IntPoint(q);
+            T.SetIntPoint(&ip);
+            h_D(DD+1,q,e) = nh->c_mu->Eval(T, ip);
+            h_D(DD+2,q,e) = nh->c_K->Eval(T, ip);
+            h_D(DD+3,q,e) = nh->c_g ? nh->c_g->Eval(T, ip) : 1.0;
+         }
+      }
+   }
+}
+
+void HyperelasticNLFIntegrator::AssembleGradPA(const Vector &x,
+                                               const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(fespace == &fes, "AssemblePA() must be called first!");
+   if (ne == 0) { return; }
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(*pa_ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->Derivatives(x, pa_qvec);
+   pa_grad.SetSize(dim*dim*nq*ne, Device::GetMemoryType());
+   const double *D = pa_data.Read();
+   const double *Q = pa_qvec.Read();
+   double *F = pa_grad.Write();
+   if (dim == 2) { HyperelasticGradSetup<2>(ne, nq, D, Q, F); }
+   else { HyperelasticGradSetup<3>(ne, nq, D, Q, F); }
+}
+
+double HyperelasticNLFIntegrator::GetGridFunctionEnergyPA(const Vector &x) const
+{
+   if (ne == 0) { return 0.0; }
+   const QuadratureInterpolator *qi = fespace->GetQuadratureInterpolator(*pa_ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->Derivatives(x, pa_qvec);
+   Vector energy(nq*ne, Device::GetMemoryType());
+   const double *D = pa_data.Read();
+   const double *Q = pa_qvec.Read();
+   double *E = energy.Write();
+   if (dim == 2) { HyperelasticEnergy<2>(ne, nq, D, Q, E); }
+   else { HyperelasticEnergy<3>(ne, nq, D, Q, E); }
+   return energy.Sum();
+}
+
+void HyperelasticNLFIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const QuadratureInterpolator *qi = fespace->GetQuadratureInterpolator(*pa_ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->Derivatives(x, pa_qvec);
+   const double *D = pa_data.Read();
+   double *Q = pa_qvec.ReadWrite();
+   const double *B = maps->B.Read();
+   const double *G = maps->G.Read();
+   double *Y = y.ReadWrite();
+   if (dim == 2)
+   {
+      HyperelasticStress<2>(ne, nq, D, Q);
+      HyperelasticApplyGradT2D(ne, B, G, Q, Y, maps->ndof, maps->nqpt);
+   }
+   else
+   {
+      HyperelasticStress<3>(ne, nq, D, Q);
+      HyperelasticApplyGradT3D(ne, B, G, Q, Y, maps->ndof, maps->nqpt);
+   }
+}
+
+void HyperelasticNLFIntegrator::AddMultGradPA(const Vector &g,
+                                              const Vector &x,
+                                              Vector &y) const
+{
+   MFEM_CONTRACT_VAR(g);
+   if (ne == 0) { return; }
+   MFEM_VERIFY(pa_grad.Size() == dim*dim*nq*ne,
+               "AssembleGradPA() must be called first!");
+   const QuadratureInterpolator *qi = fespace->GetQuadratureInterpolator(*pa_ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->Derivatives(x, pa_qvec);
+   const double *D = pa_data.Read();
+   const double *F = pa_grad.Read();
+   double *Q = pa_qvec.ReadWrite();
+   const double *B = maps->B.Read();
+   const double *G = maps->G.Read();
+   double *Y = y.ReadWrite();
+   if (dim == 2)
+   {
+      HyperelasticGradStress<2>(ne, nq, D, F, Q);
+      HyperelasticApplyGradT2D(ne, B, G, Q, Y, maps->ndof, maps->nqpt);
+   }
+   else
+   {
+      HyperelasticGradStress<3>(ne, nq, D, F, Q);
+      HyperelasticApplyGradT3D(ne, B, G, Q, Y, maps->ndof, maps->nqpt);
+   }
+}
+
+void HyperelasticNLFIntegrator::AssembleGradDiagonalPA(const Vector &g,
+                                                       Vector &diag) const
+{
+   MFEM_CONTRACT_VAR(g);
+   if (ne == 0) { return; }
+   MFEM_VERIFY(pa_grad.Size() == dim*dim*nq*ne,
+               "AssembleGradPA() must be called first!");
+   const double *B = maps->B.Read();
+   const double *G = maps->G.Read();
+   const double *D = pa_data.Read();
+   const double *F = pa_grad.Read();
+   double *Y = diag.ReadWrite();
+   const int D1D = maps->ndof, Q1D = maps->nqpt;
+   if (dim == 2)
+   {
+      HyperelasticGradDiagonal<2>(ne, B, G, D, F, Y, D1D, Q1D);
+   }
+   else
+   {
+      HyperelasticGradDiagonal<3>(ne, B, G, D, F, Y, D1D, Q1D);
+   }
+}
+
+} // namespace mfem
@@ -0,0 +1,105 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PA_SIMD_HPP
+#define MFEM_PA_SIMD_HPP
+
+#include "../config/config.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/simd.hpp"
+#include "../linalg/vector.hpp"
+
+// The host partial assembly kernels can process several elements at once, one
+// element in each lane of an AutoSIMD vector ("SIMD across elements"). This is
+// enabled when MFEM is configured with MFEM_USE_SIMD and the target holds at
+// least two doubles in a SIMD register, e.g. with AVX2 or AVX-512. The SIMD
+// width is the one selected by MFEM_SIMD_BYTES, see linalg/simd.hpp.
+#if defined(MFEM_USE_SIMD) && (MFEM_SIMD_BYTES > 8) && \
+    !defined(__CUDACC__) && !defined(__HIPCC__)
+#define MFEM_PA_SIMD
+#endif
+
+#ifdef MFEM_PA_SIMD
+
+namespace mfem
+{
+
+/// Number of elements processed together by the SIMD partial assembly kernels
+constexpr int PA_SIMD_SIZE = MFEM_SIMD_BYTES/sizeof(double);
+
+/// SIMD type holding one value of each of the PA_SIMD_SIZE elements of a batch
+typedef AutoSIMD<double,PA_SIMD_SIZE,MFEM_SIMD_BYTES> pa_simd_t;
+
+/** @brief Function that determines if the SIMD partial assembly kernels should
+    be used, based on the current mfem::Device configuration. */
+inline bool DeviceCanUsePASimd()
+{
+   return !Device::Allows(Backend::DEVICE_MASK | Backend::CEED_MASK |
+                          Backend::OCCA_MASK | Backend::RAJA_MASK);
+}
+
+/** @brief Apply an element kernel to the @a NE elements, PA_SIMD_SIZE elements
+    at a time.
+
+    The @a DS values of the quadrature data @a d_, the @a XS values of the input
+    E-vector @a x_ and the @a YS values of the output E-vector @a y_ of each
+    element are contiguous. For every batch of elements, these are interleaved
+    in local arrays of pa_simd_t, such that the lane l of the entry i holds the
+    i-th value of the l-th element of the batch, and the kernel is called as
+    kernel(d, x, y). The output of the kernel is added to @a y_. The lanes past
+    the last element are filled with zeros. The batches are distributed among
+    the OpenMP threads with Backend::OMP and among the ThreadPool threads with
+    Backend::THREADS. */
+template <int DS, int XS, int YS, typename KERNEL>
+inline void PASimdApply(const int NE, const Vector &d_, const Vector &x_,
+                        Vector &y_, KERNEL &&kernel)
+{
+   const double *D = d_.HostRead();
+   const double *X = x_.HostRead();
+   double *Y = y_.HostReadWrite();
+   const int NB = (NE + PA_SIMD_SIZE - 1) / PA_SIMD_SIZE;
+   auto batch = [&](const int b)
+   {
+      const int e0 = b * PA_SIMD_SIZE;
+      const int ne = NE - e0 < PA_SIMD_SIZE ? NE - e0 : PA_SIMD_SIZE;
+      pa_simd_t d[DS], x[XS], y[YS];
+      if (ne < PA_SIMD_SIZE)
+      {
+         for (int i = 0; i < DS; i++) { d[i] = 0.0; }
+         for (int i = 0; i < XS; i++) { x[i] = 0.0; }
+      }
+      for (int l = 0; l < ne; l++)
+      {
+         const double *De = D + DS*(e0 + l);
+         const double *Xe = X + XS*(e0 + l);
+         for (int i = 0; i < DS; i++) { d[i][l] = De[i]; }
+         for (int i = 0; i < XS; i++) { x[i][l] = Xe[i]; }
+      }
+      for (int i = 0; i < YS; i++) { y[i] = 0.0; }
+      kernel(d, x, y);
+      for (int l = 0; l < ne; l++)
+      {
+         double *Ye = Y + YS*(e0 + l);
+         for (int i = 0; i < YS; i++) { Ye[i] += y[i][l]; }
+      }
+   };
+#ifdef MFEM_USE_OPENMP
+   if (Device::Allows(Backend::OMP)) { return OmpWrap(NB, batch); }
+#endif
+   if (Device::Allows(Backend::THREADS)) { return ThreadPool::For(NB, batch); }
+   for (int b = 0; b < NB; b++) { batch(b); }
+}
+
+} // namespace mfem
+
+#endif // MFEM_PA_SIMD
+
+#endif // MFEM_PA_SIMD_HPP
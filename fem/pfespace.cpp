@@ -528,6 +528,18 @@ const Operator *ParFiniteElementSpace::GetFaceRestriction(
    }
 }
 
+const Operator *ParFiniteElementSpace::GetFaceNeighborRestriction(
+   FaceType type) const
+{
+   MFEM_VERIFY(IsDGSpace(), "only discontinuous spaces are supported");
+   OperatorHandle &res = (type == FaceType::Interior) ? L2FN_int : L2FN_bdr;
+   if (res.Ptr() == NULL)
+   {
+      res.Reset(new ParL2FaceNeighborRestriction(*this, type));
+   }
+   return res.Ptr();
+}
+
 void ParFiniteElementSpace::GetSharedEdgeDofs(
    int group, int ei, Array<int> &dofs) const
 {
@@ -3005,6 +3017,7 @@ ConformingProlongationOperator::ConformingProlongationOperator(
 
 void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("ConformingProlongationOperator::Mult");
    MFEM_ASSERT(x.Size() == Width(), "");
    MFEM_ASSERT(y.Size() == Height(), "");
 
@@ -3031,6 +3044,7 @@ void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
 void ConformingProlongationOperator::MultTranspose(
    const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("ConformingProlongationOperator::MultTranspose");
    MFEM_ASSERT(x.Size() == Height(), "");
    MFEM_ASSERT(y.Size() == Width(), "");
 
@@ -273,6 +273,11 @@ public:
       ElementDofOrdering e_ordering, FaceType type,
       L2FaceValues mul = L2FaceValues::DoubleValued) const;
 
+   /** Returns an Operator that gathers the dofs of the elements neighboring
+       each face. Shared faces are treated as interior faces, using the dofs of
+       the face-neighbor elements. */
+   virtual const Operator *GetFaceNeighborRestriction(FaceType type) const;
+
    void GetSharedEdgeDofs(int group, int ei, Array<int> &dofs) const;
    void GetSharedTriangleDofs(int group, int fi, Array<int> &dofs) const;
    void GetSharedQuadrilateralDofs(int group, int fi, Array<int> &dofs) const;
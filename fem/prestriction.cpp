@@ -448,6 +448,81 @@ void ParL2FaceRestriction::FillJAndData(const Vector &ea_data,
    });
 }
 
+ParL2FaceNeighborRestriction::ParL2FaceNeighborRestriction(
+   const ParFiniteElementSpace &fes, FaceType type)
+   : L2FaceNeighborRestriction(fes, type)
+{
+   if (type != FaceType::Interior || nf == 0) { return; }
+   // The base class leaves the second element of the shared faces unset; here
+   // it points to the face-neighbor dofs, shifted by ndofs.
+   int f_ind = 0;
+   Array<int> sharedDofs;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      int e1, e2, inf1, inf2;
+      fes.GetMesh()->GetFaceElements(f, &e1, &e2);
+      fes.GetMesh()->GetFaceInfos(f, &inf1, &inf2);
+      if (e2>=0 || (e2<0 && inf2>=0))
+      {
+         if (e2<0) // shared face
+         {
+            fes.GetFaceNbrElementVDofs(-1 - e2, sharedDofs);
+            for (int d = 0; d < elem_dofs; ++d)
+            {
+               indices2[elem_dofs*f_ind + d] = ndofs + sharedDofs[d];
+            }
+         }
+         f_ind++;
+      }
+   }
+   MFEM_VERIFY(f_ind==nf, "Unexpected number of faces.");
+}
+
+void ParL2FaceNeighborRestriction::Mult(const Vector &x, Vector &y) const
+{
+   const ParFiniteElementSpace &pfes =
+      static_cast<const ParFiniteElementSpace&>(this->fes);
+   ParGridFunction x_gf;
+   x_gf.MakeRef(const_cast<ParFiniteElementSpace*>(&pfes),
+                const_cast<Vector&>(x), 0);
+   x_gf.ExchangeFaceNbrData();
+
+   const int nd = elem_dofs;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int threshold = ndofs;
+   auto d_indices1 = indices1.Read();
+   auto d_indices2 = indices2.Read();
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_x_shared = Reshape(x_gf.FaceNbrData().Read(),
+                             t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.Write(), nd, vd, 2, nf);
+   MFEM_FORALL(i, nfdofs,
+   {
+      const int dof = i % nd;
+      const int face = i / nd;
+      const int idx1 = d_indices1[i];
+      const int idx2 = d_indices2[i];
+      for (int c = 0; c < vd; ++c)
+      {
+         d_y(dof, c, 0, face) = d_x(t?c:idx1, t?idx1:c);
+         if (idx2>-1 && idx2<threshold) // interior face
+         {
+            d_y(dof, c, 1, face) = d_x(t?c:idx2, t?idx2:c);
+         }
+         else if (idx2>=threshold) // shared face
+         {
+            d_y(dof, c, 1, face) = d_x_shared(t?c:(idx2-threshold),
+                                              t?(idx2-threshold):c);
+         }
+         else // true boundary
+         {
+            d_y(dof, c, 1, face) = 0.0;
+         }
+      }
+   });
+}
+
 } // namespace mfem
 
 #endif
@@ -43,6 +43,19 @@ public:
                      SparseMatrix &face_mat) const;
 };
 
+/** @brief Operator that extracts, for each face, all the degrees of freedom of
+    the elements sharing the face, in parallel. */
+/** On shared faces, the dofs of the face-neighbor element are obtained through
+    ParGridFunction::ExchangeFaceNbrData(). Objects of this type are typically
+    created and owned by ParFiniteElementSpace objects, see
+    FiniteElementSpace::GetFaceNeighborRestriction(). */
+class ParL2FaceNeighborRestriction : public L2FaceNeighborRestriction
+{
+public:
+   ParL2FaceNeighborRestriction(const ParFiniteElementSpace&, FaceType type);
+   void Mult(const Vector &x, Vector &y) const;
+};
+
 }
 
 #endif // MFEM_USE_MPI
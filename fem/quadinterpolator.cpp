@@ -47,6 +47,52 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
                "Only scalar finite elements are supported");
 }
 
+template<const int T_VDIM, const int T_ND, const int T_NQ>
+void QuadratureInterpolator::Eval1D(
+   const int NE,
+   const int vdim,
+   const DofToQuad &maps,
+   const Vector &e_vec,
+   Vector &q_val,
+   Vector &q_der,
+   Vector &q_det,
+   const int eval_flags)
+{
+   const int nd = maps.ndof;
+   const int nq = maps.nqpt;
+   const int ND = T_ND ? T_ND : nd;
+   const int NQ = T_NQ ? T_NQ : nq;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+   MFEM_VERIFY(VDIM == 1 || !(eval_flags & DETERMINANTS), "");
+   auto B = Reshape(maps.B.Read(), NQ, ND);
+   auto G = Reshape(maps.G.Read(), NQ, ND);
+   auto E = Reshape(e_vec.Read(), ND, VDIM, NE);
+   auto val = Reshape(q_val.Write(), NQ, VDIM, NE);
+   auto der = Reshape(q_der.Write(), NQ, VDIM, NE);
+   auto det = Reshape(q_det.Write(), NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int ND = T_ND ? T_ND : nd;
+      const int NQ = T_NQ ? T_NQ : nq;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      for (int q = 0; q < NQ; ++q)
+      {
+         for (int c = 0; c < VDIM; c++)
+         {
+            double ed = 0.0, dd = 0.0;
+            for (int d = 0; d < ND; ++d)
+            {
+               ed += B(q,d)*E(d,c,e);
+               dd += G(q,d)*E(d,c,e);
+            }
+            if (eval_flags & VALUES) { val(q,c,e) = ed; }
+            if (eval_flags & DERIVATIVES) { der(q,c,e) = dd; }
+            if (VDIM == 1 && (eval_flags & DETERMINANTS)) { det(q,e) = dd; }
+         }
+      }
+   });
+}
+
 template<const int T_VDIM, const int T_ND, const int T_NQ>
 void QuadratureInterpolator::Eval2D(
    const int NE,
@@ -268,7 +314,11 @@ void QuadratureInterpolator::Mult(
       Vector &q_der,
       Vector &q_det,
       const int eval_flags) = NULL;
-   if (vdim == 1)
+   if (dim == 1)
+   {
+      eval_func = (vdim == 1) ? &Eval1D<1> : &Eval1D<>;
+   }
+   else if (vdim == 1)
    {
       if (dim == 2)
       {
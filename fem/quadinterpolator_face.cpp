@@ -34,7 +34,11 @@ static void GetSigns(const FiniteElementSpace &fes, const FaceType type,
       if ( (type==FaceType::Interior && (e2>=0 || (e2<0 && inf2>=0))) ||
            (type==FaceType::Boundary && e2<0 && inf2<0) )
       {
-         if (dim==2)
+         if (dim==1)
+         {
+            signs[f_ind] = (face_id==0);
+         }
+         else if (dim==2)
          {
             if (face_id==2 || face_id==3)
             {
@@ -85,6 +89,39 @@ FaceQuadratureInterpolator::FaceQuadratureInterpolator(
                "FaceQuadratureInterpolator.");
 }
 
+void FaceQuadratureInterpolator::Eval1D(
+   const int NF,
+   const int vdim,
+   const DofToQuad &maps,
+   const Array<bool> &signs,
+   const Vector &f_vec,
+   Vector &q_val,
+   Vector &q_der,
+   Vector &q_det,
+   Vector &q_nor,
+   const int eval_flags)
+{
+   const int VDIM = vdim;
+   MFEM_VERIFY(maps.ndof == 1 && maps.nqpt == 1, "");
+   MFEM_VERIFY(VDIM == 1 || !(eval_flags & (DETERMINANTS | NORMALS)), "");
+   MFEM_VERIFY(!(eval_flags & DERIVATIVES),
+               "Derivatives on the faces are not yet supported.");
+   auto F = Reshape(f_vec.Read(), VDIM, NF);
+   auto sign = signs.Read();
+   auto val = Reshape(q_val.Write(), VDIM, NF);
+   auto det = Reshape(q_det.Write(), NF);
+   auto n   = Reshape(q_nor.Write(), NF);
+   MFEM_FORALL(f, NF,
+   {
+      if (eval_flags & VALUES)
+      {
+         for (int c = 0; c < VDIM; c++) { val(c,f) = F(c,f); }
+      }
+      if (eval_flags & DETERMINANTS) { det(f) = 1.0; }
+      if (eval_flags & NORMALS) { n(f) = sign[f] ? -1.0 : 1.0; }
+   });
+}
+
 template<const int T_VDIM, const int T_ND1D, const int T_NQ1D>
 void FaceQuadratureInterpolator::Eval2D(
    const int NF,
@@ -362,7 +399,9 @@ void FaceQuadratureInterpolator::Mult(
    const FiniteElement *fe =
       fespace->GetTraceElement(0, fespace->GetMesh()->GetFaceBaseGeometry(0));
    const IntegrationRule *ir = IntRule;
-   const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::TENSOR);
+   // In 1D, the trace element is a point and has no tensor maps
+   const DofToQuad &maps =
+      fe->GetDofToQuad(*ir, dim == 1 ? DofToQuad::FULL : DofToQuad::TENSOR);
    const int nd = maps.ndof;
    const int nq = maps.nqpt;
    void (*eval_func)(
@@ -376,7 +415,11 @@ void FaceQuadratureInterpolator::Mult(
       Vector &q_det,
       Vector &q_nor,
       const int eval_flags) = NULL;
-   if (vdim == 1)
+   if (dim == 1)
+   {
+      eval_func = &Eval1D;
+   }
+   else if (vdim == 1)
    {
       if (dim == 2)
       {
@@ -87,6 +87,18 @@ public:
 
    // Compute kernels follow (cannot be private or protected with nvcc)
 
+   /// Compute kernel for 1D, where the faces are points.
+   static void Eval1D(const int NF,
+                      const int vdim,
+                      const DofToQuad &maps,
+                      const Array<bool> &signs,
+                      const Vector &e_vec,
+                      Vector &q_val,
+                      Vector &q_der,
+                      Vector &q_det,
+                      Vector &q_nor,
+                      const int eval_flags);
+
    /// Template compute kernel for 2D.
    template<const int T_VDIM = 0, const int T_ND = 0, const int T_NQ = 0>
    static void Eval2D(const int NF,
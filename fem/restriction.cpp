@@ -17,6 +17,41 @@
 namespace mfem
 {
 
+void GetElementGeometryGroups(const FiniteElementSpace &fes,
+                              Array<int> &group_offsets,
+                              Array<int> &group_elements)
+{
+   const Mesh &mesh = *fes.GetMesh();
+   const int ne = fes.GetNE();
+   int geom_group[Geometry::NumGeom];
+   for (int g = 0; g < Geometry::NumGeom; g++) { geom_group[g] = 0; }
+   for (int e = 0; e < ne; e++)
+   {
+      geom_group[mesh.GetElementBaseGeometry(e)] = 1;
+   }
+   int ngroups = 0;
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      geom_group[g] = geom_group[g] ? ngroups++ : -1;
+   }
+
+   group_offsets.SetSize(ngroups + 1);
+   group_offsets = 0;
+   for (int e = 0; e < ne; e++)
+   {
+      group_offsets[geom_group[mesh.GetElementBaseGeometry(e)] + 1]++;
+   }
+   group_offsets.PartialSum();
+
+   Array<int> pos(ngroups);
+   for (int g = 0; g < ngroups; g++) { pos[g] = group_offsets[g]; }
+   group_elements.SetSize(ne);
+   for (int e = 0; e < ne; e++)
+   {
+      group_elements[pos[geom_group[mesh.GetElementBaseGeometry(e)]]++] = e;
+   }
+}
+
 ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
                                        ElementDofOrdering e_ordering)
    : fes(f),
@@ -25,13 +60,12 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
      byvdim(fes.GetOrdering() == Ordering::byVDIM),
      ndofs(fes.GetNDofs()),
      dof(ne > 0 ? fes.GetFE(0)->GetDof() : 0),
-     nedofs(ne*dof),
+     nedofs(fes.GetElementToDofTable().Size_of_connections()),
      offsets(ndofs+1),
-     indices(ne*dof),
-     gatherMap(ne*dof)
+     indices(nedofs),
+     gatherMap(nedofs)
 {
-   // Assuming all finite elements are the same.
-   height = vdim*ne*dof;
+   height = vdim*nedofs;
    width = fes.GetVSize();
    const bool dof_reorder = (e_ordering == ElementDofOrdering::LEXICOGRAPHIC);
    const int *dof_map = NULL;
@@ -54,19 +88,33 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    }
    const Table& e2dTable = fes.GetElementToDofTable();
    const int* elementMap = e2dTable.GetJ();
+   // On meshes with mixed element types, the elements are grouped by geometry
+   // and the number of dofs varies between the groups.
+   Array<int> group_offsets, group_elements;
+   const Mesh *mesh = fes.GetMesh();
+   if (mesh->GetNumGeometries(mesh->Dimension()) > 1)
+   {
+      GetElementGeometryGroups(fes, group_offsets, group_elements);
+      elem_offsets.SetSize(ne+1);
+      dof_elem.SetSize(nedofs);
+      elem_offsets[0] = 0;
+      for (int k = 0; k < ne; ++k)
+      {
+         const int nd = e2dTable.RowSize(group_elements[k]);
+         elem_offsets[k+1] = elem_offsets[k] + nd;
+         for (int d = 0; d < nd; ++d) { dof_elem[elem_offsets[k] + d] = k; }
+      }
+   }
    // We will be keeping a count of how many local nodes point to its global dof
    for (int i = 0; i <= ndofs; ++i)
    {
       offsets[i] = 0;
    }
-   for (int e = 0; e < ne; ++e)
+   for (int i = 0; i < nedofs; ++i)
    {
-      for (int d = 0; d < dof; ++d)
-      {
-         const int sgid = elementMap[dof*e + d];  // signed
-         const int gid = (sgid >= 0) ? sgid : -1 - sgid;
-         ++offsets[gid + 1];
-      }
+      const int sgid = elementMap[i];  // signed
+      const int gid = (sgid >= 0) ? sgid : -1 - sgid;
+      ++offsets[gid + 1];
    }
    // Aggregate to find offsets for each global dof
    for (int i = 1; i <= ndofs; ++i)
@@ -74,15 +122,19 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
       offsets[i] += offsets[i - 1];
    }
    // For each global dof, fill in all local nodes that point to it
-   for (int e = 0; e < ne; ++e)
+   for (int k = 0; k < ne; ++k)
    {
-      for (int d = 0; d < dof; ++d)
+      const int e = Mixed() ? group_elements[k] : k;
+      const int *elem_dofs = e2dTable.GetRow(e);
+      const int nd = Mixed() ? e2dTable.RowSize(e) : dof;
+      const int eoffset = Mixed() ? elem_offsets[k] : dof*k;
+      for (int d = 0; d < nd; ++d)
       {
          const int sdid = dof_reorder ? dof_map[d] : 0;  // signed
          const int did = (!dof_reorder)?d:(sdid >= 0 ? sdid : -1-sdid);
-         const int sgid = elementMap[dof*e + did];  // signed
+         const int sgid = elem_dofs[did];  // signed
          const int gid = (sgid >= 0) ? sgid : -1-sgid;
-         const int lid = dof*e + d;
+         const int lid = eoffset + d;
          const bool plus = (sgid >= 0 && sdid >= 0) || (sgid < 0 && sdid < 0);
          gatherMap[lid] = plus ? gid : -1-gid;
          indices[offsets[gid]++] = plus ? lid : -1-lid;
@@ -97,8 +149,69 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    offsets[0] = 0;
 }
 
+void ElementRestriction::MultMixed(const Vector& x, Vector& y,
+                                   const bool use_signs) const
+{
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = y.Write();
+   auto d_gatherMap = gatherMap.Read();
+   auto d_elem_offsets = elem_offsets.Read();
+   auto d_dof_elem = dof_elem.Read();
+   MFEM_FORALL(i, nedofs,
+   {
+      // The block of element k in the E-vector has size nd x vd.
+      const int k = d_dof_elem[i];
+      const int eoffset = d_elem_offsets[k];
+      const int nd = d_elem_offsets[k+1] - eoffset;
+      const int gid = d_gatherMap[i];
+      const bool plus = gid >= 0 || !use_signs;
+      const int j = gid >= 0 ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = d_x(t?c:j, t?j:c);
+         d_y[vd*eoffset + (i - eoffset) + nd*c] = plus ? dofValue : -dofValue;
+      }
+   });
+}
+
+void ElementRestriction::MultTransposeMixed(const Vector& x, Vector& y,
+                                            const bool use_signs) const
+{
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_elem_offsets = elem_offsets.Read();
+   auto d_dof_elem = dof_elem.Read();
+   auto d_x = x.Read();
+   auto d_y = Reshape(y.Write(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+            const int k = d_dof_elem[idx_j];
+            const int eoffset = d_elem_offsets[k];
+            const int nd = d_elem_offsets[k+1] - eoffset;
+            const double value = d_x[vd*eoffset + (idx_j - eoffset) + nd*c];
+            dofValue += (d_indices[j] >= 0 || !use_signs) ? value : -value;
+         }
+         d_y(t?c:i,t?i:c) = dofValue;
+      }
+   });
+}
+
 void ElementRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PROFILE_REGION("ElementRestriction::Mult");
+   if (Mixed()) { return MultMixed(x, y, true); }
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -121,6 +234,7 @@ void ElementRestriction::Mult(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
 {
+   if (Mixed()) { return MultMixed(x, y, false); }
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -142,6 +256,8 @@ void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   MFEM_PROFILE_REGION("ElementRestriction::MultTranspose");
+   if (Mixed()) { return MultTransposeMixed(x, y, true); }
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -170,6 +286,7 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
 {
+   if (Mixed()) { return MultTransposeMixed(x, y, false); }
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -197,6 +314,7 @@ void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
 
 void ElementRestriction::BooleanMask(Vector& y) const
 {
+   MFEM_VERIFY(!Mixed(), "meshes with mixed element types are not supported");
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -232,6 +350,61 @@ void ElementRestriction::BooleanMask(Vector& y) const
    }
 }
 
+void ElementRestriction::ComputeElementColors() const
+{
+   MFEM_VERIFY(!Mixed(), "meshes with mixed element types are not supported");
+   const int nd = dof;
+   auto d_offsets = offsets.HostRead();
+   auto d_indices = indices.HostRead();
+   auto d_gatherMap = gatherMap.HostRead();
+   // Greedy coloring: every element gets the smallest color not used by the
+   // previously colored elements sharing a dof with it.
+   Array<int> color(ne), used;
+   color = -1;
+   int num_colors = 0;
+   for (int e = 0; e < ne; ++e)
+   {
+      used.SetSize(num_colors + 1);
+      used = 0;
+      for (int d = 0; d < nd; ++d)
+      {
+         const int sgid = d_gatherMap[nd*e + d];
+         const int gid = (sgid >= 0) ? sgid : -1 - sgid;
+         for (int j = d_offsets[gid]; j < d_offsets[gid+1]; ++j)
+         {
+            const int sidx = d_indices[j];
+            const int idx = (sidx >= 0) ? sidx : -1 - sidx;
+            const int c = color[idx / nd];
+            if (c >= 0) { used[c] = 1; }
+         }
+      }
+      int c = 0;
+      while (used[c]) { c++; }
+      color[e] = c;
+      num_colors = std::max(num_colors, c + 1);
+   }
+   color_offsets.SetSize(num_colors + 1);
+   color_offsets = 0;
+   for (int e = 0; e < ne; ++e) { color_offsets[color[e] + 1]++; }
+   color_offsets.PartialSum();
+   color_elems.SetSize(ne);
+   Array<int> count(num_colors);
+   count = 0;
+   for (int e = 0; e < ne; ++e)
+   {
+      const int c = color[e];
+      color_elems[color_offsets[c] + count[c]++] = e;
+   }
+}
+
+void ElementRestriction::GetElementColors(const Array<int> *&offsets_,
+                                          const Array<int> *&elems_) const
+{
+   if (color_offsets.Size() == 0) { ComputeElementColors(); }
+   offsets_ = &color_offsets;
+   elems_ = &color_elems;
+}
+
 void ElementRestriction::FillSparseMatrix(const Vector &mat_ea,
                                           SparseMatrix &mat) const
 {
@@ -273,6 +446,19 @@ static MFEM_HOST_DEVICE int GetMinElt(const int *my_elts, const int nbElts,
    return min;
 }
 
+/** Returns the index encoded in a signed entry of the gather map or of the
+    indices of an ElementRestriction, see ElementRestriction::Mult(). */
+static MFEM_HOST_DEVICE int DecodeDof(const int j)
+{
+   return j >= 0 ? j : -1 - j;
+}
+
+/// Returns the sign encoded in a signed entry, see DecodeDof().
+static MFEM_HOST_DEVICE double DofSign(const int j)
+{
+   return j >= 0 ? 1.0 : -1.0;
+}
+
 /** Returns the index where a non-zero entry should be added and increment the
     number of non-zeros for the row i_L. */
 static MFEM_HOST_DEVICE int GetAndIncrementNnzIndex(const int i_L, int* I)
@@ -283,6 +469,7 @@ static MFEM_HOST_DEVICE int GetAndIncrementNnzIndex(const int i_L, int* I)
 
 int ElementRestriction::FillI(SparseMatrix &mat) const
 {
+   MFEM_VERIFY(!Mixed(), "meshes with mixed element types are not supported");
    static constexpr int Max = MaxNbNbr;
    const int all_dofs = ndofs;
    const int vd = vdim;
@@ -301,19 +488,19 @@ int ElementRestriction::FillI(SparseMatrix &mat) const
       {
          int i_elts[Max];
          const int i_E = e*elt_dofs + i;
-         const int i_L = d_gatherMap[i_E];
+         const int i_L = DecodeDof(d_gatherMap[i_E]);
          const int i_offset = d_offsets[i_L];
          const int i_nextOffset = d_offsets[i_L+1];
          const int i_nbElts = i_nextOffset - i_offset;
          for (int e_i = 0; e_i < i_nbElts; ++e_i)
          {
-            const int i_E = d_indices[i_offset+e_i];
+            const int i_E = DecodeDof(d_indices[i_offset+e_i]);
             i_elts[e_i] = i_E/elt_dofs;
          }
          for (int j = 0; j < elt_dofs; j++)
          {
             const int j_E = e*elt_dofs + j;
-            const int j_L = d_gatherMap[j_E];
+            const int j_L = DecodeDof(d_gatherMap[j_E]);
             const int j_offset = d_offsets[j_L];
             const int j_nextOffset = d_offsets[j_L+1];
             const int j_nbElts = j_nextOffset - j_offset;
@@ -326,7 +513,7 @@ int ElementRestriction::FillI(SparseMatrix &mat) const
                int j_elts[Max];
                for (int e_j = 0; e_j < j_nbElts; ++e_j)
                {
-                  const int j_E = d_indices[j_offset+e_j];
+                  const int j_E = DecodeDof(d_indices[j_offset+e_j]);
                   const int elt = j_E/elt_dofs;
                   j_elts[e_j] = elt;
                }
@@ -357,6 +544,7 @@ int ElementRestriction::FillI(SparseMatrix &mat) const
 void ElementRestriction::FillJAndData(const Vector &ea_data,
                                       SparseMatrix &mat) const
 {
+   MFEM_VERIFY(!Mixed(), "meshes with mixed element types are not supported");
    static constexpr int Max = MaxNbNbr;
    const int all_dofs = ndofs;
    const int vd = vdim;
@@ -374,21 +562,26 @@ void ElementRestriction::FillJAndData(const Vector &ea_data,
       {
          int i_elts[Max];
          int i_B[Max];
+         double i_S[Max];
          const int i_E = e*elt_dofs + i;
-         const int i_L = d_gatherMap[i_E];
+         const int i_sL = d_gatherMap[i_E];
+         const int i_L = DecodeDof(i_sL);
          const int i_offset = d_offsets[i_L];
          const int i_nextOffset = d_offsets[i_L+1];
          const int i_nbElts = i_nextOffset - i_offset;
          for (int e_i = 0; e_i < i_nbElts; ++e_i)
          {
-            const int i_E = d_indices[i_offset+e_i];
+            const int i_sE = d_indices[i_offset+e_i];
+            const int i_E = DecodeDof(i_sE);
             i_elts[e_i] = i_E/elt_dofs;
             i_B[e_i]    = i_E%elt_dofs;
+            i_S[e_i]    = DofSign(i_sE);
          }
          for (int j = 0; j < elt_dofs; j++)
          {
             const int j_E = e*elt_dofs + j;
-            const int j_L = d_gatherMap[j_E];
+            const int j_sL = d_gatherMap[j_E];
+            const int j_L = DecodeDof(j_sL);
             const int j_offset = d_offsets[j_L];
             const int j_nextOffset = d_offsets[j_L+1];
             const int j_nbElts = j_nextOffset - j_offset;
@@ -396,18 +589,21 @@ void ElementRestriction::FillJAndData(const Vector &ea_data,
             {
                const int nnz = GetAndIncrementNnzIndex(i_L, I);
                J[nnz] = j_L;
-               Data[nnz] = mat_ea(j,i,e);
+               Data[nnz] = DofSign(i_sL)*DofSign(j_sL)*mat_ea(j,i,e);
             }
             else // assembly required
             {
                int j_elts[Max];
                int j_B[Max];
+               double j_S[Max];
                for (int e_j = 0; e_j < j_nbElts; ++e_j)
                {
-                  const int j_E = d_indices[j_offset+e_j];
+                  const int j_sE = d_indices[j_offset+e_j];
+                  const int j_E = DecodeDof(j_sE);
                   const int elt = j_E/elt_dofs;
                   j_elts[e_j] = elt;
                   j_B[e_j]    = j_E%elt_dofs;
+                  j_S[e_j]    = DofSign(j_sE);
                }
                int min_e = GetMinElt<Max>(i_elts, i_nbElts, j_elts, j_nbElts);
                if (e == min_e) // add the nnz only once
@@ -423,7 +619,7 @@ void ElementRestriction::FillJAndData(const Vector &ea_data,
                         const int j_Bloc = j_B[j];
                         if (e_i == e_j)
                         {
-                           val += mat_ea(j_Bloc, i_Bloc, e_i);
+                           val += i_S[i]*j_S[j]*mat_ea(j_Bloc, i_Bloc, e_i);
                         }
                      }
                   }
@@ -459,6 +655,7 @@ L2ElementRestriction::L2ElementRestriction(const FiniteElementSpace &fes)
 
 void L2ElementRestriction::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("L2ElementRestriction::Mult");
    const int nd = ndof;
    const int vd = vdim;
    const bool t = byvdim;
@@ -478,6 +675,7 @@ void L2ElementRestriction::Mult(const Vector &x, Vector &y) const
 
 void L2ElementRestriction::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("L2ElementRestriction::MultTranspose");
    const int nd = ndof;
    const int vd = vdim;
    const bool t = byvdim;
@@ -535,6 +733,139 @@ void L2ElementRestriction::FillJAndData(const Vector &ea_data,
 }
 
 // Return the face degrees of freedom returned in Lexicographic order.
+L2FaceNeighborRestriction::L2FaceNeighborRestriction(
+   const FiniteElementSpace &fes, const FaceType type)
+   : fes(fes),
+     nf(fes.GetNFbyType(type)),
+     vdim(fes.GetVDim()),
+     byvdim(fes.GetOrdering() == Ordering::byVDIM),
+     ndofs(fes.GetNDofs()),
+     elem_dofs(fes.GetNE() > 0 ? fes.GetFE(0)->GetDof() : 0),
+     nfdofs(nf*elem_dofs),
+     indices1(nfdofs),
+     indices2(nfdofs),
+     offsets(ndofs+1)
+{
+   Mesh &mesh = *fes.GetMesh();
+   MFEM_VERIFY(mesh.Conforming(),
+               "Non-conforming meshes not yet supported with partial assembly.");
+   MFEM_VERIFY(mesh.GetNumGeometries(mesh.Dimension()) <= 1,
+               "meshes with mixed element types are not supported");
+   height = 2*vdim*nfdofs;
+   width = fes.GetVSize();
+   if (nf == 0) { ComputeGatherIndices(); return; }
+
+   const Table &e2dTable = fes.GetElementToDofTable();
+   MFEM_VERIFY(e2dTable.Size_of_connections() == fes.GetNE()*elem_dofs,
+               "all elements must have the same number of dofs");
+   const int *elementMap = e2dTable.GetJ();
+   int f_ind = 0;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      int e1, e2, inf1, inf2;
+      mesh.GetFaceElements(f, &e1, &e2);
+      mesh.GetFaceInfos(f, &inf1, &inf2);
+      if ((type==FaceType::Interior && (e2>=0 || (e2<0 && inf2>=0))) ||
+          (type==FaceType::Boundary && e2<0 && inf2<0))
+      {
+         for (int d = 0; d < elem_dofs; ++d)
+         {
+            const int lid = elem_dofs*f_ind + d;
+            indices1[lid] = elementMap[e1*elem_dofs + d];
+            // Shared faces are set by ParL2FaceNeighborRestriction
+            indices2[lid] = (e2 >= 0) ? elementMap[e2*elem_dofs + d] : -1;
+         }
+         f_ind++;
+      }
+   }
+   MFEM_VERIFY(f_ind==nf, "Unexpected number of faces.");
+   ComputeGatherIndices();
+}
+
+void L2FaceNeighborRestriction::ComputeGatherIndices()
+{
+   const int *h_ind1 = indices1.HostRead();
+   const int *h_ind2 = indices2.HostRead();
+   offsets = 0;
+   for (int i = 0; i < nfdofs; ++i)
+   {
+      ++offsets[h_ind1[i] + 1];
+      const int idx2 = h_ind2[i];
+      if (idx2 >= 0 && idx2 < ndofs) { ++offsets[idx2 + 1]; }
+   }
+   offsets.PartialSum();
+   gather_indices.SetSize(offsets[ndofs]);
+   for (int i = 0; i < nfdofs; ++i)
+   {
+      gather_indices[offsets[h_ind1[i]]++] = i;
+      const int idx2 = h_ind2[i];
+      // We shift the index to express that it is the second element of f
+      if (idx2 >= 0 && idx2 < ndofs)
+      {
+         gather_indices[offsets[idx2]++] = nfdofs + i;
+      }
+   }
+   for (int i = ndofs; i > 0; --i)
+   {
+      offsets[i] = offsets[i - 1];
+   }
+   offsets[0] = 0;
+}
+
+void L2FaceNeighborRestriction::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_PROFILE_REGION("L2FaceNeighborRestriction::Mult");
+   const int nd = elem_dofs;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_indices1 = indices1.Read();
+   auto d_indices2 = indices2.Read();
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.Write(), nd, vd, 2, nf);
+   MFEM_FORALL(i, nfdofs,
+   {
+      const int dof = i % nd;
+      const int face = i / nd;
+      const int idx1 = d_indices1[i];
+      const int idx2 = d_indices2[i];
+      for (int c = 0; c < vd; ++c)
+      {
+         d_y(dof, c, 0, face) = d_x(t?c:idx1, t?idx1:c);
+         d_y(dof, c, 1, face) = idx2==-1 ? 0.0 : d_x(t?c:idx2, t?idx2:c);
+      }
+   });
+}
+
+void L2FaceNeighborRestriction::MultTranspose(const Vector &x, Vector &y) const
+{
+   MFEM_PROFILE_REGION("L2FaceNeighborRestriction::MultTranspose");
+   const int nd = elem_dofs;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int dofs = nfdofs;
+   auto d_offsets = offsets.Read();
+   auto d_indices = gather_indices.Read();
+   auto d_x = Reshape(x.Read(), nd, vd, 2, nf);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            int idx_j = d_indices[j];
+            const int side = idx_j < dofs ? 0 : 1;
+            idx_j = side ? idx_j - dofs : idx_j;
+            dofValue += d_x(idx_j % nd, c, side, idx_j / nd);
+         }
+         d_y(t?c:i,t?i:c) += dofValue;
+      }
+   });
+}
+
 void GetFaceDofs(const int dim, const int face_id,
                  const int dof1d, Array<int> &faceMap)
 {
@@ -671,7 +1002,8 @@ H1FaceRestriction::H1FaceRestriction(const FiniteElementSpace &fes,
    height = vdim*nf*dof;
    width = fes.GetVSize();
    const bool dof_reorder = (e_ordering == ElementDofOrdering::LEXICOGRAPHIC);
-   if (dof_reorder && nf > 0)
+   // In 1D, the faces are points with a single dof and need no reordering.
+   if (dof_reorder && nf > 0 && fes.GetMesh()->Dimension() > 1)
    {
       for (int f = 0; f < fes.GetNF(); ++f)
       {
@@ -801,6 +1133,7 @@ H1FaceRestriction::H1FaceRestriction(const FiniteElementSpace &fes,
 
 void H1FaceRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PROFILE_REGION("H1FaceRestriction::Mult");
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -822,6 +1155,7 @@ void H1FaceRestriction::Mult(const Vector& x, Vector& y) const
 
 void H1FaceRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   MFEM_PROFILE_REGION("H1FaceRestriction::MultTranspose");
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -1018,7 +1352,7 @@ L2FaceRestriction::L2FaceRestriction(const FiniteElementSpace &fes,
    {
       mfem_error("Non-Tensor L2FaceRestriction not yet implemented.");
    }
-   if (dof_reorder && nf > 0)
+   if (dof_reorder && nf > 0 && fes.GetMesh()->Dimension() > 1)
    {
       for (int f = 0; f < fes.GetNF(); ++f)
       {
@@ -1195,6 +1529,7 @@ L2FaceRestriction::L2FaceRestriction(const FiniteElementSpace &fes,
 
 void L2FaceRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PROFILE_REGION("L2FaceRestriction::Mult");
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -1242,6 +1577,7 @@ void L2FaceRestriction::Mult(const Vector& x, Vector& y) const
 
 void L2FaceRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   MFEM_PROFILE_REGION("L2FaceRestriction::MultTranspose");
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
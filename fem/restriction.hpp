@@ -25,9 +25,26 @@ enum class ElementDofOrdering;
     e1 and e2 (DoubleValued). */
 enum class L2FaceValues : bool {SingleValued, DoubleValued};
 
+/** @brief Split the elements of @a fes into groups of elements with the same
+    geometry, in the order used for the E-vectors of ElementRestriction.
+
+    On output, group g consists of the elements group_elements[i] for
+    group_offsets[g] <= i < group_offsets[g+1], listed in increasing order, and
+    the groups are sorted by geometry type. Meshes with a single element
+    geometry have one group with all elements in their natural order. */
+void GetElementGeometryGroups(const FiniteElementSpace &fes,
+                              Array<int> &group_offsets,
+                              Array<int> &group_elements);
+
 /// Operator that converts FiniteElementSpace L-vectors to E-vectors.
 /** Objects of this type are typically created and owned by FiniteElementSpace
-    objects, see FiniteElementSpace::GetElementRestriction(). */
+    objects, see FiniteElementSpace::GetElementRestriction().
+
+    On meshes with mixed element types, the elements in the E-vector are sorted
+    by geometry, see GetElementGeometryGroups(). Every geometry group is then a
+    contiguous block of the E-vector with the same layout as the E-vector of a
+    mesh with a single element type, so that it can be processed by a single
+    kernel. */
 class ElementRestriction : public Operator
 {
 private:
@@ -46,6 +63,27 @@ protected:
    Array<int> offsets;
    Array<int> indices;
    Array<int> gatherMap;
+   // Used only on meshes with mixed element types: the E-vector offsets of the
+   // scalar dofs of the elements (in E-vector order), and the E-vector element
+   // of every scalar E-vector dof.
+   Array<int> elem_offsets;
+   Array<int> dof_elem;
+   // Element coloring used by the fused PA kernels, computed on demand: the
+   // elements of color c are color_elems[i], color_offsets[c] <= i <
+   // color_offsets[c+1].
+   mutable Array<int> color_offsets;
+   mutable Array<int> color_elems;
+
+   /// Compute the element coloring, see GetElementColors().
+   void ComputeElementColors() const;
+
+   /// Return true if the elements are grouped by geometry.
+   bool Mixed() const { return elem_offsets.Size() > 0; }
+
+   /// Versions of Mult() and MultTranspose() for meshes with mixed elements.
+   void MultMixed(const Vector &x, Vector &y, const bool use_signs) const;
+   void MultTransposeMixed(const Vector &x, Vector &y,
+                           const bool use_signs) const;
 
 public:
    ElementRestriction(const FiniteElementSpace&, ElementDofOrdering);
@@ -68,6 +106,22 @@ public:
    /// Fill a Sparse Matrix with Element Matrices.
    void FillSparseMatrix(const Vector &mat_ea, SparseMatrix &mat) const;
 
+   /** @brief Return the map from the (scalar) E-vector dofs to the (scalar)
+       L-vector dofs. Negative entries j represent the dof -1-j with a sign
+       change. */
+   const Array<int> &GatherMap() const { return gatherMap; }
+
+   /** @brief Return a coloring of the elements such that no two elements of
+       the same color share a dof.
+
+       The elements of color c are @a elems[i] for @a offsets[c] <= i <
+       @a offsets[c+1]. Element-wise kernels can therefore add their results
+       directly to an L-vector, without atomics, if they process the colors one
+       after the other. The coloring is computed by a greedy algorithm on the
+       first call. Meshes with mixed element types are not supported. */
+   void GetElementColors(const Array<int> *&offsets,
+                         const Array<int> *&elems) const;
+
    /** Fill the I array of SparseMatrix corresponding to the sparsity pattern
        given by this ElementRestriction. */
    int FillI(SparseMatrix &mat) const;
@@ -168,6 +222,42 @@ public:
                                          Vector &ea_data) const;
 };
 
+/** @brief Operator that extracts, for each face, all the degrees of freedom of
+    the elements sharing the face. */
+/** The E-vector on the faces has the layout (elem_dofs x vdim x 2 x nf), where
+    the element dofs are in their native ordering; the second block is zero on
+    true boundary faces. This is used by face integrators whose partial
+    assembly needs more than the trace of the solution on the face, e.g. its
+    normal derivatives, see BilinearFormIntegrator::UsesFaceNeighborDofs().
+    Only conforming meshes with a single element type are supported. Objects of
+    this type are typically created and owned by FiniteElementSpace objects,
+    see FiniteElementSpace::GetFaceNeighborRestriction(). */
+class L2FaceNeighborRestriction : public Operator
+{
+protected:
+   const FiniteElementSpace &fes;
+   const int nf;
+   const int vdim;
+   const bool byvdim;
+   const int ndofs;
+   const int elem_dofs;
+   const int nfdofs;
+   Array<int> indices1;
+   Array<int> indices2;
+   Array<int> offsets;
+   Array<int> gather_indices;
+
+   /** Compute the transpose map from the L-vector dofs to the entries of the
+       face E-vector, using the local entries of indices1 and indices2. */
+   void ComputeGatherIndices();
+
+public:
+   L2FaceNeighborRestriction(const FiniteElementSpace&, const FaceType);
+   virtual void Mult(const Vector &x, Vector &y) const;
+   /// Add the transpose of the restriction applied to @a x to @a y.
+   void MultTranspose(const Vector &x, Vector &y) const;
+};
+
 // Return the face degrees of freedom returned in Lexicographic order.
 void GetFaceDofs(const int dim, const int face_id,
                  const int dof1d, Array<int> &faceMap);
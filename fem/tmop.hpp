@@ -1141,6 +1141,27 @@ protected:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // Partial assembly data, see AssemblePA().
+   struct
+   {
+      int dim, ne, nq, metric_id;
+      const FiniteElementSpace *fes; // not owned
+      const IntegrationRule *ir;     // not owned
+      const DofToQuad *maps;         // not owned
+      // Per quadrature point: Jrt (dim x dim) and ip.weight * det(Jtr).
+      Vector Jrt_W;
+      // Per quadrature point: limiting nodes x0 (dim) and 1/d^2.
+      Vector X0_D;
+      // Per quadrature point: Jpt at the state given to AssembleGradPA().
+      Vector Jpt;
+      // Q-vector work space.
+      mutable Vector qder, qval, energy;
+   } PA;
+
+   // Scaling of the metric and limiting terms, used by the PA kernels.
+   double GetPAMetricScale() const;
+   double GetPALimitingScale() const;
+
    void ComputeNormalizationEnergies(const GridFunction &x,
                                      double &metric_energy, double &lim_energy);
 
@@ -1219,7 +1240,7 @@ public:
         zeta_0(NULL), zeta(NULL), coeff_zeta(NULL), adapt_eval(NULL),
         discr_tc(dynamic_cast<DiscreteAdaptTC *>(tc)),
         fdflag(false), dxscale(1.0e3), fd_call_flag(false), exact_action(false)
-   { }
+   { PA.fes = NULL; PA.ne = 0; }
 
    ~TMOP_Integrator();
 
@@ -1317,6 +1338,30 @@ public:
 
    /** @brief Flag to control if exact action of Integration is effected. */
    void SetExactActionFlag(bool flag_) { exact_action = flag_; }
+
+   using NonlinearFormIntegrator::AssemblePA;
+
+   /** @brief Partial assembly: store the target Jacobians and quadrature
+       weights at all quadrature points.
+
+       Supported are the metrics 1, 2 (2D) and 302, 303, 321 (3D) on tensor
+       product elements, with TargetConstructor target types, optional
+       ConstantCoefficient weights, and the quadratic limiting term. The
+       deformation gradients are computed on the fly with sum factorization
+       and the metrics are evaluated point-wise on the device. */
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   /// Store the Jacobians Jpt at the state @a x (an E-vector).
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   virtual double GetGridFunctionEnergyPA(const Vector &x) const;
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AddMultGradPA(const Vector &g,
+                              const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradDiagonalPA(const Vector &g, Vector &diag) const;
 };
 
 class TMOPComboIntegrator : public NonlinearFormIntegrator
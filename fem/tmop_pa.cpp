@@ -0,0 +1,977 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Partial assembly of TMOP_Integrator.
+
+#include "tmop.hpp"
+#include "gridfunc.hpp"
+#include "quadinterpolator.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
+
+namespace mfem
+{
+
+// All dim x dim matrices below are stored column-major: A(i,j) = A[i+dim*j].
+// The quadrature point data is organized as follows:
+//   Jrt_W: (DIM*DIM+1, NQ, NE) with the entries [Jrt, ip.weight*det(Jtr)],
+//   X0_D:  (DIM+1, NQ, NE) with the entries [x0, 1/d^2],
+//   Jpt:   (DIM*DIM, NQ, NE).
+
+// The point-wise metric functions below use the invariants of Jpt:
+//    I1 = |J|^2, I1b = det(J)^{-2/dim} I1,
+//    I2 = |adj(J)|^2, I2b = det(J)^{-4/3} I2 (3D only),
+// together with Z = adj(J)^t = d(det(J))/dJ. For each quantity X, dX denotes
+// its derivative with respect to J (a matrix) and ddX[H] denotes the
+// directional derivative of dX in the direction H.
+
+template<int DIM> MFEM_HOST_DEVICE inline
+double TMOPInner(const double *A, const double *B)
+{
+   double s = 0.0;
+   for (int i = 0; i < DIM*DIM; i++) { s += A[i]*B[i]; }
+   return s;
+}
+
+// Z = adj(J)^t, returns det(J).
+template<int DIM> MFEM_HOST_DEVICE inline
+double TMOPAdjT(const double *J, double *Z)
+{
+   double Jinv[DIM*DIM];
+   kernels::CalcInverse<DIM>(J, Jinv);
+   const double det = kernels::Det<DIM>(J);
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++) { Z[i+DIM*j] = det*Jinv[j+DIM*i]; }
+   }
+   return det;
+}
+
+// dZ[H] = (tr Z - Z H^t Z) / det, with tr = Z:H.
+template<int DIM> MFEM_HOST_DEVICE inline
+void TMOPdZ(const double *Z, const double det, const double *H,
+            const double tr, double *dZ)
+{
+   double M[DIM*DIM];
+   for (int k = 0; k < DIM; k++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         double s = 0.0;
+         for (int l = 0; l < DIM; l++) { s += H[l+DIM*k]*Z[l+DIM*j]; }
+         M[k+DIM*j] = s;
+      }
+   }
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         double ZM = 0.0;
+         for (int k = 0; k < DIM; k++) { ZM += Z[i+DIM*k]*M[k+DIM*j]; }
+         dZ[i+DIM*j] = (tr*Z[i+DIM*j] - ZM)/det;
+      }
+   }
+}
+
+// I1b and dI1b = 2a J - (2/dim) a I1 Z / det, with a = det^{-2/dim}.
+template<int DIM> MFEM_HOST_DEVICE inline
+double TMOP_dI1b(const double *J, const double *Z, const double det,
+                 double *dI1b)
+{
+   const double I1 = TMOPInner<DIM>(J, J);
+   const double a = pow(det, -2.0/DIM);
+   for (int i = 0; i < DIM*DIM; i++)
+   {
+      dI1b[i] = 2.0*a*J[i] - (2.0/DIM)*a*I1*Z[i]/det;
+   }
+   return a*I1;
+}
+
+template<int DIM> MFEM_HOST_DEVICE inline
+void TMOP_ddI1b(const double *J, const double *Z, const double det,
+                const double *H, const double tr, const double *dZ,
+                double *ddI1b)
+{
+   const double I1 = TMOPInner<DIM>(J, J);
+   const double dI1 = 2.0*TMOPInner<DIM>(J, H);
+   const double a = pow(det, -2.0/DIM);
+   const double da = -(2.0/DIM)*a*tr/det;
+   for (int i = 0; i < DIM*DIM; i++)
+   {
+      ddI1b[i] = 2.0*da*J[i] + 2.0*a*H[i]
+                 - (2.0/DIM)*((da*I1 + a*dI1)*Z[i] + a*I1*dZ[i]
+                              - a*I1*Z[i]*tr/det)/det;
+   }
+}
+
+// 3D: I2 and dI2 = 2 (I1 J - J J^t J).
+MFEM_HOST_DEVICE inline
+double TMOP_dI2(const double *J, const double *Z, double *dI2)
+{
+   const double I1 = TMOPInner<3>(J, J);
+   double JJt[9];
+   kernels::MultABt(3, 3, 3, J, J, JJt);
+   for (int i = 0; i < 3; i++)
+   {
+      for (int j = 0; j < 3; j++)
+      {
+         double s = 0.0;
+         for (int k = 0; k < 3; k++) { s += JJt[i+3*k]*J[k+3*j]; }
+         dI2[i+3*j] = 2.0*(I1*J[i+3*j] - s);
+      }
+   }
+   return TMOPInner<3>(Z, Z);
+}
+
+// 3D: ddI2[H] = 2 (dI1 J + I1 H - H J^t J - J H^t J - J J^t H).
+MFEM_HOST_DEVICE inline
+void TMOP_ddI2(const double *J, const double *H, double *ddI2)
+{
+   const double I1 = TMOPInner<3>(J, J);
+   const double dI1 = 2.0*TMOPInner<3>(J, H);
+   double JJt[9], HJt[9], JHt[9];
+   kernels::MultABt(3, 3, 3, J, J, JJt);
+   kernels::MultABt(3, 3, 3, H, J, HJt);
+   kernels::MultABt(3, 3, 3, J, H, JHt);
+   for (int i = 0; i < 3; i++)
+   {
+      for (int j = 0; j < 3; j++)
+      {
+         double s = 0.0;
+         for (int k = 0; k < 3; k++)
+         {
+            s += (HJt[i+3*k] + JHt[i+3*k])*J[k+3*j] + JJt[i+3*k]*H[k+3*j];
+         }
+         ddI2[i+3*j] = 2.0*(dI1*J[i+3*j] + I1*H[i+3*j] - s);
+      }
+   }
+}
+
+// 3D: I2b and dI2b = b dI2 - (4/3) b I2 Z / det, with b = det^{-4/3}.
+MFEM_HOST_DEVICE inline
+double TMOP_dI2b(const double *J, const double *Z, const double det,
+                 double *dI2b)
+{
+   double dI2[9];
+   const double I2 = TMOP_dI2(J, Z, dI2);
+   const double b = pow(det, -4.0/3.0);
+   for (int i = 0; i < 9; i++)
+   {
+      dI2b[i] = b*dI2[i] - (4.0/3.0)*b*I2*Z[i]/det;
+   }
+   return b*I2;
+}
+
+MFEM_HOST_DEVICE inline
+void TMOP_ddI2b(const double *J, const double *Z, const double det,
+                const double *H, const double tr, const double *dZ,
+                double *ddI2b)
+{
+   double dI2[9], ddI2[9];
+   const double I2 = TMOP_dI2(J, Z, dI2);
+   TMOP_ddI2(J, H, ddI2);
+   const double dI2H = TMOPInner<3>(dI2, H);
+   const double b = pow(det, -4.0/3.0);
+   const double db = -(4.0/3.0)*b*tr/det;
+   for (int i = 0; i < 9; i++)
+   {
+      ddI2b[i] = db*dI2[i] + b*ddI2[i]
+                 - (4.0/3.0)*((db*I2 + b*dI2H)*Z[i] + b*I2*dZ[i]
+                              - b*I2*Z[i]*tr/det)/det;
+   }
+}
+
+// Metric energy density W(J), see TMOP_Metric_XXX::EvalW().
+template<int DIM> MFEM_HOST_DEVICE inline
+double TMOPEvalW(const int metric, const double *J)
+{
+   double Z[DIM*DIM], dI1b[DIM*DIM];
+   const double det = TMOPAdjT<DIM>(J, Z);
+   switch (metric)
+   {
+      case 1: return TMOPInner<DIM>(J, J);
+      case 2: return 0.5*TMOP_dI1b<DIM>(J, Z, det, dI1b) - 1.0;
+      case 303: return TMOP_dI1b<DIM>(J, Z, det, dI1b)/3.0 - 1.0;
+      case 302:
+      {
+         double dI2b[9];
+         const double I1b = TMOP_dI1b<DIM>(J, Z, det, dI1b);
+         return I1b*TMOP_dI2b(J, Z, det, dI2b)/9.0 - 1.0;
+      }
+      case 321:
+      {
+         double dI2[9];
+         const double I2 = TMOP_dI2(J, Z, dI2);
+         return TMOPInner<DIM>(J, J) + I2/(det*det) - 6.0;
+      }
+   }
+   return 0.0;
+}
+
+// First Piola-Kirchhoff tensor P = dW/dJ, see TMOP_Metric_XXX::EvalP().
+template<int DIM> MFEM_HOST_DEVICE inline
+void TMOPEvalP(const int metric, const double *J, double *P)
+{
+   constexpr int DD = DIM*DIM;
+   double Z[DD], dI1b[DD];
+   const double det = TMOPAdjT<DIM>(J, Z);
+   switch (metric)
+   {
+      case 1:
+      {
+         for (int i = 0; i < DD; i++) { P[i] = 2.0*J[i]; }
+         return;
+      }
+      case 2:
+      case 303:
+      {
+         const double c = (metric == 2) ? 0.5 : 1.0/3.0;
+         TMOP_dI1b<DIM>(J, Z, det, dI1b);
+         for (int i = 0; i < DD; i++) { P[i] = c*dI1b[i]; }
+         return;
+      }
+      case 302:
+      {
+         double dI2b[9];
+         const double I1b = TMOP_dI1b<DIM>(J, Z, det, dI1b);
+         const double I2b = TMOP_dI2b(J, Z, det, dI2b);
+         for (int i = 0; i < DD; i++)
+         {
+            P[i] = (I1b*dI2b[i] + I2b*dI1b[i])/9.0;
+         }
+         return;
+      }
+      case 321:
+      {
+         double dI2[9];
+         const double I2 = TMOP_dI2(J, Z, dI2);
+         const double det2 = det*det, det3 = det2*det;
+         for (int i = 0; i < DD; i++)
+         {
+            P[i] = 2.0*J[i] + dI2[i]/det2 - 2.0*I2*Z[i]/det3;
+         }
+         return;
+      }
+   }
+}
+
+// Directional derivative dP = dP/dJ : H, see TMOP_Metric_XXX::AssembleH().
+template<int DIM> MFEM_HOST_DEVICE inline
+void TMOPEvalDP(const int metric, const double *J, const double *H,
+                double *dP)
+{
+   constexpr int DD = DIM*DIM;
+   double Z[DD], dZ[DD];
+   const double det = TMOPAdjT<DIM>(J, Z);
+   const double tr = TMOPInner<DIM>(Z, H);
+   TMOPdZ<DIM>(Z, det, H, tr, dZ);
+   switch (metric)
+   {
+      case 1:
+      {
+         for (int i = 0; i < DD; i++) { dP[i] = 2.0*H[i]; }
+         return;
+      }
+      case 2:
+      case 303:
+      {
+         const double c = (metric == 2) ? 0.5 : 1.0/3.0;
+         double ddI1b[DD];
+         TMOP_ddI1b<DIM>(J, Z, det, H, tr, dZ, ddI1b);
+         for (int i = 0; i < DD; i++) { dP[i] = c*ddI1b[i]; }
+         return;
+      }
+      case 302:
+      {
+         double dI1b[9], dI2b[9], ddI1b[9], ddI2b[9];
+         const double I1b = TMOP_dI1b<DIM>(J, Z, det, dI1b);
+         const double I2b = TMOP_dI2b(J, Z, det, dI2b);
+         TMOP_ddI1b<DIM>(J, Z, det, H, tr, dZ, ddI1b);
+         TMOP_ddI2b(J, Z, det, H, tr, dZ, ddI2b);
+         const double dI1bH = TMOPInner<DIM>(dI1b, H);
+         const double dI2bH = TMOPInner<DIM>(dI2b, H);
+         for (int i = 0; i < DD; i++)
+         {
+            dP[i] = (dI1bH*dI2b[i] + I1b*ddI2b[i] +
+                     dI2bH*dI1b[i] + I2b*ddI1b[i])/9.0;
+         }
+         return;
+      }
+      case 321:
+      {
+         double dI2[9], ddI2[9];
+         const double I2 = TMOP_dI2(J, Z, dI2);
+         TMOP_ddI2(J, H, ddI2);
+         const double dI2H = TMOPInner<DIM>(dI2, H);
+         const double det2 = det*det, det3 = det2*det, det4 = det3*det;
+         for (int i = 0; i < DD; i++)
+         {
+            dP[i] = 2.0*H[i] + ddI2[i]/det2 - 2.0*dI2[i]*tr/det3
+                    - 2.0*(dI2H*Z[i]/det3 - 3.0*I2*tr*Z[i]/det4
+                           + I2*dZ[i]/det3);
+         }
+         return;
+      }
+   }
+}
+
+// Jpt = Jpr Jrt at the point (q,e), Jpr(c,r) = Q(c,r,q,e).
+template<int DIM> MFEM_HOST_DEVICE inline
+void TMOPJpt(const DeviceTensor<3,const double> &JW,
+             const DeviceTensor<4,const double> &Q,
+             const int q, const int e, double *Jpt)
+{
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int d = 0; d < DIM; d++)
+      {
+         double s = 0.0;
+         for (int r = 0; r < DIM; r++) { s += Q(c,r,q,e)*JW(r+DIM*d,q,e); }
+         Jpt[c+DIM*d] = s;
+      }
+   }
+}
+
+// Q(c,r,q,e) = w * P(c,d) Jrt(r,d).
+template<int DIM> MFEM_HOST_DEVICE inline
+void TMOPPullBack(const DeviceTensor<3,const double> &JW,
+                  const DeviceTensor<4,double> &Q,
+                  const int q, const int e, const double w, const double *P)
+{
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int r = 0; r < DIM; r++)
+      {
+         double s = 0.0;
+         for (int d = 0; d < DIM; d++) { s += P[c+DIM*d]*JW(r+DIM*d,q,e); }
+         Q(c,r,q,e) = w*s;
+      }
+   }
+}
+
+template<int DIM>
+static void TMOPSetupGradPA(const int NE, const int NQ,
+                            const double *jw_, const double *q_, double *j_)
+{
+   constexpr int DD = DIM*DIM;
+   auto JW = Reshape(jw_, DD+1, NQ, NE);
+   auto Q = Reshape(q_, DIM, DIM, NQ, NE);
+   auto Jpt = Reshape(j_, DD, NQ, NE);
+   MFEM_FORALL(i, NE*NQ,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double J[DD];
+      TMOPJpt<DIM>(JW, Q, q, e, J);
+      for (int n = 0; n < DD; n++) { Jpt(n,q,e) = J[n]; }
+   });
+}
+
+template<int DIM>
+static void TMOPEnergyPA(const int metric, const int NE, const int NQ,
+                         const double metric_c, const double lim_c,
+                         const double *jw_, const double *x0_,
+                         const double *qd_, const double *qv_, double *en_)
+{
+   constexpr int DD = DIM*DIM;
+   auto JW = Reshape(jw_, DD+1, NQ, NE);
+   auto X0 = Reshape(x0_, DIM+1, NQ, NE);
+   auto QD = Reshape(qd_, DIM, DIM, NQ, NE);
+   auto QV = Reshape(qv_, DIM, NQ, NE);
+   auto E = Reshape(en_, NQ, NE);
+   MFEM_FORALL(i, NE*NQ,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double J[DD];
+      TMOPJpt<DIM>(JW, QD, q, e, J);
+      double val = metric_c * TMOPEvalW<DIM>(metric, J);
+      if (lim_c != 0.0)
+      {
+         double dist2 = 0.0;
+         for (int c = 0; c < DIM; c++)
+         {
+            const double dx = QV(c,q,e) - X0(c,q,e);
+            dist2 += dx*dx;
+         }
+         val += lim_c * 0.5 * dist2 * X0(DIM,q,e);
+      }
+      E(q,e) = JW(DD,q,e) * val;
+   });
+}
+
+// Replace the reference gradients (and values) of the state in the Q-vectors
+// with the pulled back P (and the limiting term derivative).
+template<int DIM>
+static void TMOPResidualPA(const int metric, const int NE, const int NQ,
+                           const double metric_c, const double lim_c,
+                           const double *jw_, const double *x0_,
+                           double *qd_, double *qv_)
+{
+   constexpr int DD = DIM*DIM;
+   auto JW = Reshape(jw_, DD+1, NQ, NE);
+   auto X0 = Reshape(x0_, DIM+1, NQ, NE);
+   auto QD = Reshape(qd_, DIM, DIM, NQ, NE);
+   auto QDr = Reshape((const double*)qd_, DIM, DIM, NQ, NE);
+   auto QV = Reshape(qv_, DIM, NQ, NE);
+   MFEM_FORALL(i, NE*NQ,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      const double w = JW(DD,q,e);
+      double J[DD], P[DD];
+      TMOPJpt<DIM>(JW, QDr, q, e, J);
+      TMOPEvalP<DIM>(metric, J, P);
+      TMOPPullBack<DIM>(JW, QD, q, e, w*metric_c, P);
+      if (lim_c != 0.0)
+      {
+         const double wl = w * lim_c * X0(DIM,q,e);
+         for (int c = 0; c < DIM; c++)
+         {
+            QV(c,q,e) = wl * (QV(c,q,e) - X0(c,q,e));
+         }
+      }
+   });
+}
+
+// Replace the reference gradients (and values) of the direction in the
+// Q-vectors with the pulled back dP (and the limiting Hessian action).
+template<int DIM>
+static void TMOPGradPA(const int metric, const int NE, const int NQ,
+                       const double metric_c, const double lim_c,
+                       const double *jw_, const double *x0_, const double *j_,
+                       double *qd_, double *qv_)
+{
+   constexpr int DD = DIM*DIM;
+   auto JW = Reshape(jw_, DD+1, NQ, NE);
+   auto X0 = Reshape(x0_, DIM+1, NQ, NE);
+   auto Jpt = Reshape(j_, DD, NQ, NE);
+   auto QD = Reshape(qd_, DIM, DIM, NQ, NE);
+   auto QDr = Reshape((const double*)qd_, DIM, DIM, NQ, NE);
+   auto QV = Reshape(qv_, DIM, NQ, NE);
+   MFEM_FORALL(i, NE*NQ,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      const double w = JW(DD,q,e);
+      double J[DD], H[DD], dP[DD];
+      for (int n = 0; n < DD; n++) { J[n] = Jpt(n,q,e); }
+      TMOPJpt<DIM>(JW, QDr, q, e, H);
+      TMOPEvalDP<DIM>(metric, J, H, dP);
+      TMOPPullBack<DIM>(JW, QD, q, e, w*metric_c, dP);
+      if (lim_c != 0.0)
+      {
+         const double wl = w * lim_c * X0(DIM,q,e);
+         for (int c = 0; c < DIM; c++) { QV(c,q,e) *= wl; }
+      }
+   });
+}
+
+// y(i,c) += sum_q [ sum_r DSh_r(i,q) QD(c,r,q) + Sh(i,q) QV(c,q) ], where the
+// values term is skipped when QV is NULL.
+static void TMOPApplyT2D(const int NE,
+                         const double *b_,
+                         const double *g_,
+                         const double *qd_,
+                         const double *qv_,
+                         double *y_,
+                         const int d1d,
+                         const int q1d)
+{
+   const int D1D = d1d;
+   const int Q1D = q1d;
+   const bool values = qv_ != NULL;
+   auto B = Reshape(b_, Q1D, D1D);
+   auto G = Reshape(g_, Q1D, D1D);
+   auto QD = Reshape(qd_, 2, 2, Q1D, Q1D, NE);
+   auto QV = Reshape(values ? qv_ : qd_, 2, Q1D, Q1D, NE);
+   auto Y = Reshape(y_, D1D, D1D, 2, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = d1d;
+      const int Q1D = q1d;
+      constexpr int MD1 = MAX_D1D;
+      for (int c = 0; c < 2; c++)
+      {
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            double a0[MD1], a1[MD1], av[MD1];
+            for (int dx = 0; dx < D1D; dx++)
+            {
+               a0[dx] = a1[dx] = av[dx] = 0.0;
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  a0[dx] += G(qx,dx)*QD(c,0,qx,qy,e);
+                  a1[dx] += B(qx,dx)*QD(c,1,qx,qy,e);
+                  if (values) { av[dx] += B(qx,dx)*QV(c,qx,qy,e); }
+               }
+            }
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               const double by = B(qy,dy), gy = G(qy,dy);
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  Y(dx,dy,c,e) += by*(a0[dx] + av[dx]) + gy*a1[dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+static void TMOPApplyT3D(const int NE,
+                         const double *b_,
+                         const double *g_,
+                         const double *qd_,
+                         const double *qv_,
+                         double *y_,
+                         const int d1d,
+                         const int q1d)
+{
+   const int D1D = d1d;
+   const int Q1D = q1d;
+   const bool values = qv_ != NULL;
+   auto B = Reshape(b_, Q1D, D1D);
+   auto G = Reshape(g_, Q1D, D1D);
+   auto QD = Reshape(qd_, 3, 3, Q1D, Q1D, Q1D, NE);
+   auto QV = Reshape(values ? qv_ : qd_, 3, Q1D, Q1D, Q1D, NE);
+   auto Y = Reshape(y_, D1D, D1D, D1D, 3, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = d1d;
+      const int Q1D = q1d;
+      constexpr int MD1 = 8;
+      for (int c = 0; c < 3; c++)
+      {
+         for (int qz = 0; qz < Q1D; qz++)
+         {
+            // b0: x- and values-terms, b1: y-term, b2: z-term.
+            double b0[MD1][MD1], b1[MD1][MD1], b2[MD1][MD1];
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  b0[dy][dx] = b1[dy][dx] = b2[dy][dx] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               double a0[MD1], a1[MD1], a2[MD1], av[MD1];
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  a0[dx] = a1[dx] = a2[dx] = av[dx] = 0.0;
+                  for (int qx = 0; qx < Q1D; qx++)
+                  {
+                     a0[dx] += G(qx,dx)*QD(c,0,qx,qy,qz,e);
+                     a1[dx] += B(qx,dx)*QD(c,1,qx,qy,qz,e);
+                     a2[dx] += B(qx,dx)*QD(c,2,qx,qy,qz,e);
+                     if (values) { av[dx] += B(qx,dx)*QV(c,qx,qy,qz,e); }
+                  }
+               }
+               for (int dy = 0; dy < D1D; dy++)
+               {
+                  const double by = B(qy,dy), gy = G(qy,dy);
+                  for (int dx = 0; dx < D1D; dx++)
+                  {
+                     b0[dy][dx] += by*(a0[dx] + av[dx]);
+                     b1[dy][dx] += gy*a1[dx];
+                     b2[dy][dx] += by*a2[dx];
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; dz++)
+            {
+               const double bz = B(qz,dz), gz = G(qz,dz);
+               for (int dy = 0; dy < D1D; dy++)
+               {
+                  for (int dx = 0; dx < D1D; dx++)
+                  {
+                     Y(dx,dy,dz,c,e) += bz*(b0[dy][dx] + b1[dy][dx]) +
+                                        gz*b2[dy][dx];
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// diag(i,c) += sum_q [ sum_{r,s} DSh_r(i,q) M_c(r,s,q) DSh_s(i,q)
+//                      + Sh(i,q)^2 w lim_c / d^2 ], where
+// M_c(r,s) = w metric_c sum_{d,t} Jrt(r,d) dP(c,d)/dJ(c,t) Jrt(s,t).
+template<int DIM>
+static void TMOPDiagonalPA(const int metric, const int NE,
+                           const double metric_c, const double lim_c,
+                           const double *b_, const double *g_,
+                           const double *jw_, const double *x0_,
+                           const double *j_, double *y_,
+                           const int d1d, const int q1d)
+{
+   constexpr int DD = DIM*DIM;
+   const int D1D = d1d;
+   const int Q1D = q1d;
+   const int ND = DIM == 2 ? D1D*D1D : D1D*D1D*D1D;
+   const int NQ = DIM == 2 ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   auto B = Reshape(b_, Q1D, D1D);
+   auto G = Reshape(g_, Q1D, D1D);
+   auto JW = Reshape(jw_, DD+1, NQ, NE);
+   auto X0 = Reshape(x0_, DIM+1, NQ, NE);
+   auto Jpt = Reshape(j_, DD, NQ, NE);
+   auto Y = Reshape(y_, ND, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         const int qx = q % Q1D;
+         const int qy = (q / Q1D) % Q1D;
+         const int qz = q / (Q1D*Q1D);
+         const double w = JW(DD,q,e);
+         const double wl = lim_c != 0.0 ? w*lim_c*X0(DIM,q,e) : 0.0;
+         double J[DD], H[DD], dP[DD];
+         for (int n = 0; n < DD; n++) { J[n] = Jpt(n,q,e); H[n] = 0.0; }
+         double M[DIM][DIM][DIM];
+         for (int c = 0; c < DIM; c++)
+         {
+            double A[DIM][DIM];
+            for (int t = 0; t < DIM; t++)
+            {
+               H[c+DIM*t] = 1.0;
+               TMOPEvalDP<DIM>(metric, J, H, dP);
+               H[c+DIM*t] = 0.0;
+               for (int d = 0; d < DIM; d++) { A[d][t] = dP[c+DIM*d]; }
+            }
+            for (int r = 0; r < DIM; r++)
+            {
+               for (int s = 0; s < DIM; s++)
+               {
+                  double m = 0.0;
+                  for (int d = 0; d < DIM; d++)
+                  {
+                     for (int t = 0; t < DIM; t++)
+                     {
+                        m += JW(r+DIM*d,q,e)*A[d][t]*JW(s+DIM*t,q,e);
+                     }
+                  }
+                  M[c][r][s] = w*metric_c*m;
+               }
+            }
+         }
+         for (int i = 0; i < ND; i++)
+         {
+            const int dx = i % D1D;
+            const int dy = (i / D1D) % D1D;
+            const int dz = i / (D1D*D1D);
+            double DSh[DIM], Sh;
+            if (DIM == 2)
+            {
+               DSh[0] = G(qx,dx)*B(qy,dy);
+               DSh[1] = B(qx,dx)*G(qy,dy);
+               Sh = B(qx,dx)*B(qy,dy);
+            }
+            else
+            {
+               DSh[0] = G(qx,dx)*B(qy,dy)*B(qz,dz);
+               DSh[1] = B(qx,dx)*G(qy,dy)*B(qz,dz);
+               DSh[DIM-1] = B(qx,dx)*B(qy,dy)*G(qz,dz);
+               Sh = B(qx,dx)*B(qy,dy)*B(qz,dz);
+            }
+            for (int c = 0; c < DIM; c++)
+            {
+               double s = wl*Sh*Sh;
+               for (int r = 0; r < DIM; r++)
+               {
+                  for (int t = 0; t < DIM; t++)
+                  {
+                     s += DSh[r]*M[c][r][t]*DSh[t];
+                  }
+               }
+               Y(i,c,e) += s;
+            }
+         }
+      }
+   });
+}
+
+static int GetTMOPMetricId(const TMOP_QualityMetric *metric, int dim)
+{
+   if (dim == 2)
+   {
+      if (dynamic_cast<const TMOP_Metric_001 *>(metric)) { return 1; }
+      if (dynamic_cast<const TMOP_Metric_002 *>(metric)) { return 2; }
+   }
+   if (dim == 3)
+   {
+      if (dynamic_cast<const TMOP_Metric_302 *>(metric)) { return 302; }
+      if (dynamic_cast<const TMOP_Metric_303 *>(metric)) { return 303; }
+      if (dynamic_cast<const TMOP_Metric_321 *>(metric)) { return 321; }
+   }
+   return -1;
+}
+
+double TMOP_Integrator::GetPAMetricScale() const
+{
+   double scale = metric_normal;
+   if (coeff1)
+   {
+      scale *= static_cast<ConstantCoefficient *>(coeff1)->constant;
+   }
+   return scale;
+}
+
+double TMOP_Integrator::GetPALimitingScale() const
+{
+   if (!coeff0) { return 0.0; }
+   return lim_normal * static_cast<ConstantCoefficient *>(coeff0)->constant;
+}
+
+void TMOP_Integrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   PA.fes = &fes;
+   PA.dim = dim;
+   PA.ne = fes.GetNE();
+   PA.metric_id = GetTMOPMetricId(metric, dim);
+   MFEM_VERIFY(PA.metric_id > 0, "PA is not implemented for this metric!");
+   MFEM_VERIFY(fes.GetVDim() == dim, "A vector space with vdim = dim is"
+               " required!");
+   MFEM_VERIFY(discr_tc == NULL &&
+               dynamic_cast<const AnalyticAdaptTC *>(targetC) == NULL,
+               "PA requires a TargetConstructor target type!");
+   MFEM_VERIFY(!fdflag && !exact_action && zeta == NULL,
+               "PA does not support finite differences, exact action or"
+               " adaptive limiting!");
+   MFEM_VERIFY(coeff1 == NULL ||
+               dynamic_cast<ConstantCoefficient *>(coeff1) != NULL,
+               "PA supports only ConstantCoefficient metric weights!");
+   MFEM_VERIFY(coeff0 == NULL ||
+               (dynamic_cast<ConstantCoefficient *>(coeff0) != NULL &&
+                dynamic_cast<TMOP_QuadraticLimiter *>(lim_func) != NULL),
+               "PA supports only the quadratic limiting function with a"
+               " ConstantCoefficient weight!");
+   if (PA.ne == 0) { return; }
+   MFEM_VERIFY(UsesTensorBasis(fes), "PA requires tensor product elements!");
+
+   const FiniteElement &fe = *fes.GetFE(0);
+   PA.ir = &EnergyIntegrationRule(fe);
+   PA.nq = PA.ir->GetNPoints();
+   PA.maps = &fe.GetDofToQuad(*PA.ir, DofToQuad::TENSOR);
+   MFEM_VERIFY(PA.maps->ndof <= (dim == 2 ? MAX_D1D : 8) &&
+               PA.maps->nqpt <= (dim == 2 ? MAX_Q1D : 8),
+               "Orders or quadrature rules this high are not supported!");
+
+   const int NE = PA.ne, NQ = PA.nq, DD = dim*dim;
+   PA.qder.SetSize(DD*NQ*NE, Device::GetMemoryType());
+   PA.qval.SetSize(dim*NQ*NE, Device::GetMemoryType());
+   PA.energy.SetSize(NQ*NE, Device::GetMemoryType());
+   PA.Jpt.Destroy();
+
+   // The target Jacobians of the TargetConstructor target types do not depend
+   // on the current positions and are computed once on the host.
+   PA.Jrt_W.SetSize((DD+1)*NQ*NE, Device::GetMemoryType());
+   auto JW = Reshape(PA.Jrt_W.HostWrite(), DD+1, NQ, NE);
+   DenseTensor Jtr(dim, dim, NQ);
+   DenseMatrix Jinv(dim);
+   Vector elfun;
+   for (int e = 0; e < NE; e++)
+   {
+      targetC->ComputeElementTargets(e, *fes.GetFE(e), *PA.ir, elfun, Jtr);
+      for (int q = 0; q < NQ; q++)
+      {
+         CalcInverse(Jtr(q), Jinv);
+         for (int n = 0; n < DD; n++) { JW(n,q,e) = Jinv.Data()[n]; }
+         JW(DD,q,e) = PA.ir->IntPoint(q).weight * Jtr(q).Det();
+      }
+   }
+
+   // Limiting nodes and distances at the quadrature points.
+   PA.X0_D.SetSize((dim+1)*NQ*NE, Device::GetMemoryType());
+   PA.X0_D = 0.0;
+   if (coeff0)
+   {
+      const FiniteElementSpace &fes0 = *nodes0->FESpace();
+      MFEM_VERIFY(fes0.GetVDim() == dim, "Invalid limiting nodes!");
+      const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
+      const Operator *R0 = fes0.GetElementRestriction(ordering);
+      Vector x0_e(R0->Height(), Device::GetMemoryType());
+      R0->Mult(*nodes0, x0_e);
+      const QuadratureInterpolator *qi0 =
+         fes0.GetQuadratureInterpolator(*PA.ir);
+      qi0->SetOutputLayout(QVectorLayout::byVDIM);
+      qi0->Values(x0_e, PA.qval);
+
+      // As in the full assembly, only the first component of the distance
+      // function is used.
+      const int VD = lim_dist ? lim_dist->FESpace()->GetVDim() : 1;
+      Vector d_q(VD*NQ*NE, Device::GetMemoryType());
+      if (lim_dist)
+      {
+         const FiniteElementSpace &fesd = *lim_dist->FESpace();
+         const Operator *Rd = fesd.GetElementRestriction(ordering);
+         Vector d_e(Rd->Height(), Device::GetMemoryType());
+         Rd->Mult(*lim_dist, d_e);
+         const QuadratureInterpolator *qid =
+            fesd.GetQuadratureInterpolator(*PA.ir);
+         qid->SetOutputLayout(QVectorLayout::byVDIM);
+         qid->Values(d_e, d_q);
+      }
+      else { d_q = 1.0; }
+
+      const int DIM = dim;
+      auto X0 = Reshape(PA.qval.Read(), DIM, NQ, NE);
+      auto D = Reshape(d_q.Read(), VD, NQ, NE);
+      auto X0D = Reshape(PA.X0_D.Write(), DIM+1, NQ, NE);
+      MFEM_FORALL(i, NE*NQ,
+      {
+         const int q = i % NQ;
+         const int e = i / NQ;
+         for (int c = 0; c < DIM; c++) { X0D(c,q,e) = X0(c,q,e); }
+         X0D(DIM,q,e) = 1.0 / (D(0,q,e)*D(0,q,e));
+      });
+   }
+}
+
+void TMOP_Integrator::AssembleGradPA(const Vector &x,
+                                     const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(PA.fes == &fes, "AssemblePA() must be called first!");
+   if (PA.ne == 0) { return; }
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(*PA.ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->Derivatives(x, PA.qder);
+   const int NE = PA.ne, NQ = PA.nq, dim = PA.dim;
+   PA.Jpt.SetSize(dim*dim*NQ*NE, Device::GetMemoryType());
+   const double *JW = PA.Jrt_W.Read();
+   const double *Q = PA.qder.Read();
+   double *J = PA.Jpt.Write();
+   if (dim == 2) { TMOPSetupGradPA<2>(NE, NQ, JW, Q, J); }
+   else { TMOPSetupGradPA<3>(NE, NQ, JW, Q, J); }
+}
+
+double TMOP_Integrator::GetGridFunctionEnergyPA(const Vector &x) const
+{
+   if (PA.ne == 0) { return 0.0; }
+   const QuadratureInterpolator *qi = PA.fes->GetQuadratureInterpolator(*PA.ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->Derivatives(x, PA.qder);
+   const double lim_c = GetPALimitingScale();
+   if (lim_c != 0.0) { qi->Values(x, PA.qval); }
+   const int NE = PA.ne, NQ = PA.nq, M = PA.metric_id;
+   const double metric_c = GetPAMetricScale();
+   const double *JW = PA.Jrt_W.Read();
+   const double *X0 = PA.X0_D.Read();
+   const double *QD = PA.qder.Read();
+   const double *QV = PA.qval.Read();
+   double *E = PA.energy.Write();
+   if (PA.dim == 2)
+   {
+      TMOPEnergyPA<2>(M, NE, NQ, metric_c, lim_c, JW, X0, QD, QV, E);
+   }
+   else
+   {
+      TMOPEnergyPA<3>(M, NE, NQ, metric_c, lim_c, JW, X0, QD, QV, E);
+   }
+   return PA.energy.Sum();
+}
+
+void TMOP_Integrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (PA.ne == 0) { return; }
+   const QuadratureInterpolator *qi = PA.fes->GetQuadratureInterpolator(*PA.ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->Derivatives(x, PA.qder);
+   const double lim_c = GetPALimitingScale();
+   if (lim_c != 0.0) { qi->Values(x, PA.qval); }
+   const int NE = PA.ne, NQ = PA.nq, M = PA.metric_id;
+   const int D1D = PA.maps->ndof, Q1D = PA.maps->nqpt;
+   const double metric_c = GetPAMetricScale();
+   const double *JW = PA.Jrt_W.Read();
+   const double *X0 = PA.X0_D.Read();
+   double *QD = PA.qder.ReadWrite();
+   double *QV = lim_c != 0.0 ? PA.qval.ReadWrite() : NULL;
+   const double *B = PA.maps->B.Read();
+   const double *G = PA.maps->G.Read();
+   double *Y = y.ReadWrite();
+   if (PA.dim == 2)
+   {
+      TMOPResidualPA<2>(M, NE, NQ, metric_c, lim_c, JW, X0, QD, QV);
+      TMOPApplyT2D(NE, B, G, QD, QV, Y, D1D, Q1D);
+   }
+   else
+   {
+      TMOPResidualPA<3>(M, NE, NQ, metric_c, lim_c, JW, X0, QD, QV);
+      TMOPApplyT3D(NE, B, G, QD, QV, Y, D1D, Q1D);
+   }
+}
+
+void TMOP_Integrator::AddMultGradPA(const Vector &g,
+                                    const Vector &x, Vector &y) const
+{
+   MFEM_CONTRACT_VAR(g);
+   if (PA.ne == 0) { return; }
+   const int NE = PA.ne, NQ = PA.nq, M = PA.metric_id;
+   MFEM_VERIFY(PA.Jpt.Size() == PA.dim*PA.dim*NQ*NE,
+               "AssembleGradPA() must be called first!");
+   const QuadratureInterpolator *qi = PA.fes->GetQuadratureInterpolator(*PA.ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->Derivatives(x, PA.qder);
+   const double lim_c = GetPALimitingScale();
+   if (lim_c != 0.0) { qi->Values(x, PA.qval); }
+   const int D1D = PA.maps->ndof, Q1D = PA.maps->nqpt;
+   const double metric_c = GetPAMetricScale();
+   const double *JW = PA.Jrt_W.Read();
+   const double *X0 = PA.X0_D.Read();
+   const double *J = PA.Jpt.Read();
+   double *QD = PA.qder.ReadWrite();
+   double *QV = lim_c != 0.0 ? PA.qval.ReadWrite() : NULL;
+   const double *B = PA.maps->B.Read();
+   const double *G = PA.maps->G.Read();
+   double *Y = y.ReadWrite();
+   if (PA.dim == 2)
+   {
+      TMOPGradPA<2>(M, NE, NQ, metric_c, lim_c, JW, X0, J, QD, QV);
+      TMOPApplyT2D(NE, B, G, QD, QV, Y, D1D, Q1D);
+   }
+   else
+   {
+      TMOPGradPA<3>(M, NE, NQ, metric_c, lim_c, JW, X0, J, QD, QV);
+      TMOPApplyT3D(NE, B, G, QD, QV, Y, D1D, Q1D);
+   }
+}
+
+void TMOP_Integrator::AssembleGradDiagonalPA(const Vector &g,
+                                             Vector &diag) const
+{
+   MFEM_CONTRACT_VAR(g);
+   if (PA.ne == 0) { return; }
+   const int NE = PA.ne, M = PA.metric_id;
+   MFEM_VERIFY(PA.Jpt.Size() == PA.dim*PA.dim*PA.nq*NE,
+               "AssembleGradPA() must be called first!");
+   const int D1D = PA.maps->ndof, Q1D = PA.maps->nqpt;
+   const double metric_c = GetPAMetricScale();
+   const double lim_c = GetPALimitingScale();
+   const double *B = PA.maps->B.Read();
+   const double *G = PA.maps->G.Read();
+   const double *JW = PA.Jrt_W.Read();
+   const double *X0 = PA.X0_D.Read();
+   const double *J = PA.Jpt.Read();
+   double *Y = diag.ReadWrite();
+   if (PA.dim == 2)
+   {
+      TMOPDiagonalPA<2>(M, NE, metric_c, lim_c, B, G, JW, X0, J, Y, D1D, Q1D);
+   }
+   else
+   {
+      TMOPDiagonalPA<3>(M, NE, metric_c, lim_c, B, G, JW, X0, J, Y, D1D, Q1D);
+   }
+}
+
+} // namespace mfem
@@ -20,6 +20,7 @@
 #include "table.hpp"
 #include "sets.hpp"
 #include "globals.hpp"
+#include "profiler.hpp"
 #include <mpi.h>
 
 
@@ -28,7 +29,8 @@ namespace mfem
 
 /** @brief A simple convenience class that calls MPI_Init() at construction and
     MPI_Finalize() at destruction. It also provides easy access to
-    MPI_COMM_WORLD's rank and size. */
+    MPI_COMM_WORLD's rank and size. Before MPI_Finalize(), the output of the
+    Profiler, if requested, is aggregated over MPI_COMM_WORLD. */
 class MPI_Session
 {
 protected:
@@ -38,7 +40,7 @@ public:
    MPI_Session() { MPI_Init(NULL, NULL); GetRankAndSize(); }
    MPI_Session(int &argc, char **&argv)
    { MPI_Init(&argc, &argv); GetRankAndSize(); }
-   ~MPI_Session() { MPI_Finalize(); }
+   ~MPI_Session() { Profiler::Finalize(); MPI_Finalize(); }
    /// Return MPI_COMM_WORLD's rank.
    int WorldRank() const { return world_rank; }
    /// Return MPI_COMM_WORLD's size.
@@ -18,6 +18,7 @@
 #include <unordered_map>
 #include <string>
 #include <map>
+#include <cctype>
 
 namespace mfem
 {
@@ -44,7 +45,7 @@ static const Backend::Id backend_list[Backend::NUM_BACKENDS] =
 {
    Backend::CEED_CUDA, Backend::OCCA_CUDA, Backend::RAJA_CUDA, Backend::CUDA,
    Backend::CEED_HIP, Backend::HIP, Backend::DEBUG_DEVICE,
-   Backend::OCCA_OMP, Backend::RAJA_OMP, Backend::OMP,
+   Backend::OCCA_OMP, Backend::RAJA_OMP, Backend::OMP, Backend::THREADS,
    Backend::CEED_CPU, Backend::OCCA_CPU, Backend::RAJA_CPU, Backend::CPU
 };
 
@@ -53,10 +54,25 @@ static const char *backend_name[Backend::NUM_BACKENDS] =
 {
    "ceed-cuda", "occa-cuda", "raja-cuda", "cuda",
    "ceed-hip", "hip", "debug",
-   "occa-omp", "raja-omp", "omp",
+   "occa-omp", "raja-omp", "omp", "threads",
    "ceed-cpu", "occa-cpu", "raja-cpu", "cpu"
 };
 
+// Return true if @a name is one of the '+'-separated device options, e.g.
+// 'pool' and 'profile' in 'cuda:pool+profile'.
+static bool HasDeviceOption(const char *device_option, const char *name)
+{
+   if (!device_option) { return false; }
+   const std::size_t length = std::strlen(name);
+   for (const char *opt = device_option; opt; opt = std::strchr(opt, '+'))
+   {
+      if (*opt == '+') { opt++; }
+      if (!std::strncmp(opt, name, length) &&
+          (opt[length] == '\0' || opt[length] == '+')) { return true; }
+   }
+   return false;
+}
+
 } // namespace mfem::internal
 
 
@@ -105,6 +121,24 @@ Device::Device() : mode(Device::SEQUENTIAL),
          // Device::UpdateMemoryTypeAndClass().
          device_mem_type = MemoryType::HOST_UMPIRE;
       }
+      else if (mem_backend == "pool")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_POOL;
+         // Note: device_mem_type will be set to MemoryType::DEVICE_POOL only
+         // when an actual device is configured -- this is done later in
+         // Device::UpdateMemoryTypeAndClass().
+         device_mem_type = MemoryType::HOST_POOL;
+      }
+      else if (mem_backend == "numa" || mem_backend == "numa-interleave")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_NUMA;
+         device_mem_type = MemoryType::HOST_NUMA;
+         mm.SetNumaPolicy(mem_backend == "numa" ?
+                          MemoryNumaPolicy::FIRST_TOUCH :
+                          MemoryNumaPolicy::INTERLEAVE);
+      }
       else if (mem_backend == "debug")
       {
          mem_host_env = true;
@@ -142,6 +176,8 @@ Device::Device() : mode(Device::SEQUENTIAL),
       mm.Configure(host_mem_type, device_mem_type);
    }
 
+   if (getenv("MFEM_PROFILE")) { Profiler::SetOutput(getenv("MFEM_PROFILE")); }
+
    if (getenv("MFEM_DEVICE"))
    {
       std::string device(getenv("MFEM_DEVICE"));
@@ -175,8 +211,10 @@ Device::~Device()
       mm.Destroy();
    }
    Get().ngpu = -1;
+   Get().device_option = NULL;
    Get().mode = SEQUENTIAL;
    Get().backends = Backend::CPU;
+   Get().async = false;
    Get().host_mem_type = MemoryType::HOST;
    Get().host_mem_class = MemoryClass::HOST;
    Get().device_mem_type = MemoryType::HOST;
@@ -245,12 +283,32 @@ void Device::Configure(const std::string &device, const int dev)
    }
 #endif
 
+   // Enable the profiler when requested, e.g. with 'cpu:profile'
+   if (internal::HasDeviceOption(Get().device_option, "profile") &&
+       !Profiler::IsEnabled())
+   {
+      Profiler::SetOutput("text");
+   }
+
+   // Record the host/device transfers when requested, e.g. with
+   // 'debug:transfers', and report them at exit
+   if (internal::HasDeviceOption(Get().device_option, "transfers"))
+   {
+      mm.EnableTransferTrace(true);
+   }
+
+   // Run the ExecutionQueue operations concurrently when requested
+   Get().async = internal::HasDeviceOption(Get().device_option, "async");
+
    // Perform setup.
    Get().Setup(dev);
 
    // Enable the device
    Enable();
 
+   MFEM_VERIFY(!Get().async || !Allows(~(Backend::CPU | Backend::THREADS)),
+               "the 'async' option requires the 'cpu' or 'threads' backends");
+
    // Copy all data members from the global 'singleton_device' into '*this'.
    if (this != &Get()) { std::memcpy(this, &Get(), sizeof(Device)); }
 
@@ -258,6 +316,24 @@ void Device::Configure(const std::string &device, const int dev)
    destroy_mm = true;
 }
 
+Backend::Id Device::GetBackend()
+{
+   for (int i = 0; i < Backend::NUM_BACKENDS; i++)
+   {
+      if (Allows(internal::backend_list[i])) { return internal::backend_list[i]; }
+   }
+   return Backend::CPU;
+}
+
+const char *Device::GetBackendName()
+{
+   for (int i = 0; i < Backend::NUM_BACKENDS; i++)
+   {
+      if (Allows(internal::backend_list[i])) { return internal::backend_name[i]; }
+   }
+   return "cpu";
+}
+
 void Device::Print(std::ostream &out)
 {
    out << "Device configuration: ";
@@ -315,6 +391,9 @@ void Device::UpdateMemoryTypeAndClass()
                case MemoryType::HOST_DEBUG:
                   device_mem_type = MemoryType::DEVICE_DEBUG;
                   break;
+               case MemoryType::HOST_POOL:
+                  device_mem_type = MemoryType::DEVICE_POOL;
+                  break;
                default:
                   device_mem_type = MemoryType::DEVICE;
             }
@@ -332,7 +411,7 @@ void Device::UpdateMemoryTypeAndClass()
    }
 
    // Enable the UVM shortcut when requested
-   if (device && device_option && !strcmp(device_option, "uvm"))
+   if (device && internal::HasDeviceOption(device_option, "uvm"))
    {
       host_mem_type = MemoryType::MANAGED;
       device_mem_type = MemoryType::MANAGED;
@@ -345,6 +424,26 @@ void Device::UpdateMemoryTypeAndClass()
       device_mem_type = MemoryType::DEVICE_DEBUG;
    }
 
+   // Enable the caching pools when requested, e.g. with 'cuda:pool', also
+   // with the 'debug' device, which then uses the host as pool backend
+   if (internal::HasDeviceOption(device_option, "pool"))
+   {
+      host_mem_type = MemoryType::HOST_POOL;
+      device_mem_type = device ? MemoryType::DEVICE_POOL : MemoryType::HOST_POOL;
+   }
+
+   // Place the host pages on the NUMA nodes when requested, e.g. with
+   // 'omp:numa' or 'threads:numa+interleave'
+   const bool interleave = internal::HasDeviceOption(device_option,
+                                                     "interleave");
+   if (interleave || internal::HasDeviceOption(device_option, "numa"))
+   {
+      host_mem_type = MemoryType::HOST_NUMA;
+      if (!device) { device_mem_type = MemoryType::HOST_NUMA; }
+      mm.SetNumaPolicy(interleave ? MemoryNumaPolicy::INTERLEAVE :
+                       MemoryNumaPolicy::FIRST_TOUCH);
+   }
+
    // Update the memory manager with the new settings
    mm.Configure(host_mem_type, device_mem_type);
 }
@@ -472,6 +571,15 @@ static void CeedDeviceSetup(const char* ceed_spec)
 #endif
 }
 
+static void ThreadsDeviceSetup(const char *device_option)
+{
+   // The number of threads can be given as option, e.g. 'threads:8'
+   if (device_option && std::isdigit(device_option[0]))
+   {
+      ThreadPool::SetNumThreads(std::atoi(device_option));
+   }
+}
+
 void Device::Setup(const int device)
 {
    MFEM_VERIFY(ngpu == -1, "the mfem::Device is already configured!");
@@ -544,6 +652,7 @@ void Device::Setup(const int device)
          CeedDeviceSetup(device_option);
       }
    }
+   if (Allows(Backend::THREADS)) { ThreadsDeviceSetup(device_option); }
    if (Allows(Backend::DEBUG_DEVICE)) { ngpu = 1; }
 }
 
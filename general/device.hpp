@@ -69,7 +69,10 @@ struct Backend
           (using separate host/device memory pools and host <-> device
           transfers) without any GPU hardware. As 'DEBUG' is sometimes used
           as a macro, `_DEVICE` has been added to avoid conflicts. */
-      DEBUG_DEVICE = 1 << 13
+      DEBUG_DEVICE = 1 << 13,
+      /** @brief [host] Native threads backend: the MFEM_FORALL kernels are run
+          by the work-stealing ThreadPool on each MPI rank. */
+      THREADS = 1 << 14
    };
 
    /** @brief Additional useful constants. For example, the *_MASK constants can
@@ -77,7 +80,7 @@ struct Backend
    enum
    {
       /// Number of backends: from (1 << 0) to (1 << (NUM_BACKENDS-1)).
-      NUM_BACKENDS = 14,
+      NUM_BACKENDS = 15,
 
       /// Biwise-OR of all CPU backends
       CPU_MASK = CPU | RAJA_CPU | OCCA_CPU | CEED_CPU,
@@ -131,6 +134,7 @@ private:
    /// Set to true during configuration, except in 'device_singleton'.
    bool destroy_mm;
    bool mpi_gpu_aware;
+   bool async = false; ///< Set by the 'async' option, see ExecutionQueue.
 
    MemoryType host_mem_type;      ///< Current Host MemoryType
    MemoryClass host_mem_class;    ///< Current Host MemoryClass
@@ -203,7 +207,7 @@ public:
        * The current backend priority from highest to lowest is:
          'ceed-cuda', 'occa-cuda', 'raja-cuda', 'cuda',
          'ceed-hip', 'hip', 'debug',
-         'occa-omp', 'raja-omp', 'omp',
+         'occa-omp', 'raja-omp', 'omp', 'threads',
          'ceed-cpu', 'occa-cpu', 'raja-cpu', 'cpu'.
        * Multiple backends can be configured at the same time.
        * Only one 'occa-*' backend can be configured at a time.
@@ -221,6 +225,36 @@ public:
          and evaluation of operators and enables the 'hip' backend to avoid
          transfers between host and device.
        * The 'debug' backend should not be combined with other device backends.
+       * The option ':pool' appended to a backend name, e.g. 'cpu:pool',
+         'cuda:pool' or 'debug:pool', selects the caching pool memory types,
+         MemoryType::HOST_POOL and MemoryType::DEVICE_POOL, see also the
+         MemoryManager methods SetPoolHighWaterMark() and GetPoolStats(). The
+         pools can also be selected by setting the environment variable
+         MFEM_MEMORY to 'pool'.
+       * The option ':numa', e.g. 'omp:numa' or 'threads:numa', selects the
+         MemoryType::HOST_NUMA host memory, whose pages are first touched at
+         allocation by the threads of the backend, so that they are placed on
+         the NUMA nodes of the threads using them. With ':interleave', e.g.
+         'omp:numa+interleave', the pages are interleaved among the NUMA nodes
+         instead, see MemoryNumaPolicy. The environment variable MFEM_MEMORY
+         can also be set to 'numa' or 'numa-interleave'.
+       * The option ':profile' enables the Profiler, which prints a summary of
+         the time spent in the MFEM regions and kernels at exit. The profiler
+         can also be enabled by setting the environment variable MFEM_PROFILE,
+         see the Profiler documentation.
+       * The option ':<n>' appended to the 'threads' backend, e.g. 'threads:8',
+         sets the number of threads of the ThreadPool, see
+         ThreadPool::SetNumThreads().
+       * The option ':async', e.g. 'threads:async', runs the operations of the
+         ExecutionQueue objects concurrently on the ThreadPool, e.g. the
+         blocks of BlockOperator. It requires the 'cpu' or 'threads'
+         backends.
+       * The option ':transfers', e.g. 'debug:transfers+profile', records the
+         host/device copies with their call site, i.e. their Profiler region,
+         and reports them at exit, see MemoryManager::EnableTransferTrace().
+       * Several of the 'pool', 'numa', 'interleave', 'profile', 'uvm',
+         'async' and 'transfers' options can be combined with '+', e.g.
+         'cuda:pool+profile' or 'threads:8+async'.
    */
    void Configure(const std::string &device, const int dev = 0);
 
@@ -246,6 +280,12 @@ public:
    static inline bool Allows(unsigned long b_mask)
    { return Get().backends & b_mask; }
 
+   /// Return the configured backend with the highest priority.
+   static Backend::Id GetBackend();
+
+   /// Return the name of the configured backend with the highest priority.
+   static const char *GetBackendName();
+
    /** @brief Get the current Host MemoryType. This is the MemoryType used by
        most MFEM classes when allocating memory used on the host.
    */
@@ -276,6 +316,10 @@ public:
    { Get().mpi_gpu_aware = force; }
 
    static bool GetGPUAwareMPI() { return Get().mpi_gpu_aware; }
+
+   /** @brief Return true if the ExecutionQueue operations run concurrently,
+       i.e. if the Device was configured with the 'async' option. */
+   static bool IsAsync() { return Get().async; }
 };
 
 
@@ -0,0 +1,127 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "execution_queue.hpp"
+
+#include <mutex>
+#include <thread>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// An operation of an ExecutionQueue, which is also the state of its Event.
+struct QueueOperation
+{
+   std::function<void()> fn;
+   ExecutionQueue *queue;
+   // Number of incomplete dependencies, plus one while it is being enqueued
+   std::atomic<int> waiting;
+   // Protects 'successors' and the update of 'complete'
+   std::mutex mutex;
+   std::atomic<bool> complete;
+   // Operations waiting for this one
+   std::vector<std::shared_ptr<QueueOperation>> successors;
+
+   QueueOperation() : queue(nullptr), waiting(1), complete(false) { }
+};
+
+} // namespace mfem::internal
+
+
+bool Event::IsComplete() const { return !op || op->complete; }
+
+void Event::Wait() const
+{
+   while (!IsComplete())
+   {
+      if (!ThreadPool::RunTask()) { std::this_thread::yield(); }
+   }
+}
+
+bool ExecutionQueue::IsConcurrent()
+{
+   return Device::IsAsync() && ThreadPool::GetNumThreads() > 1;
+}
+
+Event ExecutionQueue::Enqueue(std::function<void()> fn,
+                              const std::vector<Event> &deps)
+{
+   Event event;
+   if (!IsConcurrent())
+   {
+      // The operations run in program order, so deps are already complete
+      for (const Event &dep : deps) { dep.Wait(); }
+      fn();
+      return event;
+   }
+   std::shared_ptr<internal::QueueOperation> op =
+      std::make_shared<internal::QueueOperation>();
+   op->fn = std::move(fn);
+   op->queue = this;
+   incomplete++;
+   for (const Event &dep : deps)
+   {
+      if (!dep.op) { continue; }
+      std::lock_guard<std::mutex> guard(dep.op->mutex);
+      if (!dep.op->complete)
+      {
+         op->waiting++;
+         dep.op->successors.push_back(op);
+      }
+   }
+   if (--op->waiting == 0) { Launch(op); }
+   event.op = op;
+   return event;
+}
+
+void ExecutionQueue::Launch(const std::shared_ptr<internal::QueueOperation>
+                            &op)
+{
+   tasks.Run([op]()
+   {
+      op->fn();
+      Complete(op);
+   });
+}
+
+void ExecutionQueue::Complete(const std::shared_ptr<internal::QueueOperation>
+                              &op)
+{
+   std::vector<std::shared_ptr<internal::QueueOperation>> successors;
+   {
+      std::lock_guard<std::mutex> guard(op->mutex);
+      op->complete = true;
+      successors.swap(op->successors);
+   }
+   // Release the data captured by the operation
+   op->fn = nullptr;
+   ExecutionQueue *queue = op->queue;
+   for (auto &next : successors)
+   {
+      if (--next->waiting == 0) { next->queue->Launch(next); }
+   }
+   // The queue may be destroyed once all its operations are complete
+   queue->incomplete--;
+}
+
+void ExecutionQueue::Synchronize()
+{
+   while (incomplete > 0)
+   {
+      if (!ThreadPool::RunTask()) { std::this_thread::yield(); }
+   }
+   tasks.Wait();
+}
+
+} // namespace mfem
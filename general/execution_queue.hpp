@@ -0,0 +1,92 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_EXECUTION_QUEUE_HPP
+#define MFEM_EXECUTION_QUEUE_HPP
+
+#include "../config/config.hpp"
+#include "forall.hpp"
+#include "thread_pool.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace mfem
+{
+
+namespace internal { struct QueueOperation; }
+
+/** @brief Completion handle of an operation enqueued in an ExecutionQueue. A
+    default constructed Event is always complete. */
+class Event
+{
+   friend class ExecutionQueue;
+   std::shared_ptr<internal::QueueOperation> op;
+
+public:
+   /// Return true if the operation is complete.
+   bool IsComplete() const;
+
+   /** @brief Wait for the completion of the operation, running other queued
+       operations in the meantime. */
+   void Wait() const;
+};
+
+
+/** @brief Queue of operations, e.g. kernels or Operator applications, with
+    explicit dependencies.
+
+    The operations of a queue are only ordered by their dependencies: an
+    operation starts after the completion of all the Events it depends on,
+    which may belong to other queues. With the Device option 'async', e.g.
+    'cpu:async' or 'threads:async', the operations run concurrently on the
+    ThreadPool as soon as their dependencies are complete; the kernels of the
+    operations running on the workers are then sequential. Otherwise, and with
+    the device backends, each operation runs immediately when it is enqueued,
+    i.e. in program order.
+
+    The operations and the data they use must stay valid until the operations
+    are complete, e.g. until Synchronize() returns. The destructor waits for
+    all the operations of the queue. */
+class ExecutionQueue
+{
+   std::atomic<int> incomplete; // Number of incomplete operations
+   TaskGroup tasks;             // Tasks of the running operations
+
+   void Launch(const std::shared_ptr<internal::QueueOperation> &op);
+   static void Complete(const std::shared_ptr<internal::QueueOperation> &op);
+
+public:
+   ExecutionQueue() : incomplete(0) { }
+
+   /** @brief Return true if the queued operations run concurrently, i.e. with
+       the Device option 'async' and more than one ThreadPool thread. */
+   static bool IsConcurrent();
+
+   /// Enqueue the function @a fn, which runs after the Events @a deps.
+   Event Enqueue(std::function<void()> fn,
+                 const std::vector<Event> &deps = std::vector<Event>());
+
+   /// Wait for the completion of all the operations of the queue.
+   void Synchronize();
+
+   ~ExecutionQueue() { Synchronize(); }
+};
+
+} // namespace mfem
+
+/** @brief Enqueue an MFEM_FORALL kernel in the ExecutionQueue @a queue, after
+    the Events @a deps, and return its Event. The captured variables are copied
+    when the kernel is enqueued. */
+#define MFEM_FORALL_ASYNC(queue,deps,i,N,...) \
+   (queue).Enqueue([=]() { MFEM_FORALL(i,N,__VA_ARGS__); }, deps)
+
+#endif // MFEM_EXECUTION_QUEUE_HPP
@@ -17,6 +17,8 @@
 #include "backends.hpp"
 #include "device.hpp"
 #include "mem_manager.hpp"
+#include "profiler.hpp"
+#include "thread_pool.hpp"
 #include "../linalg/dtensor.hpp"
 
 namespace mfem
@@ -37,27 +39,30 @@ const int MAX_Q1D = 14;
 #endif
 
 // Implementation of MFEM's "parallel for" (forall) device/host kernel
-// interfaces supporting RAJA, CUDA, OpenMP, and sequential backends.
+// interfaces supporting RAJA, CUDA, OpenMP, native threads, and sequential
+// backends.
 
-// The MFEM_FORALL wrapper
+// The MFEM_FORALL wrapper. When the Profiler is enabled, the kernels are
+// recorded as regions named after the function that launches them.
 #define MFEM_FORALL(i,N,...)                             \
    ForallWrap<1>(true,N,                                 \
                  [=] MFEM_DEVICE (int i) {__VA_ARGS__},  \
-                 [&] MFEM_LAMBDA (int i) {__VA_ARGS__})
+                 [&] MFEM_LAMBDA (int i) {__VA_ARGS__},\
+                 0,0,0,__func__)
 
 // MFEM_FORALL with a 2D CUDA block
 #define MFEM_FORALL_2D(i,N,X,Y,BZ,...)                   \
    ForallWrap<2>(true,N,                                 \
                  [=] MFEM_DEVICE (int i) {__VA_ARGS__},  \
                  [&] MFEM_LAMBDA (int i) {__VA_ARGS__},\
-                 X,Y,BZ)
+                 X,Y,BZ,__func__)
 
 // MFEM_FORALL with a 3D CUDA block
 #define MFEM_FORALL_3D(i,N,X,Y,Z,...)                    \
    ForallWrap<3>(true,N,                                 \
                  [=] MFEM_DEVICE (int i) {__VA_ARGS__},  \
                  [&] MFEM_LAMBDA (int i) {__VA_ARGS__},\
-                 X,Y,Z)
+                 X,Y,Z,__func__)
 
 // MFEM_FORALL that uses the basic CPU backend when use_dev is false. See for
 // example the functions in vector.cpp, where we don't want to use the mfem
@@ -65,7 +70,8 @@ const int MAX_Q1D = 14;
 #define MFEM_FORALL_SWITCH(use_dev,i,N,...)              \
    ForallWrap<1>(use_dev,N,                              \
                  [=] MFEM_DEVICE (int i) {__VA_ARGS__},  \
-                 [&] MFEM_LAMBDA (int i) {__VA_ARGS__})
+                 [&] MFEM_LAMBDA (int i) {__VA_ARGS__},\
+                 0,0,0,__func__)
 
 
 /// OpenMP backend
@@ -307,12 +313,22 @@ void HipWrap3D(const int N, DBODY &&d_body,
 template <const int DIM, typename DBODY, typename HBODY>
 inline void ForallWrap(const bool use_dev, const int N,
                        DBODY &&d_body, HBODY &&h_body,
-                       const int X=0, const int Y=0, const int Z=0)
+                       const int X=0, const int Y=0, const int Z=0,
+                       const char *name = nullptr)
 {
    MFEM_CONTRACT_VAR(X);
    MFEM_CONTRACT_VAR(Y);
    MFEM_CONTRACT_VAR(Z);
    MFEM_CONTRACT_VAR(d_body);
+   if (name && Profiler::IsEnabled())
+   {
+      // Synchronize the device kernels, so that their time is recorded.
+      Profiler::Begin(name);
+      ForallWrap<DIM>(use_dev, N, d_body, h_body, X, Y, Z);
+      if (use_dev && Device::Allows(Backend::DEVICE_MASK)) { MFEM_STREAM_SYNC; }
+      Profiler::End();
+      return;
+   }
    if (!use_dev) { goto backend_cpu; }
 
 #if defined(MFEM_USE_RAJA) && defined(RAJA_ENABLE_CUDA)
@@ -358,6 +374,9 @@ inline void ForallWrap(const bool use_dev, const int N,
    if (Device::Allows(Backend::OMP)) { return OmpWrap(N, h_body); }
 #endif
 
+   // If Backend::THREADS is allowed, use it
+   if (Device::Allows(Backend::THREADS)) { return ThreadPool::For(N, h_body); }
+
 #ifdef MFEM_USE_RAJA
    // If Backend::RAJA_CPU is allowed, use it
    if (Device::Allows(Backend::RAJA_CPU)) { return RajaSeqWrap(N, h_body); }
@@ -120,6 +120,10 @@ public:
    void Reparent(int id, int new_p1, int new_p2);
    void Reparent(int id, int new_p1, int new_p2, int new_p3, int new_p4 = -1);
 
+   /** @brief Make sure the hash table can hold @a nitems items without
+       rehashing, e.g. before a large batch of insertions. */
+   void Reserve(int nitems);
+
    /// Return total size of allocated memory (tables plus items), in bytes.
    long MemoryUsage() const;
 
@@ -197,9 +201,12 @@ protected:
    inline void Insert(int idx, int id, T &item);
    void Unlink(int idx, int id);
 
+   /// Maximum average length of the lists in the hash table
+   static const int fill_factor = 2;
+
    /// Check table load factor and resize if necessary
    inline void CheckRehash();
-   void DoRehash();
+   void DoRehash(int new_table_size);
 };
 
 
@@ -408,22 +415,27 @@ int HashTable<T>::SearchList(int id, int p1, int p2, int p3) const
 template<typename T>
 inline void HashTable<T>::CheckRehash()
 {
-   const int fill_factor = 2;
-
    // is the table overfull?
    if (Base::Size() > (mask+1) * fill_factor)
    {
-      DoRehash();
+      // double the table size
+      DoRehash(2*(mask+1));
    }
 }
 
 template<typename T>
-void HashTable<T>::DoRehash()
+void HashTable<T>::Reserve(int nitems)
+{
+   int new_table_size = mask+1;
+   while (nitems > new_table_size * fill_factor) { new_table_size *= 2; }
+   if (new_table_size > mask+1) { DoRehash(new_table_size); }
+}
+
+template<typename T>
+void HashTable<T>::DoRehash(int new_table_size)
 {
    delete [] table;
 
-   // double the table size
-   int new_table_size = 2*(mask+1);
    table = new int[new_table_size];
    for (int i = 0; i < new_table_size; i++) { table[i] = -1; }
    mask = new_table_size-1;
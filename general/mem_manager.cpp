@@ -11,10 +11,20 @@
 
 #include "forall.hpp"
 #include "mem_manager.hpp"
+#include "profiler.hpp"
 
 #include <list>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread> // std::this_thread::yield
+#include <memory> // std::unique_ptr
+#include <vector>
+#include <cstdint>
+#include <cstdlib> // std::atexit
 #include <cstring> // std::memcpy, std::memcmp
-#include <unordered_map>
+#include <iomanip>
+#include <string>
 #include <algorithm> // std::max
 
 // Uncomment to try _WIN32 platform
@@ -25,6 +35,9 @@
 #include <unistd.h>
 #include <signal.h>
 #include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #define mfem_memalign(p,a,s) posix_memalign(p,a,s)
 #define mfem_aligned_free free
 #else
@@ -72,10 +85,13 @@ MemoryType MemoryManager::GetDualMemoryType_(MemoryType mt)
       case MemoryType::HOST_64:        return MemoryType::DEVICE;
       case MemoryType::HOST_DEBUG:     return MemoryType::DEVICE_DEBUG;
       case MemoryType::HOST_UMPIRE:    return MemoryType::DEVICE_UMPIRE;
+      case MemoryType::HOST_POOL:      return MemoryType::DEVICE_POOL;
+      case MemoryType::HOST_NUMA:      return MemoryType::DEVICE;
       case MemoryType::MANAGED:        return MemoryType::MANAGED;
       case MemoryType::DEVICE:         return MemoryType::HOST;
       case MemoryType::DEVICE_DEBUG:   return MemoryType::HOST_DEBUG;
       case MemoryType::DEVICE_UMPIRE:  return MemoryType::HOST_UMPIRE;
+      case MemoryType::DEVICE_POOL:    return MemoryType::HOST_POOL;
       default: mfem_error("Unknown memory type!");
    }
    MFEM_VERIFY(false,"");
@@ -89,7 +105,9 @@ static void MFEM_VERIFY_TYPES(const MemoryType h_mt, const MemoryType d_mt)
    const bool sync =
       (h_mt == MemoryType::HOST_UMPIRE && d_mt == MemoryType::DEVICE_UMPIRE) ||
       (h_mt == MemoryType::HOST_DEBUG && d_mt == MemoryType::DEVICE_DEBUG) ||
+      (h_mt == MemoryType::HOST_POOL && d_mt == MemoryType::DEVICE_POOL) ||
       (h_mt == MemoryType::MANAGED && d_mt == MemoryType::MANAGED) ||
+      (h_mt == MemoryType::HOST_NUMA && d_mt == MemoryType::DEVICE) ||
       (h_mt == MemoryType::HOST_64 && d_mt == MemoryType::DEVICE) ||
       (h_mt == MemoryType::HOST_32 && d_mt == MemoryType::DEVICE) ||
       (h_mt == MemoryType::HOST && d_mt == MemoryType::DEVICE);
@@ -151,9 +169,234 @@ struct Alias
    const MemoryType h_mt;
 };
 
+/// Lock of the shards of PointerMap, whose critical sections are short enough
+/// for a spin lock to be cheaper than a std::mutex
+class SpinLock
+{
+   std::atomic_flag flag;
+public:
+   SpinLock() { flag.clear(); }
+   void lock()
+   {
+      while (flag.test_and_set(std::memory_order_acquire))
+      {
+         std::this_thread::yield();
+      }
+   }
+   void unlock() { flag.clear(std::memory_order_release); }
+};
+
+/// Hash map from the registered host pointers to their entries, which can be
+/// used concurrently by several threads
+/** The pointers are distributed among independent shards, each one protected
+    by its own lock, so that threads registering different pointers rarely
+    contend. Each shard is an open addressing table with linear probing, which
+    only stores the pointers and the addresses of their entries. The entries
+    are allocated by blocks and recycled through a free list, so they never
+    move: the references returned by Find() and At() stay valid until the
+    entry is erased. */
+template <typename V>
+class PointerMap
+{
+   static constexpr size_t num_shards = 64;
+   static constexpr size_t block_size = 64;
+
+   union Node
+   {
+      Node *next; // next free node
+      V value;
+      Node() : next(nullptr) { }
+      ~Node() { }
+   };
+
+   struct Slot { const void *key; Node *node; };
+
+   struct Shard
+   {
+      SpinLock lock;
+      std::vector<Slot> slots; // empty, or a power of 2 slots
+      size_t size;
+      Node *free;
+      std::vector<std::unique_ptr<Node[]>> blocks;
+      char padding[64]; // keep the locks of the shards on distinct cache lines
+      Shard() : size(0), free(nullptr) { }
+   };
+
+   Shard shards[num_shards];
+
+   static size_t Hash(const void *key)
+   {
+      // MurmurHash3 finalizer: the low bits of the addresses are not random
+      std::uint64_t h = reinterpret_cast<std::uintptr_t>(key);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return static_cast<size_t>(h);
+   }
+
+   static size_t Home(const Shard &s, size_t h)
+   { return (h / num_shards) & (s.slots.size() - 1); }
+
+   // Return the slot of @a key, or the empty slot where it would be inserted.
+   static size_t Probe(const Shard &s, const void *key, size_t h)
+   {
+      const size_t mask = s.slots.size() - 1;
+      size_t i = Home(s, h);
+      while (s.slots[i].key && s.slots[i].key != key) { i = (i + 1) & mask; }
+      return i;
+   }
+
+   // Double the number of slots, keeping the load factor at most 1/2.
+   static void Grow(Shard &s)
+   {
+      std::vector<Slot> slots(std::max<size_t>(16, 2*s.slots.size()),
+                              Slot{nullptr, nullptr});
+      slots.swap(s.slots);
+      for (const Slot &slot : slots)
+      {
+         if (slot.key) { s.slots[Probe(s, slot.key, Hash(slot.key))] = slot; }
+      }
+   }
+
+   static Node *NewNode(Shard &s)
+   {
+      if (!s.free)
+      {
+         Node *block = new Node[block_size];
+         s.blocks.emplace_back(block);
+         for (size_t i = 0; i + 1 < block_size; i++)
+         {
+            block[i].next = block + i + 1;
+         }
+         s.free = block;
+      }
+      Node *node = s.free;
+      s.free = node->next;
+      return node;
+   }
+
+   // Remove the entry of slot @a i, with backward shift deletion: the next
+   // keys of the cluster are moved back if the hole would hide them.
+   static void Remove(Shard &s, size_t i)
+   {
+      Node *node = s.slots[i].node;
+      node->value.~V();
+      node->next = s.free;
+      s.free = node;
+      s.size--;
+      const size_t mask = s.slots.size() - 1;
+      for (size_t j = (i + 1) & mask; s.slots[j].key; j = (j + 1) & mask)
+      {
+         const size_t k = Home(s, Hash(s.slots[j].key));
+         if (((j - k) & mask) >= ((j - i) & mask))
+         {
+            s.slots[i] = s.slots[j];
+            i = j;
+         }
+      }
+      s.slots[i] = Slot{nullptr, nullptr};
+   }
+
+public:
+   ~PointerMap()
+   {
+      for (Shard &s : shards)
+      {
+         for (Slot &slot : s.slots)
+         {
+            if (slot.key) { slot.node->value.~V(); }
+         }
+      }
+   }
+
+   /// Return the entry of @a key, or nullptr if @a key is not in the map.
+   V *Find(const void *key)
+   {
+      const size_t h = Hash(key);
+      Shard &s = shards[h % num_shards];
+      std::lock_guard<SpinLock> guard(s.lock);
+      if (s.size == 0) { return nullptr; }
+      const Slot &slot = s.slots[Probe(s, key, h)];
+      return slot.key ? &slot.node->value : nullptr;
+   }
+
+   /// Return the entry of @a key, which must be in the map.
+   V &At(const void *key)
+   {
+      V *value = Find(key);
+      if (!value) { mfem_error("Unknown pointer!"); }
+      return *value;
+   }
+
+   /** @brief Insert @a value as the entry of @a key and return true, or call
+       update(entry) on the existing entry of @a key and return false. */
+   /** The update is done while holding the lock of the shard of @a key. */
+   template <typename U>
+   bool Emplace(const void *key, const V &value, U &&update)
+   {
+      const size_t h = Hash(key);
+      Shard &s = shards[h % num_shards];
+      std::lock_guard<SpinLock> guard(s.lock);
+      if (2*(s.size + 1) > s.slots.size()) { Grow(s); }
+      const size_t i = Probe(s, key, h);
+      if (s.slots[i].key)
+      {
+         update(s.slots[i].node->value);
+         return false;
+      }
+      Node *node = NewNode(s);
+      new (&node->value) V(value);
+      s.slots[i] = Slot{key, node};
+      s.size++;
+      return true;
+   }
+
+   /** @brief Call pred(entry) on the entry of @a key, which must be in the
+       map, and erase the entry if pred returns true. */
+   /** The call is done while holding the lock of the shard of @a key. */
+   template <typename P>
+   void EraseIf(const void *key, P &&pred)
+   {
+      const size_t h = Hash(key);
+      Shard &s = shards[h % num_shards];
+      std::lock_guard<SpinLock> guard(s.lock);
+      const size_t i = s.size ? Probe(s, key, h) : 0;
+      if (s.size == 0 || !s.slots[i].key) { mfem_error("Unknown pointer!"); }
+      if (pred(s.slots[i].node->value)) { Remove(s, i); }
+   }
+
+   /// Call f(key, entry) on all the entries, locking one shard at a time.
+   template <typename F>
+   void ForEach(F &&f)
+   {
+      for (Shard &s : shards)
+      {
+         std::lock_guard<SpinLock> guard(s.lock);
+         for (Slot &slot : s.slots)
+         {
+            if (slot.key) { f(slot.key, slot.node->value); }
+         }
+      }
+   }
+
+   /// Return the number of entries.
+   size_t Size()
+   {
+      size_t size = 0;
+      for (Shard &s : shards)
+      {
+         std::lock_guard<SpinLock> guard(s.lock);
+         size += s.size;
+      }
+      return size;
+   }
+};
+
 /// Maps for the Memory and the Alias classes
-typedef std::unordered_map<const void*, Memory> MemoryMap;
-typedef std::unordered_map<const void*, Alias> AliasMap;
+typedef PointerMap<Memory> MemoryMap;
+typedef PointerMap<Alias> AliasMap;
 
 struct Maps
 {
@@ -174,7 +417,7 @@ class HostMemorySpace
 public:
    virtual ~HostMemorySpace() { }
    virtual void Alloc(void **ptr, size_t bytes) { *ptr = std::malloc(bytes); }
-   virtual void Dealloc(void *ptr) { std::free(ptr); }
+   virtual void Dealloc(void *ptr, size_t) { std::free(ptr); }
    virtual void Protect(const Memory&, size_t) { }
    virtual void Unprotect(const Memory&, size_t) { }
    virtual void AliasProtect(const void*, size_t) { }
@@ -216,7 +459,7 @@ public:
    Aligned32HostMemorySpace(): HostMemorySpace() { }
    void Alloc(void **ptr, size_t bytes)
    { if (mfem_memalign(ptr, 32, bytes) != 0) { throw ::std::bad_alloc(); } }
-   void Dealloc(void *ptr) { mfem_aligned_free(ptr); }
+   void Dealloc(void *ptr, size_t) { mfem_aligned_free(ptr); }
 };
 
 /// The aligned 64 host memory space
@@ -226,7 +469,7 @@ public:
    Aligned64HostMemorySpace(): HostMemorySpace() { }
    void Alloc(void **ptr, size_t bytes)
    { if (mfem_memalign(ptr, 64, bytes) != 0) { throw ::std::bad_alloc(); } }
-   void Dealloc(void *ptr) { mfem_aligned_free(ptr); }
+   void Dealloc(void *ptr, size_t) { mfem_aligned_free(ptr); }
 };
 
 #ifndef _WIN32
@@ -353,7 +596,7 @@ class MmuHostMemorySpace : public HostMemorySpace
 public:
    MmuHostMemorySpace(): HostMemorySpace() { MmuInit(); }
    void Alloc(void **ptr, size_t bytes) { MmuAlloc(ptr, bytes); }
-   void Dealloc(void *ptr) { MmuDealloc(ptr, maps->memories.at(ptr).bytes); }
+   void Dealloc(void *ptr, size_t bytes) { MmuDealloc(ptr, bytes); }
    void Protect(const Memory& mem, size_t bytes)
    { if (mem.h_rw) { mem.h_rw = false; MmuProtect(mem.h_ptr, bytes); } }
    void Unprotect(const Memory &mem, size_t bytes)
@@ -372,7 +615,7 @@ class UvmHostMemorySpace : public HostMemorySpace
 public:
    UvmHostMemorySpace(): HostMemorySpace() { }
    void Alloc(void **ptr, size_t bytes) { CuMallocManaged(ptr, bytes == 0 ? 8 : bytes); }
-   void Dealloc(void *ptr) { CuMemFree(ptr); }
+   void Dealloc(void *ptr, size_t) { CuMemFree(ptr); }
 };
 
 /// The 'No' device memory space
@@ -488,7 +731,7 @@ public:
                   (name, rm.getAllocator("HOST"))),
       strat(h_allocator.getAllocationStrategy()) { }
    void Alloc(void **ptr, size_t bytes) { *ptr = h_allocator.allocate(bytes); }
-   void Dealloc(void *ptr) { h_allocator.deallocate(ptr); }
+   void Dealloc(void *ptr, size_t) { h_allocator.deallocate(ptr); }
    void Insert(void *ptr, size_t bytes)
    { rm.registerAllocation(ptr, {ptr, bytes, strat}); }
 };
@@ -549,17 +792,249 @@ class UmpireDeviceMemorySpace : public NoDeviceMemorySpace { };
 #endif // MFEM_USE_CUDA
 #endif // MFEM_USE_UMPIRE
 
+/// Size-class cache of memory blocks, used by the pool memory spaces
+/** The requested sizes are rounded up to four size classes per power of two,
+    so that at most 25% of the memory is wasted, and the freed blocks are kept
+    in one free list per size class. The pool can be used by several threads
+    concurrently. */
+class MemoryPool
+{
+   std::mutex mutex;
+   std::map<size_t, std::vector<void*>> free_blocks;
+   MemoryPoolStats stats;
+
+public:
+   /// Return the size class of a request of @a bytes
+   static size_t ClassSize(size_t bytes)
+   {
+      if (bytes <= 64) { return 64; }
+      int p = 0;
+      while ((bytes - 1) >> (p + 1)) { p++; }
+      const size_t step = size_t(1) << (p - 2);
+      return (bytes + step - 1) & ~(step - 1);
+   }
+
+   /// Return a cached block of @a size bytes, or nullptr
+   void *Get(size_t size)
+   {
+      std::lock_guard<std::mutex> guard(mutex);
+      stats.allocs++;
+      stats.used += size;
+      auto it = free_blocks.find(size);
+      if (it == free_blocks.end() || it->second.empty())
+      {
+         stats.peak = std::max(stats.peak, stats.used + stats.cached);
+         return nullptr;
+      }
+      void *ptr = it->second.back();
+      it->second.pop_back();
+      stats.reuses++;
+      stats.cached -= size;
+      return ptr;
+   }
+
+   /// Cache the block @a ptr of @a size bytes, or return false if it has to
+   /// be returned to the backend, according to the pool policy
+   bool Put(void *ptr, size_t size)
+   {
+      std::lock_guard<std::mutex> guard(mutex);
+      stats.used -= size;
+      const bool keep =
+         mm.GetPoolReleasePolicy() == MemoryPoolRelease::ON_REQUEST ||
+         stats.cached + size <= mm.GetPoolHighWaterMark();
+      if (!keep) { stats.releases++; return false; }
+      free_blocks[size].push_back(ptr);
+      stats.cached += size;
+      return true;
+   }
+
+   /// Return all cached blocks to the backend through @a dealloc
+   template <typename F> void Release(F &&dealloc)
+   {
+      std::lock_guard<std::mutex> guard(mutex);
+      for (auto &fb : free_blocks)
+      {
+         for (void *ptr : fb.second) { dealloc(ptr, fb.first); }
+         stats.releases += fb.second.size();
+      }
+      free_blocks.clear();
+      stats.cached = 0;
+   }
+
+   MemoryPoolStats Stats()
+   {
+      std::lock_guard<std::mutex> guard(mutex);
+      return stats;
+   }
+};
+
+/// The pool host memory space, caching aligned 64 host memory blocks
+class PoolHostMemorySpace : public HostMemorySpace
+{
+   Aligned64HostMemorySpace backend;
+   MemoryPool pool;
+public:
+   ~PoolHostMemorySpace() { Release(); }
+   void Alloc(void **ptr, size_t bytes)
+   {
+      const size_t size = MemoryPool::ClassSize(bytes);
+      *ptr = pool.Get(size);
+      if (*ptr == nullptr) { backend.Alloc(ptr, size); }
+   }
+   void Dealloc(void *ptr, size_t bytes)
+   {
+      const size_t size = MemoryPool::ClassSize(bytes);
+      if (!pool.Put(ptr, size)) { backend.Dealloc(ptr, size); }
+   }
+   void Release()
+   { pool.Release([&](void *p, size_t size) { backend.Dealloc(p, size); }); }
+   MemoryPoolStats Stats() { return pool.Stats(); }
+};
+
+/// The pool device memory space, caching blocks of the DEVICE memory space,
+/// or of the std:: device memory space without CUDA or HIP support
+class PoolDeviceMemorySpace : public DeviceMemorySpace
+{
+   DeviceMemorySpace *backend;
+   MemoryPool pool;
+public:
+   PoolDeviceMemorySpace(): DeviceMemorySpace(),
+#if defined(MFEM_USE_CUDA)
+      backend(new CudaDeviceMemorySpace())
+#elif defined(MFEM_USE_HIP)
+      backend(new HipDeviceMemorySpace())
+#else
+      backend(new StdDeviceMemorySpace())
+#endif
+   { }
+   ~PoolDeviceMemorySpace() { Release(); delete backend; }
+   void Alloc(Memory &base)
+   {
+      const size_t size = MemoryPool::ClassSize(base.bytes);
+      base.d_ptr = pool.Get(size);
+      if (base.d_ptr) { return; }
+      Memory block(base.h_ptr, size, base.h_mt, base.d_mt);
+      backend->Alloc(block);
+      base.d_ptr = block.d_ptr;
+   }
+   void Dealloc(Memory &base)
+   {
+      const size_t size = MemoryPool::ClassSize(base.bytes);
+      if (!pool.Put(base.d_ptr, size)) { Free(base.d_ptr, size); }
+   }
+   void *HtoD(void *dst, const void *src, size_t bytes)
+   { return backend->HtoD(dst, src, bytes); }
+   void *DtoD(void *dst, const void *src, size_t bytes)
+   { return backend->DtoD(dst, src, bytes); }
+   void *DtoH(void *dst, const void *src, size_t bytes)
+   { return backend->DtoH(dst, src, bytes); }
+   void Release()
+   { pool.Release([&](void *p, size_t size) { Free(p, size); }); }
+   MemoryPoolStats Stats() { return pool.Stats(); }
+private:
+   void Free(void *d_ptr, size_t size)
+   {
+      Memory block(nullptr, size, MemoryType::HOST_POOL,
+                   MemoryType::DEVICE_POOL);
+      block.d_ptr = d_ptr;
+      backend->Dealloc(block);
+   }
+};
+
+/// Interleave the pages of [ptr, ptr + bytes) among the NUMA nodes allowed to
+/// the process, through the mbind system call. Return false on failure, e.g.
+/// if the system call is not available.
+static bool NumaInterleave(void *ptr, size_t bytes)
+{
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+   // Values of MPOL_INTERLEAVE and MPOL_F_MEMS_ALLOWED from <numaif.h>
+   const int mpol_interleave = 3, mpol_f_mems_allowed = 1 << 2;
+   const unsigned long maxnode = 1024;
+   unsigned long nodes[maxnode / (8 * sizeof(unsigned long))] = { 0 };
+   if (syscall(SYS_get_mempolicy, nullptr, nodes, maxnode, nullptr,
+               mpol_f_mems_allowed) != 0) { return false; }
+   return syscall(SYS_mbind, ptr, bytes, mpol_interleave, nodes, maxnode,
+                  0) == 0;
+#else
+   MFEM_CONTRACT_VAR(ptr);
+   MFEM_CONTRACT_VAR(bytes);
+   return false;
+#endif
+}
+
+/// The NUMA host memory space, placing the pages of the large blocks according
+/// to the MemoryNumaPolicy, see MemoryType::HOST_NUMA
+class NumaHostMemorySpace : public HostMemorySpace
+{
+   static constexpr size_t min_bytes = 64 * 1024;
+   Aligned64HostMemorySpace small;
+   size_t page;
+
+   // Write the first byte of each page, with the partition of the host
+   // MFEM_FORALL backend, so that each page is placed on the NUMA node of the
+   // thread that first touches it.
+   void FirstTouch(char *ptr, size_t bytes) const
+   {
+      const int pages = int((bytes + page - 1) / page);
+      const size_t page_size = page;
+      auto touch = [=](int p) { ptr[p * page_size] = 0; };
+      if (Device::Allows(Backend::OMP | Backend::RAJA_OMP))
+      {
+         OmpWrap(pages, touch);
+      }
+      else if (Device::Allows(Backend::THREADS))
+      {
+         ThreadPool::For(pages, touch);
+      }
+      else
+      {
+         for (int p = 0; p < pages; p++) { touch(p); }
+      }
+   }
+
+public:
+   NumaHostMemorySpace(): HostMemorySpace()
+   {
+#ifndef _WIN32
+      page = (size_t) sysconf(_SC_PAGE_SIZE);
+#else
+      page = 4096;
+#endif
+   }
+   void Alloc(void **ptr, size_t bytes)
+   {
+      if (bytes < min_bytes) { small.Alloc(ptr, bytes); return; }
+      // Fresh pages from the OS, which are placed when first touched
+      MmuAlloc(ptr, bytes);
+      if (mm.GetNumaPolicy() == MemoryNumaPolicy::INTERLEAVE &&
+          NumaInterleave(*ptr, bytes)) { return; }
+      FirstTouch(static_cast<char*>(*ptr), bytes);
+   }
+   void Dealloc(void *ptr, size_t bytes)
+   {
+      if (bytes < min_bytes) { small.Dealloc(ptr, bytes); }
+      else { MmuDealloc(ptr, bytes); }
+   }
+};
+
 /// Memory space controller class
 class Ctrl
 {
    typedef MemoryType MT;
 
+   // Protects the delayed initialization of the controllers
+   std::mutex mutex;
+
 public:
-   HostMemorySpace *host[HostMemoryTypeSize];
-   DeviceMemorySpace *device[DeviceMemoryTypeSize];
+   std::atomic<HostMemorySpace*> host[HostMemoryTypeSize];
+   std::atomic<DeviceMemorySpace*> device[DeviceMemoryTypeSize];
 
 public:
-   Ctrl(): host{nullptr}, device{nullptr} { }
+   Ctrl()
+   {
+      for (auto &h : host) { h = nullptr; }
+      for (auto &d : device) { d = nullptr; }
+   }
 
    void Configure()
    {
@@ -577,6 +1052,8 @@ public:
       // HOST_DEBUG is delayed, as it reroutes signals
       host[static_cast<int>(MT::HOST_DEBUG)] = nullptr;
       host[static_cast<int>(MT::HOST_UMPIRE)] = new UmpireHostMemorySpace();
+      host[static_cast<int>(MT::HOST_POOL)] = new PoolHostMemorySpace();
+      host[static_cast<int>(MT::HOST_NUMA)] = new NumaHostMemorySpace();
       host[static_cast<int>(MT::MANAGED)] = new UvmHostMemorySpace();
 
       // Filling the device memory backends, shifting with the device size
@@ -586,12 +1063,16 @@ public:
       device[static_cast<int>(MemoryType::DEVICE)-shift] = nullptr;
       device[static_cast<int>(MT::DEVICE_DEBUG)-shift] = nullptr;
       device[static_cast<int>(MT::DEVICE_UMPIRE)-shift] = nullptr;
+      device[static_cast<int>(MT::DEVICE_POOL)-shift] = nullptr;
    }
 
    HostMemorySpace* Host(const MemoryType mt)
    {
       const int mt_i = static_cast<int>(mt);
+      HostMemorySpace *h = host[mt_i];
+      if (h) { return h; }
       // Delayed host controllers initialization
+      std::lock_guard<std::mutex> guard(mutex);
       if (!host[mt_i]) { host[mt_i] = NewHostCtrl(mt); }
       MFEM_ASSERT(host[mt_i], "Host memory controller is not configured!");
       return host[mt_i];
@@ -601,7 +1082,10 @@ public:
    {
       const int mt_i = static_cast<int>(mt) - DeviceMemoryType;
       MFEM_ASSERT(mt_i >= 0,"");
+      DeviceMemorySpace *d = device[mt_i];
+      if (d) { return d; }
       // Lazy device controller initializations
+      std::lock_guard<std::mutex> guard(mutex);
       if (!device[mt_i]) { device[mt_i] = NewDeviceCtrl(mt); }
       MFEM_ASSERT(device[mt_i], "Memory manager has not been configured!");
       return device[mt_i];
@@ -629,6 +1113,7 @@ private:
       {
          case MT::DEVICE_UMPIRE: return new UmpireDeviceMemorySpace();
          case MT::DEVICE_DEBUG: return new MmuDeviceMemorySpace();
+         case MT::DEVICE_POOL: return new PoolDeviceMemorySpace();
          case MT::DEVICE:
          {
 #if defined(MFEM_USE_CUDA)
@@ -650,6 +1135,158 @@ private:
 
 static internal::Ctrl *ctrl;
 
+namespace internal
+{
+
+/// Host/device transfers recorded by the MemoryManager, see
+/// MemoryManager::EnableTransferTrace()
+class TransferTrace
+{
+   // Last copy of a registered host range, identified by its address and size
+   struct Copy { bool htod; std::uint64_t checksum; };
+   typedef std::pair<const char*, size_t> Range;
+
+   std::mutex mutex;
+   std::map<std::string, MemoryTransferStats> sites;
+   std::map<Range, Copy> copies;
+
+   // 64-bit FNV-1a checksum, processing 8 bytes at a time
+   static std::uint64_t Checksum(const void *ptr, size_t bytes)
+   {
+      const unsigned char *p = static_cast<const unsigned char*>(ptr);
+      const std::uint64_t prime = 0x100000001b3ULL;
+      std::uint64_t h = 0xcbf29ce484222325ULL;
+      size_t i = 0;
+      for (; i + 8 <= bytes; i += 8)
+      {
+         std::uint64_t w;
+         std::memcpy(&w, p + i, 8);
+         h = (h ^ w) * prime;
+      }
+      for (; i < bytes; i++) { h = (h ^ p[i]) * prime; }
+      return h;
+   }
+
+public:
+   /** Record a copy of @a bytes, with the host data @a data, to or from the
+       device memory of the registered host range @a key, which may be NULL
+       for the copies between the device and unregistered host memory. */
+   void Record(bool htod, const void *key, const void *data, size_t bytes)
+   {
+      if (bytes == 0) { return; }
+      const std::uint64_t checksum = key ? Checksum(data, bytes) : 0;
+      const std::string site = Profiler::GetRegionPath();
+      std::lock_guard<std::mutex> guard(mutex);
+      MemoryTransferStats &stats = sites[site];
+      if (htod) { stats.htod++; stats.htod_bytes += bytes; }
+      else { stats.dtoh++; stats.dtoh_bytes += bytes; }
+      if (!key) { return; }
+      const Range range(static_cast<const char*>(key), bytes);
+      auto it = copies.find(range);
+      if (it == copies.end()) { copies.emplace(range, Copy{htod, checksum}); }
+      else
+      {
+         // The data came back unchanged from the other side
+         if (it->second.htod != htod && it->second.checksum == checksum)
+         {
+            stats.redundant++;
+            stats.redundant_bytes += bytes;
+         }
+         it->second = Copy{htod, checksum};
+      }
+   }
+
+   /// Forget the copies of the host ranges in [h_ptr, h_ptr + bytes).
+   void Forget(const void *h_ptr, size_t bytes)
+   {
+      const char *begin = static_cast<const char*>(h_ptr);
+      std::lock_guard<std::mutex> guard(mutex);
+      copies.erase(copies.lower_bound(Range(begin, 0)),
+                   copies.lower_bound(Range(begin + bytes, 0)));
+   }
+
+   /// Return the statistics of @a site, or of all the sites if it is NULL.
+   MemoryTransferStats Stats(const char *site)
+   {
+      std::lock_guard<std::mutex> guard(mutex);
+      MemoryTransferStats total;
+      for (const auto &s : sites)
+      {
+         if (site && s.first != site) { continue; }
+         total.htod += s.second.htod;
+         total.htod_bytes += s.second.htod_bytes;
+         total.dtoh += s.second.dtoh;
+         total.dtoh_bytes += s.second.dtoh_bytes;
+         total.redundant += s.second.redundant;
+         total.redundant_bytes += s.second.redundant_bytes;
+      }
+      return total;
+   }
+
+   void Reset(bool keep_sites)
+   {
+      std::lock_guard<std::mutex> guard(mutex);
+      if (!keep_sites) { sites.clear(); }
+      copies.clear();
+   }
+
+   void Print(std::ostream &out)
+   {
+      std::vector<std::pair<std::string, MemoryTransferStats>> list;
+      {
+         std::lock_guard<std::mutex> guard(mutex);
+         list.assign(sites.begin(), sites.end());
+      }
+      std::stable_sort(list.begin(), list.end(),
+                       [](const std::pair<std::string, MemoryTransferStats> &a,
+                          const std::pair<std::string, MemoryTransferStats> &b)
+      {
+         return a.second.htod_bytes + a.second.dtoh_bytes >
+                b.second.htod_bytes + b.second.dtoh_bytes;
+      });
+      list.emplace_back("total", Stats(NULL));
+      std::ios::fmtflags flags(out.flags());
+      const std::streamsize precision = out.precision();
+      out << std::left << std::setw(40) << "call site" << std::right
+          << std::setw(8) << "H->D" << std::setw(11) << "H->D [MB]"
+          << std::setw(8) << "D->H" << std::setw(11) << "D->H [MB]"
+          << std::setw(11) << "redundant" << std::setw(11) << "red. [MB]"
+          << '\n' << std::fixed << std::setprecision(3);
+      for (const auto &site : list)
+      {
+         // Keep the innermost regions of long paths
+         std::string name = site.first.empty() ? "(no region)" : site.first;
+         if (name.size() > 40) { name = "..." + name.substr(name.size() - 37); }
+         const MemoryTransferStats &st = site.second;
+         out << std::left << std::setw(40) << name << std::right
+             << std::setw(8) << st.htod << std::setw(11) << 1e-6*st.htod_bytes
+             << std::setw(8) << st.dtoh << std::setw(11) << 1e-6*st.dtoh_bytes
+             << std::setw(11) << st.redundant
+             << std::setw(11) << 1e-6*st.redundant_bytes << '\n';
+      }
+      out.flags(flags);
+      out.precision(precision);
+      out.flush();
+   }
+};
+
+static TransferTrace &GetTransferTrace()
+{
+   // Never destroyed, since the global MemoryManager may use it at exit
+   static TransferTrace *trace = new TransferTrace;
+   return *trace;
+}
+
+} // namespace mfem::internal
+
+// Record a copy, see internal::TransferTrace::Record().
+static inline void TraceTransfer(bool htod, const void *key, const void *data,
+                                 size_t bytes)
+{
+   if (!mm.IsTransferTraceEnabled()) { return; }
+   internal::GetTransferTrace().Record(htod, key, data, bytes);
+}
+
 void *MemoryManager::New_(void *h_tmp, size_t bytes, MemoryType mt,
                           unsigned &flags)
 {
@@ -667,7 +1304,6 @@ void *MemoryManager::New_(void *h_tmp, size_t bytes, MemoryType mt,
    flags |= is_host_mem ? Mem::VALID_HOST : Mem::VALID_DEVICE;
    if (is_host_mem) { mm.Insert(h_ptr, bytes, h_mt, d_mt); }
    else { mm.InsertDevice(nullptr, h_ptr, bytes, h_mt, d_mt); }
-   CheckHostMemoryType_(h_mt, h_ptr);
    return h_ptr;
 }
 
@@ -709,7 +1345,6 @@ void *MemoryManager::Register_(void *ptr, void *h_tmp, size_t bytes,
       flags = own ? flags | Mem::OWNS_HOST   : flags & ~Mem::OWNS_HOST;
       flags |= Mem::VALID_DEVICE;
    }
-   CheckHostMemoryType_(h_mt, h_ptr);
    return h_ptr;
 }
 
@@ -736,9 +1371,8 @@ MemoryType MemoryManager::Delete_(void *h_ptr, MemoryType mt, unsigned flags)
    {
       if (owns_internal)
       {
-         const MemoryType h_mt = maps->aliases.at(h_ptr).h_mt;
+         const MemoryType h_mt = mm.EraseAlias(h_ptr);
          MFEM_ASSERT(mt == h_mt,"");
-         mm.EraseAlias(h_ptr);
          return h_mt;
       }
    }
@@ -746,10 +1380,25 @@ MemoryType MemoryManager::Delete_(void *h_ptr, MemoryType mt, unsigned flags)
    {
       const MemoryType h_mt = mt;
       MFEM_ASSERT(!owns_internal ||
-                  mt == maps->memories.at(h_ptr).h_mt,"");
+                  mt == maps->memories.At(h_ptr).h_mt,"");
+      // Unregister the pointer before its deallocation: another thread may
+      // then receive the same address from the allocator and register it.
+      size_t bytes = 0;
+      if (owns_internal)
+      {
+         bytes = mm.Erase(h_ptr, owns_device);
+         if (mm.IsTransferTraceEnabled())
+         {
+            internal::GetTransferTrace().Forget(h_ptr, bytes);
+         }
+      }
+      else if (owns_host && (h_mt != MemoryType::HOST))
+      {
+         const internal::Memory *mem = maps->memories.Find(h_ptr);
+         bytes = mem ? mem->bytes : 0;
+      }
       if (owns_host && (h_mt != MemoryType::HOST))
-      { ctrl->Host(h_mt)->Dealloc(h_ptr); }
-      if (owns_internal) { mm.Erase(h_ptr, owns_device); }
+      { ctrl->Host(h_mt)->Dealloc(h_ptr, bytes); }
       return h_mt;
    }
    return mt;
@@ -765,13 +1414,12 @@ bool MemoryManager::MemoryClassCheck_(MemoryClass mc, void *h_ptr,
       return true;
    }
 
-   const bool known = mm.IsKnown(h_ptr);
-   const bool alias = mm.IsAlias(h_ptr);
+   const internal::Memory *known = maps->memories.Find(h_ptr);
+   const internal::Alias *alias = maps->aliases.Find(h_ptr);
    const bool check = known || ((flags & Mem::ALIAS) && alias);
    MFEM_VERIFY(check,"");
    const internal::Memory &mem =
-      (flags & Mem::ALIAS) ?
-      *maps->aliases.at(h_ptr).mem : maps->memories.at(h_ptr);
+      (flags & Mem::ALIAS) ? *alias->mem : *known;
    const MemoryType &d_mt = mem.d_mt;
    switch (mc)
    {
@@ -791,6 +1439,7 @@ bool MemoryManager::MemoryClassCheck_(MemoryClass mc, void *h_ptr,
          MFEM_VERIFY(d_mt == MemoryType::DEVICE ||
                      d_mt == MemoryType::DEVICE_DEBUG ||
                      d_mt == MemoryType::DEVICE_UMPIRE ||
+                     d_mt == MemoryType::DEVICE_POOL ||
                      d_mt == MemoryType::MANAGED,"");
          return true;
       }
@@ -905,18 +1554,10 @@ MemoryType MemoryManager::GetDeviceMemoryType_(void *h_ptr)
 {
    if (mm.exists)
    {
-      const bool known = mm.IsKnown(h_ptr);
-      if (known)
-      {
-         internal::Memory &mem = maps->memories.at(h_ptr);
-         return mem.d_mt;
-      }
-      const bool alias = mm.IsAlias(h_ptr);
-      if (alias)
-      {
-         internal::Memory *mem = maps->aliases.at(h_ptr).mem;
-         return mem->d_mt;
-      }
+      const internal::Memory *mem = maps->memories.Find(h_ptr);
+      if (mem) { return mem->d_mt; }
+      const internal::Alias *alias = maps->aliases.Find(h_ptr);
+      if (alias) { return alias->mem->d_mt; }
    }
    MFEM_ABORT("internal error");
    return MemoryManager::host_mem_type;
@@ -925,8 +1566,10 @@ MemoryType MemoryManager::GetDeviceMemoryType_(void *h_ptr)
 MemoryType MemoryManager::GetHostMemoryType_(void *h_ptr)
 {
    if (!mm.exists) { return MemoryManager::host_mem_type; }
-   if (mm.IsKnown(h_ptr)) { return maps->memories.at(h_ptr).h_mt; }
-   if (mm.IsAlias(h_ptr)) { return maps->aliases.at(h_ptr).mem->h_mt; }
+   const internal::Memory *mem = maps->memories.Find(h_ptr);
+   if (mem) { return mem->h_mt; }
+   const internal::Alias *alias = maps->aliases.Find(h_ptr);
+   if (alias) { return alias->mem->h_mt; }
    return MemoryManager::host_mem_type;
 }
 
@@ -977,9 +1620,10 @@ void MemoryManager::Copy_(void *dst_h_ptr, const void *src_h_ptr,
       {
          if (dst_h_ptr != src_d_ptr && bytes != 0)
          {
-            internal::Memory &src_d_base = maps->memories.at(src_d_ptr);
+            internal::Memory &src_d_base = maps->memories.At(src_d_ptr);
             MemoryType src_d_mt = src_d_base.d_mt;
             ctrl->Device(src_d_mt)->DtoH(dst_h_ptr, src_d_ptr, bytes);
+            TraceTransfer(false, dst_h_ptr, dst_h_ptr, bytes);
          }
       }
    }
@@ -990,24 +1634,23 @@ void MemoryManager::Copy_(void *dst_h_ptr, const void *src_h_ptr,
                          mm.GetDevicePtr(dst_h_ptr, bytes, false);
       if (src_on_host)
       {
-         const bool known = mm.IsKnown(dst_h_ptr);
+         const internal::Memory *known = maps->memories.Find(dst_h_ptr);
          const bool alias = dst_flags & Mem::ALIAS;
          MFEM_VERIFY(alias||known,"");
-         const MemoryType d_mt = known ?
-                                 maps->memories.at(dst_h_ptr).d_mt :
-                                 maps->aliases.at(dst_h_ptr).mem->d_mt;
+         const MemoryType d_mt = known ? known->d_mt :
+                                 maps->aliases.At(dst_h_ptr).mem->d_mt;
+         TraceTransfer(true, dst_h_ptr, src_h_ptr, bytes);
          ctrl->Device(d_mt)->HtoD(dest_d_ptr, src_h_ptr, bytes);
       }
       else
       {
          if (dest_d_ptr != src_d_ptr && bytes != 0)
          {
-            const bool known = mm.IsKnown(dst_h_ptr);
+            const internal::Memory *known = maps->memories.Find(dst_h_ptr);
             const bool alias = dst_flags & Mem::ALIAS;
             MFEM_VERIFY(alias||known,"");
-            const MemoryType d_mt = known ?
-                                    maps->memories.at(dst_h_ptr).d_mt :
-                                    maps->aliases.at(dst_h_ptr).mem->d_mt;
+            const MemoryType d_mt = known ? known->d_mt :
+                                    maps->aliases.At(dst_h_ptr).mem->d_mt;
             ctrl->Device(d_mt)->DtoD(dest_d_ptr, src_d_ptr, bytes);
          }
       }
@@ -1034,9 +1677,10 @@ void MemoryManager::CopyToHost_(void *dest_h_ptr, const void *src_h_ptr,
       const void *src_d_ptr = (src_flags & Mem::ALIAS) ?
                               mm.GetAliasDevicePtr(src_h_ptr, bytes, false) :
                               mm.GetDevicePtr(src_h_ptr, bytes, false);
-      const internal::Memory &base = maps->memories.at(dest_h_ptr);
+      const internal::Memory &base = maps->memories.At(dest_h_ptr);
       const MemoryType d_mt = base.d_mt;
       ctrl->Device(d_mt)->DtoH(dest_h_ptr, src_d_ptr, bytes);
+      TraceTransfer(false, NULL, dest_h_ptr, bytes);
    }
 }
 
@@ -1059,8 +1703,9 @@ void MemoryManager::CopyFromHost_(void *dest_h_ptr, const void *src_h_ptr,
       void *dest_d_ptr = (dest_flags & Mem::ALIAS) ?
                          mm.GetAliasDevicePtr(dest_h_ptr, bytes, false) :
                          mm.GetDevicePtr(dest_h_ptr, bytes, false);
-      const internal::Memory &base = maps->memories.at(dest_h_ptr);
+      const internal::Memory &base = maps->memories.At(dest_h_ptr);
       const MemoryType d_mt = base.d_mt;
+      TraceTransfer(true, dest_h_ptr, src_h_ptr, bytes);
       ctrl->Device(d_mt)->HtoD(dest_d_ptr, src_h_ptr, bytes);
    }
    dest_flags = dest_flags &
@@ -1069,12 +1714,12 @@ void MemoryManager::CopyFromHost_(void *dest_h_ptr, const void *src_h_ptr,
 
 bool MemoryManager::IsKnown_(const void *h_ptr)
 {
-   return maps->memories.find(h_ptr) != maps->memories.end();
+   return maps->memories.Find(h_ptr) != nullptr;
 }
 
 bool MemoryManager::IsAlias_(const void *h_ptr)
 {
-   return maps->aliases.find(h_ptr) != maps->aliases.end();
+   return maps->aliases.Find(h_ptr) != nullptr;
 }
 
 void MemoryManager::Insert(void *h_ptr, size_t bytes,
@@ -1086,18 +1731,13 @@ void MemoryManager::Insert(void *h_ptr, size_t bytes,
       return;
    }
    MFEM_VERIFY_TYPES(h_mt, d_mt);
-#ifdef MFEM_DEBUG
-   auto res =
-#endif
-      maps->memories.emplace(h_ptr, internal::Memory(h_ptr, bytes, h_mt, d_mt));
-#ifdef MFEM_DEBUG
-   if (res.second == false)
+   maps->memories.Emplace(h_ptr, internal::Memory(h_ptr, bytes, h_mt, d_mt),
+                          [&](const internal::Memory &m)
    {
-      auto &m = res.first->second;
-      MFEM_VERIFY(m.bytes >= bytes && m.h_mt == h_mt && m.d_mt == d_mt,
+      MFEM_VERIFY(m.h_mt == h_mt, "");
+      MFEM_ASSERT(m.bytes >= bytes && m.d_mt == d_mt,
                   "Address already present with different attributes!");
-   }
-#endif
+   });
 }
 
 void MemoryManager::InsertDevice(void *d_ptr, void *h_ptr, size_t bytes,
@@ -1106,7 +1746,7 @@ void MemoryManager::InsertDevice(void *d_ptr, void *h_ptr, size_t bytes,
    MFEM_VERIFY_TYPES(h_mt, d_mt);
    MFEM_ASSERT(h_ptr != NULL, "internal error");
    Insert(h_ptr, bytes, h_mt, d_mt);
-   internal::Memory &mem = maps->memories.at(h_ptr);
+   internal::Memory &mem = maps->memories.At(h_ptr);
    if (d_ptr == NULL) { ctrl->Device(d_mt)->Alloc(mem); }
    else { mem.d_ptr = d_ptr; }
 }
@@ -1124,46 +1764,48 @@ void MemoryManager::InsertAlias(const void *base_ptr, void *alias_ptr,
    }
    if (base_is_alias)
    {
-      const internal::Alias &alias = maps->aliases.at(base_ptr);
+      const internal::Alias &alias = maps->aliases.At(base_ptr);
       MFEM_ASSERT(alias.mem,"");
       base_ptr = alias.mem->h_ptr;
       offset += alias.offset;
    }
-   internal::Memory &mem = maps->memories.at(base_ptr);
-   auto res =
-      maps->aliases.emplace(alias_ptr,
-                            internal::Alias{&mem, offset, bytes, 1, mem.h_mt});
-   if (res.second == false) // alias_ptr was already in the map
+   internal::Memory &mem = maps->memories.At(base_ptr);
+   maps->aliases.Emplace(alias_ptr,
+                         internal::Alias{&mem, offset, bytes, 1, mem.h_mt},
+                         [&](internal::Alias &alias)
    {
-      if (res.first->second.mem != &mem || res.first->second.offset != offset)
+      // alias_ptr was already in the map
+      if (alias.mem != &mem || alias.offset != offset)
       {
          mfem_error("alias already exists with different base/offset!");
       }
-      else
-      {
-         res.first->second.counter++;
-      }
-   }
+      alias.counter++;
+   });
 }
 
-void MemoryManager::Erase(void *h_ptr, bool free_dev_ptr)
+size_t MemoryManager::Erase(void *h_ptr, bool free_dev_ptr)
 {
-   if (!h_ptr) { return; }
-   auto mem_map_iter = maps->memories.find(h_ptr);
-   if (mem_map_iter == maps->memories.end()) { mfem_error("Unknown pointer!"); }
-   internal::Memory &mem = mem_map_iter->second;
-   if (mem.d_ptr && free_dev_ptr) { ctrl->Device(mem.d_mt)->Dealloc(mem);}
-   maps->memories.erase(mem_map_iter);
+   if (!h_ptr) { return 0; }
+   size_t bytes = 0;
+   maps->memories.EraseIf(h_ptr, [&](internal::Memory &mem)
+   {
+      if (mem.d_ptr && free_dev_ptr) { ctrl->Device(mem.d_mt)->Dealloc(mem);}
+      bytes = mem.bytes;
+      return true;
+   });
+   return bytes;
 }
 
-void MemoryManager::EraseAlias(void *alias_ptr)
+MemoryType MemoryManager::EraseAlias(void *alias_ptr)
 {
-   if (!alias_ptr) { return; }
-   auto alias_map_iter = maps->aliases.find(alias_ptr);
-   if (alias_map_iter == maps->aliases.end()) { mfem_error("Unknown alias!"); }
-   internal::Alias &alias = alias_map_iter->second;
-   if (--alias.counter) { return; }
-   maps->aliases.erase(alias_map_iter);
+   if (!alias_ptr) { return host_mem_type; }
+   MemoryType h_mt = host_mem_type;
+   maps->aliases.EraseIf(alias_ptr, [&](internal::Alias &alias)
+   {
+      h_mt = alias.h_mt;
+      return --alias.counter == 0;
+   });
+   return h_mt;
 }
 
 void *MemoryManager::GetDevicePtr(const void *h_ptr, size_t bytes,
@@ -1174,7 +1816,7 @@ void *MemoryManager::GetDevicePtr(const void *h_ptr, size_t bytes,
       MFEM_VERIFY(bytes == 0, "Trying to access NULL with size " << bytes);
       return NULL;
    }
-   internal::Memory &mem = maps->memories.at(h_ptr);
+   internal::Memory &mem = maps->memories.At(h_ptr);
    const MemoryType &h_mt = mem.h_mt;
    const MemoryType &d_mt = mem.d_mt;
    MFEM_VERIFY_TYPES(h_mt, d_mt);
@@ -1184,6 +1826,7 @@ void *MemoryManager::GetDevicePtr(const void *h_ptr, size_t bytes,
    if (copy_data)
    {
       MFEM_ASSERT(bytes <= mem.bytes, "invalid copy size");
+      TraceTransfer(true, h_ptr, h_ptr, bytes);
       ctrl->Device(d_mt)->HtoD(mem.d_ptr, h_ptr, bytes);
    }
    ctrl->Host(h_mt)->Protect(mem, bytes);
@@ -1198,10 +1841,9 @@ void *MemoryManager::GetAliasDevicePtr(const void *alias_ptr, size_t bytes,
       MFEM_VERIFY(bytes == 0, "Trying to access NULL with size " << bytes);
       return NULL;
    }
-   auto &alias_map = maps->aliases;
-   auto alias_map_iter = alias_map.find(alias_ptr);
-   if (alias_map_iter == alias_map.end()) { mfem_error("alias not found"); }
-   const internal::Alias &alias = alias_map_iter->second;
+   const internal::Alias *alias_it = maps->aliases.Find(alias_ptr);
+   if (!alias_it) { mfem_error("alias not found"); }
+   const internal::Alias &alias = *alias_it;
    const size_t offset = alias.offset;
    internal::Memory &mem = *alias.mem;
    const MemoryType &h_mt = mem.h_mt;
@@ -1215,14 +1857,18 @@ void *MemoryManager::GetAliasDevicePtr(const void *alias_ptr, size_t bytes,
    mem.d_rw = false;
    ctrl->Device(d_mt)->AliasUnprotect(alias_d_ptr, bytes);
    ctrl->Host(h_mt)->AliasUnprotect(alias_ptr, bytes);
-   if (copy) { ctrl->Device(d_mt)->HtoD(alias_d_ptr, alias_h_ptr, bytes); }
+   if (copy)
+   {
+      TraceTransfer(true, alias_h_ptr, alias_h_ptr, bytes);
+      ctrl->Device(d_mt)->HtoD(alias_d_ptr, alias_h_ptr, bytes);
+   }
    ctrl->Host(h_mt)->AliasProtect(alias_ptr, bytes);
    return alias_d_ptr;
 }
 
 void *MemoryManager::GetHostPtr(const void *ptr, size_t bytes, bool copy)
 {
-   const internal::Memory &mem = maps->memories.at(ptr);
+   const internal::Memory &mem = maps->memories.At(ptr);
    MFEM_ASSERT(mem.h_ptr == ptr, "internal error");
    MFEM_ASSERT(bytes <= mem.bytes, "internal error")
    const MemoryType &h_mt = mem.h_mt;
@@ -1231,7 +1877,11 @@ void *MemoryManager::GetHostPtr(const void *ptr, size_t bytes, bool copy)
    // Aliases might have done some protections
    ctrl->Host(h_mt)->Unprotect(mem, bytes);
    if (mem.d_ptr) { ctrl->Device(d_mt)->Unprotect(mem); }
-   if (copy && mem.d_ptr) { ctrl->Device(d_mt)->DtoH(mem.h_ptr, mem.d_ptr, bytes); }
+   if (copy && mem.d_ptr)
+   {
+      ctrl->Device(d_mt)->DtoH(mem.h_ptr, mem.d_ptr, bytes);
+      TraceTransfer(false, mem.h_ptr, mem.h_ptr, bytes);
+   }
    if (mem.d_ptr) { ctrl->Device(d_mt)->Protect(mem); }
    return mem.h_ptr;
 }
@@ -1239,7 +1889,7 @@ void *MemoryManager::GetHostPtr(const void *ptr, size_t bytes, bool copy)
 void *MemoryManager::GetAliasHostPtr(const void *ptr, size_t bytes,
                                      bool copy_data)
 {
-   const internal::Alias &alias = maps->aliases.at(ptr);
+   const internal::Alias &alias = maps->aliases.At(ptr);
    const internal::Memory *const mem = alias.mem;
    const MemoryType &h_mt = mem->h_mt;
    const MemoryType &d_mt = mem->d_mt;
@@ -1251,7 +1901,10 @@ void *MemoryManager::GetAliasHostPtr(const void *ptr, size_t bytes,
    ctrl->Host(h_mt)->AliasUnprotect(alias_h_ptr, bytes);
    if (mem->d_ptr) { ctrl->Device(d_mt)->AliasUnprotect(alias_d_ptr, bytes); }
    if (copy_data && mem->d_ptr)
-   { ctrl->Device(d_mt)->DtoH(const_cast<void*>(ptr), alias_d_ptr, bytes); }
+   {
+      ctrl->Device(d_mt)->DtoH(const_cast<void*>(ptr), alias_d_ptr, bytes);
+      TraceTransfer(false, ptr, ptr, bytes);
+   }
    if (mem->d_ptr) { ctrl->Device(d_mt)->AliasProtect(alias_d_ptr, bytes); }
    return alias_h_ptr;
 }
@@ -1277,6 +1930,63 @@ void MemoryManager::Configure(const MemoryType host_mt,
    device_mem_type = device_mt;
 }
 
+void MemoryManager::ReleasePool()
+{
+   if (!exists) { return; }
+   constexpr int d_pool = static_cast<int>(MemoryType::DEVICE_POOL);
+   static_cast<internal::PoolHostMemorySpace*>(
+      ctrl->Host(MemoryType::HOST_POOL))->Release();
+   if (ctrl->device[d_pool - DeviceMemoryType])
+   {
+      static_cast<internal::PoolDeviceMemorySpace*>(
+         ctrl->device[d_pool - DeviceMemoryType].load())->Release();
+   }
+}
+
+MemoryPoolStats MemoryManager::GetPoolStats(MemoryType mt) const
+{
+   MFEM_VERIFY(mt == MemoryType::HOST_POOL || mt == MemoryType::DEVICE_POOL,
+               "not a pool memory type!");
+   if (!exists) { return MemoryPoolStats(); }
+   if (mt == MemoryType::HOST_POOL)
+   {
+      return static_cast<internal::PoolHostMemorySpace*>(
+                ctrl->Host(MemoryType::HOST_POOL))->Stats();
+   }
+   const int d_pool = static_cast<int>(mt) - DeviceMemoryType;
+   if (!ctrl->device[d_pool]) { return MemoryPoolStats(); }
+   return static_cast<internal::PoolDeviceMemorySpace*>(
+             ctrl->device[d_pool].load())->Stats();
+}
+
+static void PrintTransfersAtExit() { mm.PrintTransfers(mfem::out); }
+
+void MemoryManager::EnableTransferTrace(bool report)
+{
+   static bool at_exit = false;
+   trace_transfers = true;
+   if (report && !at_exit)
+   {
+      at_exit = true;
+      std::atexit(PrintTransfersAtExit);
+   }
+}
+
+MemoryTransferStats MemoryManager::GetTransferStats(const char *site) const
+{
+   return internal::GetTransferTrace().Stats(site);
+}
+
+void MemoryManager::ResetTransferTrace()
+{
+   internal::GetTransferTrace().Reset(false);
+}
+
+void MemoryManager::PrintTransfers(std::ostream &out)
+{
+   internal::GetTransferTrace().Print(out);
+}
+
 #ifdef MFEM_USE_UMPIRE
 void MemoryManager::SetUmpireAllocatorNames(const char *h_name,
                                             const char *d_name)
@@ -1289,13 +1999,13 @@ void MemoryManager::SetUmpireAllocatorNames(const char *h_name,
 void MemoryManager::Destroy()
 {
    MFEM_VERIFY(exists, "MemoryManager has already been destroyed!");
-   for (auto& n : maps->memories)
+   maps->memories.ForEach([](const void*, internal::Memory &mem)
    {
-      internal::Memory &mem = n.second;
       bool mem_h_ptr = mem.h_mt != MemoryType::HOST && mem.h_ptr;
-      if (mem_h_ptr) { ctrl->Host(mem.h_mt)->Dealloc(mem.h_ptr); }
+      if (mem_h_ptr) { ctrl->Host(mem.h_mt)->Dealloc(mem.h_ptr, mem.bytes); }
       if (mem.d_ptr) { ctrl->Device(mem.d_mt)->Dealloc(mem); }
-   }
+   });
+   if (trace_transfers) { internal::GetTransferTrace().Reset(true); }
    delete maps; maps = nullptr;
    delete ctrl; ctrl = nullptr;
    host_mem_type = MemoryType::HOST;
@@ -1317,32 +2027,30 @@ void MemoryManager::RegisterCheck(void *ptr)
 int MemoryManager::PrintPtrs(std::ostream &out)
 {
    int n_out = 0;
-   for (const auto& n : maps->memories)
+   maps->memories.ForEach([&](const void *key, const internal::Memory &mem)
    {
-      const internal::Memory &mem = n.second;
-      out << "\nkey " << n.first << ", "
+      out << "\nkey " << key << ", "
           << "h_ptr " << mem.h_ptr << ", "
           << "d_ptr " << mem.d_ptr;
       n_out++;
-   }
-   if (maps->memories.size() > 0) { out << std::endl; }
+   });
+   if (n_out > 0) { out << std::endl; }
    return n_out;
 }
 
 int MemoryManager::PrintAliases(std::ostream &out)
 {
    int n_out = 0;
-   for (const auto& n : maps->aliases)
+   maps->aliases.ForEach([&](const void *key, const internal::Alias &alias)
    {
-      const internal::Alias &alias = n.second;
-      out << "\nalias: key " << n.first << ", "
+      out << "\nalias: key " << key << ", "
           << "h_ptr " << alias.mem->h_ptr << ", "
           << "offset " << alias.offset << ", "
           << "bytes  " << alias.bytes << ", "
           << "counter " << alias.counter;
       n_out++;
-   }
-   if (maps->aliases.size() > 0) { out << std::endl; }
+   });
+   if (n_out > 0) { out << std::endl; }
    return n_out;
 }
 
@@ -1378,10 +2086,10 @@ void MemoryPrintFlags(unsigned flags)
 void MemoryManager::CheckHostMemoryType_(MemoryType h_mt, void *h_ptr)
 {
    if (!mm.exists) {return;}
-   const bool known = mm.IsKnown(h_ptr);
-   const bool alias = mm.IsAlias(h_ptr);
-   if (known) { MFEM_VERIFY(h_mt == maps->memories.at(h_ptr).h_mt,""); }
-   if (alias) { MFEM_VERIFY(h_mt == maps->aliases.at(h_ptr).mem->h_mt,""); }
+   const internal::Memory *mem = maps->memories.Find(h_ptr);
+   if (mem) { MFEM_VERIFY(h_mt == mem->h_mt,""); return; }
+   const internal::Alias *alias = maps->aliases.Find(h_ptr);
+   if (alias) { MFEM_VERIFY(h_mt == alias->mem->h_mt,""); }
 }
 
 MemoryManager mm;
@@ -1393,12 +2101,19 @@ const char* MemoryManager::h_umpire_name = "HOST";
 const char* MemoryManager::d_umpire_name = "DEVICE";
 #endif
 
+size_t MemoryManager::pool_high_water_mark = size_t(1) << 30;
+MemoryPoolRelease MemoryManager::pool_release =
+   MemoryPoolRelease::HIGH_WATER_MARK;
+MemoryNumaPolicy MemoryManager::numa_policy = MemoryNumaPolicy::FIRST_TOUCH;
+bool MemoryManager::trace_transfers = false;
+
 MemoryType MemoryManager::host_mem_type = MemoryType::HOST;
 MemoryType MemoryManager::device_mem_type = MemoryType::HOST;
 
 const char *MemoryTypeName[MemoryTypeSize] =
 {
-   "host-std", "host-32", "host-64", "host-debug", "host-umpire",
+   "host-std", "host-32", "host-64", "host-debug", "host-umpire", "host-pool",
+   "host-numa",
 #if defined(MFEM_USE_CUDA)
    "cuda-uvm",
    "cuda",
@@ -1411,11 +2126,14 @@ const char *MemoryTypeName[MemoryTypeSize] =
 #endif
    "device-debug",
 #if defined(MFEM_USE_CUDA)
-   "cuda-umpire"
+   "cuda-umpire",
+   "cuda-pool"
 #elif defined(MFEM_USE_HIP)
-   "hip-umpire"
+   "hip-umpire",
+   "hip-pool"
 #else
-   "device-umpire"
+   "device-umpire",
+   "device-pool"
 #endif
 };
 
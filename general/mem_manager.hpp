@@ -32,12 +32,19 @@ enum class MemoryType
    HOST_64,        ///< Host memory; aligned at 64 bytes
    HOST_DEBUG,     ///< Host memory; allocated from a "host-debug" pool
    HOST_UMPIRE,    ///< Host memory; using Umpire
+   HOST_POOL,      /**< Host memory; cached by a size-class pool, see
+                        MemoryPoolStats */
+   HOST_NUMA,      /**< Host memory; page aligned and placed on the NUMA nodes
+                        of the threads of the backend, see MemoryNumaPolicy */
    MANAGED,        /**< Managed memory; using CUDA or HIP *MallocManaged
                         and *Free */
    DEVICE,         ///< Device memory; using CUDA or HIP *Malloc and *Free
    DEVICE_DEBUG,   /**< Pseudo-device memory; allocated on host from a
                         "device-debug" pool */
    DEVICE_UMPIRE,  ///< Device memory; using Umpire
+   DEVICE_POOL,    /**< Device memory; cached by a size-class pool, using the
+                        DEVICE memory, or the host memory when no CUDA or HIP
+                        support is enabled (e.g. with the 'debug' device) */
    SIZE            ///< Number of host and device memory types
 };
 
@@ -58,13 +65,71 @@ extern const char *MemoryTypeName[MemoryTypeSize];
 enum class MemoryClass
 {
    HOST,    /**< Memory types: { HOST, HOST_32, HOST_64, HOST_DEBUG,
-                                 HOST_UMPIRE, MANAGED } */
+                                 HOST_UMPIRE, HOST_POOL, HOST_NUMA,
+                                 MANAGED } */
    HOST_32, ///< Memory types: { HOST_32, HOST_64, HOST_DEBUG }
    HOST_64, ///< Memory types: { HOST_64, HOST_DEBUG }
-   DEVICE,  ///< Memory types: { DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE, MANAGED }
+   DEVICE,  /**< Memory types: { DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE,
+                                 DEVICE_POOL, MANAGED } */
    MANAGED  ///< Memory types: { MANAGED }
 };
 
+/// Policy used by the HOST_POOL and DEVICE_POOL memory types to return the
+/// cached blocks to their backend (i.e. to the OS or to the device driver).
+enum class MemoryPoolRelease
+{
+   HIGH_WATER_MARK, /**< Freed blocks are cached as long as the cached bytes
+                         stay below the high-water mark, otherwise they are
+                         returned to the backend (default). */
+   ON_REQUEST       /**< Freed blocks are always cached, they are returned to
+                         the backend only by MemoryManager::ReleasePool() or
+                         when the MemoryManager is destroyed. */
+};
+
+/// Page placement policy of the HOST_NUMA memory type.
+/** Blocks of HOST_NUMA memory are allocated with fresh pages from the OS. The
+    blocks smaller than 64 KiB, which span only a few pages, are 64-byte aligned
+    host blocks placed by the allocating thread. */
+enum class MemoryNumaPolicy
+{
+   FIRST_TOUCH, /**< The pages are touched at allocation by the threads of
+                     the OMP or THREADS backend, with the same static partition
+                     as the MFEM_FORALL loops, so that each page is placed on
+                     the NUMA node of the thread that will use it (default).
+                     With the other backends, they are touched sequentially. */
+   INTERLEAVE   /**< The pages are interleaved round-robin among the NUMA
+                     nodes allowed to the process (Linux only, otherwise same
+                     as FIRST_TOUCH), for data used by all the threads. */
+};
+
+/// Allocation statistics of the HOST_POOL or DEVICE_POOL memory types.
+/** The sizes are in bytes, rounded up to the size classes of the pool. */
+struct MemoryPoolStats
+{
+   size_t allocs = 0;   ///< Number of allocations requested from the pool
+   size_t reuses = 0;   ///< Number of allocations served from the cache
+   size_t releases = 0; ///< Number of blocks returned to the backend
+   size_t used = 0;     ///< Bytes currently in use
+   size_t cached = 0;   ///< Bytes currently cached, i.e. freed but not released
+   size_t peak = 0;     ///< Peak of the bytes held, i.e. of used + cached
+};
+
+/// Statistics of the host/device transfers recorded by the MemoryManager.
+/** See MemoryManager::EnableTransferTrace(). A copy is redundant when it moves
+    back data that was not modified since its previous transfer in the other
+    direction, i.e. a device to host copy of data that the device kernels did
+    not change, or a host to device copy of data that the host did not change.
+    The unmodified data is detected by comparing checksums. */
+struct MemoryTransferStats
+{
+   size_t htod = 0;             ///< Number of host to device copies
+   size_t htod_bytes = 0;       ///< Bytes copied from host to device
+   size_t dtoh = 0;             ///< Number of device to host copies
+   size_t dtoh_bytes = 0;       ///< Bytes copied from device to host
+   size_t redundant = 0;        ///< Number of redundant copies
+   size_t redundant_bytes = 0;  ///< Bytes of the redundant copies
+};
+
 /// Return true if the given memory type is in MemoryClass::HOST.
 inline bool IsHostMemory(MemoryType mt) { return mt <= MemoryType::MANAGED; }
 inline bool IsDeviceMemory(MemoryType mt) { return mt >= MemoryType::MANAGED; }
@@ -96,7 +161,7 @@ MemoryClass operator*(MemoryClass mc1, MemoryClass mc2);
 
     A Memory object stores up to two different pointers: one host pointer (with
     MemoryType from MemoryClass::HOST) and one device pointer (currently one of
-    MemoryType: DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE or MANAGED).
+    MemoryType: DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE, DEVICE_POOL or MANAGED).
 
     A Memory object can hold (wrap) an externally allocated pointer with any
     given MemoryType.
@@ -473,7 +538,13 @@ private:
 
 /** The MFEM memory manager class. Host-side pointers are inserted into this
     manager which keeps track of the associated device pointer, and where the
-    data currently resides. */
+    data currently resides.
+
+    The registration and the removal of the pointers and of their aliases are
+    thread-safe, so that several threads can create and destroy Memory objects,
+    e.g. Vector%s, of any MemoryType concurrently. A given Memory object must
+    not be used concurrently by several threads if one of them modifies it,
+    e.g. with Read() or Write() when the data has to be moved. */
 class MemoryManager
 {
 private:
@@ -501,6 +572,16 @@ private:
    static const char *d_umpire_name;
 #endif
 
+   /// High-water mark and release policy of the HOST_POOL and DEVICE_POOL.
+   static size_t pool_high_water_mark;
+   static MemoryPoolRelease pool_release;
+
+   /// Page placement policy of the HOST_NUMA memory type.
+   static MemoryNumaPolicy numa_policy;
+
+   /// Recording of the host/device transfers, see EnableTransferTrace().
+   static bool trace_transfers;
+
 private: // Static methods used by the Memory<T> class
 
    /// Allocate and register a new pointer. Return the host pointer.
@@ -592,11 +673,12 @@ private:
    void InsertAlias(const void *base_ptr, void *alias_ptr,
                     const size_t bytes, const bool base_is_alias);
 
-   /// Erase an address from the memory map, as well as all its aliases
-   void Erase(void *h_ptr, bool free_dev_ptr = true);
+   /// Erase an address from the memory map, as well as all its aliases, and
+   /// return its size in bytes
+   size_t Erase(void *h_ptr, bool free_dev_ptr = true);
 
-   /// Erase an alias from the aliases map
-   void EraseAlias(void *alias_ptr);
+   /// Erase an alias from the aliases map and return its host MemoryType
+   MemoryType EraseAlias(void *alias_ptr);
 
    /// Return the corresponding device pointer of h_ptr,
    /// allocating and moving the data if needed
@@ -632,6 +714,61 @@ public:
    const char *GetUmpireAllocatorDeviceName() { return d_umpire_name; }
 #endif
 
+   /** @brief Set the maximum number of bytes cached by each of the HOST_POOL
+       and DEVICE_POOL memory types, the default is 1 GiB. */
+   /** With the MemoryPoolRelease::HIGH_WATER_MARK policy, the blocks freed
+       above this mark are returned to the backend. */
+   void SetPoolHighWaterMark(size_t bytes) { pool_high_water_mark = bytes; }
+   size_t GetPoolHighWaterMark() const { return pool_high_water_mark; }
+
+   /// Set the policy used by the pools to return their cached blocks.
+   void SetPoolReleasePolicy(MemoryPoolRelease policy)
+   { pool_release = policy; }
+   MemoryPoolRelease GetPoolReleasePolicy() const { return pool_release; }
+
+   /// Return all the blocks cached by the HOST_POOL and DEVICE_POOL memory
+   /// types to their backend.
+   void ReleasePool();
+
+   /// Return the allocation statistics of the given pool memory type,
+   /// HOST_POOL or DEVICE_POOL.
+   MemoryPoolStats GetPoolStats(MemoryType mt) const;
+
+   /** @brief Set the page placement policy of the next allocations of the
+       HOST_NUMA memory type, see MemoryNumaPolicy. */
+   void SetNumaPolicy(MemoryNumaPolicy policy) { numa_policy = policy; }
+   MemoryNumaPolicy GetNumaPolicy() const { return numa_policy; }
+
+   /** @brief Start recording the host to device and device to host copies,
+       with their call site and the detection of the redundant copies, see
+       MemoryTransferStats. If @a report is true, the transfers are printed
+       with PrintTransfers() when the program exits. */
+   /** The call site of a copy is the current Profiler region, e.g. the
+       region of an iterative solver or of a bilinear form extension, so the
+       Profiler should also be enabled, e.g. with the Device options
+       'transfers+profile'. User code can mark its own call sites with
+       MFEM_PROFILE_REGION. The recording is meant for debugging: it computes
+       a checksum of the data of every copy. It works with all the devices,
+       including the 'debug' device. */
+   void EnableTransferTrace(bool report = false);
+
+   /// Stop recording the transfers; the data recorded so far is kept.
+   void DisableTransferTrace() { trace_transfers = false; }
+
+   /// Return true if the transfers are being recorded.
+   bool IsTransferTraceEnabled() const { return trace_transfers; }
+
+   /** @brief Return the statistics of the transfers recorded at the call site
+       @a site, a Profiler region path, or of all of them if @a site is NULL. */
+   MemoryTransferStats GetTransferStats(const char *site = NULL) const;
+
+   /// Clear the recorded transfers.
+   void ResetTransferTrace();
+
+   /** @brief Print the recorded transfers of every call site, sorted by
+       decreasing volume, followed by their total. */
+   void PrintTransfers(std::ostream &out = mfem::out);
+
    /// Free all the device memories
    void Destroy();
 
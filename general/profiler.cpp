@@ -0,0 +1,519 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "profiler.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace mfem
+{
+
+bool Profiler::enabled = false;
+
+namespace internal
+{
+
+typedef std::chrono::steady_clock ProfilerClock;
+
+/// A node of the region tree, i.e. a region in a given calling context.
+struct ProfilerNode
+{
+   const char *name;
+   int parent;
+   std::vector<int> children;
+   long calls;
+   double time, tmin, tmax; // seconds; tmin and tmax are over the ranks
+   double bytes, flops;
+   int ranks; // number of ranks that entered the region
+
+   ProfilerNode(const char *name, int parent)
+      : name(name), parent(parent), calls(0), time(0.0), tmin(0.0), tmax(0.0),
+        bytes(0.0), flops(0.0), ranks(1) { }
+};
+
+/// A region instance, for the TRACE output.
+struct ProfilerEvent
+{
+   int node, rank;
+   double ts, dur; // microseconds
+};
+
+class ProfilerData
+{
+public:
+   std::vector<ProfilerNode> nodes;
+   std::vector<std::pair<int,ProfilerClock::time_point>> stack;
+   std::vector<ProfilerEvent> events;
+   std::list<std::string> names; // storage of the names received from ranks
+   ProfilerClock::time_point t0;
+   bool trace, finalized, at_exit;
+   Profiler::Format format;
+   std::string file;
+   bool output;
+
+   ProfilerData()
+      : t0(ProfilerClock::now()), trace(false), finalized(false),
+        at_exit(false), format(Profiler::TEXT), output(false)
+   { Reset(); }
+
+   void Reset()
+   {
+      nodes.clear();
+      nodes.emplace_back("total", -1);
+      stack.clear();
+      events.clear();
+   }
+
+   int Current() const { return stack.empty() ? 0 : stack.back().first; }
+
+   int Child(int parent, const char *name)
+   {
+      for (int c : nodes[parent].children)
+      {
+         if (nodes[c].name == name || !std::strcmp(nodes[c].name, name))
+         {
+            return c;
+         }
+      }
+      const int c = nodes.size();
+      nodes.emplace_back(name, parent);
+      nodes[parent].children.push_back(c);
+      return c;
+   }
+
+   const char *StoreName(const std::string &name)
+   {
+      names.push_back(name);
+      return names.back().c_str();
+   }
+
+   /// Update the total, i.e. the root node, with the time since the start.
+   void UpdateTotal()
+   {
+      const std::chrono::duration<double> t = ProfilerClock::now() - t0;
+      ProfilerNode &root = nodes[0];
+      root.calls = 1;
+      root.time = root.tmin = root.tmax = t.count();
+      root.bytes = root.flops = 0.0;
+      for (int c : root.children)
+      {
+         root.bytes += nodes[c].bytes;
+         root.flops += nodes[c].flops;
+      }
+   }
+
+   std::string Path(int n) const
+   {
+      std::string path = nodes[n].name;
+      for (int p = nodes[n].parent; p > 0; p = nodes[p].parent)
+      {
+         path = std::string(nodes[p].name) + '/' + path;
+      }
+      return path;
+   }
+};
+
+static ProfilerData &GetProfilerData()
+{
+   static ProfilerData data;
+   return data;
+}
+
+// Print @a value with a fixed number of decimals, or '-' if it is not positive.
+static void PrintFixed(std::ostream &out, int width, int decimals, double value)
+{
+   if (value <= 0.0) { out << std::setw(width) << '-'; return; }
+   out << std::setw(width) << std::fixed << std::setprecision(decimals)
+       << value << std::resetiosflags(std::ios::floatfield)
+       << std::setprecision(6);
+}
+
+static void PrintText(const ProfilerData &data, int n, int depth, int nranks,
+                      std::ostream &out)
+{
+   const ProfilerNode &node = data.nodes[n];
+   const double total = data.nodes[0].time/data.nodes[0].ranks;
+   const double time = node.time/node.ranks;
+   std::string name = std::string(2*depth, ' ') + node.name;
+   if (name.size() > 40) { name = name.substr(0, 37) + "..."; }
+   out << std::left << std::setw(40) << name << std::right
+       << std::setw(10) << node.calls
+       << std::setw(13) << time;
+   PrintFixed(out, 8, 1, total > 0.0 ? 100.0*time/total : 0.0);
+   if (nranks > 1)
+   {
+      out << std::setw(13) << node.tmin << std::setw(13) << node.tmax;
+   }
+   // Aggregate rates: the counters of all the ranks over the average time.
+   const double rate = (node.time > 0.0) ? 1e-9*node.ranks/node.time : 0.0;
+   PrintFixed(out, 10, 2, rate*node.bytes);
+   PrintFixed(out, 10, 2, rate*node.flops);
+   out << '\n';
+   for (int c : node.children) { PrintText(data, c, depth + 1, nranks, out); }
+}
+
+static void PrintJSONString(const char *s, std::ostream &out)
+{
+   out << '"';
+   for (; *s; s++)
+   {
+      const char c = *s;
+      if (c == '"' || c == '\\') { out << '\\' << c; }
+      else if (c == '\n') { out << "\\n"; }
+      else if (static_cast<unsigned char>(c) < 0x20) { out << ' '; }
+      else { out << c; }
+   }
+   out << '"';
+}
+
+static void PrintJSON(const ProfilerData &data, int n, int depth,
+                      std::ostream &out)
+{
+   const ProfilerNode &node = data.nodes[n];
+   const std::string indent(2*depth, ' ');
+   out << indent << "{\"name\": ";
+   PrintJSONString(node.name, out);
+   out << ", \"calls\": " << node.calls
+       << ", \"time\": " << node.time/node.ranks
+       << ", \"time_min\": " << node.tmin
+       << ", \"time_max\": " << node.tmax
+       << ", \"bytes\": " << node.bytes
+       << ", \"flops\": " << node.flops
+       << ", \"children\": [";
+   for (std::size_t i = 0; i < node.children.size(); i++)
+   {
+      out << (i ? ",\n" : "\n");
+      PrintJSON(data, node.children[i], depth + 1, out);
+   }
+   if (!node.children.empty()) { out << '\n' << indent; }
+   out << "]}";
+}
+
+static void PrintTrace(const ProfilerData &data, std::ostream &out)
+{
+   out << "{\"traceEvents\": [";
+   for (std::size_t i = 0; i < data.events.size(); i++)
+   {
+      const ProfilerEvent &e = data.events[i];
+      out << (i ? ",\n" : "\n") << "{\"name\": ";
+      PrintJSONString(data.nodes[e.node].name, out);
+      out << ", \"cat\": \"mfem\", \"ph\": \"X\", \"ts\": " << e.ts
+          << ", \"dur\": " << e.dur << ", \"pid\": " << e.rank
+          << ", \"tid\": 0}";
+   }
+   out << "\n]}\n";
+}
+
+static void Print(const ProfilerData &data, int nranks, std::ostream &out,
+                  Profiler::Format format)
+{
+   std::ios::fmtflags flags(out.flags());
+   const std::streamsize precision = out.precision();
+   out << std::setprecision(6);
+   switch (format)
+   {
+      case Profiler::TEXT:
+         out << std::left << std::setw(40) << "region" << std::right
+             << std::setw(10) << "calls" << std::setw(13) << "time [s]"
+             << std::setw(8) << "%";
+         if (nranks > 1)
+         {
+            out << std::setw(13) << "min [s]" << std::setw(13) << "max [s]";
+         }
+         out << std::setw(10) << "GB/s" << std::setw(10) << "GFLOP/s" << '\n';
+         PrintText(data, 0, 0, nranks, out);
+         break;
+      case Profiler::JSON:
+         PrintJSON(data, 0, 0, out);
+         out << '\n';
+         break;
+      case Profiler::TRACE:
+         PrintTrace(data, out);
+         break;
+   }
+   out.flags(flags);
+   out.precision(precision);
+   out.flush();
+}
+
+static void PrintOutput(std::ostream &out)
+{
+   ProfilerData &data = GetProfilerData();
+#ifdef MFEM_USE_MPI
+   int initialized, finalized;
+   MPI_Initialized(&initialized);
+   MPI_Finalized(&finalized);
+   if (initialized && !finalized)
+   {
+      Profiler::Print(MPI_COMM_WORLD, out, data.format);
+      return;
+   }
+#endif
+   Profiler::Print(out, data.format);
+}
+
+} // namespace internal
+
+void Profiler::Enable(bool trace)
+{
+   internal::ProfilerData &data = internal::GetProfilerData();
+   data.trace = data.trace || trace;
+   enabled = true;
+}
+
+void Profiler::Disable()
+{
+   enabled = false;
+}
+
+void Profiler::Begin(const char *name)
+{
+   internal::ProfilerData &data = internal::GetProfilerData();
+   const int node = data.Child(data.Current(), name);
+   data.stack.emplace_back(node, internal::ProfilerClock::now());
+}
+
+void Profiler::End()
+{
+   internal::ProfilerData &data = internal::GetProfilerData();
+   if (data.stack.empty()) { return; }
+   const internal::ProfilerClock::time_point t1 =
+      internal::ProfilerClock::now();
+   const int n = data.stack.back().first;
+   const internal::ProfilerClock::time_point t0 = data.stack.back().second;
+   data.stack.pop_back();
+   const std::chrono::duration<double> dt = t1 - t0;
+   internal::ProfilerNode &node = data.nodes[n];
+   node.calls++;
+   node.time += dt.count();
+   node.tmin = node.tmax = node.time;
+   if (data.trace)
+   {
+      const std::chrono::duration<double,std::micro> ts = t0 - data.t0;
+      data.events.push_back({n, 0, ts.count(), 1e6*dt.count()});
+   }
+}
+
+void Profiler::AddCounters(double bytes, double flops)
+{
+   internal::ProfilerData &data = internal::GetProfilerData();
+   // The counters are inclusive, as the times: add them to the enclosing
+   // regions too, the total being updated in Print().
+   for (int n = data.Current(); n > 0; n = data.nodes[n].parent)
+   {
+      data.nodes[n].bytes += bytes;
+      data.nodes[n].flops += flops;
+   }
+}
+
+std::string Profiler::GetRegionPath()
+{
+   if (!IsEnabled()) { return std::string(); }
+   const internal::ProfilerData &data = internal::GetProfilerData();
+   const int n = data.Current();
+   return (n > 0) ? data.Path(n) : std::string();
+}
+
+void Profiler::Reset()
+{
+   internal::ProfilerData &data = internal::GetProfilerData();
+   data.Reset();
+   data.t0 = internal::ProfilerClock::now();
+}
+
+void Profiler::Print(std::ostream &out, Format format)
+{
+   internal::ProfilerData &data = internal::GetProfilerData();
+   data.UpdateTotal();
+   internal::Print(data, 1, out, format);
+}
+
+#ifdef MFEM_USE_MPI
+void Profiler::Print(MPI_Comm comm, std::ostream &out, Format format)
+{
+   internal::ProfilerData &data = internal::GetProfilerData();
+   data.UpdateTotal();
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+
+   // Serialize the regions by their path, one per line, followed by the trace
+   // events when the TRACE output is requested.
+   std::ostringstream os;
+   os << std::setprecision(17);
+   os << data.nodes.size() - 1 << '\n';
+   for (std::size_t n = 1; n < data.nodes.size(); n++)
+   {
+      const internal::ProfilerNode &node = data.nodes[n];
+      os << node.calls << ' ' << node.time << ' ' << node.bytes << ' '
+         << node.flops << ' ' << data.Path(n) << '\n';
+   }
+   const bool trace = (format == TRACE);
+   os << (trace ? data.events.size() : 0) << '\n';
+   for (std::size_t i = 0; trace && i < data.events.size(); i++)
+   {
+      const internal::ProfilerEvent &e = data.events[i];
+      os << e.node << ' ' << e.ts << ' ' << e.dur << '\n';
+   }
+   const std::string buf = os.str();
+
+   int size = buf.size();
+   std::vector<int> sizes(rank == 0 ? nranks : 0), displs;
+   MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+   std::vector<char> recv;
+   if (rank == 0)
+   {
+      displs.resize(nranks + 1, 0);
+      for (int r = 0; r < nranks; r++) { displs[r+1] = displs[r] + sizes[r]; }
+      recv.resize(displs[nranks]);
+   }
+   MPI_Gatherv(const_cast<char*>(buf.data()), size, MPI_CHAR, recv.data(),
+               sizes.data(), displs.data(), MPI_CHAR, 0, comm);
+   double total = data.nodes[0].time, tmin = total, tmax = total;
+   MPI_Reduce(&total, &tmin, 1, MPI_DOUBLE, MPI_MIN, 0, comm);
+   MPI_Reduce(&total, &tmax, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+   if (rank != 0) { return; }
+
+   // Merge the regions of all the ranks in a new tree.
+   internal::ProfilerData merged;
+   merged.nodes[0].calls = 1;
+   merged.nodes[0].time = tmax*nranks;
+   merged.nodes[0].tmin = tmin;
+   merged.nodes[0].tmax = tmax;
+   merged.nodes[0].ranks = nranks;
+   for (int r = 0; r < nranks; r++)
+   {
+      std::istringstream is(std::string(recv.data() + displs[r], sizes[r]));
+      std::size_t num_nodes, num_events;
+      is >> num_nodes;
+      std::vector<int> map(num_nodes + 1, 0);
+      for (std::size_t n = 1; n <= num_nodes; n++)
+      {
+         long calls;
+         double time, bytes, flops;
+         std::string path;
+         is >> calls >> time >> bytes >> flops;
+         is.get();
+         std::getline(is, path);
+         // Walk the path in the merged tree, creating the missing nodes.
+         int m = 0;
+         for (std::size_t p = 0, q; p <= path.size(); p = q + 1)
+         {
+            q = path.find('/', p);
+            if (q == std::string::npos) { q = path.size(); }
+            const std::string name = path.substr(p, q - p);
+            int c = -1;
+            for (int k : merged.nodes[m].children)
+            {
+               if (name == merged.nodes[k].name) { c = k; break; }
+            }
+            if (c < 0)
+            {
+               c = merged.Child(m, merged.StoreName(name));
+               merged.nodes[c].ranks = 0;
+            }
+            m = c;
+         }
+         map[n] = m;
+         internal::ProfilerNode &node = merged.nodes[m];
+         node.tmin = (node.ranks == 0) ? time : std::min(node.tmin, time);
+         node.tmax = (node.ranks == 0) ? time : std::max(node.tmax, time);
+         node.ranks++;
+         node.calls += calls;
+         node.time += time;
+         node.bytes += bytes;
+         node.flops += flops;
+      }
+      is >> num_events;
+      for (std::size_t i = 0; i < num_events; i++)
+      {
+         internal::ProfilerEvent e;
+         is >> e.node >> e.ts >> e.dur;
+         e.node = map[e.node];
+         e.rank = r;
+         merged.events.push_back(e);
+      }
+   }
+   for (std::size_t n = 1; n < merged.nodes.size(); n++)
+   {
+      merged.nodes[0].bytes += (merged.nodes[n].parent == 0) ?
+                               merged.nodes[n].bytes : 0.0;
+      merged.nodes[0].flops += (merged.nodes[n].parent == 0) ?
+                               merged.nodes[n].flops : 0.0;
+   }
+   internal::Print(merged, nranks, out, format);
+}
+#endif
+
+void Profiler::SetOutput(const char *spec)
+{
+   MFEM_VERIFY(spec, "invalid profiler output");
+   internal::ProfilerData &data = internal::GetProfilerData();
+   const char *colon = std::strchr(spec, ':');
+   const std::string format =
+      colon ? std::string(spec, colon - spec) : std::string(spec);
+   if (format == "text") { data.format = TEXT; }
+   else if (format == "json") { data.format = JSON; }
+   else if (format == "trace") { data.format = TRACE; }
+   else { MFEM_ABORT("unknown profiler format: '" << format << "'"); }
+   data.file = colon ? std::string(colon + 1) : std::string();
+   data.output = true;
+   data.finalized = false;
+   Enable(data.format == TRACE);
+   if (!data.at_exit)
+   {
+      data.at_exit = true;
+      std::atexit(Finalize);
+   }
+}
+
+void Profiler::Finalize()
+{
+   internal::ProfilerData &data = internal::GetProfilerData();
+   if (!data.output || data.finalized) { return; }
+   data.finalized = true;
+   if (data.file.empty())
+   {
+      internal::PrintOutput(mfem::out);
+      return;
+   }
+#ifdef MFEM_USE_MPI
+   int initialized, finalized, rank = 0;
+   MPI_Initialized(&initialized);
+   MPI_Finalized(&finalized);
+   if (initialized && !finalized) { MPI_Comm_rank(MPI_COMM_WORLD, &rank); }
+   if (rank != 0)
+   {
+      std::ostringstream discard;
+      internal::PrintOutput(discard);
+      return;
+   }
+#endif
+   std::ofstream out(data.file);
+   if (!out)
+   {
+      MFEM_WARNING("cannot open the profiler output '" << data.file << "'");
+      return;
+   }
+   internal::PrintOutput(out);
+}
+
+} // namespace mfem
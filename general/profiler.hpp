@@ -0,0 +1,153 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PROFILER_HPP
+#define MFEM_PROFILER_HPP
+
+#include "../config/config.hpp"
+#include "globals.hpp" // mfem::out, and mpi.h with MFEM_USE_MPI
+#include "thread_pool.hpp"
+
+#include <string>
+
+namespace mfem
+{
+
+/** @brief Hierarchical region profiler.
+
+    The profiler records the number of calls and the wall-clock time of nested
+    named regions, marked with MFEM_PROFILE_REGION, e.g. in the bilinear form
+    extensions, the element restrictions, the iterative solvers and the
+    GroupCommunicator. Every MFEM_FORALL kernel is also recorded as a region
+    named after the function that launches it. Regions can carry counters of
+    the bytes moved and of the floating point operations, see
+    MFEM_PROFILE_COUNTERS, which are estimated by the partial assembly kernels.
+
+    The profiler is always compiled, but is disabled by default: a disabled
+    region costs a single test of a static flag. It is enabled with Enable(),
+    with the Device option 'profile', e.g. 'cpu:profile', or with the
+    environment variable MFEM_PROFILE, whose value has the form
+
+        <format>[:<file>]
+
+    where <format> is 'text', 'json' or 'trace' (Chrome trace event format, to
+    be loaded e.g. in chrome://tracing or Perfetto). The profile is written
+    when the program exits or, in parallel, when the MPI_Session is destroyed,
+    in which case the profiles of all the MPI ranks are aggregated.
+
+    Region names must be string literals or otherwise outlive the profiler.
+    Device kernels are synchronized at the end of their region, so that their
+    time is attributed to it. The profiler is not thread-safe: regions should
+    only be opened by the thread that launches the kernels. The regions of the
+    ThreadPool workers, e.g. of the concurrent ExecutionQueue operations, are
+    not recorded. */
+class Profiler
+{
+public:
+   /// Output formats
+   enum Format
+   {
+      TEXT,  ///< Indented text summary
+      JSON,  ///< Nested JSON regions
+      TRACE  ///< Chrome trace event format
+   };
+
+   /** @brief Start recording the regions. If @a trace is true, every region
+       instance is also recorded as an event, for the TRACE output. */
+   static void Enable(bool trace = false);
+
+   /// Stop recording the regions; the data recorded so far is kept.
+   static void Disable();
+
+   /// Return true if the regions are being recorded by the calling thread.
+   static inline bool IsEnabled()
+   { return enabled && !ThreadPool::InWorker(); }
+
+   /// Open a region nested in the current one, see MFEM_PROFILE_REGION.
+   static void Begin(const char *name);
+
+   /// Close the current region.
+   static void End();
+
+   /** @brief Add the given bytes and floating point operations to the current
+       region and to the regions enclosing it. */
+   static void AddCounters(double bytes, double flops);
+
+   /** @brief Return the path of the current region, e.g.
+       "CGSolver::Mult/PABilinearFormExtension::Mult", or an empty string
+       outside of the regions or if the profiler is disabled. */
+   static std::string GetRegionPath();
+
+   /// Clear all the recorded regions and events.
+   static void Reset();
+
+   /// Print the recorded regions in the given format.
+   static void Print(std::ostream &out = mfem::out, Format format = TEXT);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Aggregate the regions of all the ranks of @a comm and print them
+       on its rank 0. The text and JSON outputs report the minimum, average and
+       maximum time over the ranks; the TRACE output has one process per rank.
+       This is a collective call. */
+   static void Print(MPI_Comm comm, std::ostream &out = mfem::out,
+                     Format format = TEXT);
+#endif
+
+   /** @brief Enable the profiler and request its output in the form
+       <format>[:<file>] when the program exits, see the class documentation.
+       Without a file, the output goes to mfem::out. */
+   static void SetOutput(const char *spec);
+
+   /** @brief Write the output requested with SetOutput(), if any. This is done
+       automatically at exit and by the MPI_Session destructor. */
+   static void Finalize();
+
+private:
+   static bool enabled;
+};
+
+/// RAII object opening a Profiler region for its lifetime.
+class ProfilerRegion
+{
+   const bool active;
+public:
+   explicit ProfilerRegion(const char *name) : active(Profiler::IsEnabled())
+   { if (active) { Profiler::Begin(name); } }
+   ~ProfilerRegion() { if (active) { Profiler::End(); } }
+};
+
+/** @brief Estimated number of floating point operations of a sum factorized
+    interpolation of D1D^dim values to Q1D^dim points, or of its transpose,
+    used for the counters of the partial assembly kernels. */
+inline double SumFactorizationFlops(int dim, int D1D, int Q1D)
+{
+   double flops = 0.0, d = 1.0, q = 1.0;
+   for (int k = 0; k < dim; k++) { d *= D1D; }
+   for (int k = 0; k < dim; k++) { d /= D1D; q *= Q1D; flops += D1D*d*q; }
+   return 2.0*flops;
+}
+
+} // namespace mfem
+
+#define MFEM_PROFILE_CAT_(a,b) a##b
+#define MFEM_PROFILE_CAT(a,b) MFEM_PROFILE_CAT_(a,b)
+
+/// Profile the rest of the enclosing scope as the region @a name.
+#define MFEM_PROFILE_REGION(name) \
+   mfem::ProfilerRegion MFEM_PROFILE_CAT(mfem_profile_region_,__LINE__)(name)
+
+/** @brief Add @a bytes and @a flops to the counters of the current region. The
+    arguments are only evaluated when the profiler is enabled. */
+#define MFEM_PROFILE_COUNTERS(bytes,flops) \
+   do { if (mfem::Profiler::IsEnabled()) \
+        { mfem::Profiler::AddCounters(bytes,flops); } } while (0)
+
+#endif // MFEM_PROFILER_HPP
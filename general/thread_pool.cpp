@@ -0,0 +1,386 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "thread_pool.hpp"
+#include "error.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// Index of the current thread in the pool: 0 for the other threads, including
+// the one running a parallel loop, and 1, 2, ... for the workers.
+static thread_local int thread_index = 0;
+
+// True while the current thread runs a parallel loop.
+static thread_local bool in_loop = false;
+
+// Range [lo,hi) of the chunks of a parallel loop owned by a thread, packed in
+// 64 bits so that it can be updated atomically by its owner, which takes the
+// chunks from the front, and by the thieves, which take its upper half.
+struct ChunkRange
+{
+   std::atomic<std::uint64_t> range;
+   char padding[64 - sizeof(std::atomic<std::uint64_t>)];
+};
+
+static inline std::uint64_t Pack(const int lo, const int hi)
+{
+   return (std::uint64_t(std::uint32_t(lo)) << 32) | std::uint32_t(hi);
+}
+static inline int Lo(const std::uint64_t r) { return int(r >> 32); }
+static inline int Hi(const std::uint64_t r) { return int(r & 0xffffffffu); }
+
+// A parallel loop running on the pool.
+struct Loop
+{
+   void (*fn)(void *data, int begin, int end);
+   void *data;
+   int N, size;
+   std::atomic<int> remaining; // Number of chunks not yet completed
+};
+
+// Queue of the tasks spawned from a thread, with the counter of their group.
+struct TaskQueue
+{
+   std::mutex mutex;
+   std::deque<std::pair<std::function<void()>, std::atomic<int>*>> tasks;
+};
+
+class ThreadPoolData
+{
+public:
+   int num_threads = 0;     // Requested number of threads, 0: default
+   int default_threads = 0; // Default number of threads, 0: not computed
+   int grain = 0;           // Default grain size
+
+   std::mutex start_mutex;
+   std::atomic<bool> started{false};
+   int size = 1; // Number of threads of the running pool
+   std::vector<std::thread> workers;
+   std::unique_ptr<ChunkRange[]> ranges; // One per thread, 0 is the caller
+   std::unique_ptr<TaskQueue[]> queues;  // One per thread, 0 is shared
+
+   std::mutex loop_mutex; // Held by the thread running a parallel loop
+   std::atomic<Loop*> loop{nullptr};
+   std::atomic<int> active{0}; // Number of workers looking at 'loop'
+
+   std::atomic<int> queued{0};
+   std::atomic<unsigned> next_queue{0};
+
+   // The workers wait for a change of 'epoch', notified through 'cv'
+   std::mutex mutex;
+   std::condition_variable cv;
+   std::atomic<unsigned> epoch{0};
+   bool stop = false;
+
+   ~ThreadPoolData() { Stop(); }
+
+   int NumThreads()
+   {
+      if (started) { return size; }
+      if (num_threads > 0) { return num_threads; }
+      if (default_threads == 0)
+      {
+         const char *env = getenv("MFEM_NUM_THREADS");
+         default_threads = env ? atoi(env) : 0;
+         if (default_threads <= 0)
+         {
+            default_threads = std::thread::hardware_concurrency();
+         }
+         if (default_threads <= 0) { default_threads = 1; }
+      }
+      return default_threads;
+   }
+
+   void Start()
+   {
+      if (started) { return; }
+      std::lock_guard<std::mutex> guard(start_mutex);
+      if (started) { return; }
+      size = NumThreads();
+      ranges.reset(new ChunkRange[size]);
+      queues.reset(new TaskQueue[size]);
+      for (int t = 0; t < size; t++) { ranges[t].range = Pack(0, 0); }
+      stop = false;
+      for (int t = 1; t < size; t++)
+      {
+         workers.emplace_back(&ThreadPoolData::Work, this, t);
+      }
+      started = true;
+   }
+
+   void Stop()
+   {
+      if (!started) { return; }
+      MFEM_VERIFY(queued == 0 && loop == nullptr,
+                  "the ThreadPool is still in use!");
+      {
+         std::lock_guard<std::mutex> guard(mutex);
+         stop = true;
+      }
+      cv.notify_all();
+      for (auto &w : workers) { w.join(); }
+      workers.clear();
+      started = false;
+   }
+
+   void Notify()
+   {
+      {
+         std::lock_guard<std::mutex> guard(mutex);
+         epoch++;
+      }
+      cv.notify_all();
+   }
+
+   void Work(const int t)
+   {
+      thread_index = t;
+      unsigned seen = 0;
+      while (true)
+      {
+         // Spin for a short while before blocking, to reduce the latency of
+         // the loops launched in a sequence.
+         for (int s = 0; s < 128 && epoch == seen; s++)
+         {
+            std::this_thread::yield();
+         }
+         {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return stop || epoch != seen; });
+            if (stop) { return; }
+            seen = epoch;
+         }
+         JoinLoop(t);
+         while (RunTask(t)) { JoinLoop(t); }
+      }
+   }
+
+   void JoinLoop(const int t)
+   {
+      // The caller of Run() waits for 'active' to be zero after resetting
+      // 'loop', so the loop is alive while it is used here.
+      active++;
+      Loop *l = loop;
+      if (l) { Participate(*l, t); }
+      active--;
+   }
+
+   void Participate(Loop &l, const int t)
+   {
+      int c;
+      while (Pop(t, c) || Steal(t, c))
+      {
+         const int begin = c * l.size;
+         const int end = l.N - begin < l.size ? l.N : begin + l.size;
+         l.fn(l.data, begin, end);
+         l.remaining--;
+      }
+   }
+
+   // Take the first chunk of the range of thread t.
+   bool Pop(const int t, int &c)
+   {
+      std::atomic<std::uint64_t> &r = ranges[t].range;
+      std::uint64_t v = r;
+      while (Lo(v) < Hi(v))
+      {
+         if (r.compare_exchange_weak(v, Pack(Lo(v) + 1, Hi(v))))
+         {
+            c = Lo(v);
+            return true;
+         }
+      }
+      return false;
+   }
+
+   // Take the upper half of the range of another thread: its first chunk is
+   // returned in c and the others become the range of thread t, which is empty.
+   bool Steal(const int t, int &c)
+   {
+      for (int k = 1; k < size; k++)
+      {
+         std::atomic<std::uint64_t> &r = ranges[(t + k) % size].range;
+         std::uint64_t v = r;
+         while (Lo(v) < Hi(v))
+         {
+            const int lo = Lo(v), hi = Hi(v), mid = lo + (hi - lo) / 2;
+            if (r.compare_exchange_weak(v, Pack(lo, mid)))
+            {
+               c = mid;
+               ranges[t].range = Pack(mid + 1, hi);
+               return true;
+            }
+         }
+      }
+      return false;
+   }
+
+   // Run a task of the own queue of thread t, last in first out, or else the
+   // oldest task of another queue.
+   bool RunTask(const int t)
+   {
+      if (queued == 0) { return false; }
+      for (int k = 0; k < size; k++)
+      {
+         TaskQueue &q = queues[(t + k) % size];
+         std::function<void()> task;
+         std::atomic<int> *pending;
+         {
+            std::lock_guard<std::mutex> guard(q.mutex);
+            if (q.tasks.empty()) { continue; }
+            auto &entry = (k == 0 && t > 0) ? q.tasks.back() : q.tasks.front();
+            task = std::move(entry.first);
+            pending = entry.second;
+            if (k == 0 && t > 0) { q.tasks.pop_back(); }
+            else { q.tasks.pop_front(); }
+         }
+         queued--;
+         task();
+         (*pending)--;
+         return true;
+      }
+      return false;
+   }
+};
+
+static ThreadPoolData &Pool()
+{
+   static ThreadPoolData pool;
+   return pool;
+}
+
+} // namespace mfem::internal
+
+
+void ThreadPool::SetNumThreads(int num_threads)
+{
+   internal::ThreadPoolData &pool = internal::Pool();
+   MFEM_VERIFY(num_threads >= 0, "invalid number of threads");
+   pool.Stop();
+   pool.num_threads = num_threads;
+}
+
+int ThreadPool::GetNumThreads() { return internal::Pool().NumThreads(); }
+
+void ThreadPool::SetGrainSize(int grain)
+{
+   MFEM_VERIFY(grain >= 0, "invalid grain size");
+   internal::Pool().grain = grain;
+}
+
+int ThreadPool::GetGrainSize() { return internal::Pool().grain; }
+
+bool ThreadPool::InWorker() { return internal::thread_index > 0; }
+
+int ThreadPool::ChunkSize(const int N, const int grain)
+{
+   int size = grain > 0 ? grain : internal::Pool().grain;
+   if (size <= 0)
+   {
+      // A few chunks per thread, to balance the load
+      const int chunks = 4 * GetNumThreads();
+      size = (N + chunks - 1) / chunks;
+   }
+   return size > 0 ? size : 1;
+}
+
+void ThreadPool::Run(const int N, const int grain, RangeFunction fn,
+                     void *data)
+{
+   if (N <= 0) { return; }
+   internal::ThreadPoolData &pool = internal::Pool();
+   const int size = ChunkSize(N, grain);
+   if (size >= N || internal::thread_index > 0 || internal::in_loop ||
+       pool.NumThreads() == 1)
+   {
+      fn(data, 0, N);
+      return;
+   }
+   pool.Start();
+   std::unique_lock<std::mutex> lock(pool.loop_mutex, std::try_to_lock);
+   if (!lock.owns_lock())
+   {
+      // Another thread runs a loop on the pool
+      fn(data, 0, N);
+      return;
+   }
+
+   internal::Loop loop;
+   loop.fn = fn;
+   loop.data = data;
+   loop.N = N;
+   loop.size = size;
+   const int num_chunks = (N + size - 1) / size;
+   loop.remaining = num_chunks;
+   const long long nc = num_chunks, nt = pool.size;
+   for (int t = 0; t < pool.size; t++)
+   {
+      pool.ranges[t].range = internal::Pack(int(t*nc/nt), int((t+1)*nc/nt));
+   }
+
+   internal::in_loop = true;
+   pool.loop = &loop;
+   pool.Notify();
+   pool.Participate(loop, 0);
+   while (loop.remaining > 0) { std::this_thread::yield(); }
+   pool.loop = nullptr;
+   while (pool.active > 0) { std::this_thread::yield(); }
+   internal::in_loop = false;
+}
+
+void ThreadPool::Spawn(std::function<void()> &&task, std::atomic<int> &pending)
+{
+   internal::ThreadPoolData &pool = internal::Pool();
+   if (pool.NumThreads() == 1)
+   {
+      task();
+      pending--;
+      return;
+   }
+   pool.Start();
+   const int t = internal::thread_index;
+   const int q = (t > 0) ? t : int(pool.next_queue++ % pool.size);
+   {
+      std::lock_guard<std::mutex> guard(pool.queues[q].mutex);
+      pool.queues[q].tasks.emplace_back(std::move(task), &pending);
+   }
+   pool.queued++;
+   pool.Notify();
+}
+
+bool ThreadPool::RunTask()
+{
+   internal::ThreadPoolData &pool = internal::Pool();
+   if (!pool.started) { return false; }
+   return pool.RunTask(internal::thread_index);
+}
+
+void TaskGroup::Wait()
+{
+   while (pending > 0)
+   {
+      if (!ThreadPool::RunTask()) { std::this_thread::yield(); }
+   }
+}
+
+} // namespace mfem
@@ -0,0 +1,165 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_THREAD_POOL_HPP
+#define MFEM_THREAD_POOL_HPP
+
+#include "../config/config.hpp"
+
+#include <atomic>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief Persistent pool of worker threads with work stealing, used by the
+    MFEM_FORALL kernels with Backend::THREADS.
+
+    The iterations [0,N) of a parallel loop are split in chunks of a given
+    grain size. The chunks are distributed in contiguous ranges among the
+    workers and the calling thread, which also takes part in the loop. A thread
+    that runs out of chunks steals half of the remaining range of another
+    thread, so that unbalanced loops are still evenly distributed.
+
+    The pool is created on first use with GetNumThreads() threads, including
+    the calling thread. The number of threads is set with SetNumThreads() or
+    with the Device option 'threads:<n>'. By default, it is the value of the
+    environment variable MFEM_NUM_THREADS or else the number of hardware
+    threads. With MPI, the number of threads should be reduced accordingly
+    when several ranks share a node.
+
+    Only one parallel loop runs on the pool at a time: a loop started by a
+    thread while the pool is busy, e.g. by a user thread, or started inside a
+    loop or a task, e.g. by a worker, runs sequentially on the calling thread.
+    This way, applications that manage their own threads can call the MFEM
+    kernels without oversubscribing the cores. */
+class ThreadPool
+{
+public:
+   /** @brief Set the number of threads, including the calling thread, used by
+       the next parallel loops. The value 0 restores the default. This must not
+       be called while the pool is in use. */
+   static void SetNumThreads(int num_threads);
+
+   /// Return the number of threads used by the parallel loops.
+   static int GetNumThreads();
+
+   /** @brief Set the default grain size, i.e. the minimum number of iterations
+       of the chunks of a parallel loop. The value 0, the default, selects a
+       grain size giving a few chunks per thread. */
+   static void SetGrainSize(int grain);
+
+   /// Return the default grain size, see SetGrainSize().
+   static int GetGrainSize();
+
+   /// Return true if called from one of the worker threads of the pool.
+   static bool InWorker();
+
+   /** @brief Call body(i) for i in [0,N) in parallel, with chunks of @a grain
+       iterations, or of GetGrainSize() iterations if @a grain is 0. */
+   template <typename BODY>
+   static void For(const int N, BODY &&body, const int grain = 0);
+
+   /** @brief Parallel reduction: call body(i, value) for i in [0,N), where
+       body accumulates the contribution of i into value, and combine the
+       values of the chunks with op(a, b). The value @a init must be the
+       identity of @a op, e.g. 0 for a sum. The chunks are always combined in
+       the same order, so the result is deterministic for a given number of
+       threads and grain size. */
+   template <typename T, typename BODY, typename OP>
+   static T Reduce(const int N, const T &init, BODY &&body, OP &&op,
+                   const int grain = 0);
+
+private:
+   friend class TaskGroup;
+   friend class Event;
+   friend class ExecutionQueue;
+
+   typedef void (*RangeFunction)(void *data, int begin, int end);
+
+   /// Return the number of iterations of the chunks of a loop of size @a N.
+   static int ChunkSize(const int N, const int grain);
+
+   /// Run fn(data, begin, end) on the chunks of [0,N).
+   static void Run(const int N, const int grain, RangeFunction fn, void *data);
+
+   /** @brief Queue @a task, decrementing @a pending when it is done, or run
+       it immediately if the pool has no workers. */
+   static void Spawn(std::function<void()> &&task, std::atomic<int> &pending);
+
+   /// Run one of the queued tasks, if any. Return false if none was found.
+   static bool RunTask();
+};
+
+
+/** @brief Group of tasks run asynchronously on the ThreadPool.
+
+    Tasks can be spawned from any thread, including from other tasks. Wait()
+    runs the queued tasks while the group is not complete, so that waiting from
+    a worker does not block it. The destructor waits for the tasks. */
+class TaskGroup
+{
+   std::atomic<int> pending;
+
+public:
+   TaskGroup() : pending(0) { }
+
+   /// Spawn @a task, which is run by one of the threads of the ThreadPool.
+   void Run(std::function<void()> task)
+   {
+      pending++;
+      ThreadPool::Spawn(std::move(task), pending);
+   }
+
+   /// Wait for the completion of all the tasks of the group.
+   void Wait();
+
+   ~TaskGroup() { Wait(); }
+};
+
+
+template <typename BODY>
+inline void ThreadPool::For(const int N, BODY &&body, const int grain)
+{
+   typedef typename std::remove_reference<BODY>::type B;
+   auto range = [](void *data, int begin, int end)
+   {
+      B &b = *static_cast<B*>(data);
+      for (int i = begin; i < end; i++) { b(i); }
+   };
+   Run(N, grain, range, const_cast<void*>(static_cast<const void*>(&body)));
+}
+
+template <typename T, typename BODY, typename OP>
+inline T ThreadPool::Reduce(const int N, const T &init, BODY &&body, OP &&op,
+                            const int grain)
+{
+   if (N <= 0) { return init; }
+   const int size = ChunkSize(N, grain);
+   const int num_chunks = (N + size - 1) / size;
+   std::vector<T> values(num_chunks, init);
+   For(num_chunks, [&](const int c)
+   {
+      const int end = (c + 1) * size < N ? (c + 1) * size : N;
+      T value = init;
+      for (int i = c * size; i < end; i++) { body(i, value); }
+      values[c] = value;
+   }, 1);
+   T result = init;
+   for (int c = 0; c < num_chunks; c++) { result = op(result, values[c]); }
+   return result;
+}
+
+} // namespace mfem
+
+#endif // MFEM_THREAD_POOL_HPP
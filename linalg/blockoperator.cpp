@@ -80,15 +80,42 @@ void BlockOperator::Mult (const Vector & x, Vector & y) const
    xblock.Update(const_cast<Vector&>(x),col_offsets);
    yblock.Update(y,row_offsets);
 
-   for (int iRow=0; iRow < nRowBlocks; ++iRow)
+   if (ExecutionQueue::IsConcurrent())
    {
-      tmp.SetSize(row_offsets[iRow+1] - row_offsets[iRow]);
-      for (int jCol=0; jCol < nColBlocks; ++jCol)
+      // The block rows run concurrently, each one using its part of tmp
+      tmp.SetSize(height);
+      ExecutionQueue queue;
+      for (int iRow=0; iRow < nRowBlocks; ++iRow)
       {
-         if (op(iRow,jCol))
+         queue.Enqueue([this, iRow]()
          {
-            op(iRow,jCol)->Mult(xblock.GetBlock(jCol), tmp);
-            yblock.GetBlock(iRow).Add(coef(iRow,jCol), tmp);
+            Vector tmp_i;
+            tmp_i.MakeRef(tmp, row_offsets[iRow],
+                          row_offsets[iRow+1] - row_offsets[iRow]);
+            for (int jCol=0; jCol < nColBlocks; ++jCol)
+            {
+               if (op(iRow,jCol))
+               {
+                  op(iRow,jCol)->Mult(xblock.GetBlock(jCol), tmp_i);
+                  yblock.GetBlock(iRow).Add(coef(iRow,jCol), tmp_i);
+               }
+            }
+         });
+      }
+      queue.Synchronize();
+   }
+   else
+   {
+      for (int iRow=0; iRow < nRowBlocks; ++iRow)
+      {
+         tmp.SetSize(row_offsets[iRow+1] - row_offsets[iRow]);
+         for (int jCol=0; jCol < nColBlocks; ++jCol)
+         {
+            if (op(iRow,jCol))
+            {
+               op(iRow,jCol)->Mult(xblock.GetBlock(jCol), tmp);
+               yblock.GetBlock(iRow).Add(coef(iRow,jCol), tmp);
+            }
          }
       }
    }
@@ -116,15 +143,42 @@ void BlockOperator::MultTranspose (const Vector & x, Vector & y) const
    xblock.Update(const_cast<Vector&>(x),row_offsets);
    yblock.Update(y,col_offsets);
 
-   for (int iRow=0; iRow < nColBlocks; ++iRow)
+   if (ExecutionQueue::IsConcurrent())
    {
-      tmp.SetSize(col_offsets[iRow+1] - col_offsets[iRow]);
-      for (int jCol=0; jCol < nRowBlocks; ++jCol)
+      // The block columns run concurrently, each one using its part of tmp
+      tmp.SetSize(width);
+      ExecutionQueue queue;
+      for (int iRow=0; iRow < nColBlocks; ++iRow)
       {
-         if (op(jCol,iRow))
+         queue.Enqueue([this, iRow]()
+         {
+            Vector tmp_i;
+            tmp_i.MakeRef(tmp, col_offsets[iRow],
+                          col_offsets[iRow+1] - col_offsets[iRow]);
+            for (int jCol=0; jCol < nRowBlocks; ++jCol)
+            {
+               if (op(jCol,iRow))
+               {
+                  op(jCol,iRow)->MultTranspose(xblock.GetBlock(jCol), tmp_i);
+                  yblock.GetBlock(iRow).Add(coef(jCol,iRow), tmp_i);
+               }
+            }
+         });
+      }
+      queue.Synchronize();
+   }
+   else
+   {
+      for (int iRow=0; iRow < nColBlocks; ++iRow)
+      {
+         tmp.SetSize(col_offsets[iRow+1] - col_offsets[iRow]);
+         for (int jCol=0; jCol < nRowBlocks; ++jCol)
          {
-            op(jCol,iRow)->MultTranspose(xblock.GetBlock(jCol), tmp);
-            yblock.GetBlock(iRow).Add(coef(jCol,iRow), tmp);
+            if (op(jCol,iRow))
+            {
+               op(jCol,iRow)->MultTranspose(xblock.GetBlock(jCol), tmp);
+               yblock.GetBlock(iRow).Add(coef(jCol,iRow), tmp);
+            }
          }
       }
    }
@@ -192,17 +246,20 @@ void BlockDiagonalPreconditioner::Mult (const Vector & x, Vector & y) const
    xblock.Update(const_cast<Vector&>(x),offsets);
    yblock.Update(y,offsets);
 
+   // The diagonal blocks are independent and may run concurrently
+   ExecutionQueue queue;
    for (int i=0; i<nBlocks; ++i)
    {
       if (op[i])
       {
-         op[i]->Mult(xblock.GetBlock(i), yblock.GetBlock(i));
+         op[i]->MultAsync(queue, xblock.GetBlock(i), yblock.GetBlock(i));
       }
       else
       {
          yblock.GetBlock(i) = xblock.GetBlock(i);
       }
    }
+   queue.Synchronize();
 
    for (int i=0; i<nBlocks; ++i)
    {
@@ -228,17 +285,21 @@ void BlockDiagonalPreconditioner::MultTranspose (const Vector & x,
    xblock.Update(const_cast<Vector&>(x),offsets);
    yblock.Update(y,offsets);
 
+   // The diagonal blocks are independent and may run concurrently
+   ExecutionQueue queue;
    for (int i=0; i<nBlocks; ++i)
    {
       if (op[i])
       {
-         (op[i])->MultTranspose(xblock.GetBlock(i), yblock.GetBlock(i));
+         op[i]->MultTransposeAsync(queue, xblock.GetBlock(i),
+                                   yblock.GetBlock(i));
       }
       else
       {
          yblock.GetBlock(i) = xblock.GetBlock(i);
       }
    }
+   queue.Synchronize();
 
    for (int i=0; i<nBlocks; ++i)
    {
@@ -30,6 +30,9 @@ namespace mfem
  * - Use the method Mult and MultTranspose to apply the operator to a vector.
  *
  * If a block is not set, it is assumed to be a zero block.
+ *
+ * With ExecutionQueue::IsConcurrent(), i.e. with the Device option 'async',
+ * the block rows are applied concurrently.
  */
 class BlockOperator : public Operator
 {
@@ -138,6 +141,8 @@ private:
  *
  * If a block is not set, it is assumed to be an identity block.
  *
+ * With ExecutionQueue::IsConcurrent(), i.e. with the Device option 'async',
+ * the diagonal blocks are applied concurrently.
  */
 class BlockDiagonalPreconditioner : public Solver
 {
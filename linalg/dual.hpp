@@ -0,0 +1,309 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_DUAL_HPP
+#define MFEM_DUAL_HPP
+
+#include "../config/config.hpp"
+#include "../general/backends.hpp"
+
+#include <cmath>
+
+namespace mfem
+{
+
+/// Forward mode automatic differentiation
+namespace ad
+{
+
+/** @brief Dual number for forward mode automatic differentiation, carrying
+    the value of a function and its @a N partial derivatives.
+
+    A function written as a template on its scalar type, e.g.
+    @code
+       template <typename T> T f(const T &x, const T &y) { return x*sin(y); }
+    @endcode
+    can be evaluated with Dual<double,2> arguments seeded with Dual(x,0) and
+    Dual(y,1), which gives f(x,y) in the @a value and the gradient of f in the
+    @a grad of the result, with a single evaluation. The scalar type @a T is
+    typically double; it can also be any type with the arithmetic operators,
+    e.g. AutoSIMD, to evaluate several points at once.
+
+    The operators and the math functions (sqrt, exp, log, pow, sin, cos, tanh,
+    fabs) are defined in the namespace mfem::ad and are found by argument
+    dependent lookup. Generic code should call them unqualified, after e.g.
+    "using std::sqrt;", so that the same code works with double. */
+template <typename T, int N>
+class Dual
+{
+public:
+   typedef T value_type;
+
+   T value;   ///< Value of the function
+   T grad[N]; ///< Partial derivatives of the function
+
+   /// Uninitialized dual number
+   Dual() = default;
+
+   /// Dual number of the constant @a v, i.e. with zero derivatives
+   MFEM_HOST_DEVICE Dual(const T &v) : value(v)
+   {
+      for (int i = 0; i < N; i++) { grad[i] = 0.0; }
+   }
+
+   /// Dual number of the @a i-th independent variable, with value @a v
+   MFEM_HOST_DEVICE Dual(const T &v, const int i) : value(v)
+   {
+      for (int j = 0; j < N; j++) { grad[j] = (i == j) ? 1.0 : 0.0; }
+   }
+
+   MFEM_HOST_DEVICE Dual &operator=(const T &v)
+   {
+      value = v;
+      for (int i = 0; i < N; i++) { grad[i] = 0.0; }
+      return *this;
+   }
+
+   MFEM_HOST_DEVICE Dual &operator+=(const Dual &b)
+   {
+      value += b.value;
+      for (int i = 0; i < N; i++) { grad[i] += b.grad[i]; }
+      return *this;
+   }
+
+   MFEM_HOST_DEVICE Dual &operator-=(const Dual &b)
+   {
+      value -= b.value;
+      for (int i = 0; i < N; i++) { grad[i] -= b.grad[i]; }
+      return *this;
+   }
+
+   MFEM_HOST_DEVICE Dual &operator*=(const Dual &b)
+   {
+      for (int i = 0; i < N; i++)
+      {
+         grad[i] = grad[i]*b.value + value*b.grad[i];
+      }
+      value *= b.value;
+      return *this;
+   }
+
+   MFEM_HOST_DEVICE Dual &operator/=(const Dual &b)
+   {
+      const T inv = 1.0/b.value;
+      value *= inv;
+      for (int i = 0; i < N; i++)
+      {
+         grad[i] = (grad[i] - value*b.grad[i])*inv;
+      }
+      return *this;
+   }
+
+   MFEM_HOST_DEVICE Dual &operator+=(const T &b) { value += b; return *this; }
+
+   MFEM_HOST_DEVICE Dual &operator-=(const T &b) { value -= b; return *this; }
+
+   MFEM_HOST_DEVICE Dual &operator*=(const T &b)
+   {
+      value *= b;
+      for (int i = 0; i < N; i++) { grad[i] *= b; }
+      return *this;
+   }
+
+   MFEM_HOST_DEVICE Dual &operator/=(const T &b)
+   {
+      const T inv = 1.0/b;
+      return *this *= inv;
+   }
+};
+
+/** @brief The scalar type of Dual<T,N>. It is not deduced in the operators,
+    so that e.g. 2*x is valid for a Dual x with T = double. */
+template <typename T, int N>
+using Scalar = typename Dual<T,N>::value_type;
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator+(const Dual<T,N> &a) { return a; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator-(const Dual<T,N> &a)
+{
+   Dual<T,N> r;
+   r.value = -a.value;
+   for (int i = 0; i < N; i++) { r.grad[i] = -a.grad[i]; }
+   return r;
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator+(Dual<T,N> a, const Dual<T,N> &b) { return a += b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator+(Dual<T,N> a, const Scalar<T,N> &b) { return a += b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator+(const Scalar<T,N> &a, Dual<T,N> b) { return b += a; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator-(Dual<T,N> a, const Dual<T,N> &b) { return a -= b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator-(Dual<T,N> a, const Scalar<T,N> &b) { return a -= b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator-(const Scalar<T,N> &a, const Dual<T,N> &b) { return -b + a; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator*(Dual<T,N> a, const Dual<T,N> &b) { return a *= b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator*(Dual<T,N> a, const Scalar<T,N> &b) { return a *= b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator*(const Scalar<T,N> &a, Dual<T,N> b) { return b *= a; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator/(Dual<T,N> a, const Dual<T,N> &b) { return a /= b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator/(Dual<T,N> a, const Scalar<T,N> &b) { return a /= b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> operator/(const Scalar<T,N> &a, const Dual<T,N> &b)
+{
+   Dual<T,N> r;
+   r.value = a/b.value;
+   const T d = -r.value/b.value;
+   for (int i = 0; i < N; i++) { r.grad[i] = d*b.grad[i]; }
+   return r;
+}
+
+// The comparison operators compare the values.
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator<(const Dual<T,N> &a, const Dual<T,N> &b)
+{ return a.value < b.value; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator<(const Dual<T,N> &a, const Scalar<T,N> &b) { return a.value < b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator<(const Scalar<T,N> &a, const Dual<T,N> &b) { return a < b.value; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator>(const Dual<T,N> &a, const Dual<T,N> &b)
+{ return a.value > b.value; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator>(const Dual<T,N> &a, const Scalar<T,N> &b) { return a.value > b; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator>(const Scalar<T,N> &a, const Dual<T,N> &b) { return a > b.value; }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator<=(const Dual<T,N> &a, const Dual<T,N> &b) { return !(a > b); }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator<=(const Dual<T,N> &a, const Scalar<T,N> &b) { return !(a > b); }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator<=(const Scalar<T,N> &a, const Dual<T,N> &b) { return !(a > b); }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator>=(const Dual<T,N> &a, const Dual<T,N> &b) { return !(a < b); }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator>=(const Dual<T,N> &a, const Scalar<T,N> &b) { return !(a < b); }
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+bool operator>=(const Scalar<T,N> &a, const Dual<T,N> &b) { return !(a < b); }
+
+/// Return the dual number of f(a), given f(a) in @a f and f'(a) in @a df
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> Chain(const Dual<T,N> &a, const T &f, const T &df)
+{
+   Dual<T,N> r;
+   r.value = f;
+   for (int i = 0; i < N; i++) { r.grad[i] = df*a.grad[i]; }
+   return r;
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> sqrt(const Dual<T,N> &a)
+{
+   using std::sqrt;
+   const T s = sqrt(a.value);
+   return Chain(a, s, 0.5/s);
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> exp(const Dual<T,N> &a)
+{
+   using std::exp;
+   const T e = exp(a.value);
+   return Chain(a, e, e);
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> log(const Dual<T,N> &a)
+{
+   using std::log;
+   return Chain(a, T(log(a.value)), T(1.0/a.value));
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> pow(const Dual<T,N> &a, const Scalar<T,N> &p)
+{
+   using std::pow;
+   const T ap = pow(a.value, p - 1.0);
+   return Chain(a, T(ap*a.value), T(p*ap));
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> pow(const Dual<T,N> &a, const Dual<T,N> &p)
+{
+   return exp(p*log(a));
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> sin(const Dual<T,N> &a)
+{
+   using std::sin; using std::cos;
+   return Chain(a, T(sin(a.value)), T(cos(a.value)));
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> cos(const Dual<T,N> &a)
+{
+   using std::sin; using std::cos;
+   return Chain(a, T(cos(a.value)), T(-sin(a.value)));
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> tanh(const Dual<T,N> &a)
+{
+   using std::tanh;
+   const T t = tanh(a.value);
+   return Chain(a, t, T(1.0 - t*t));
+}
+
+template <typename T, int N> MFEM_HOST_DEVICE inline
+Dual<T,N> fabs(const Dual<T,N> &a)
+{
+   return (a.value < 0.0) ? -a : a;
+}
+
+} // namespace mfem::ad
+
+using ad::Dual;
+
+} // namespace mfem
+
+#endif // MFEM_DUAL_HPP
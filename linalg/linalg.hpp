@@ -29,6 +29,7 @@
 #include "solvers.hpp"
 #include "handle.hpp"
 #include "invariants.hpp"
+#include "dual.hpp"
 
 #ifdef MFEM_USE_AMGX
 #include "amgxsolver.hpp"
@@ -324,6 +324,46 @@ ProductOperator::~ProductOperator()
 }
 
 
+SumOperator::SumOperator(const Operator *A, const double alpha,
+                         const Operator *B, const double beta,
+                         bool ownA, bool ownB)
+   : Operator(A->Height(), A->Width()),
+     A(A), B(B), alpha(alpha), beta(beta), ownA(ownA), ownB(ownB),
+     z(A->Height())
+{
+   MFEM_VERIFY(A->Width() == B->Width() && A->Height() == B->Height(),
+               "incompatible Operators: A is " << A->Height() << " x "
+               << A->Width() << ", B is " << B->Height() << " x "
+               << B->Width());
+}
+
+void SumOperator::Mult(const Vector &x, Vector &y) const
+{
+   z.SetSize(A->Height());
+   ExecutionQueue queue;
+   A->MultAsync(queue, x, z);
+   B->MultAsync(queue, x, y);
+   queue.Synchronize();
+   add(alpha, z, beta, y, y);
+}
+
+void SumOperator::MultTranspose(const Vector &x, Vector &y) const
+{
+   z.SetSize(A->Width());
+   ExecutionQueue queue;
+   A->MultTransposeAsync(queue, x, z);
+   B->MultTransposeAsync(queue, x, y);
+   queue.Synchronize();
+   add(alpha, z, beta, y, y);
+}
+
+SumOperator::~SumOperator()
+{
+   if (ownA) { delete A; }
+   if (ownB) { delete B; }
+}
+
+
 RAPOperator::RAPOperator(const Operator &Rt_, const Operator &A_,
                          const Operator &P_)
    : Operator(Rt_.Width(), P_.Width()), Rt(Rt_), A(A_), P(P_)
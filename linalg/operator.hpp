@@ -13,6 +13,7 @@
 #define MFEM_OPERATOR
 
 #include "vector.hpp"
+#include "../general/execution_queue.hpp"
 
 namespace mfem
 {
@@ -92,6 +93,19 @@ public:
    virtual void MultTranspose(const Vector &x, Vector &y) const
    { mfem_error("Operator::MultTranspose() is not overloaded!"); }
 
+   /** @brief Enqueue the operator application `y=A(x)` in @a queue, after the
+       Events @a deps. The vectors must not be used by other operations until
+       the returned Event is complete, see ExecutionQueue. */
+   Event MultAsync(ExecutionQueue &queue, const Vector &x, Vector &y,
+                   const std::vector<Event> &deps = std::vector<Event>()) const
+   { return queue.Enqueue([this, &x, &y]() { Mult(x, y); }, deps); }
+
+   /// Enqueue the action of the transpose operator, see MultAsync().
+   Event MultTransposeAsync(ExecutionQueue &queue, const Vector &x, Vector &y,
+                            const std::vector<Event> &deps =
+                               std::vector<Event>()) const
+   { return queue.Enqueue([this, &x, &y]() { MultTranspose(x, y); }, deps); }
+
    /** @brief Evaluate the gradient operator at the point @a x. The default
        behavior in class Operator is to generate an error. */
    virtual Operator &GetGradient(const Vector &x) const
@@ -743,6 +757,28 @@ public:
 };
 
 
+/** @brief General linear combination operator: x -> alpha A(x) + beta B(x).
+    With ExecutionQueue::IsConcurrent(), A and B are applied concurrently. */
+class SumOperator : public Operator
+{
+   const Operator *A, *B;
+   const double alpha, beta;
+   bool ownA, ownB;
+   mutable Vector z;
+
+public:
+   SumOperator(const Operator *A, const double alpha,
+               const Operator *B, const double beta,
+               bool ownA, bool ownB);
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   virtual ~SumOperator();
+};
+
+
 /// The operator x -> R*A*P*x constructed through the actions of R^T, A and P
 class RAPOperator : public Operator
 {
@@ -378,6 +378,7 @@ void SLISolver::UpdateVectors()
 
 void SLISolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PROFILE_REGION("SLISolver::Mult");
    int i;
 
    // Optimized preconditioned SLI with fixed number of iterations and given
@@ -556,6 +557,7 @@ void CGSolver::UpdateVectors()
 
 void CGSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PROFILE_REGION("CGSolver::Mult");
    int i;
    double r0, den, nom, nom0, betanom, alpha, beta;
 
@@ -819,6 +821,7 @@ inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
 
 void GMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PROFILE_REGION("GMRESSolver::Mult");
    // Generalized Minimum Residual method following the algorithm
    // on p. 20 of the SIAM Templates book.
 
@@ -1006,6 +1009,7 @@ finish:
 
 void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PROFILE_REGION("FGMRESSolver::Mult");
    DenseMatrix H(m+1,m);
    Vector s(m+1), cs(m+1), sn(m+1);
    Vector r(b.Size());
@@ -1213,6 +1217,7 @@ void BiCGSTABSolver::UpdateVectors()
 
 void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PROFILE_REGION("BiCGSTABSolver::Mult");
    // BiConjugate Gradient Stabilized method following the algorithm
    // on p. 27 of the SIAM Templates book.
 
@@ -1386,6 +1391,7 @@ void MINRESSolver::SetOperator(const Operator &op)
 
 void MINRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PROFILE_REGION("MINRESSolver::Mult");
    // Based on the MINRES algorithm on p. 86, Fig. 6.9 in
    // "Iterative Krylov Methods for Large Linear Systems",
    // by Henk A. van der Vorst, 2003.
@@ -1584,6 +1590,7 @@ void NewtonSolver::SetOperator(const Operator &op)
 
 void NewtonSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PROFILE_REGION("NewtonSolver::Mult");
    MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
    MFEM_ASSERT(prec != NULL, "the Solver is not set (use SetSolver).");
 
@@ -1665,6 +1672,7 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
 
 void LBFGSSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PROFILE_REGION("LBFGSSolver::Mult");
    MFEM_VERIFY(oper != NULL, "the Operator is not set (use SetOperator).");
 
    // Quadrature points that are checked for negative Jacobians etc.
@@ -765,6 +765,7 @@ double Vector::Norml2() const
 
 double Vector::Normlinf() const
 {
+   HostRead();
    double max = 0.0;
    for (int i = 0; i < size; i++)
    {
@@ -775,6 +776,7 @@ double Vector::Normlinf() const
 
 double Vector::Norml1() const
 {
+   HostRead();
    double sum = 0.0;
    for (int i = 0; i < size; i++)
    {
@@ -1046,11 +1048,7 @@ double Vector::operator*(const Vector &v) const
    MFEM_ASSERT(size == v.size, "incompatible Vectors!");
 
    const bool use_dev = UseDevice() || v.UseDevice();
-#if defined(MFEM_USE_CUDA) || defined(MFEM_USE_HIP) || defined(MFEM_USE_OPENMP)
    auto m_data = Read(use_dev);
-#else
-   Read(use_dev);
-#endif
    auto v_data = v.Read(use_dev);
 
    if (!use_dev) { goto vector_dot_cpu; }
@@ -1114,6 +1112,13 @@ double Vector::operator*(const Vector &v) const
 #endif // MFEM_USE_OPENMP_DETERMINISTIC_DOT
    }
 #endif // MFEM_USE_OPENMP
+   if (Device::Allows(Backend::THREADS))
+   {
+      // The ThreadPool reduction is deterministic
+      auto dot = [=](const int i, double &d) { d += m_data[i] * v_data[i]; };
+      auto sum = [](const double a, const double b) { return a + b; };
+      return ThreadPool::Reduce(size, 0.0, dot, sum);
+   }
    if (Device::Allows(Backend::DEBUG_DEVICE))
    {
       const int N = size;
@@ -1174,6 +1179,13 @@ double Vector::Min() const
    }
 #endif
 
+   if (Device::Allows(Backend::THREADS))
+   {
+      auto min = [=](const int i, double &m) { m = std::min(m, m_data[i]); };
+      auto op = [](const double a, const double b) { return std::min(a, b); };
+      return ThreadPool::Reduce(size, infinity(), min, op);
+   }
+
    if (Device::Allows(Backend::DEBUG_DEVICE))
    {
       const int N = size;
@@ -6692,6 +6692,33 @@ void Mesh::AverageVertices(const int *indexes, int n, int result)
    }
 }
 
+void Mesh::AverageEdgeVertices(int oedge, const Array<int> &e2v)
+{
+   // Record the two vertices of each edge (serial, integer writes only), then
+   // average them independently for each edge.
+   Array<int> edge_vert(2*NumOfEdges);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      const Element *el = elements[i];
+      const int *v = el->GetVertices();
+      const int *e = el_to_edge->GetRow(i);
+      for (int ei = 0; ei < el->GetNEdges(); ei++)
+      {
+         const int *ev = el->GetEdgeVertices(ei);
+         edge_vert[2*e[ei]+0] = v[ev[0]];
+         edge_vert[2*e[ei]+1] = v[ev[1]];
+      }
+   }
+
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfEdges; i++)
+   {
+      AverageVertices(&edge_vert[2*i], 2, oedge + (e2v.Size() ? e2v[i] : i));
+   }
+}
+
 void Mesh::UpdateNodes()
 {
    if (Nodes)
@@ -6711,14 +6738,16 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
       NumOfEdges = GetElementToEdgeTable(*el_to_edge, be_to_edge);
    }
 
-   int quad_counter = 0;
+   // Prefix sum over the elements giving the index of the new vertex at the
+   // center of each quad, so that the elements can be refined independently.
+   Array<int> quad_offset(NumOfElements+1);
+   quad_offset[0] = 0;
    for (int i = 0; i < NumOfElements; i++)
    {
-      if (elements[i]->GetType() == Element::QUADRILATERAL)
-      {
-         quad_counter++;
-      }
+      const bool quad = (elements[i]->GetType() == Element::QUADRILATERAL);
+      quad_offset[i+1] = quad_offset[i] + (quad ? 1 : 0);
    }
+   const int quad_counter = quad_offset[NumOfElements];
 
    const int oedge = NumOfVertices;
    const int oelem = oedge + NumOfEdges;
@@ -6728,27 +6757,22 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
 
    vertices.SetSize(oelem + quad_counter);
    new_elements.SetSize(4 * NumOfElements);
-   quad_counter = 0;
 
-   for (int i = 0, j = 0; i < NumOfElements; i++)
+   AverageEdgeVertices(oedge, Array<int>());
+
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfElements; i++)
    {
       const Element::Type el_type = elements[i]->GetType();
       const int attr = elements[i]->GetAttribute();
       int *v = elements[i]->GetVertices();
       const int *e = el_to_edge->GetRow(i);
-      int vv[2];
+      int j = 4*i;
 
       if (el_type == Element::TRIANGLE)
       {
-         for (int ei = 0; ei < 3; ei++)
-         {
-            for (int k = 0; k < 2; k++)
-            {
-               vv[k] = v[tri_t::Edges[ei][k]];
-            }
-            AverageVertices(vv, 2, oedge+e[ei]);
-         }
-
          new_elements[j++] =
             new Triangle(v[0], oedge+e[0], oedge+e[2], attr);
          new_elements[j++] =
@@ -6760,19 +6784,9 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
       }
       else if (el_type == Element::QUADRILATERAL)
       {
-         const int qe = quad_counter;
-         quad_counter++;
+         const int qe = quad_offset[i];
          AverageVertices(v, 4, oelem+qe);
 
-         for (int ei = 0; ei < 4; ei++)
-         {
-            for (int k = 0; k < 2; k++)
-            {
-               vv[k] = v[quad_t::Edges[ei][k]];
-            }
-            AverageVertices(vv, 2, oedge+e[ei]);
-         }
-
          new_elements[j++] =
             new Quadrilateral(v[0], oedge+e[0], oelem+qe, oedge+e[3], attr);
          new_elements[j++] =
@@ -6901,17 +6915,16 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
       }
    }
 
-   int hex_counter = 0;
-   if (HasGeometry(Geometry::CUBE))
+   // Prefix sum over the elements giving the index of the new vertex at the
+   // center of each hex, so that the elements can be refined independently.
+   Array<int> hex_offset(NumOfElements+1);
+   hex_offset[0] = 0;
+   for (int i = 0; i < NumOfElements; i++)
    {
-      for (int i = 0; i < elements.Size(); i++)
-      {
-         if (elements[i]->GetType() == Element::HEXAHEDRON)
-         {
-            hex_counter++;
-         }
-      }
+      const bool hex = (elements[i]->GetType() == Element::HEXAHEDRON);
+      hex_offset[i+1] = hex_offset[i] + (hex ? 1 : 0);
    }
+   const int hex_counter = hex_offset[NumOfElements];
 
    // Map from edge-index to vertex-index, needed for ReorientTetMesh() for
    // parallel meshes.
@@ -6973,14 +6986,32 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
    new_elements.SetSize(8 * NumOfElements);
    CoarseFineTr.embeddings.SetSize(new_elements.Size());
 
-   hex_counter = 0;
-   for (int i = 0, j = 0; i < NumOfElements; i++)
+   // The new vertices at the edge midpoints and at the centers of the quad
+   // faces are computed once per entity, independently of the elements.
+   AverageEdgeVertices(oedge, e2v);
+
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < faces.Size(); i++)
+   {
+      if (faces[i]->GetType() != Element::QUADRILATERAL) { continue; }
+      const int qf = f2qf.Size() ? f2qf[i] : i;
+      AverageVertices(faces[i]->GetVertices(), 4, oface + qf);
+   }
+
+   // Elements are refined in parallel, except when they are allocated from
+   // the (non thread-safe) TetMemory pool.
+#if defined(MFEM_USE_LEGACY_OPENMP) && !defined(MFEM_USE_MEMALLOC)
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfElements; i++)
    {
       const Element::Type el_type = elements[i]->GetType();
       const int attr = elements[i]->GetAttribute();
       int *v = elements[i]->GetVertices();
       const int *e = el_to_edge->GetRow(i);
-      int vv[4], ev[12];
+      int j = 8*i, ev[12];
 
       if (e2v.Size())
       {
@@ -6993,15 +7024,6 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
       {
          case Element::TETRAHEDRON:
          {
-            for (int ei = 0; ei < 6; ei++)
-            {
-               for (int k = 0; k < 2; k++)
-               {
-                  vv[k] = v[tet_t::Edges[ei][k]];
-               }
-               AverageVertices(vv, 2, oedge+e[ei]);
-            }
-
             // Algorithm for choosing refinement type:
             // 0: smallest octahedron diagonal
             // 1: best aspect ratio
@@ -7010,9 +7032,10 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
             // 0: (v0,v1)-(v2,v3), 1: (v0,v2)-(v1,v3), 2: (v0,v3)-(v1,v2)
             // 0:      e0-e5,      1:      e1-e4,      2:      e2-e3
             int rt;
-            ElementTransformation *T = GetElementTransformation(i);
-            T->SetIntPoint(&Geometries.GetCenter(Geometry::TETRAHEDRON));
-            const DenseMatrix &J = T->Jacobian();
+            IsoparametricTransformation T;
+            GetElementTransformation(i, &T);
+            T.SetIntPoint(&Geometries.GetCenter(Geometry::TETRAHEDRON));
+            const DenseMatrix &J = T.Jacobian();
             if (rt_algo == 0)
             {
                // smallest octahedron diagonal
@@ -7171,8 +7194,6 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
                CoarseFineTr.embeddings[j+4+k].parent = i;
                CoarseFineTr.embeddings[j+4+k].matrix = 4*(rt+1)+k;
             }
-
-            j += 8;
          }
          break;
 
@@ -7180,24 +7201,6 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
          {
             const int *f = el_to_face->GetRow(i);
 
-            for (int fi = 2; fi < 5; fi++)
-            {
-               for (int k = 0; k < 4; k++)
-               {
-                  vv[k] = v[pri_t::FaceVert[fi][k]];
-               }
-               AverageVertices(vv, 4, oface + f2qf[f[fi]]);
-            }
-
-            for (int ei = 0; ei < 9; ei++)
-            {
-               for (int k = 0; k < 2; k++)
-               {
-                  vv[k] = v[pri_t::Edges[ei][k]];
-               }
-               AverageVertices(vv, 2, oedge+e[ei]);
-            }
-
             const int qf2 = f2qf[f[2]];
             const int qf3 = f2qf[f[3]];
             const int qf4 = f2qf[f[4]];
@@ -7239,8 +7242,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
          case Element::HEXAHEDRON:
          {
             const int *f = el_to_face->GetRow(i);
-            const int he = hex_counter;
-            hex_counter++;
+            const int he = hex_offset[i];
 
             const int *qf;
             int qf_data[6];
@@ -7256,24 +7258,6 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
 
             AverageVertices(v, 8, oelem+he);
 
-            for (int fi = 0; fi < 6; fi++)
-            {
-               for (int k = 0; k < 4; k++)
-               {
-                  vv[k] = v[hex_t::FaceVert[fi][k]];
-               }
-               AverageVertices(vv, 4, oface + qf[fi]);
-            }
-
-            for (int ei = 0; ei < 12; ei++)
-            {
-               for (int k = 0; k < 2; k++)
-               {
-                  vv[k] = v[hex_t::Edges[ei][k]];
-               }
-               AverageVertices(vv, 2, oedge+e[ei]);
-            }
-
             new_elements[j++] =
                new Hexahedron(v[0], oedge+e[0], oface+qf[0],
                               oedge+e[3], oedge+e[8], oface+qf[1],
@@ -10596,100 +10580,11 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
    elem_ids = -1;
    if (!GetNE()) { return 0; }
 
-   double *data = point_mat.GetData();
-   InverseElementTransformation *inv_tr = inv_trans;
-   inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
-
-   // For each point in 'point_mat', find the element whose center is closest.
-   Vector min_dist(npts);
-   Array<int> e_idx(npts);
-   min_dist = std::numeric_limits<double>::max();
-   e_idx = -1;
-
-   Vector pt(spaceDim);
-   for (int i = 0; i < GetNE(); i++)
-   {
-      GetElementTransformation(i)->Transform(
-         Geometries.GetCenter(GetElementBaseGeometry(i)), pt);
-      for (int k = 0; k < npts; k++)
-      {
-         double dist = pt.DistanceTo(data+k*spaceDim);
-         if (dist < min_dist(k))
-         {
-            min_dist(k) = dist;
-            e_idx[k] = i;
-         }
-      }
-   }
-
-   // Checks if the points lie in the closest element
-   int pts_found = 0;
-   pt.NewDataAndSize(NULL, spaceDim);
-   for (int k = 0; k < npts; k++)
-   {
-      pt.SetData(data+k*spaceDim);
-      inv_tr->SetTransformation(*GetElementTransformation(e_idx[k]));
-      int res = inv_tr->Transform(pt, ips[k]);
-      if (res == InverseElementTransformation::Inside)
-      {
-         elem_ids[k] = e_idx[k];
-         pts_found++;
-      }
-   }
-   if (pts_found != npts)
-   {
-      Array<int> vertices;
-      Table *vtoel = GetVertexToElementTable();
-      for (int k = 0; k < npts; k++)
-      {
-         if (elem_ids[k] != -1) { continue; }
-         // Try all vertex-neighbors of element e_idx[k]
-         pt.SetData(data+k*spaceDim);
-         GetElementVertices(e_idx[k], vertices);
-         for (int v = 0; v < vertices.Size(); v++)
-         {
-            int vv = vertices[v];
-            int ne = vtoel->RowSize(vv);
-            const int* els = vtoel->GetRow(vv);
-            for (int e = 0; e < ne; e++)
-            {
-               if (els[e] == e_idx[k]) { continue; }
-               inv_tr->SetTransformation(*GetElementTransformation(els[e]));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = els[e];
-                  pts_found++;
-                  goto next_point;
-               }
-            }
-         }
-         // Try neighbors for non-conforming meshes
-         if (ncmesh)
-         {
-            Array<int> neigh;
-            int le = ncmesh->leaf_elements[e_idx[k]];
-            ncmesh->FindNeighbors(le,neigh);
-            for (int e = 0; e < neigh.Size(); e++)
-            {
-               int nn = neigh[e];
-               if (ncmesh->IsGhost(ncmesh->elements[nn])) { continue; }
-               int el = ncmesh->elements[nn].index;
-               inv_tr->SetTransformation(*GetElementTransformation(el));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = el;
-                  pts_found++;
-                  goto next_point;
-               }
-            }
-         }
-      next_point: ;
-      }
-      delete vtoel;
-   }
-   if (inv_trans == NULL) { delete inv_tr; }
+   // Bin the element bounding boxes and test only the elements whose boxes
+   // contain each point.
+   MeshPointLocator locator(*this);
+   int pts_found = locator.FindPoints(point_mat, elem_ids, ips, false,
+                                      inv_trans);
 
    if (warn && pts_found != npts)
    {
@@ -10719,20 +10614,23 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    const Operator *elem_restr = fespace->GetElementRestriction(
                                    ElementDofOrdering::NATIVE);
 
+   // Allocate the factors like the PA data that use them, e.g. with the NUMA
+   // placement of MemoryType::HOST_NUMA on the host backends
+   const MemoryType d_mt = Device::GetDeviceMemoryType();
    unsigned eval_flags = 0;
    if (flags & GeometricFactors::COORDINATES)
    {
-      X.SetSize(vdim*NQ*NE);
+      X.SetSize(vdim*NQ*NE, d_mt);
       eval_flags |= QuadratureInterpolator::VALUES;
    }
    if (flags & GeometricFactors::JACOBIANS)
    {
-      J.SetSize(dim*vdim*NQ*NE);
+      J.SetSize(dim*vdim*NQ*NE, d_mt);
       eval_flags |= QuadratureInterpolator::DERIVATIVES;
    }
    if (flags & GeometricFactors::DETERMINANTS)
    {
-      detJ.SetSize(NQ*NE);
+      detJ.SetSize(NQ*NE, d_mt);
       eval_flags |= QuadratureInterpolator::DETERMINANTS;
    }
 
@@ -10742,7 +10640,7 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    qi->SetOutputLayout(QVectorLayout::byNODES);
    if (elem_restr)
    {
-      Vector Enodes(vdim*ND*NE);
+      Vector Enodes(vdim*ND*NE, d_mt);
       elem_restr->Mult(*nodes, Enodes);
       qi->Mult(Enodes, eval_flags, X, J, detJ);
    }
@@ -304,6 +304,12 @@ protected:
        in #vertices[result]. */
    void AverageVertices(const int *indexes, int n, int result);
 
+   /** @brief Set the new vertices at the midpoints of all edges: the midpoint
+       of edge i is saved in #vertices[oedge + e2v[i]], or in
+       #vertices[oedge + i] if @a e2v is empty. Used by the uniform refinement
+       where the edge midpoints are computed in parallel. */
+   void AverageEdgeVertices(int oedge, const Array<int> &e2v);
+
    void InitRefinementTransforms();
    int FindCoarseElement(int i);
 
@@ -832,7 +838,8 @@ public:
 
    Geometry::Type GetFaceBaseGeometry(int i) const
    {
-      return faces[i]->GetGeometryType();
+      // In 1D, the faces are points and are not stored explicitly
+      return (Dim == 1) ? Geometry::POINT : faces[i]->GetGeometryType();
    }
 
    Geometry::Type GetElementBaseGeometry(int i) const
@@ -1370,6 +1377,10 @@ public:
        non-negative number; the other ranks will set their elem_ids[i] to -2 to
        indicate that the point was found but assigned to another rank.
 
+       The candidate elements for each point are selected with a temporary
+       MeshPointLocator; to amortize its construction over multiple calls, or
+       to reuse the results of a previous call, use MeshPointLocator directly.
+
        @returns The total number of points that were found.
 
        @note This method is not 100 percent reliable, i.e. it is not guaranteed
@@ -640,17 +640,17 @@ void NCMesh::ForceRefinement(int vn1, int vn2, int vn3, int vn4)
       if ((CubeFaceLeft(vn1, nodes) && CubeFaceRight(vn2, nodes)) ||
           (CubeFaceLeft(vn2, nodes) && CubeFaceRight(vn1, nodes)))
       {
-         ref_stack.Append(Refinement(elem, 1)); // X split
+         PushForcedRefinement(elem, 1); // X split
       }
       else if ((CubeFaceFront(vn1, nodes) && CubeFaceBack(vn2, nodes)) ||
                (CubeFaceFront(vn2, nodes) && CubeFaceBack(vn1, nodes)))
       {
-         ref_stack.Append(Refinement(elem, 2)); // Y split
+         PushForcedRefinement(elem, 2); // Y split
       }
       else if ((CubeFaceBottom(vn1, nodes) && CubeFaceTop(vn2, nodes)) ||
                (CubeFaceBottom(vn2, nodes) && CubeFaceTop(vn1, nodes)))
       {
-         ref_stack.Append(Refinement(elem, 4)); // Z split
+         PushForcedRefinement(elem, 4); // Z split
       }
       else
       {
@@ -662,12 +662,12 @@ void NCMesh::ForceRefinement(int vn1, int vn2, int vn3, int vn4)
       if ((PrismFaceTop(vn1, nodes) && PrismFaceBottom(vn4, nodes)) ||
           (PrismFaceTop(vn4, nodes) && PrismFaceBottom(vn1, nodes)))
       {
-         ref_stack.Append(Refinement(elem, 3)); // XY split
+         PushForcedRefinement(elem, 3); // XY split
       }
       else if ((PrismFaceTop(vn1, nodes) && PrismFaceBottom(vn2, nodes)) ||
                (PrismFaceTop(vn2, nodes) && PrismFaceBottom(vn1, nodes)))
       {
-         ref_stack.Append(Refinement(elem, 4)); // Z split
+         PushForcedRefinement(elem, 4); // Z split
       }
       else
       {
@@ -747,7 +747,7 @@ void NCMesh::CheckAnisoPrism(int vn1, int vn2, int vn3, int vn4,
       {
          // schedule prism refinement along Z axis
          MFEM_ASSERT(elements[elem].Geom() == Geometry::PRISM, "");
-         ref_stack.Append(Refinement(elem, 4));
+         PushForcedRefinement(elem, 4);
       }
    }
 }
@@ -1500,11 +1500,37 @@ void NCMesh::RefineElement(int elem, char ref_type)
 
 void NCMesh::Refine(const Array<Refinement>& refinements)
 {
+   // Process the batch level by level: sort the refinements so that the
+   // coarsest elements are refined first.
+   Array<Pair<int, int> > order(refinements.Size());
+   for (int i = 0; i < refinements.Size(); i++)
+   {
+      order[i] = Pair<int, int>(GetElementDepth(refinements[i].index), i);
+   }
+   order.Sort([](const Pair<int, int> &a, const Pair<int, int> &b)
+   { return (a.one != b.one) ? (a.one < b.one) : (a.two < b.two); });
+
+   // remember the refinements of the batch, forced refinements of the same
+   // elements will be merged with them, see PushForcedRefinement()
+   ref_pending.SetSize(elements.Size());
+   ref_pending = 0;
+   for (int i = 0; i < refinements.Size(); i++)
+   {
+      const Refinement& ref = refinements[i];
+      ref_pending[leaf_elements[ref.index]] |= ref.ref_type;
+   }
+
+   // reserve the hash tables for the new nodes and faces to avoid repeated
+   // rehashing during large batches
+   const int nref = refinements.Size();
+   nodes.Reserve(nodes.Size() + (Dim < 3 ? 3 : 7)*nref);
+   if (Dim == 3) { faces.Reserve(faces.Size() + 24*nref); }
+
    // push all refinements on the stack in reverse order
    ref_stack.Reserve(refinements.Size());
    for (int i = refinements.Size()-1; i >= 0; i--)
    {
-      const Refinement& ref = refinements[i];
+      const Refinement& ref = refinements[order[i].two];
       ref_stack.Append(Refinement(leaf_elements[ref.index], ref.ref_type));
    }
 
@@ -1514,28 +1540,20 @@ void NCMesh::Refine(const Array<Refinement>& refinements)
    {
       Refinement ref = ref_stack.Last();
       ref_stack.DeleteLast();
+      if (ref.index < ref_pending.Size()) { ref_pending[ref.index] = 0; }
 
       int size = ref_stack.Size();
       RefineElement(ref.index, ref.ref_type);
       nforced += ref_stack.Size() - size;
    }
 
-   /* TODO: the current algorithm of forced refinements is not optimal. As
-      forced refinements spread through the mesh, some may not be necessary
-      in the end, since the affected elements may still be scheduled for
-      refinement that could stop the propagation. We should introduce the
-      member Element::ref_pending that would show the intended refinement in
-      the batch. A forced refinement would be combined with ref_pending to
-      (possibly) stop the propagation earlier.
-
-      Update: what about a FIFO instead of ref_stack? */
-
 #if defined(MFEM_DEBUG) && !defined(MFEM_USE_MPI)
    mfem::out << "Refined " << refinements.Size() << " + " << nforced
              << " elements" << std::endl;
 #endif
 
    ref_stack.DeleteAll();
+   ref_pending.DeleteAll();
    shadow.DeleteAll();
 
    Update();
@@ -5198,7 +5216,7 @@ long NCMesh::NCList::MemoryUsage() const
    int pm_size = 0;
    for (int i = 0; i < Geometry::NumGeom; i++)
    {
-      for (int j = 0; j < point_matrices[i].Size(); i++)
+      for (int j = 0; j < point_matrices[i].Size(); j++)
       {
          pm_size += point_matrices[i][j]->MemoryUsage();
       }
@@ -5243,27 +5261,45 @@ long NCMesh::MemoryUsage() const
           sizeof(*this);
 }
 
+double NCMesh::MemoryUsagePerElement() const
+{
+   return leaf_elements.Size() ? double(MemoryUsage())/leaf_elements.Size()
+          : 0.0;
+}
+
 int NCMesh::PrintMemoryDetail() const
 {
-   nodes.PrintMemoryDetail(); mfem::out << " nodes\n";
-   faces.PrintMemoryDetail(); mfem::out << " faces\n";
-
-   mfem::out << elements.MemoryUsage() << " elements\n"
-             << free_element_ids.MemoryUsage() << " free_element_ids\n"
-             << root_state.MemoryUsage() << " root_state\n"
-             << top_vertex_pos.MemoryUsage() << " top_vertex_pos\n"
-             << leaf_elements.MemoryUsage() << " leaf_elements\n"
-             << vertex_nodeId.MemoryUsage() << " vertex_nodeId\n"
-             << face_list.MemoryUsage() << " face_list\n"
-             << edge_list.MemoryUsage() << " edge_list\n"
-             << vertex_list.MemoryUsage() << " vertex_list\n"
-             << boundary_faces.MemoryUsage() << " boundary_faces\n"
-             << element_vertex.MemoryUsage() << " element_vertex\n"
-             << ref_stack.MemoryUsage() << " ref_stack\n"
-             << derefinements.MemoryUsage() << " derefinements\n"
-             << transforms.MemoryUsage() << " transforms\n"
-             << coarse_elements.MemoryUsage() << " coarse_elements\n"
-             << sizeof(*this) << " NCMesh"
+   const double nleaf = std::max(leaf_elements.Size(), 1);
+   const auto print = [nleaf](long bytes, const char *name)
+   {
+      mfem::out << bytes << " (" << bytes/nleaf << " B/elem) " << name << '\n';
+   };
+
+   nodes.PrintMemoryDetail();
+   mfem::out << " (" << nodes.MemoryUsage()/nleaf << " B/elem) nodes ["
+             << nodes.Size() << " x " << sizeof(Node) << " B]\n";
+   faces.PrintMemoryDetail();
+   mfem::out << " (" << faces.MemoryUsage()/nleaf << " B/elem) faces ["
+             << faces.Size() << " x " << sizeof(Face) << " B]\n";
+
+   print(elements.MemoryUsage(), "elements");
+   print(free_element_ids.MemoryUsage(), "free_element_ids");
+   print(root_state.MemoryUsage(), "root_state");
+   print(top_vertex_pos.MemoryUsage(), "top_vertex_pos");
+   print(leaf_elements.MemoryUsage(), "leaf_elements");
+   print(vertex_nodeId.MemoryUsage(), "vertex_nodeId");
+   print(face_list.MemoryUsage(), "face_list");
+   print(edge_list.MemoryUsage(), "edge_list");
+   print(vertex_list.MemoryUsage(), "vertex_list");
+   print(boundary_faces.MemoryUsage(), "boundary_faces");
+   print(element_vertex.MemoryUsage(), "element_vertex");
+   print(ref_stack.MemoryUsage(), "ref_stack");
+   print(derefinements.MemoryUsage(), "derefinements");
+   print(transforms.MemoryUsage(), "transforms");
+   print(coarse_elements.MemoryUsage(), "coarse_elements");
+   mfem::out << sizeof(*this) << " NCMesh\n"
+             << MemoryUsage() << " (" << MemoryUsagePerElement()
+             << " B/elem) total, " << leaf_elements.Size() << " leaf elements"
              << std::endl;
 
    return elements.Size() - free_element_ids.Size();
@@ -5319,6 +5355,8 @@ void NCMesh::PrintStats(std::ostream &out) const
        << edge_list.slaves.Size() << "\n"
        "   total memory              : " << std::setw(17)
        << "[ " << std::setw(9) << MemoryUsage()/MiB << " MiB ]\n"
+       "   memory per leaf element   : " << std::setw(17)
+       << "[ " << std::setw(9) << MemoryUsagePerElement() << " B   ]\n"
        ;
 }
 
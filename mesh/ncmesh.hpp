@@ -364,6 +364,12 @@ public:
    /// Return total number of bytes allocated.
    long MemoryUsage() const;
 
+   /** @brief Return the average number of bytes allocated per leaf element,
+       i.e., MemoryUsage() divided by the number of leaf elements. */
+   double MemoryUsagePerElement() const;
+
+   /** Print the memory usage of the individual data structures, both in total
+       and per leaf element. Return the number of elements in use. */
    int PrintMemoryDetail() const;
 
    void PrintStats(std::ostream &out = mfem::out) const;
@@ -534,6 +540,7 @@ protected: // implementation
    // refinement/derefinement
 
    Array<Refinement> ref_stack; ///< stack of scheduled refinements (temporary)
+   Array<char> ref_pending; ///< refinements pending in the batch (temporary)
    HashTable<Node> shadow; ///< temporary storage for reparented nodes
    Array<Triple<int, int, int> > reparents; ///< scheduled node reparents (tmp)
 
@@ -542,6 +549,19 @@ protected: // implementation
    void RefineElement(int elem, char ref_type);
    void DerefineElement(int elem);
 
+   /** Push a forced refinement of @a elem on the #ref_stack. If @a elem is
+       still scheduled for refinement in the current batch, the two refinements
+       are merged, so that the element is only split once. */
+   void PushForcedRefinement(int elem, char ref_type)
+   {
+      if (elem < ref_pending.Size() && ref_pending[elem])
+      {
+         ref_type |= ref_pending[elem];
+         ref_pending[elem] = 0;
+      }
+      ref_stack.Append(Refinement(elem, ref_type));
+   }
+
    int AddElement(const Element &el)
    {
       if (free_element_ids.Size())
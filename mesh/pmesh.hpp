@@ -216,6 +216,27 @@ public:
    /** The @a refine parameter is passed to the method Mesh::Finalize(). */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
 
+   /** @brief Read a serial mesh file in parallel, without constructing the
+       global serial Mesh on any MPI rank.
+
+       Every rank parses the file, keeping only its contiguous slab of the
+       elements, boundary elements and vertices. The elements are partitioned
+       by sorting the Morton (Z-order) keys of their centers in parallel, and
+       migrated to their owners. The shared vertices, edges and faces, and the
+       owners of the boundary elements, are determined by sending the entities
+       to "home" ranks (based on their smallest vertex id) which match the
+       copies coming from different ranks, so the memory usage on each rank is
+       proportional to the size of its part of the mesh.
+
+       Only conforming, linear meshes in MFEM format v1.0 or v1.2 (without
+       "nodes") are supported; each element, boundary element and vertex must
+       be on its own line, as written by Mesh::Print().
+
+       The @a refine parameter is passed to the method Mesh::Finalize(). The
+       returned ParMesh must be deleted by the caller. */
+   static ParMesh *LoadDistributed(MPI_Comm comm, const char *filename,
+                                   bool refine = true);
+
    /// Create a uniformly refined (by any factor) version of @a orig_mesh.
    /** @param[in] orig_mesh  The starting coarse mesh.
        @param[in] ref_factor The refinement factor, an integer > 1.
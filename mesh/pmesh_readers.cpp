@@ -0,0 +1,786 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of ParMesh::LoadDistributed
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "mesh_headers.hpp"
+#include "../general/sets.hpp"
+#include "../general/text.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+namespace mfem
+{
+
+// Record sizes (in ints) of the elements and boundary elements read from the
+// file: attribute, geometry and up to 8 (resp. 4) vertices.
+static const int elem_rec = 10;
+static const int bdr_rec = 6;
+
+// Entity records exchanged with the home ranks: kind (element entity or
+// boundary element), number of vertices, the sorted vertices, two data fields
+// (element number, or attribute and geometry) and the vertices in their
+// original order. Unused vertex slots are set to -1.
+static const int ent_rec = 12;
+enum { ENT_KIND = 0, ENT_NV = 1, ENT_SORTED = 2, ENT_A = 6, ENT_B = 7,
+       ENT_VERTS = 8
+     };
+enum { ENT_ELEMENT = 0, ENT_BOUNDARY = 1 };
+
+// The items [BlockOffset(n,p,r), BlockOffset(n,p,r+1)) out of 'n' are stored
+// on rank 'r' out of 'p'.
+static inline int BlockOffset(int n, int p, int r)
+{
+   return (int) (((long long) n * r) / p);
+}
+
+static inline int BlockOwner(int n, int p, int i)
+{
+   int r = (int) (((long long) i * p) / n);
+   while (r > 0 && BlockOffset(n, p, r) > i) { r--; }
+   while (r < p-1 && BlockOffset(n, p, r+1) <= i) { r++; }
+   return r;
+}
+
+/* Send the array send[r] to every rank r. On return, 'recv' contains the data
+   received from all ranks, ordered by source rank: the data from rank r is in
+   the range [recv_off[r], recv_off[r+1]). */
+template <typename T>
+static void ExchangeArrays(MPI_Comm comm, MPI_Datatype type,
+                           const vector<Array<T> > &send,
+                           Array<T> &recv, Array<int> &recv_off)
+{
+   const int nranks = (int) send.size();
+   Array<int> send_cnt(nranks), send_off(nranks+1), recv_cnt(nranks);
+   send_off[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      send_cnt[r] = send[r].Size();
+      send_off[r+1] = send_off[r] + send_cnt[r];
+   }
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT,
+                recv_cnt.GetData(), 1, MPI_INT, comm);
+   recv_off.SetSize(nranks+1);
+   recv_off[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      recv_off[r+1] = recv_off[r] + recv_cnt[r];
+   }
+
+   Array<T> send_buf(send_off[nranks]);
+   for (int r = 0; r < nranks; r++)
+   {
+      std::copy(send[r].begin(), send[r].end(),
+                send_buf.GetData() + send_off[r]);
+   }
+   recv.SetSize(recv_off[nranks]);
+   MPI_Alltoallv(send_buf.GetData(), send_cnt.GetData(), send_off.GetData(),
+                 type, recv.GetData(), recv_cnt.GetData(), recv_off.GetData(),
+                 type, comm);
+}
+
+// The part of a serial mesh file stored on one rank before the partitioning.
+struct MeshSlab
+{
+   int dim, sdim;
+   int ne, nbe, nv; // global numbers of elements, boundary elements, vertices
+   int elem_begin, vert_begin; // first global element and vertex in the slab
+   Array<int> elems;     // elem_rec ints per element
+   Array<int> bdr;       // bdr_rec ints per boundary element
+   Array<double> coords; // sdim doubles per vertex
+};
+
+// Read the lines [begin,end) out of 'n' lines of the form "attr geom v0 v1 ..."
+// skipping the rest; 'dim' is the expected dimension of the geometries.
+static void ReadSlabEntities(istream &input, int n, int begin, int end,
+                             int dim, int rec, Array<int> &recs)
+{
+   recs.SetSize(rec*(end - begin));
+   recs = -1;
+   input.ignore(numeric_limits<streamsize>::max(), '\n');
+   for (int i = 0; i < n; i++)
+   {
+      if (i >= begin && i < end)
+      {
+         int *r = recs.GetData() + rec*(i - begin);
+         input >> r[0] >> r[1];
+         MFEM_VERIFY(input && r[1] >= 0 && r[1] < Geometry::NumGeom &&
+                     Geometry::Dimension[r[1]] == dim &&
+                     Geometry::NumVerts[r[1]] <= rec-2,
+                     "invalid mesh file entry " << i);
+         for (int j = 0; j < Geometry::NumVerts[r[1]]; j++)
+         {
+            input >> r[2+j];
+         }
+      }
+      input.ignore(numeric_limits<streamsize>::max(), '\n');
+   }
+}
+
+static void ReadMeshSlab(MPI_Comm comm, const char *filename, MeshSlab &slab)
+{
+   int myid, nranks;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &nranks);
+
+   named_ifgzstream input(filename);
+   MFEM_VERIFY(input, "Mesh file not found: " << filename);
+
+   string ident;
+   getline(input, ident);
+   filter_dos(ident);
+   MFEM_VERIFY(ident == "MFEM mesh v1.0" || ident == "MFEM mesh v1.2",
+               "unsupported mesh format '" << ident << "' in " << filename
+               << ": only conforming MFEM mesh v1.0 and v1.2 are supported");
+
+   skip_comment_lines(input, '#');
+   input >> ident;
+   MFEM_VERIFY(ident == "dimension", "invalid mesh file");
+   input >> slab.dim;
+
+   skip_comment_lines(input, '#');
+   input >> ident;
+   MFEM_VERIFY(ident == "elements", "invalid mesh file");
+   input >> slab.ne;
+   MFEM_VERIFY(slab.ne > 0, "the mesh has no elements");
+   slab.elem_begin = BlockOffset(slab.ne, nranks, myid);
+   ReadSlabEntities(input, slab.ne, slab.elem_begin,
+                    BlockOffset(slab.ne, nranks, myid+1), slab.dim,
+                    elem_rec, slab.elems);
+
+   skip_comment_lines(input, '#');
+   input >> ident;
+   MFEM_VERIFY(ident == "boundary", "invalid mesh file");
+   input >> slab.nbe;
+   ReadSlabEntities(input, slab.nbe, BlockOffset(slab.nbe, nranks, myid),
+                    BlockOffset(slab.nbe, nranks, myid+1), slab.dim-1,
+                    bdr_rec, slab.bdr);
+
+   skip_comment_lines(input, '#');
+   input >> ident;
+   MFEM_VERIFY(ident == "vertices", "invalid mesh file");
+   input >> slab.nv;
+   input >> ws >> ident;
+   MFEM_VERIFY(ident != "nodes",
+               "meshes with nodes (curved meshes) are not supported");
+   slab.sdim = atoi(ident.c_str());
+   MFEM_VERIFY(slab.sdim >= slab.dim && slab.sdim <= 3,
+               "invalid space dimension: " << slab.sdim);
+
+   slab.vert_begin = BlockOffset(slab.nv, nranks, myid);
+   const int vert_end = BlockOffset(slab.nv, nranks, myid+1);
+   slab.coords.SetSize(slab.sdim*(vert_end - slab.vert_begin));
+   input.ignore(numeric_limits<streamsize>::max(), '\n');
+   for (int i = 0; i < slab.nv; i++)
+   {
+      if (i >= slab.vert_begin && i < vert_end)
+      {
+         double *x = slab.coords.GetData() + slab.sdim*(i - slab.vert_begin);
+         for (int d = 0; d < slab.sdim; d++) { input >> x[d]; }
+         MFEM_VERIFY(input, "invalid mesh file vertex " << i);
+      }
+      input.ignore(numeric_limits<streamsize>::max(), '\n');
+   }
+}
+
+/* Get the coordinates of the vertices 'vids' (a sorted list of global vertex
+   numbers without repetitions) from the ranks storing them in their slabs. */
+static void FetchVertexCoordinates(MPI_Comm comm, const MeshSlab &slab,
+                                   const Array<int> &vids,
+                                   Array<double> &coords)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+   const int sdim = slab.sdim;
+
+   vector<Array<int> > request(nranks);
+   for (int i = 0; i < vids.Size(); i++)
+   {
+      request[BlockOwner(slab.nv, nranks, vids[i])].Append(vids[i]);
+   }
+   Array<int> recv, recv_off;
+   ExchangeArrays(comm, MPI_INT, request, recv, recv_off);
+
+   vector<Array<double> > reply(nranks);
+   for (int r = 0; r < nranks; r++)
+   {
+      reply[r].Reserve(sdim*(recv_off[r+1] - recv_off[r]));
+      for (int i = recv_off[r]; i < recv_off[r+1]; i++)
+      {
+         const int v = recv[i] - slab.vert_begin;
+         MFEM_ASSERT(v >= 0 && sdim*v < slab.coords.Size(), "invalid vertex");
+         reply[r].Append(slab.coords.GetData() + sdim*v, sdim);
+      }
+   }
+   // The owners are monotone in the vertex number, so the replies, ordered by
+   // source rank, are in the same order as 'vids'.
+   Array<int> coords_off;
+   ExchangeArrays(comm, MPI_DOUBLE, reply, coords, coords_off);
+}
+
+// Morton (Z-order) key of the point 'x' in the box [bmin,bmax].
+static long long MortonKey(const double *x, const double *bmin,
+                           const double *bmax, int sdim)
+{
+   const int bits = 60/sdim;
+   const long long qmax = (1ll << bits) - 1;
+   long long q[3] = { 0, 0, 0 };
+   for (int d = 0; d < sdim; d++)
+   {
+      const double ext = bmax[d] - bmin[d];
+      const double t = (ext > 0.0) ? (x[d] - bmin[d])/ext : 0.0;
+      q[d] = (long long) (std::max(t, 0.0)*(double) qmax);
+      q[d] = std::min(q[d], qmax);
+   }
+   long long key = 0;
+   for (int b = bits-1; b >= 0; b--)
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         key = (key << 1) | ((q[d] >> b) & 1);
+      }
+   }
+   return key;
+}
+
+/* Partition the elements of the slabs into equal contiguous pieces of the
+   Morton curve through the element centers, using a parallel sample sort of
+   the keys. On return, 'partitioning' contains the new owners of the elements
+   of the local slab. */
+static void PartitionSlab(MPI_Comm comm, const MeshSlab &slab,
+                          Array<int> &partitioning)
+{
+   int myid, nranks;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &nranks);
+   const int ne = slab.elems.Size()/elem_rec, sdim = slab.sdim;
+
+   Array<int> vids;
+   for (int e = 0; e < ne; e++)
+   {
+      const int *r = slab.elems.GetData() + elem_rec*e;
+      vids.Append(r + 2, Geometry::NumVerts[r[1]]);
+   }
+   vids.Sort();
+   vids.Unique();
+   Array<double> coords;
+   FetchVertexCoordinates(comm, slab, vids, coords);
+
+   Array<double> centers(sdim*ne);
+   centers = 0.0;
+   double bmin[3], bmax[3];
+   for (int d = 0; d < sdim; d++)
+   {
+      bmin[d] = numeric_limits<double>::infinity();
+      bmax[d] = -numeric_limits<double>::infinity();
+   }
+   for (int e = 0; e < ne; e++)
+   {
+      const int *r = slab.elems.GetData() + elem_rec*e;
+      const int nv = Geometry::NumVerts[r[1]];
+      double *c = centers.GetData() + sdim*e;
+      for (int j = 0; j < nv; j++)
+      {
+         const double *x = coords.GetData() + sdim*vids.FindSorted(r[2+j]);
+         for (int d = 0; d < sdim; d++) { c[d] += x[d]/nv; }
+      }
+      for (int d = 0; d < sdim; d++)
+      {
+         bmin[d] = std::min(bmin[d], c[d]);
+         bmax[d] = std::max(bmax[d], c[d]);
+      }
+   }
+   MPI_Allreduce(MPI_IN_PLACE, bmin, sdim, MPI_DOUBLE, MPI_MIN, comm);
+   MPI_Allreduce(MPI_IN_PLACE, bmax, sdim, MPI_DOUBLE, MPI_MAX, comm);
+
+   typedef pair<long long, long long> KeyElem;
+   vector<KeyElem> keys(ne);
+   for (int e = 0; e < ne; e++)
+   {
+      keys[e].first = MortonKey(centers.GetData() + sdim*e, bmin, bmax, sdim);
+      keys[e].second = slab.elem_begin + e;
+   }
+   std::sort(keys.begin(), keys.end());
+
+   // Choose nranks-1 splitters from regular samples of the sorted local keys.
+   Array<long long> samples;
+   for (int i = 1; ne > 0 && i < nranks; i++)
+   {
+      const KeyElem &s = keys[((long long) i*ne)/nranks];
+      samples.Append(s.first);
+      samples.Append(s.second);
+   }
+   Array<int> samp_cnt(nranks), samp_off(nranks+1);
+   int nsamp = samples.Size();
+   MPI_Allgather(&nsamp, 1, MPI_INT, samp_cnt.GetData(), 1, MPI_INT, comm);
+   samp_off[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      samp_off[r+1] = samp_off[r] + samp_cnt[r];
+   }
+   Array<long long> all_samples(samp_off[nranks]);
+   MPI_Allgatherv(samples.GetData(), nsamp, MPI_LONG_LONG,
+                  all_samples.GetData(), samp_cnt.GetData(),
+                  samp_off.GetData(), MPI_LONG_LONG, comm);
+   vector<KeyElem> splitters(all_samples.Size()/2);
+   for (size_t i = 0; i < splitters.size(); i++)
+   {
+      splitters[i] = KeyElem(all_samples[2*i], all_samples[2*i+1]);
+   }
+   std::sort(splitters.begin(), splitters.end());
+   if (!splitters.empty())
+   {
+      vector<KeyElem> s(nranks-1);
+      for (int i = 1; i < nranks; i++)
+      {
+         s[i-1] = splitters[((long long) i*splitters.size())/nranks];
+      }
+      splitters.swap(s);
+   }
+
+   vector<Array<long long> > bucket(nranks);
+   for (int e = 0; e < ne; e++)
+   {
+      const int r = (int) (std::upper_bound(splitters.begin(), splitters.end(),
+                                            keys[e]) - splitters.begin());
+      bucket[r].Append(keys[e].first);
+      bucket[r].Append(keys[e].second);
+   }
+   Array<long long> recv;
+   Array<int> recv_off;
+   ExchangeArrays(comm, MPI_LONG_LONG, bucket, recv, recv_off);
+
+   const int nloc = recv.Size()/2;
+   keys.resize(nloc);
+   for (int i = 0; i < nloc; i++)
+   {
+      keys[i] = KeyElem(recv[2*i], recv[2*i+1]);
+   }
+   std::sort(keys.begin(), keys.end());
+   long long my_nloc = nloc, first = 0;
+   MPI_Exscan(&my_nloc, &first, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   if (myid == 0) { first = 0; }
+
+   // Assign equal contiguous pieces of the global order to the ranks, and send
+   // the assignment to the owners of the slabs.
+   vector<Array<int> > assign(nranks);
+   for (int i = 0; i < nloc; i++)
+   {
+      const int elem = (int) keys[i].second;
+      Array<int> &a = assign[BlockOwner(slab.ne, nranks, elem)];
+      a.Append(elem);
+      a.Append(BlockOwner(slab.ne, nranks, (int) (first + i)));
+   }
+   Array<int> parts, parts_off;
+   ExchangeArrays(comm, MPI_INT, assign, parts, parts_off);
+
+   partitioning.SetSize(ne);
+   partitioning = -1;
+   for (int i = 0; i < parts.Size(); i += 2)
+   {
+      partitioning[parts[i] - slab.elem_begin] = parts[i+1];
+   }
+   MFEM_ASSERT(ne == 0 || partitioning.Min() >= 0, "incomplete partitioning");
+}
+
+static Element *NewReferenceElement(int geom)
+{
+   switch (geom)
+   {
+      case Geometry::SEGMENT:     return new Segment;
+      case Geometry::TRIANGLE:    return new Triangle;
+      case Geometry::SQUARE:      return new Quadrilateral;
+      case Geometry::TETRAHEDRON: return new Tetrahedron;
+      case Geometry::CUBE:        return new Hexahedron;
+      case Geometry::PRISM:       return new Wedge;
+      default: MFEM_ABORT("unsupported element geometry: " << geom);
+   }
+   return NULL;
+}
+
+static void AddEntityRecord(Array<int> &recs, int kind, int nv, const int *v,
+                            int a, int b)
+{
+   const int start = recs.Size();
+   recs.SetSize(start + ent_rec, -1);
+   int *r = recs.GetData() + start;
+   r[ENT_KIND] = kind;
+   r[ENT_NV] = nv;
+   for (int j = 0; j < nv; j++) { r[ENT_SORTED+j] = r[ENT_VERTS+j] = v[j]; }
+   std::sort(r + ENT_SORTED, r + ENT_SORTED + nv);
+   r[ENT_A] = a;
+   r[ENT_B] = b;
+}
+
+static inline bool SameEntity(const int *a, const int *b)
+{
+   return std::equal(a + ENT_NV, a + ENT_SORTED + 4, b + ENT_NV);
+}
+
+// Order the entity records by entity, then by kind and the first data field.
+struct EntityLess
+{
+   const int *recs;
+   EntityLess(const int *r) : recs(r) { }
+   bool operator()(int i, int j) const
+   {
+      const int *a = recs + ent_rec*i, *b = recs + ent_rec*j;
+      for (int k = ENT_NV; k < ENT_SORTED + 4; k++)
+      {
+         if (a[k] != b[k]) { return a[k] < b[k]; }
+      }
+      if (a[ENT_KIND] != b[ENT_KIND]) { return a[ENT_KIND] < b[ENT_KIND]; }
+      return a[ENT_A] < b[ENT_A];
+   }
+};
+
+/* Send the entity records to their home ranks, determined by their smallest
+   vertex. On the home ranks, match the copies of each entity: entities found
+   on more than one rank are returned to all of these ranks in 'shared' as
+   "nranks ranks... nv vertices...", and boundary elements are sent to the
+   rank owning the element with the smallest number containing them, in
+   'bdr', as "attribute geometry v0 v1 v2 v3". */
+static void MatchEntities(MPI_Comm comm, int nv_glob, Array<int> &local_recs,
+                          Array<int> &shared, Array<int> &bdr)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+
+   // Remove local duplicates, keeping the copy from the first element.
+   Array<int> idx(local_recs.Size()/ent_rec);
+   for (int i = 0; i < idx.Size(); i++) { idx[i] = i; }
+   std::sort(idx.begin(), idx.end(), EntityLess(local_recs.GetData()));
+   vector<Array<int> > send(nranks);
+   for (int i = 0; i < idx.Size(); i++)
+   {
+      const int *r = local_recs.GetData() + ent_rec*idx[i];
+      if (r[ENT_KIND] == ENT_ELEMENT && i > 0 &&
+          SameEntity(r, local_recs.GetData() + ent_rec*idx[i-1]))
+      {
+         continue;
+      }
+      send[BlockOwner(nv_glob, nranks, r[ENT_SORTED])].Append(r, ent_rec);
+   }
+   local_recs.DeleteAll();
+
+   Array<int> recs, recs_off;
+   ExchangeArrays(comm, MPI_INT, send, recs, recs_off);
+   for (int r = 0; r < nranks; r++) { send[r].DeleteAll(); }
+
+   const int n = recs.Size()/ent_rec;
+   Array<int> src(n);
+   for (int r = 0; r < nranks; r++)
+   {
+      for (int i = recs_off[r]/ent_rec; i < recs_off[r+1]/ent_rec; i++)
+      {
+         src[i] = r;
+      }
+   }
+   idx.SetSize(n);
+   for (int i = 0; i < n; i++) { idx[i] = i; }
+   std::sort(idx.begin(), idx.end(), EntityLess(recs.GetData()));
+
+   vector<Array<int> > send_bdr(nranks);
+   Array<int> ranks;
+   for (int i = 0, j; i < n; i = j)
+   {
+      const int *first = recs.GetData() + ent_rec*idx[i];
+      ranks.SetSize(0);
+      for (j = i; j < n; j++)
+      {
+         const int *r = recs.GetData() + ent_rec*idx[j];
+         if (!SameEntity(first, r)) { break; }
+         if (r[ENT_KIND] == ENT_ELEMENT) { ranks.Append(src[idx[j]]); }
+      }
+      MFEM_VERIFY(first[ENT_KIND] == ENT_ELEMENT,
+                  "boundary element is not a face of any element");
+      const int nv = first[ENT_NV];
+      ranks.Sort();
+      ranks.Unique();
+      if (ranks.Size() > 1)
+      {
+         for (int k = 0; k < ranks.Size(); k++)
+         {
+            Array<int> &s = send[ranks[k]];
+            s.Append(ranks.Size());
+            s.Append(ranks);
+            s.Append(nv);
+            s.Append(first + ENT_VERTS, nv);
+         }
+      }
+      // The first record is the element entity with the smallest element.
+      for (int k = i; k < j; k++)
+      {
+         const int *r = recs.GetData() + ent_rec*idx[k];
+         if (r[ENT_KIND] != ENT_BOUNDARY) { continue; }
+         Array<int> &s = send_bdr[src[idx[i]]];
+         s.Append(r[ENT_A]);
+         s.Append(r[ENT_B]);
+         s.Append(r + ENT_VERTS, 4);
+      }
+   }
+   recs.DeleteAll();
+
+   Array<int> off;
+   ExchangeArrays(comm, MPI_INT, send, shared, off);
+   ExchangeArrays(comm, MPI_INT, send_bdr, bdr, off);
+}
+
+// Order the shared entity records by group, then by entity.
+struct SharedLess
+{
+   const int *recs;
+   SharedLess(const int *r) : recs(r) { }
+   bool operator()(int i, int j) const
+   {
+      const int *a = recs + ent_rec*i, *b = recs + ent_rec*j;
+      for (int k = 0; k < ENT_SORTED + 4; k++)
+      {
+         if (a[k] != b[k]) { return a[k] < b[k]; }
+      }
+      return false;
+   }
+};
+
+ParMesh *ParMesh::LoadDistributed(MPI_Comm comm, const char *filename,
+                                  bool refine)
+{
+   int myid, nranks;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &nranks);
+
+   MeshSlab slab;
+   ReadMeshSlab(comm, filename, slab);
+   const int dim = slab.dim, sdim = slab.sdim;
+
+   Array<int> partitioning;
+   PartitionSlab(comm, slab, partitioning);
+
+   // Migrate the elements to their owners. The received elements are ordered
+   // by their global numbers.
+   Array<int> elems;
+   {
+      vector<Array<int> > send(nranks);
+      const int ne = partitioning.Size();
+      for (int e = 0; e < ne; e++)
+      {
+         Array<int> &s = send[partitioning[e]];
+         s.Append(slab.elem_begin + e);
+         s.Append(slab.elems.GetData() + elem_rec*e, elem_rec);
+      }
+      Array<int> off;
+      ExchangeArrays(comm, MPI_INT, send, elems, off);
+   }
+   slab.elems.DeleteAll();
+   const int erec = elem_rec + 1;
+   const int ne = elems.Size()/erec;
+
+   // Describe the vertices, edges and faces of the local elements, and the
+   // boundary elements of the slab, for the matching on the home ranks.
+   Array<int> ent_recs;
+   {
+      Array<Element*> ref(Geometry::NumGeom);
+      ref = NULL;
+      int v[4];
+      for (int e = 0; e < ne; e++)
+      {
+         const int *r = elems.GetData() + erec*e;
+         const int elem = r[0], geom = r[2], *ev = r + 3;
+         for (int j = 0; j < Geometry::NumVerts[geom]; j++)
+         {
+            AddEntityRecord(ent_recs, ENT_ELEMENT, 1, ev + j, elem, 0);
+         }
+         if (dim < 2) { continue; }
+         if (!ref[geom]) { ref[geom] = NewReferenceElement(geom); }
+         for (int k = 0; k < ref[geom]->GetNEdges(); k++)
+         {
+            const int *lv = ref[geom]->GetEdgeVertices(k);
+            v[0] = ev[lv[0]];
+            v[1] = ev[lv[1]];
+            AddEntityRecord(ent_recs, ENT_ELEMENT, 2, v, elem, 0);
+         }
+         if (dim < 3) { continue; }
+         for (int k = 0; k < ref[geom]->GetNFaces(); k++)
+         {
+            const int nfv = ref[geom]->GetNFaceVertices(k);
+            const int *lv = ref[geom]->GetFaceVertices(k);
+            for (int j = 0; j < nfv; j++) { v[j] = ev[lv[j]]; }
+            AddEntityRecord(ent_recs, ENT_ELEMENT, nfv, v, elem, 0);
+         }
+      }
+      for (int g = 0; g < ref.Size(); g++) { delete ref[g]; }
+
+      for (int i = 0; i < slab.bdr.Size(); i += bdr_rec)
+      {
+         const int *r = slab.bdr.GetData() + i;
+         AddEntityRecord(ent_recs, ENT_BOUNDARY, Geometry::NumVerts[r[1]],
+                         r + 2, r[0], r[1]);
+      }
+      slab.bdr.DeleteAll();
+   }
+   Array<int> shared, bdr;
+   MatchEntities(comm, slab.nv, ent_recs, shared, bdr);
+
+   // Local vertices, numbered in the order of their global numbers.
+   Array<int> vids;
+   for (int e = 0; e < ne; e++)
+   {
+      const int *r = elems.GetData() + erec*e;
+      vids.Append(r + 3, Geometry::NumVerts[r[2]]);
+   }
+   vids.Sort();
+   vids.Unique();
+   Array<double> coords;
+   FetchVertexCoordinates(comm, slab, vids, coords);
+   slab.coords.DeleteAll();
+
+   // Communication groups and shared entities, sorted by group and then by
+   // their global vertex numbers, so that all ranks in a group list them in
+   // the same order.
+   ListOfIntegerSets groups;
+   {
+      IntegerSet me(1, &myid);
+      groups.Insert(me);
+   }
+   Array<int> shared_recs;
+   for (int i = 0; i < shared.Size(); )
+   {
+      const int nr = shared[i];
+      IntegerSet group(nr, shared.GetData() + i + 1);
+      i += nr + 1;
+      const int nv = shared[i];
+      AddEntityRecord(shared_recs, groups.Insert(group), nv,
+                      shared.GetData() + i + 1, 0, 0);
+      i += nv + 1;
+   }
+   shared.DeleteAll();
+   const int nshared = shared_recs.Size()/ent_rec;
+   Array<int> sidx(nshared);
+   for (int i = 0; i < nshared; i++) { sidx[i] = i; }
+   std::sort(sidx.begin(), sidx.end(), SharedLess(shared_recs.GetData()));
+
+   // Write the local part in the format of ParMesh::ParPrint() and load it
+   // with the corresponding constructor.
+   ostringstream out;
+   out.precision(17);
+   out << "MFEM mesh v1.2\n\ndimension\n" << dim
+       << "\n\nelements\n" << ne << '\n';
+   for (int e = 0; e < ne; e++)
+   {
+      const int *r = elems.GetData() + erec*e;
+      out << r[1] << ' ' << r[2];
+      for (int j = 0; j < Geometry::NumVerts[r[2]]; j++)
+      {
+         out << ' ' << vids.FindSorted(r[3+j]);
+      }
+      out << '\n';
+   }
+   elems.DeleteAll();
+
+   out << "\nboundary\n" << bdr.Size()/bdr_rec << '\n';
+   for (int i = 0; i < bdr.Size(); i += bdr_rec)
+   {
+      out << bdr[i] << ' ' << bdr[i+1];
+      for (int j = 0; j < Geometry::NumVerts[bdr[i+1]]; j++)
+      {
+         out << ' ' << vids.FindSorted(bdr[i+2+j]);
+      }
+      out << '\n';
+   }
+   bdr.DeleteAll();
+
+   out << "\nvertices\n" << vids.Size() << '\n' << sdim << '\n';
+   for (int i = 0; i < vids.Size(); i++)
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         out << coords[sdim*i + d] << (d+1 < sdim ? ' ' : '\n');
+      }
+   }
+   coords.DeleteAll();
+   out << "\nmfem_serial_mesh_end\n";
+
+   out << "\ncommunication_groups\nnumber_of_groups " << groups.Size()
+       << "\n\n";
+   {
+      Table group_ranks;
+      groups.AsTable(group_ranks);
+      for (int g = 0; g < group_ranks.Size(); g++)
+      {
+         out << group_ranks.RowSize(g);
+         for (int k = 0; k < group_ranks.RowSize(g); k++)
+         {
+            out << ' ' << group_ranks.GetRow(g)[k];
+         }
+         out << '\n';
+      }
+   }
+
+   Array<int> count(4*groups.Size());
+   count = 0;
+   for (int i = 0; i < nshared; i++)
+   {
+      const int *r = shared_recs.GetData() + ent_rec*i;
+      count[4*r[ENT_KIND] + std::min(r[ENT_NV], 3)]++;
+   }
+   int total[4] = { 0, 0, 0, 0 };
+   for (int g = 0; g < groups.Size(); g++)
+   {
+      for (int k = 1; k < 4; k++) { total[k] += count[4*g + k]; }
+   }
+   out << "\ntotal_shared_vertices " << total[1] << '\n';
+   if (dim >= 2) { out << "total_shared_edges " << total[2] << '\n'; }
+   if (dim >= 3) { out << "total_shared_faces " << total[3] << '\n'; }
+
+   for (int i = 0, g = 1; g < groups.Size(); g++)
+   {
+      out << "\n# group " << g << '\n';
+      for (int k = 1; k <= dim; k++)
+      {
+         out << (k == 1 ? "shared_vertices " :
+                 k == 2 ? "\nshared_edges " : "\nshared_faces ")
+             << count[4*g + k] << '\n';
+         for (int c = 0; c < count[4*g + k]; c++, i++)
+         {
+            const int *r = shared_recs.GetData() + ent_rec*sidx[i];
+            MFEM_ASSERT(r[ENT_KIND] == g, "internal error");
+            if (k == 3)
+            {
+               out << (r[ENT_NV] == 3 ? Geometry::TRIANGLE : Geometry::SQUARE)
+                   << ' ';
+            }
+            for (int j = 0; j < r[ENT_NV]; j++)
+            {
+               out << vids.FindSorted(r[ENT_VERTS+j])
+                   << (j+1 < r[ENT_NV] ? ' ' : '\n');
+            }
+         }
+      }
+   }
+   out << "\nmfem_mesh_end" << endl;
+   shared_recs.DeleteAll();
+
+   istringstream input(out.str());
+   return new ParMesh(comm, input, refine);
+}
+
+} // namespace mfem
+
+#endif // MFEM_USE_MPI
@@ -0,0 +1,260 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "point_locator.hpp"
+#include "mesh.hpp"
+#include "../fem/fem.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace mfem
+{
+
+MeshPointLocator::MeshPointLocator(Mesh &mesh_, double bins_per_elem,
+                                   double curved_pad_)
+   : mesh(&mesh_), sdim(mesh_.SpaceDimension()), curved_pad(curved_pad_)
+{
+   MFEM_VERIFY(sdim >= 1 && sdim <= 3, "invalid space dimension: " << sdim);
+   Update(bins_per_elem);
+}
+
+void MeshPointLocator::ComputeElementBoxes()
+{
+   const int NE = mesh->GetNE();
+   const GridFunction *nodes = mesh->GetNodes();
+
+   el_min.SetSize(sdim, NE);
+   el_max.SetSize(sdim, NE);
+   for (int d = 0; d < 3; d++)
+   {
+      box_min[d] = std::numeric_limits<double>::infinity();
+      box_max[d] = -std::numeric_limits<double>::infinity();
+   }
+
+   Array<int> v;
+   DenseMatrix pointmat;
+   IsoparametricTransformation T;
+   for (int e = 0; e < NE; e++)
+   {
+      bool curved = false;
+      if (nodes == NULL)
+      {
+         // The straight-sided elements are contained in the convex hull of
+         // their vertices.
+         mesh->GetElementVertices(e, v);
+         pointmat.SetSize(sdim, v.Size());
+         for (int j = 0; j < v.Size(); j++)
+         {
+            const double *vx = mesh->GetVertex(v[j]);
+            for (int d = 0; d < sdim; d++) { pointmat(d,j) = vx[d]; }
+         }
+      }
+      else
+      {
+         const int order = nodes->FESpace()->GetOrder(e);
+         curved = (order > 1);
+         mesh->GetElementTransformation(e, &T);
+         RefinedGeometry *RefG =
+            GlobGeometryRefiner.Refine(mesh->GetElementBaseGeometry(e),
+                                       curved ? 2*order : 1);
+         T.Transform(RefG->RefPts, pointmat);
+      }
+
+      double h = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         double mn = pointmat(d,0), mx = pointmat(d,0);
+         for (int j = 1; j < pointmat.Width(); j++)
+         {
+            mn = std::min(mn, pointmat(d,j));
+            mx = std::max(mx, pointmat(d,j));
+         }
+         el_min(d,e) = mn;
+         el_max(d,e) = mx;
+         h = std::max(h, mx - mn);
+      }
+      // Enlarge the box to include the InverseElementTransformation tolerance
+      // and, for curved elements, the parts missed by the sampling.
+      const double pad = (curved ? curved_pad : 0.0)*h + 1e-8*h;
+      for (int d = 0; d < sdim; d++)
+      {
+         el_min(d,e) -= pad;
+         el_max(d,e) += pad;
+         box_min[d] = std::min(box_min[d], el_min(d,e));
+         box_max[d] = std::max(box_max[d], el_max(d,e));
+      }
+   }
+}
+
+void MeshPointLocator::Update(double bins_per_elem)
+{
+   const int NE = mesh->GetNE();
+   ComputeElementBoxes();
+
+   for (int d = 0; d < 3; d++) { nbins[d] = 1; inv_bin_size[d] = 0.0; }
+   if (NE == 0) { bin_elements.Clear(); return; }
+
+   // Choose the number of bins in each direction so that the bins are roughly
+   // cubical and their total number is about bins_per_elem*NE.
+   double vol = 1.0, ext[3];
+   for (int d = 0; d < sdim; d++)
+   {
+      ext[d] = box_max[d] - box_min[d];
+      if (ext[d] <= 0.0) { ext[d] = 1.0; }
+      vol *= ext[d];
+   }
+   const double h = std::pow(vol/std::max(bins_per_elem*NE, 1.0), 1.0/sdim);
+   for (int d = 0; d < sdim; d++)
+   {
+      nbins[d] = std::max(1, std::min((int) std::ceil(ext[d]/h), NE));
+      inv_bin_size[d] = nbins[d]/ext[d];
+   }
+
+   // Two-pass construction of the bin -> elements table.
+   const int nb = nbins[0]*nbins[1]*nbins[2];
+   int lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+   bin_elements.MakeI(nb);
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int e = 0; e < NE; e++)
+      {
+         for (int d = 0; d < sdim; d++)
+         {
+            lo[d] = BinCoord(d, el_min(d,e));
+            hi[d] = BinCoord(d, el_max(d,e));
+         }
+         for (int k = lo[2]; k <= hi[2]; k++)
+         {
+            for (int j = lo[1]; j <= hi[1]; j++)
+            {
+               for (int i = lo[0]; i <= hi[0]; i++)
+               {
+                  const int b = i + nbins[0]*(j + nbins[1]*k);
+                  if (pass == 0) { bin_elements.AddAColumnInRow(b); }
+                  else { bin_elements.AddConnection(b, e); }
+               }
+            }
+         }
+      }
+      if (pass == 0) { bin_elements.MakeJ(); }
+   }
+   bin_elements.ShiftUpI();
+}
+
+void MeshPointLocator::GetCandidates(const double *x, Array<int> &elems) const
+{
+   elems.SetSize(0);
+   if (bin_elements.Size() == 0) { return; }
+   int b = 0;
+   for (int d = sdim-1; d >= 0; d--)
+   {
+      if (x[d] < box_min[d] || x[d] > box_max[d]) { return; }
+      b = b*nbins[d] + BinCoord(d, x[d]);
+   }
+   const int *row = bin_elements.GetRow(b);
+   const int size = bin_elements.RowSize(b);
+   for (int i = 0; i < size; i++)
+   {
+      if (InElementBox(row[i], x)) { elems.Append(row[i]); }
+   }
+}
+
+int MeshPointLocator::FindPoint(const double *x, int guess,
+                                IntegrationPoint &ip,
+                                InverseElementTransformation &inv_tr,
+                                IsoparametricTransformation &T) const
+{
+   Vector pt(const_cast<double*>(x), sdim);
+   if (guess >= 0 && guess < mesh->GetNE() && InElementBox(guess, x))
+   {
+      mesh->GetElementTransformation(guess, &T);
+      inv_tr.SetTransformation(T);
+      if (inv_tr.Transform(pt, ip) == InverseElementTransformation::Inside)
+      {
+         return guess;
+      }
+   }
+
+   Array<int> elems;
+   GetCandidates(x, elems);
+   for (int i = 0; i < elems.Size(); i++)
+   {
+      const int e = elems[i];
+      if (e == guess) { continue; }
+      mesh->GetElementTransformation(e, &T);
+      inv_tr.SetTransformation(T);
+      if (inv_tr.Transform(pt, ip) == InverseElementTransformation::Inside)
+      {
+         return e;
+      }
+   }
+   return -1;
+}
+
+int MeshPointLocator::FindPoints(const DenseMatrix &point_mat,
+                                 Array<int> &elem_ids,
+                                 Array<IntegrationPoint> &ips, bool reuse,
+                                 InverseElementTransformation *inv_trans) const
+{
+   const int npts = point_mat.Width();
+   MFEM_VERIFY(npts == 0 || point_mat.Height() == sdim,
+               "Invalid points matrix");
+   if (!reuse || elem_ids.Size() != npts)
+   {
+      elem_ids.SetSize(npts);
+      elem_ids = -1;
+   }
+   ips.SetSize(npts);
+   if (npts == 0 || mesh->GetNE() == 0) { elem_ids = -1; return 0; }
+
+   const double *data = point_mat.Data();
+   int pts_found = 0;
+   if (inv_trans)
+   {
+      IsoparametricTransformation T;
+      for (int k = 0; k < npts; k++)
+      {
+         elem_ids[k] = FindPoint(data + k*sdim, elem_ids[k], ips[k],
+                                 *inv_trans, T);
+         if (elem_ids[k] >= 0) { pts_found++; }
+      }
+      return pts_found;
+   }
+
+   // The element transformations are evaluated concurrently, which requires
+   // the thread-safe build implied by MFEM_USE_LEGACY_OPENMP.
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel reduction(+:pts_found)
+#endif
+   {
+      InverseElementTransformation inv_tr;
+      IsoparametricTransformation T;
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp for schedule(dynamic, 64)
+#endif
+      for (int k = 0; k < npts; k++)
+      {
+         elem_ids[k] = FindPoint(data + k*sdim, elem_ids[k], ips[k],
+                                 inv_tr, T);
+         if (elem_ids[k] >= 0) { pts_found++; }
+      }
+   }
+   return pts_found;
+}
+
+long MeshPointLocator::MemoryUsage() const
+{
+   return el_min.MemoryUsage() + el_max.MemoryUsage() +
+          bin_elements.MemoryUsage();
+}
+
+}
@@ -0,0 +1,128 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_POINT_LOCATOR
+#define MFEM_POINT_LOCATOR
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "../general/table.hpp"
+#include "../linalg/densemat.hpp"
+#include "../fem/intrules.hpp"
+
+namespace mfem
+{
+
+class Mesh;
+class IsoparametricTransformation;
+class InverseElementTransformation;
+
+/** @brief Spatial index over the bounding boxes of the elements of a Mesh,
+    used to locate points in physical space.
+
+    The bounding box of every element is computed by sampling its
+    transformation on a refined reference grid (exact for meshes without
+    high-order nodes) and, for curved elements, enlarging it by a fraction of
+    its size. The boxes are then binned in a uniform Cartesian grid covering
+    the mesh, so that a point query only inverts the transformations of the
+    few elements whose boxes overlap the bin containing the point.
+
+    The index is built once, in the constructor, and can be reused for any
+    number of queries as long as the mesh (including its nodes) is not
+    modified; after such changes, call Update(). */
+class MeshPointLocator
+{
+protected:
+   Mesh *mesh;
+   int sdim;
+
+   double curved_pad; // relative box enlargement for curved elements
+
+   DenseMatrix el_min, el_max; // element bounding boxes, sdim x NE
+   double box_min[3], box_max[3]; // bounding box of the whole mesh
+   double inv_bin_size[3];
+   int nbins[3];
+
+   Table bin_elements; // bin -> list of elements overlapping the bin
+
+   /// Compute the bounding boxes of all elements and the global box.
+   void ComputeElementBoxes();
+
+   /// Bin index in direction @a d of the coordinate @a x, clamped to the grid.
+   inline int BinCoord(int d, double x) const
+   {
+      int b = (int) ((x - box_min[d])*inv_bin_size[d]);
+      return (b < 0) ? 0 : ((b >= nbins[d]) ? nbins[d]-1 : b);
+   }
+
+   /// Return true if the point @a x is inside the bounding box of element @a e.
+   inline bool InElementBox(int e, const double *x) const
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         if (x[d] < el_min(d,e) || x[d] > el_max(d,e)) { return false; }
+      }
+      return true;
+   }
+
+   /** Locate a single point @a x, trying element @a guess (if >= 0) first. On
+       success, return the element id and set @a ip; otherwise return -1. */
+   int FindPoint(const double *x, int guess, IntegrationPoint &ip,
+                 InverseElementTransformation &inv_tr,
+                 IsoparametricTransformation &T) const;
+
+public:
+   /** @brief Build the index for the given @a mesh.
+
+       @param[in] mesh           The mesh whose elements are indexed.
+       @param[in] bins_per_elem  Target average number of bins per element.
+       @param[in] curved_pad     Relative enlargement of the bounding boxes of
+                                 curved (high-order) elements, accounting for
+                                 the parts of the element that are not captured
+                                 by the sampling. */
+   MeshPointLocator(Mesh &mesh, double bins_per_elem = 1.0,
+                    double curved_pad = 0.05);
+
+   /// Rebuild the index, e.g. after the mesh or its nodes have been modified.
+   void Update(double bins_per_elem = 1.0);
+
+   /// Return the number of bins in direction @a d.
+   int GetNumBins(int d) const { return nbins[d]; }
+
+   /** @brief Return the list of elements whose bounding boxes contain the
+       point @a x (SpaceDimension() coordinates). */
+   void GetCandidates(const double *x, Array<int> &elems) const;
+
+   /** @brief Find the ids of the elements that contain the given points, and
+       their corresponding reference coordinates.
+
+       The semantics are the same as in Mesh::FindPoints(). In addition, if
+       @a reuse is true, the input values of @a elem_ids are used as initial
+       guesses: for every point with a valid input element id, that element is
+       tested first. This is useful when locating points that move only a
+       little between consecutive calls.
+
+       If @a inv_trans is NULL and MFEM is built with MFEM_USE_LEGACY_OPENMP,
+       the points are located in parallel using OpenMP threads. A user-provided
+       @a inv_trans is used serially.
+
+       @returns The number of points that were found. */
+   int FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                  Array<IntegrationPoint> &ips, bool reuse = false,
+                  InverseElementTransformation *inv_trans = NULL) const;
+
+   /// Return the number of bytes used by the index.
+   long MemoryUsage() const;
+};
+
+}
+
+#endif
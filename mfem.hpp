@@ -24,6 +24,9 @@
 #include "general/stable3d.hpp"
 #include "general/table.hpp"
 #include "general/tic_toc.hpp"
+#include "general/profiler.hpp"
+#include "general/thread_pool.hpp"
+#include "general/execution_queue.hpp"
 #ifdef MFEM_USE_ADIOS2
 #include "general/adios2stream.hpp"
 #endif
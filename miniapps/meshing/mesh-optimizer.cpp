@@ -66,6 +66,8 @@
 //     mesh-optimizer -m blade.mesh -o 4 -rs 0 -mid 2 -tid 1 -ni 200 -ls 2 -li 100 -bnd -qt 1 -qo 8 -fd
 //   Blade limited shape:
 //     mesh-optimizer -m blade.mesh -o 4 -rs 0 -mid 2 -tid 1 -ni 200 -ls 2 -li 100 -bnd -qt 1 -qo 8 -lc 5000
+//   Blade limited shape with partial assembly:
+//     mesh-optimizer -m blade.mesh -o 4 -rs 0 -mid 2 -tid 1 -ni 200 -ls 2 -li 100 -bnd -qt 1 -qo 8 -lc 5000 -pa
 //   ICF shape and equal size:
 //     mesh-optimizer -o 3 -rs 0 -mid 9 -tid 2 -ni 25 -ls 3 -qo 5
 //   ICF shape and initial size:
@@ -124,6 +126,7 @@ int main(int argc, char *argv[])
    bool fdscheme         = false;
    int adapt_eval        = 0;
    bool exactaction      = false;
+   bool pa               = false;
 
    // 1. Parse command-line options.
    OptionsParser args(argc, argv);
@@ -218,6 +221,8 @@ int main(int argc, char *argv[])
    args.AddOption(&exactaction, "-ex", "--exact_action",
                   "-no-ex", "--no-exact-action",
                   "Enable exact action of TMOP_Integrator.");
+   args.AddOption(&pa, "-pa", "--partial-assembly", "-no-pa",
+                  "--no-partial-assembly", "Enable partial assembly.");
    args.AddOption(&visualization, "-vis", "--visualization", "-no-vis",
                   "--no-visualization",
                   "Enable or disable GLVis visualization.");
@@ -696,6 +701,13 @@ int main(int argc, char *argv[])
    }
    else { a.AddDomainIntegrator(he_nlf_integ); }
 
+   if (pa)
+   {
+      MFEM_VERIFY(combomet == 0, "Partial assembly does not support combos!");
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.Setup();
+   }
+
    // Compute the minimum det(J) of the starting mesh.
    tauval = infinity();
    const int NE = mesh->GetNE();
@@ -802,6 +814,7 @@ int main(int argc, char *argv[])
    const double linsol_rtol = 1e-12;
    if (lin_solver == 0)
    {
+      MFEM_VERIFY(!pa, "Partial assembly requires a Krylov linear solver!");
       S = new DSmoother(1, 1.0, max_lin_iter);
    }
    else if (lin_solver == 1)
@@ -823,7 +836,16 @@ int main(int argc, char *argv[])
       minres->SetPrintLevel(verbosity_level == 2 ? 3 : -1);
       if (lin_solver == 3 || lin_solver == 4)
       {
-         S_prec = new DSmoother((lin_solver == 3) ? 0 : 1, 1.0, 1);
+         if (pa)
+         {
+            // Only the Jacobi smoother is available matrix-free.
+            S_prec = new OperatorJacobiSmoother(a.Width(),
+                                                a.GetEssentialTrueDofs());
+         }
+         else
+         {
+            S_prec = new DSmoother((lin_solver == 3) ? 0 : 1, 1.0, 1);
+         }
          minres->SetPreconditioner(*S_prec);
       }
       S = minres;
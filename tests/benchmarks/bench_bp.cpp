@@ -0,0 +1,408 @@
+//                    MFEM Bake-off Problems (BP) Benchmarks
+//
+// Compile with: make bench_bp
+//
+// Sample runs:  bench_bp
+//               bench_bp -d cpu -p "3 5" -o "1 2 3 4 5 6" -n "4 8 16"
+//               bench_bp -d omp -a "partial none" -f json
+//               bench_bp -d cuda -p "1 3" -o "3 5 7" -n "16 32" -out gpu.csv
+//               bench_bp -lb
+//
+// Description:  This benchmark measures the throughput of the mass, diffusion
+//               and vector diffusion operators on Cartesian meshes, following
+//               the CEED bake-off problems (https://ceed.exascaleproject.org):
+//
+//               BP1: scalar mass,      q = p + 2 quadrature points in 1D
+//               BP2: vector mass,      q = p + 2
+//               BP3: scalar diffusion, q = p + 2
+//               BP4: vector diffusion, q = p + 2
+//               BP5: scalar diffusion, q = p + 1 (collocated Gauss-Lobatto)
+//               BP6: vector diffusion, q = p + 1 (collocated Gauss-Lobatto)
+//
+//               For every problem, order, quadrature, mesh size and assembly
+//               level, it reports the setup time (assembly and formation of
+//               the linear system), the time and the throughput of the
+//               operator action in DOFs/s and estimated GB/s, and the time and
+//               throughput of a fixed number of unpreconditioned CG
+//               iterations. One line is printed per case, in CSV or JSON lines
+//               format, see the run-benchmarks and compare-baseline scripts.
+//
+//               The estimated memory traffic is the minimal traffic of each
+//               assembly level: the input, output and L-vector sized work
+//               vectors, plus the stored quadrature data (partial assembly),
+//               the element matrices (element assembly) or the CSR matrix
+//               (full and legacy assembly).
+
+#include "mfem.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace mfem;
+
+// Assembly levels, with their names in the options and in the output
+static const struct { AssemblyLevel level; const char *name; }
+assembly_levels[] =
+{
+   { AssemblyLevel::LEGACYFULL, "legacy" },
+   { AssemblyLevel::FULL, "full" },
+   { AssemblyLevel::ELEMENT, "element" },
+   { AssemblyLevel::PARTIAL, "partial" },
+   { AssemblyLevel::NONE, "none" }
+};
+
+// One benchmark case and its results
+struct BenchCase
+{
+   int problem, dim, order, q1d, n;
+   AssemblyLevel level;
+   const char *level_name;
+   int ne, ndofs;
+   double setup_time, apply_time, apply_bytes;
+   int solve_iters;
+   double solve_time;
+};
+
+static bool IsVectorProblem(int bp) { return bp == 2 || bp == 4 || bp == 6; }
+static bool IsMassProblem(int bp) { return bp == 1 || bp == 2; }
+
+// The vector integrators do not implement element (and hence full) assembly,
+// and the matrix-free integrators are only implemented with libCEED.
+static bool IsSupported(int bp, AssemblyLevel level)
+{
+   if (level == AssemblyLevel::NONE) { return DeviceCanUseCeed(); }
+   return !IsVectorProblem(bp) ||
+          (level != AssemblyLevel::ELEMENT && level != AssemblyLevel::FULL);
+}
+
+// Smooth perturbation of the unit cube, so that the Jacobians vary.
+static void Perturb(const Vector &x, Vector &y)
+{
+   y = x;
+   for (int d = 0; d < x.Size(); d++)
+   {
+      y(d) += 0.05*sin(M_PI*x((d+1) % x.Size()))*x(d)*(1.0 - x(d));
+   }
+}
+
+// Number of scalar nonzeros of the assembled matrix, from the element-to-dof
+// connectivity.
+static double NumNonZeros(const FiniteElementSpace &fes)
+{
+   const Table &el_dof = fes.GetElementToDofTable();
+   Table dof_el;
+   Transpose(el_dof, dof_el);
+   Table *dof_dof = Mult(dof_el, el_dof);
+   const double nnz = dof_dof->Size_of_connections();
+   delete dof_dof;
+   return nnz;
+}
+
+// Minimal memory traffic of one operator action, see the description above.
+static double ApplyBytes(const BenchCase &c, const FiniteElementSpace &fes)
+{
+   const int vdim = fes.GetVDim();
+   const double ND = pow(c.order + 1.0, c.dim);
+   const double NQ = pow(double(c.q1d), c.dim);
+   const double L = fes.GetVSize();
+   const double E = double(c.ne)*ND*vdim;
+   switch (c.level)
+   {
+      case AssemblyLevel::PARTIAL:
+      {
+         const int S = IsMassProblem(c.problem) ? 1 : c.dim*(c.dim + 1)/2;
+         return 8.0*(3*L + 3*E + c.ne*S*NQ);
+      }
+      case AssemblyLevel::NONE:
+         // The geometric factors are recomputed from the (linear) mesh nodes.
+         return 8.0*(3*L + 3*E + c.ne*c.dim*pow(2.0, c.dim));
+      case AssemblyLevel::ELEMENT:
+         return 8.0*(3*L + 3*E + c.ne*ND*ND*vdim);
+      default:
+      {
+         // Values and column indices of the block diagonal CSR matrix
+         const double nnz = vdim*NumNonZeros(fes);
+         return 12.0*nnz + 4.0*(L + 1) + 8.0*3*L;
+      }
+   }
+}
+
+static void RunCase(BenchCase &c, double min_time, int cg_iter)
+{
+   Mesh *mesh = (c.dim == 2) ?
+                new Mesh(c.n, c.n, Element::QUADRILATERAL, true) :
+                new Mesh(c.n, c.n, c.n, Element::HEXAHEDRON, true);
+   mesh->EnsureNodes();
+   mesh->Transform(Perturb);
+
+   const bool vector = IsVectorProblem(c.problem);
+   H1_FECollection fec(c.order, c.dim);
+   FiniteElementSpace fes(mesh, &fec, vector ? c.dim : 1);
+   c.ne = mesh->GetNE();
+   c.ndofs = fes.GetTrueVSize();
+
+   // Gauss-Legendre rules with q1d points, or collocated Gauss-Lobatto rules.
+   const bool gll = (c.problem == 5 || c.problem == 6);
+   IntegrationRules gll_rules(0, Quadrature1D::GaussLobatto);
+   const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+   const IntegrationRule &ir = gll ? gll_rules.Get(geom, 2*c.q1d - 3) :
+                               IntRules.Get(geom, 2*c.q1d - 1);
+
+   Array<int> ess_tdof_list;
+   if (!IsMassProblem(c.problem))
+   {
+      Array<int> ess_bdr(mesh->bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+   }
+
+   GridFunction x(&fes), b(&fes);
+   x = 0.0;
+   b.Randomize(1);
+
+   StopWatch sw;
+   sw.Start();
+   BilinearForm a(&fes);
+   a.SetAssemblyLevel(c.level);
+   BilinearFormIntegrator *integ;
+   switch (c.problem)
+   {
+      case 1: integ = new MassIntegrator; break;
+      case 2: integ = new VectorMassIntegrator; break;
+      case 3:
+      case 5: integ = new DiffusionIntegrator; break;
+      default: integ = new VectorDiffusionIntegrator;
+   }
+   integ->SetIntRule(&ir);
+   a.AddDomainIntegrator(integ);
+   a.Assemble();
+   OperatorPtr A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+   MFEM_DEVICE_SYNC;
+   sw.Stop();
+   c.setup_time = sw.RealTime();
+
+   // Operator action: after a warm-up, time batches of 10 actions until
+   // min_time is reached, and keep the fastest batch to reduce the noise.
+   Vector Y(B.Size());
+   Y.UseDevice(true);
+   A->Mult(B, Y);
+   MFEM_DEVICE_SYNC;
+   double total_time = 0.0;
+   c.apply_time = infinity();
+   do
+   {
+      sw.Clear();
+      sw.Start();
+      for (int k = 0; k < 10; k++) { A->Mult(B, Y); }
+      MFEM_DEVICE_SYNC;
+      sw.Stop();
+      total_time += sw.RealTime();
+      c.apply_time = std::min(c.apply_time, sw.RealTime()/10);
+   }
+   while (total_time < min_time);
+   c.apply_bytes = ApplyBytes(c, fes);
+
+   // Fixed number of unpreconditioned CG iterations
+   CGSolver cg;
+   cg.SetOperator(*A);
+   cg.SetRelTol(0.0);
+   cg.SetAbsTol(0.0);
+   cg.SetMaxIter(cg_iter);
+   cg.SetPrintLevel(-1);
+   X = 0.0;
+   sw.Clear();
+   sw.Start();
+   cg.Mult(B, X);
+   MFEM_DEVICE_SYNC;
+   sw.Stop();
+   c.solve_iters = cg.GetNumIterations();
+   c.solve_time = sw.RealTime();
+
+   delete mesh;
+}
+
+static void PrintCase(ostream &out, const BenchCase &c, const char *backend,
+                      bool json)
+{
+   const double apply_dofs = c.ndofs/c.apply_time;
+   const double apply_gbs = 1e-9*c.apply_bytes/c.apply_time;
+   const double solve_dofs = c.solve_iters*double(c.ndofs)/c.solve_time;
+   if (json)
+   {
+      out << "{\"problem\": \"bp" << c.problem << "\", \"backend\": \""
+          << backend << "\", \"assembly\": \"" << c.level_name
+          << "\", \"dim\": " << c.dim << ", \"order\": " << c.order
+          << ", \"q1d\": " << c.q1d << ", \"ne\": " << c.ne
+          << ", \"ndofs\": " << c.ndofs
+          << ", \"setup_time\": " << c.setup_time
+          << ", \"apply_time\": " << c.apply_time
+          << ", \"apply_dofs_per_s\": " << apply_dofs
+          << ", \"apply_gb_per_s\": " << apply_gbs
+          << ", \"solve_iters\": " << c.solve_iters
+          << ", \"solve_time\": " << c.solve_time
+          << ", \"solve_dofs_per_s\": " << solve_dofs << "}\n";
+   }
+   else
+   {
+      out << "bp" << c.problem << ',' << backend << ',' << c.level_name << ','
+          << c.dim << ',' << c.order << ',' << c.q1d << ',' << c.ne << ','
+          << c.ndofs << ',' << c.setup_time << ',' << c.apply_time << ','
+          << apply_dofs << ',' << apply_gbs << ',' << c.solve_iters << ','
+          << c.solve_time << ',' << solve_dofs << '\n';
+   }
+   out.flush();
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *device_config = "cpu";
+   Array<int> problems, orders, sizes, quad_offsets;
+   for (int i = 1; i <= 6; i++) { problems.Append(i); orders.Append(i); }
+   sizes.Append(4);
+   sizes.Append(8);
+   const char *assembly = "legacy full element partial none";
+   int dim = 3;
+   int max_dofs = 2000000;
+   double min_time = 0.1;
+   int cg_iter = 20;
+   const char *format = "csv";
+   const char *out_file = "";
+   bool header = true;
+   bool list_backends = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&device_config, "-d", "--device",
+                  "Device configuration string, see Device::Configure().");
+   args.AddOption(&problems, "-p", "--problems",
+                  "Bake-off problems to run, among 1 to 6.");
+   args.AddOption(&orders, "-o", "--orders",
+                  "Finite element orders.");
+   args.AddOption(&sizes, "-n", "--sizes",
+                  "Number of mesh elements in each direction.");
+   args.AddOption(&quad_offsets, "-q", "--quad-offsets",
+                  "Number of quadrature points in 1D minus the order; the "
+                  "default is the one of the bake-off problem.");
+   args.AddOption(&assembly, "-a", "--assembly",
+                  "Assembly levels: legacy, full, element, partial, none.");
+   args.AddOption(&dim, "-dim", "--dimension",
+                  "Mesh dimension, 2 or 3.");
+   args.AddOption(&max_dofs, "-max", "--max-dofs",
+                  "Skip the cases with more DOFs.");
+   args.AddOption(&min_time, "-t", "--min-time",
+                  "Minimum time of the timed operator actions, in seconds.");
+   args.AddOption(&cg_iter, "-cg", "--cg-iterations",
+                  "Number of CG iterations of the solve.");
+   args.AddOption(&format, "-f", "--format",
+                  "Output format: csv or json (one object per line).");
+   args.AddOption(&out_file, "-out", "--output",
+                  "Output file, instead of the standard output.");
+   args.AddOption(&header, "-hdr", "--header", "-no-hdr", "--no-header",
+                  "Print the CSV header line.");
+   args.AddOption(&list_backends, "-lb", "--list-backends", "-no-lb",
+                  "--no-list-backends",
+                  "List the host backends built in MFEM, and exit.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   if (list_backends)
+   {
+      cout << "cpu";
+#ifdef MFEM_USE_OPENMP
+      cout << " omp";
+#endif
+      cout << " threads";
+#ifdef MFEM_USE_RAJA
+      cout << " raja-cpu";
+#endif
+#ifdef MFEM_USE_OCCA
+      cout << " occa-cpu";
+#endif
+#ifdef MFEM_USE_CEED
+      cout << " ceed-cpu";
+#endif
+      cout << endl;
+      return 0;
+   }
+   args.PrintOptions(cerr);
+   MFEM_VERIFY(dim == 2 || dim == 3, "invalid dimension");
+   const bool json = !strcmp(format, "json");
+   MFEM_VERIFY(json || !strcmp(format, "csv"), "invalid format");
+
+   // 2. Parse the assembly levels.
+   std::vector<int> levels;
+   {
+      istringstream is(assembly);
+      string name;
+      while (is >> name)
+      {
+         int l = 0;
+         while (l < 5 && name != assembly_levels[l].name) { l++; }
+         MFEM_VERIFY(l < 5, "invalid assembly level: " << name);
+         levels.push_back(l);
+      }
+   }
+
+   // 3. Enable the hardware devices, e.g. CUDA, OCCA, RAJA or OpenMP.
+   Device device(device_config);
+   device.Print(cerr);
+   const char *backend = device_config;
+
+   ofstream ofs;
+   if (*out_file) { ofs.open(out_file); }
+   ostream &out = *out_file ? static_cast<ostream&>(ofs) : cout;
+   out.precision(6);
+   if (!json && header)
+   {
+      out << "problem,backend,assembly,dim,order,q1d,ne,ndofs,setup_time,"
+          "apply_time,apply_dofs_per_s,apply_gb_per_s,solve_iters,"
+          "solve_time,solve_dofs_per_s\n";
+   }
+
+   // 4. Run the sweep over problems, orders, quadratures, sizes and levels.
+   for (int bp : problems)
+   {
+      MFEM_VERIFY(1 <= bp && bp <= 6, "invalid bake-off problem: " << bp);
+      const int default_offset = (bp == 5 || bp == 6) ? 1 : 2;
+      Array<int> offsets(quad_offsets);
+      if (offsets.Size() == 0) { offsets.Append(default_offset); }
+      for (int p : orders)
+      {
+         for (int qo : offsets)
+         {
+            for (int n : sizes)
+            {
+               const double ndofs = pow(n*p + 1.0, dim)*
+                                    (IsVectorProblem(bp) ? dim : 1);
+               if (ndofs > max_dofs) { continue; }
+               for (int l : levels)
+               {
+                  const AssemblyLevel level = assembly_levels[l].level;
+                  if (!IsSupported(bp, level)) { continue; }
+                  BenchCase c;
+                  c.problem = bp;
+                  c.dim = dim;
+                  c.order = p;
+                  c.q1d = p + qo;
+                  c.n = n;
+                  c.level = level;
+                  c.level_name = assembly_levels[l].name;
+                  RunCase(c, min_time, cg_iter);
+                  PrintCase(out, c, backend, json);
+               }
+            }
+         }
+      }
+   }
+
+   return 0;
+}
@@ -0,0 +1,135 @@
+//                  MFEM Memory Registry Microbenchmarks
+//
+// Compile with: make bench_memory
+//
+// Sample runs:  bench_memory
+//               bench_memory -m host-pool -s 100 -t "1 2 4 8"
+//               bench_memory -m host-std -n 1000000
+//
+// Description:  This benchmark measures the cost of the operations of the
+//               MemoryManager registry, i.e. of the bookkeeping of the
+//               registered allocations and of their aliases:
+//
+//               alloc:       construction and destruction of a Vector of the
+//                            given MemoryType (registration and removal)
+//               makeref:     Vector::MakeRef to a slice of a registered Vector
+//                            and destruction of the reference (alias creation
+//                            and removal)
+//               blockvector: construction and destruction of a BlockVector of
+//                            4 blocks (one allocation and 4 aliases)
+//
+//               Every operation is repeated by each of the given numbers of
+//               threads concurrently, each thread using its own vectors except
+//               for 'makeref', where all the threads alias the same base
+//               Vector. The time per operation, i.e. the elapsed time divided
+//               by the number of operations of one thread, is printed in
+//               nanoseconds, one CSV line per operation and number of threads.
+//               The MemoryType 'host-std' is not registered, so it shows the
+//               cost of the allocations alone.
+
+#include "mfem.hpp"
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace mfem;
+
+// Run body(t) on num_threads threads, t = 0,...,num_threads-1, and return the
+// elapsed time.
+template <typename BODY>
+static double RunThreads(int num_threads, BODY &&body)
+{
+   StopWatch sw;
+   sw.Start();
+   std::vector<std::thread> threads;
+   for (int t = 1; t < num_threads; t++) { threads.emplace_back(body, t); }
+   body(0);
+   for (auto &thread : threads) { thread.join(); }
+   sw.Stop();
+   return sw.RealTime();
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *mem_type = "host-64";
+   int n = 200000;
+   int size = 64;
+   Array<int> num_threads;
+   num_threads.Append(1);
+   bool header = true;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mem_type, "-m", "--memory-type",
+                  "MemoryType of the vectors, see MemoryTypeName, e.g. "
+                  "host-std, host-64 or host-pool.");
+   args.AddOption(&n, "-n", "--iterations",
+                  "Number of operations per thread.");
+   args.AddOption(&size, "-s", "--size",
+                  "Size of the vectors.");
+   args.AddOption(&num_threads, "-t", "--threads",
+                  "Numbers of concurrent threads.");
+   args.AddOption(&header, "-hdr", "--header", "-no-hdr", "--no-header",
+                  "Print the CSV header line.");
+   args.Parse();
+   if (!args.Good() || n <= 0 || size < 4)
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cerr);
+
+   int m = 0;
+   while (m < MemoryTypeSize && strcmp(mem_type, MemoryTypeName[m])) { m++; }
+   MFEM_VERIFY(m < MemoryTypeSize && IsHostMemory(MemoryType(m)),
+               "invalid host memory type: " << mem_type);
+   const MemoryType mt = MemoryType(m);
+
+   if (header) { cout << "operation,memory,size,threads,ns_per_op\n"; }
+   for (int nt : num_threads)
+   {
+      MFEM_VERIFY(nt > 0, "invalid number of threads");
+      auto print = [&](const char *op, double time)
+      {
+         cout << op << ',' << mem_type << ',' << size << ',' << nt << ','
+              << 1e9*time/n << endl;
+      };
+
+      // 2. Allocation and deallocation
+      print("alloc", RunThreads(nt, [&](int)
+      {
+         for (int i = 0; i < n; i++)
+         {
+            Vector x(size, mt);
+            x[0] = i;
+         }
+      }));
+
+      // 3. Alias creation and removal
+      Vector base(size*nt, mt);
+      print("makeref", RunThreads(nt, [&](int t)
+      {
+         Vector r;
+         for (int i = 0; i < n; i++)
+         {
+            r.MakeRef(base, t*size + i % (size/2), size/2);
+         }
+      }));
+
+      // 4. BlockVector with 4 blocks
+      Array<int> offsets(5);
+      for (int b = 0; b < 5; b++) { offsets[b] = b*size/4; }
+      print("blockvector", RunThreads(nt, [&](int)
+      {
+         for (int i = 0; i < n; i++)
+         {
+            BlockVector x(offsets, mt);
+            x[0] = i;
+         }
+      }));
+   }
+
+   return 0;
+}
@@ -0,0 +1,167 @@
+//                      MFEM STREAM Memory Bandwidth Benchmark
+//
+// Compile with: make bench_stream
+//
+// Sample runs:  bench_stream
+//               bench_stream -d omp
+//               bench_stream -d omp:numa
+//               bench_stream -d threads:numa+interleave -n 50000000
+//               bench_stream -d omp:numa -no-hi
+//
+// Description:  This benchmark measures the sustainable memory bandwidth of
+//               the MFEM_FORALL kernels, following the STREAM benchmark
+//               (https://www.cs.virginia.edu/stream): it times the Copy
+//               (a = b), Scale (a = s b), Add (a = b + c) and Triad
+//               (a = b + s c) kernels on Vectors of the device MemoryType, and
+//               reports the fastest of several runs in GB/s, one CSV line per
+//               kernel.
+//
+//               By default, the vectors are initialized sequentially on the
+//               host, as small vectors or setup code often are. With the
+//               default host memory, all their pages are then placed on the
+//               NUMA node of the main thread, and the bandwidth of the 'omp'
+//               and 'threads' backends is limited by the remote accesses on
+//               multi-socket nodes. With the 'numa' device option, e.g.
+//               'omp:numa', the pages are placed at allocation on the NUMA
+//               nodes of the threads that use them, see MemoryType::HOST_NUMA,
+//               which restores the bandwidth. The option -no-hi initializes
+//               the vectors with a device kernel instead, for comparison.
+
+#include "mfem.hpp"
+#include <iostream>
+
+using namespace std;
+using namespace mfem;
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *device_config = "cpu";
+   int n = 20000000;
+   int runs = 10;
+   bool host_init = true;
+   bool header = true;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&device_config, "-d", "--device",
+                  "Device configuration string, see Device::Configure().");
+   args.AddOption(&n, "-n", "--size",
+                  "Size of the vectors; they should be much larger than the "
+                  "caches.");
+   args.AddOption(&runs, "-r", "--runs",
+                  "Number of timed runs of each kernel, at most 100 so that "
+                  "the values stay finite.");
+   args.AddOption(&host_init, "-hi", "--host-init", "-no-hi",
+                  "--no-host-init",
+                  "Initialize the vectors sequentially on the host, or with "
+                  "a device kernel.");
+   args.AddOption(&header, "-hdr", "--header", "-no-hdr", "--no-header",
+                  "Print the CSV header line.");
+   args.Parse();
+   if (!args.Good() || n <= 0 || runs <= 0 || runs > 100)
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cerr);
+
+   // 2. Enable the hardware devices, e.g. CUDA, OCCA, RAJA or OpenMP.
+   Device device(device_config);
+   device.Print(cerr);
+   const MemoryType mt = Device::GetDeviceMemoryType();
+
+   // 3. Allocate and initialize the vectors.
+   Vector a(n, mt), b(n, mt), c(n, mt);
+   a.UseDevice(true);
+   b.UseDevice(true);
+   c.UseDevice(true);
+   if (host_init)
+   {
+      double *A = a.HostWrite(), *B = b.HostWrite(), *C = c.HostWrite();
+      for (int i = 0; i < n; i++) { A[i] = 1.0; B[i] = 2.0; C[i] = 0.0; }
+   }
+   else
+   {
+      a = 1.0;
+      b = 2.0;
+      c = 0.0;
+   }
+
+   // 4. Time the kernels. Each run is c = a; b = s c; c = a + b; a = b + s c,
+   //    as in STREAM, and the fastest of the runs is kept.
+   const double s = 3.0;
+   const char *names[4] = { "copy", "scale", "add", "triad" };
+   const double bytes[4] = { 16.0*n, 16.0*n, 24.0*n, 24.0*n };
+   double best[4] = { infinity(), infinity(), infinity(), infinity() };
+   StopWatch sw;
+   for (int r = 0; r <= runs; r++)
+   {
+      for (int k = 0; k < 4; k++)
+      {
+         sw.Clear();
+         sw.Start();
+         switch (k)
+         {
+            case 0:
+            {
+               const double *A = a.Read();
+               double *C = c.Write();
+               MFEM_FORALL(i, n, C[i] = A[i];);
+               break;
+            }
+            case 1:
+            {
+               const double *C = c.Read();
+               double *B = b.Write();
+               MFEM_FORALL(i, n, B[i] = s*C[i];);
+               break;
+            }
+            case 2:
+            {
+               const double *A = a.Read(), *B = b.Read();
+               double *C = c.Write();
+               MFEM_FORALL(i, n, C[i] = A[i] + B[i];);
+               break;
+            }
+            default:
+            {
+               const double *B = b.Read(), *C = c.Read();
+               double *A = a.Write();
+               MFEM_FORALL(i, n, A[i] = B[i] + s*C[i];);
+            }
+         }
+         MFEM_DEVICE_SYNC;
+         sw.Stop();
+         // The first run is a warm-up
+         if (r > 0) { best[k] = std::min(best[k], sw.RealTime()); }
+      }
+   }
+
+   // 5. Check the values against the same sequence of operations on scalars.
+   double ea = 1.0, eb = 2.0, ec = 0.0;
+   for (int r = 0; r <= runs; r++)
+   {
+      ec = ea;
+      eb = s*ec;
+      ec = ea + eb;
+      ea = eb + s*ec;
+   }
+   a.HostRead();
+   b.HostRead();
+   c.HostRead();
+   const double err =
+      std::max(std::max(fabs(a.Max() - ea), fabs(a.Min() - ea)),
+               std::max(fabs(b.Max() - eb), fabs(c.Max() - ec)));
+   MFEM_VERIFY(err <= 1e-12*fabs(ea), "invalid STREAM results");
+
+   // 6. Print the results.
+   if (header) { cout << "kernel,backend,memory,n,time,gb_per_s\n"; }
+   for (int k = 0; k < 4; k++)
+   {
+      cout << names[k] << ',' << device_config << ','
+           << MemoryTypeName[static_cast<int>(mt)] << ',' << n << ','
+           << best[k] << ',' << 1e-9*bytes[k]/best[k] << '\n';
+   }
+
+   return 0;
+}
@@ -21,7 +21,11 @@ int dimension;
 
 double coeffFunction(const Vector& x)
 {
-   if (dimension == 2)
+   if (dimension == 1)
+   {
+      return sin(8.0 * M_PI * x[0]) + 2.0;
+   }
+   else if (dimension == 2)
    {
       return sin(8.0 * M_PI * x[0]) * cos(6.0 * M_PI * x[1]) + 2.0;
    }
@@ -36,6 +40,10 @@ double coeffFunction(const Vector& x)
 void vectorCoeffFunction(const Vector & x, Vector & f)
 {
    f = 0.0;
+   if (dimension == 1)
+   {
+      f[0] = 1.1 + sin(2.5 * M_PI * x[0]);
+   }
    if (dimension > 1)
    {
       f[0] = sin(M_PI * x[1]);
@@ -50,7 +58,11 @@ void vectorCoeffFunction(const Vector & x, Vector & f)
 void asymmetricMatrixCoeffFunction(const Vector & x, DenseMatrix & f)
 {
    f = 0.0;
-   if (dimension == 2)
+   if (dimension == 1)
+   {
+      f(0,0) = 1.1 + sin(M_PI * x[0]);  // 1,1
+   }
+   else if (dimension == 2)
    {
       f(0,0) = 1.1 + sin(M_PI * x[1]);  // 1,1
       f(1,0) = cos(1.3 * M_PI * x[1]);  // 2,1
@@ -74,7 +86,11 @@ void asymmetricMatrixCoeffFunction(const Vector & x, DenseMatrix & f)
 void fullSymmetricMatrixCoeffFunction(const Vector & x, DenseMatrix & f)
 {
    f = 0.0;
-   if (dimension == 2)
+   if (dimension == 1)
+   {
+      f(0,0) = 1.1 + sin(M_PI * x[0]);  // 1,1
+   }
+   else if (dimension == 2)
    {
       f(0,0) = 1.1 + sin(M_PI * x[1]);  // 1,1
       f(0,1) = cos(2.5 * M_PI * x[0]);  // 1,2
@@ -98,7 +114,11 @@ void fullSymmetricMatrixCoeffFunction(const Vector & x, DenseMatrix & f)
 void symmetricMatrixCoeffFunction(const Vector & x, DenseSymmetricMatrix & f)
 {
    f = 0.0;
-   if (dimension == 2)
+   if (dimension == 1)
+   {
+      f(0,0) = 1.1 + sin(M_PI * x[0]);  // 1,1
+   }
+   else if (dimension == 2)
    {
       f(0,0) = 1.1 + sin(M_PI * x[1]);  // 1,1
       f(0,1) = cos(2.5 * M_PI * x[0]);  // 1,2
@@ -117,7 +137,7 @@ void symmetricMatrixCoeffFunction(const Vector & x, DenseSymmetricMatrix & f)
 
 TEST_CASE("massdiag")
 {
-   for (dimension = 2; dimension < 4; ++dimension)
+   for (dimension = 1; dimension < 4; ++dimension)
    {
       for (int ne = 1; ne < 3; ++ne)
       {
@@ -126,7 +146,11 @@ TEST_CASE("massdiag")
          for (int order = 1; order < 5; ++order)
          {
             Mesh * mesh;
-            if (dimension == 2)
+            if (dimension == 1)
+            {
+               mesh = new Mesh(ne, 1.0);
+            }
+            else if (dimension == 2)
             {
                mesh = new Mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
             }
@@ -165,7 +189,7 @@ TEST_CASE("massdiag")
 
 TEST_CASE("diffusiondiag")
 {
-   for (dimension = 2; dimension < 4; ++dimension)
+   for (dimension = 1; dimension < 4; ++dimension)
    {
       for (int ne = 1; ne < 3; ++ne)
       {
@@ -175,7 +199,11 @@ TEST_CASE("diffusiondiag")
          for (int order = 1; order < 5; ++order)
          {
             Mesh * mesh;
-            if (dimension == 2)
+            if (dimension == 1)
+            {
+               mesh = new Mesh(ne, 1.0);
+            }
+            else if (dimension == 2)
             {
                mesh = new Mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
             }
@@ -116,6 +116,16 @@ TEST_CASE("Assembly Levels", "[AssemblyLevel], [PartialAssembly]")
    auto order_2d = GENERATE(2, 3, 4);
    auto order_3d = GENERATE(2);
 
+   SECTION("1D")
+   {
+      // High orders are cheap in 1D
+      const int order_1d = 3*order_2d;
+      test_assembly_level("../../data/inline-segment.mesh",
+                          order_1d, dg, pb, assembly);
+      test_assembly_level("../../data/periodic-segment.mesh",
+                          order_1d, dg, pb, assembly);
+   }
+
    SECTION("2D")
    {
       test_assembly_level("../../data/periodic-square.mesh",
@@ -147,4 +157,358 @@ TEST_CASE("Assembly Levels", "[AssemblyLevel], [PartialAssembly]")
    }
 } // test case
 
+void test_pa_non_tensor(const char *meshname, int order, bool dg, const int pb)
+{
+   INFO("mesh=" << meshname << ", order=" << order << ", DG=" << dg
+        << ", pb=" << pb);
+   Mesh mesh(meshname, 1, 1);
+   int dim = mesh.Dimension();
+
+   FiniteElementCollection *fec;
+   if (dg)
+   {
+      fec = new L2_FECollection(order, dim, BasisType::GaussLobatto);
+   }
+   else
+   {
+      fec = new H1_FECollection(order, dim);
+   }
+
+   FiniteElementSpace fespace(&mesh, fec);
+   REQUIRE(!UsesTensorBasis(fespace));
+
+   BilinearForm k_test(&fespace);
+   BilinearForm k_ref(&fespace);
+
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x(0)*x(0); });
+   DenseMatrix mat(dim);
+   mat = 0.5;
+   for (int d = 0; d < dim; d++) { mat(d,d) = 2.0 + d; }
+   mat(0,dim-1) = -0.25;
+   MatrixConstantCoefficient mat_coeff(mat);
+
+   if (pb==0) // Mass
+   {
+      k_ref.AddDomainIntegrator(new MassIntegrator(coeff));
+      k_test.AddDomainIntegrator(new MassIntegrator(coeff));
+   }
+   else if (pb==1) // Diffusion
+   {
+      k_ref.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      k_test.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   }
+   else if (pb==2) // Diffusion, nonsymmetric matrix coefficient
+   {
+      k_ref.AddDomainIntegrator(new DiffusionIntegrator(mat_coeff));
+      k_test.AddDomainIntegrator(new DiffusionIntegrator(mat_coeff));
+   }
+
+   k_ref.Assemble();
+   k_ref.Finalize();
+
+   k_test.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_test.Assemble();
+
+   GridFunction x(&fespace), y_ref(&fespace), y_test(&fespace);
+
+   x.Randomize(1);
+
+   k_ref.Mult(x,y_ref);
+   k_test.Mult(x,y_test);
+
+   y_test -= y_ref;
+
+   REQUIRE(y_test.Norml2() < 1.e-12);
+
+   Vector diag_ref(fespace.GetVSize()), diag_test(fespace.GetVSize());
+   k_ref.SpMat().GetDiag(diag_ref);
+   k_test.AssembleDiagonal(diag_test);
+
+   diag_test -= diag_ref;
+
+   REQUIRE(diag_test.Norml2() < 1.e-12);
+
+   delete fec;
+}
+
+TEST_CASE("PA Non-Tensor Elements", "[AssemblyLevel], [PartialAssembly]")
+{
+   auto pb = GENERATE(0, 1, 2);
+   auto dg = GENERATE(true, false);
+   auto order_2d = GENERATE(1, 2, 3);
+   auto order_3d = GENERATE(1, 2);
+
+   SECTION("2D")
+   {
+      test_pa_non_tensor("../../data/square-mixed.mesh", order_2d, dg, pb);
+      test_pa_non_tensor("../../data/inline-tri.mesh", order_2d, dg, pb);
+      test_pa_non_tensor("../../data/star-mixed.mesh", order_2d, dg, pb);
+   }
+
+   SECTION("3D")
+   {
+      test_pa_non_tensor("../../data/inline-tet.mesh", order_3d, dg, pb);
+      test_pa_non_tensor("../../data/fichera-mixed.mesh", order_3d, dg, pb);
+   }
+} // test case
+
+void test_pa_dg_diffusion(const char *meshname, int order, int btype,
+                          double sigma)
+{
+   INFO("mesh=" << meshname << ", order=" << order << ", btype=" << btype
+        << ", sigma=" << sigma);
+   Mesh mesh(meshname, 1, 1);
+   int dim = mesh.Dimension();
+
+   L2_FECollection fec(order, dim, btype);
+   FiniteElementSpace fespace(&mesh, &fec);
+
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x(0)*x(0); });
+   const double kappa = (order+1)*(order+1);
+
+   BilinearForm k_test(&fespace);
+   BilinearForm k_ref(&fespace);
+   for (BilinearForm *k : {&k_test, &k_ref})
+   {
+      k->AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      k->AddInteriorFaceIntegrator(
+         new DGDiffusionIntegrator(coeff, sigma, kappa));
+      k->AddBdrFaceIntegrator(new DGDiffusionIntegrator(coeff, sigma, kappa));
+   }
+
+   k_ref.Assemble();
+   k_ref.Finalize();
+
+   k_test.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_test.Assemble();
+
+   GridFunction x(&fespace), y_ref(&fespace), y_test(&fespace);
+   x.Randomize(1);
+
+   k_ref.Mult(x,y_ref);
+   k_test.Mult(x,y_test);
+   y_test -= y_ref;
+   REQUIRE(y_test.Norml2() < 1.e-12*y_ref.Norml2());
+
+   // Only the face terms are nonsymmetric
+   BilinearForm k_face(&fespace), k_face_ref(&fespace);
+   for (BilinearForm *k : {&k_face, &k_face_ref})
+   {
+      k->AddInteriorFaceIntegrator(
+         new DGDiffusionIntegrator(coeff, sigma, kappa));
+      k->AddBdrFaceIntegrator(new DGDiffusionIntegrator(coeff, sigma, kappa));
+   }
+   k_face_ref.Assemble();
+   k_face_ref.Finalize();
+   PABilinearFormExtension k_ext(&k_face);
+   k_ext.Assemble();
+   k_face_ref.SpMat().MultTranspose(x,y_ref);
+   k_ext.MultTranspose(x,y_test);
+   y_test -= y_ref;
+   REQUIRE(y_test.Norml2() < 1.e-12*y_ref.Norml2());
+
+   Vector diag_ref(fespace.GetVSize()), diag_test(fespace.GetVSize());
+   k_ref.SpMat().GetDiag(diag_ref);
+   k_test.AssembleDiagonal(diag_test);
+   diag_test -= diag_ref;
+   REQUIRE(diag_test.Norml2() < 1.e-12*diag_ref.Norml2());
+}
+
+TEST_CASE("PA DG Diffusion", "[AssemblyLevel], [PartialAssembly]")
+{
+   auto sigma = GENERATE(-1.0, 1.0);
+   auto btype = GENERATE(BasisType::GaussLobatto, BasisType::GaussLegendre);
+   auto order_2d = GENERATE(1, 2, 3);
+   auto order_3d = GENERATE(1, 2);
+
+   SECTION("2D")
+   {
+      test_pa_dg_diffusion("../../data/star-q3.mesh", order_2d, btype, sigma);
+      test_pa_dg_diffusion("../../data/inline-tri.mesh", order_2d, btype,
+                           sigma);
+      test_pa_dg_diffusion("../../data/periodic-square.mesh", order_2d, btype,
+                           sigma);
+   }
+
+   SECTION("3D")
+   {
+      test_pa_dg_diffusion("../../data/fichera-q3.mesh", order_3d, btype,
+                           sigma);
+      test_pa_dg_diffusion("../../data/inline-tet.mesh", order_3d, btype,
+                           sigma);
+   }
+} // test case
+
+void test_pa_fused(const char *meshname, int order, bool extra_qpts)
+{
+   INFO("mesh=" << meshname << ", order=" << order << ", extra_qpts="
+        << extra_qpts);
+   Mesh mesh(meshname, 1, 1);
+   int dim = mesh.Dimension();
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fespace(&mesh, &fec);
+
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x(0)*x(0); });
+
+   // With extra quadrature points, Q1D != D1D selects the generic kernels
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(geom, 2*order + 3);
+
+   BilinearForm k_test(&fespace), k_pa(&fespace), k_ref(&fespace);
+   for (BilinearForm *k : {&k_test, &k_pa, &k_ref})
+   {
+      BilinearFormIntegrator *diff = new DiffusionIntegrator(coeff);
+      BilinearFormIntegrator *mass = new MassIntegrator(coeff);
+      if (extra_qpts)
+      {
+         diff->SetIntRule(&ir);
+         mass->SetIntRule(&ir);
+      }
+      k->AddDomainIntegrator(diff);
+      k->AddDomainIntegrator(mass);
+   }
+
+   k_ref.Assemble();
+   k_ref.Finalize();
+
+   k_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_pa.Assemble();
+
+   k_test.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_test.EnableFusedPA();
+   k_test.Assemble();
+
+   GridFunction x(&fespace), y_ref(&fespace), y_test(&fespace);
+   x.Randomize(1);
+
+   k_ref.Mult(x,y_ref);
+   k_test.Mult(x,y_test);
+   y_test -= y_ref;
+   REQUIRE(y_test.Norml2() < 1.e-12*y_ref.Norml2());
+
+   // The fused action must agree with the unfused one to rounding
+   k_pa.Mult(x,y_ref);
+   k_test.Mult(x,y_test);
+   y_test -= y_ref;
+   REQUIRE(y_test.Norml2() < 1.e-14*y_ref.Norml2());
+
+   // The diagonal falls back to the element vectors
+   Vector diag_ref(fespace.GetVSize()), diag_test(fespace.GetVSize());
+   k_ref.SpMat().GetDiag(diag_ref);
+   k_test.AssembleDiagonal(diag_test);
+   diag_test -= diag_ref;
+   REQUIRE(diag_test.Norml2() < 1.e-12*diag_ref.Norml2());
+}
+
+TEST_CASE("PA Fused Action", "[AssemblyLevel], [PartialAssembly]")
+{
+   auto extra_qpts = GENERATE(false, true);
+   auto order_2d = GENERATE(1, 2, 3);
+   auto order_3d = GENERATE(1, 2);
+
+   SECTION("2D")
+   {
+      test_pa_fused("../../data/star-q3.mesh", order_2d, extra_qpts);
+      test_pa_fused("../../data/periodic-square.mesh", order_2d, extra_qpts);
+   }
+
+   SECTION("3D")
+   {
+      test_pa_fused("../../data/fichera-q3.mesh", order_3d, extra_qpts);
+      test_pa_fused("../../data/periodic-cube.mesh", order_3d, extra_qpts);
+   }
+} // test case
+
+static void vector_fe_coeff(const Vector &x, DenseMatrix &M)
+{
+   const int dim = x.Size();
+   M.SetSize(dim);
+   M = 0.0;
+   for (int i = 0; i < dim; i++) { M(i,i) = 2.0 + x(i)*x(i); }
+   M(0,1) = 0.5*x(0);
+   M(1,0) = -0.25;
+}
+
+// Compare the element and full assembly of the H(curl) and H(div) integrators
+// against the legacy assembly.
+void test_vector_fe_assembly(const char *meshname, int order, bool hcurl,
+                             const AssemblyLevel assembly)
+{
+   INFO("mesh=" << meshname << ", order=" << order << ", hcurl=" << hcurl
+        << ", assembly=" << int(assembly));
+   Mesh mesh(meshname, 1, 1);
+   mesh.EnsureNodes();
+   const int dim = mesh.Dimension();
+
+   FiniteElementCollection *fec;
+   if (hcurl)
+   {
+      fec = new ND_FECollection(order, dim);
+   }
+   else
+   {
+      fec = new RT_FECollection(order - 1, dim);
+   }
+   FiniteElementSpace fespace(&mesh, fec);
+
+   ConstantCoefficient one(1.0);
+   MatrixFunctionCoefficient mat_coeff(dim, vector_fe_coeff);
+
+   BilinearForm k_test(&fespace);
+   BilinearForm k_ref(&fespace);
+   if (hcurl)
+   {
+      k_ref.AddDomainIntegrator(new CurlCurlIntegrator(one));
+      k_ref.AddDomainIntegrator(new VectorFEMassIntegrator(mat_coeff));
+      k_test.AddDomainIntegrator(new CurlCurlIntegrator(one));
+      k_test.AddDomainIntegrator(new VectorFEMassIntegrator(mat_coeff));
+   }
+   else
+   {
+      k_ref.AddDomainIntegrator(new DivDivIntegrator(one));
+      k_ref.AddDomainIntegrator(new VectorFEMassIntegrator(one));
+      k_test.AddDomainIntegrator(new DivDivIntegrator(one));
+      k_test.AddDomainIntegrator(new VectorFEMassIntegrator(one));
+   }
+
+   k_ref.Assemble();
+   k_ref.Finalize();
+
+   k_test.SetAssemblyLevel(assembly);
+   k_test.Assemble();
+
+   GridFunction x(&fespace), y_ref(&fespace), y_test(&fespace);
+   x.Randomize(1);
+
+   k_ref.Mult(x, y_ref);
+   k_test.Mult(x, y_test);
+   y_test -= y_ref;
+   REQUIRE(y_test.Norml2() < 1.e-12*y_ref.Norml2());
+
+   delete fec;
+}
+
+TEST_CASE("H(curl) and H(div) Assembly Levels", "[AssemblyLevel]")
+{
+   auto assembly = GENERATE(AssemblyLevel::ELEMENT, AssemblyLevel::FULL);
+   auto hcurl = GENERATE(true, false);
+   auto order_2d = GENERATE(1, 2, 3);
+   auto order_3d = GENERATE(1, 2);
+
+   SECTION("2D")
+   {
+      test_vector_fe_assembly("../../data/inline-quad.mesh", order_2d, hcurl,
+                              assembly);
+      test_vector_fe_assembly("../../data/periodic-square.mesh", order_2d,
+                              hcurl, assembly);
+   }
+
+   SECTION("3D")
+   {
+      test_vector_fe_assembly("../../data/inline-hex.mesh", order_3d, hcurl,
+                              assembly);
+   }
+} // test case
+
 } // namespace pa_kernels
@@ -235,3 +235,65 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
    }
 
 }
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("CheckpointDataCollection", "[Parallel], [DataCollection]")
+{
+   int num_procs, my_rank;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+   Mesh mesh(4, 3, Element::QUADRILATERAL, 1, 2.0, 3.0);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+
+   H1_FECollection fec(2, pmesh.Dimension());
+   ParFiniteElementSpace fes(&pmesh, &fec, 2, Ordering::byVDIM);
+   ParGridFunction u(&fes);
+   for (int i = 0; i < u.Size(); i++) { u(i) = my_rank + 0.001*i; }
+
+   QuadratureSpace qspace(&pmesh, 3);
+   QuadratureFunction qf(&qspace, 2);
+   for (int i = 0; i < qf.Size(); i++) { qf(i) = -my_rank - 0.01*i; }
+
+   CheckpointDataCollection dc(MPI_COMM_WORLD, "ckpt_test", &pmesh);
+   dc.RegisterField("u", &u);
+   dc.RegisterQField("q", &qf);
+   dc.SetCycle(7);
+   dc.SetTime(0.25);
+   dc.Save();
+   REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+   REQUIRE(dc.GetLastIOBytes() > 0);
+
+   CheckpointDataCollection dc_new(MPI_COMM_WORLD, "ckpt_test");
+   dc_new.Load(7);
+   REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+   REQUIRE(dc_new.GetTime() == 0.25);
+
+   ParMesh *pmesh_new = dynamic_cast<ParMesh*>(dc_new.GetMesh());
+   REQUIRE(pmesh_new != NULL);
+   REQUIRE(pmesh_new->GetNE() == pmesh.GetNE());
+   REQUIRE(pmesh_new->GetNSharedFaces() == pmesh.GetNSharedFaces());
+
+   ParGridFunction *u_new = dc_new.GetParField("u");
+   REQUIRE(u_new != NULL);
+   REQUIRE(u_new->ParFESpace()->GlobalTrueVSize() == fes.GlobalTrueVSize());
+   Vector u_diff(*u_new);
+   u_diff -= u;
+   REQUIRE(u_diff.Normlinf() == 0.0);
+
+   QuadratureFunction *qf_new = dc_new.GetQField("q");
+   REQUIRE(qf_new != NULL);
+   REQUIRE(qf_new->GetVDim() == 2);
+   Vector qf_diff(*qf_new);
+   qf_diff -= qf;
+   REQUIRE(qf_diff.Normlinf() == 0.0);
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (my_rank == 0)
+   {
+      REQUIRE(remove("ckpt_test_000007.mfem_ckpt") == 0);
+   }
+}
+
+#endif
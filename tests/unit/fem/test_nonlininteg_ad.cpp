@@ -0,0 +1,177 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "unit_tests.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+namespace nonlininteg_ad
+{
+
+template <typename T>
+T dual_test_function(const T &x, const T &y)
+{
+   using std::sqrt; using std::exp; using std::sin; using std::pow;
+   return x*sin(y)/(1.0 + x*x) + sqrt(exp(x) + y*y) - pow(x, 3.0)*y;
+}
+
+TEST_CASE("Dual numbers", "[AD]")
+{
+   const double x = 0.7, y = -1.3, h = 1e-6;
+   typedef Dual<double,2> dual;
+   const dual f = dual_test_function(dual(x, 0), dual(y, 1));
+   const double f_x = (dual_test_function(x + h, y) -
+                       dual_test_function(x - h, y))/(2*h);
+   const double f_y = (dual_test_function(x, y + h) -
+                       dual_test_function(x, y - h))/(2*h);
+   REQUIRE(f.value == MFEM_Approx(dual_test_function(x, y)));
+   REQUIRE(f.grad[0] == MFEM_Approx(f_x, 1e-8));
+   REQUIRE(f.grad[1] == MFEM_Approx(f_y, 1e-8));
+}
+
+// The Neo-Hookean model of NeoHookeanModel, with constant coefficients, as a
+// point-wise residual for the ADNonlinearFormIntegrator.
+template <int DIM>
+struct NeoHookeanQFunction
+{
+   double mu, K, g;
+
+   template <typename T>
+   void operator()(ElementTransformation &, const T *, const T *J,
+                   T *, T *P) const
+   {
+      using std::pow;
+      T Z[DIM*DIM], dJ;
+      if (DIM == 2)
+      {
+         dJ = J[0]*J[3] - J[1]*J[2];
+         Z[0] = J[3]; Z[1] = -J[2];
+         Z[2] = -J[1]; Z[3] = J[0];
+      }
+      else
+      {
+         for (int i = 0; i < 3; i++)
+         {
+            const int i1 = (i+1)%3, i2 = (i+2)%3;
+            for (int j = 0; j < 3; j++)
+            {
+               const int j1 = (j+1)%3, j2 = (j+2)%3;
+               Z[i*3+j] = J[i1*3+j1]*J[i2*3+j2] - J[i1*3+j2]*J[i2*3+j1];
+            }
+         }
+         dJ = J[0]*Z[0] + J[1]*Z[1] + J[2]*Z[2];
+      }
+      T JJ = 0.0;
+      for (int i = 0; i < DIM*DIM; i++) { JJ += J[i]*J[i]; }
+      const T a = mu*pow(dJ, -2.0/DIM);
+      const T b = K*(dJ/g - 1.0)/g - a*JJ/(DIM*dJ);
+      for (int i = 0; i < DIM*DIM; i++) { P[i] = a*J[i] + b*Z[i]; }
+   }
+};
+
+static void deformation(const Vector &X, Vector &x)
+{
+   x = X;
+   x(0) += 0.05*sin(M_PI*X(1));
+   x(1) += 0.05*X(0)*X(0);
+   if (X.Size() == 3) { x(2) += 0.05*X(0)*X(1); }
+}
+
+static void mesh_map(const Vector &X, Vector &Y)
+{
+   Y = X;
+   Y(0) += 0.1*X(1)*X(1);
+   Y(1) += 0.1*X(0);
+}
+
+// Compare the AD Neo-Hookean integrator against HyperelasticNLFIntegrator, with
+// full and partial assembly.
+template <int DIM>
+double test_ad_hyperelastic(bool pa)
+{
+   Mesh *mesh = nullptr;
+   if (DIM == 2)
+   {
+      mesh = new Mesh(3, 2, Element::QUADRILATERAL, 0, 1.0, 2.0);
+   }
+   if (DIM == 3)
+   {
+      mesh = new Mesh(2, 2, 2, Element::HEXAHEDRON, 0, 1.0, 1.0, 2.0);
+   }
+   mesh->EnsureNodes();
+   mesh->Transform(mesh_map);
+
+   const int order = 2;
+   H1_FECollection fec(order, DIM);
+   FiniteElementSpace fes(mesh, &fec, DIM);
+
+   VectorFunctionCoefficient deform(DIM, deformation);
+   GridFunction x(&fes), v(&fes);
+   x.ProjectCoefficient(deform);
+   v.Randomize(7);
+
+   NeoHookeanModel model(1.5, 5.0, 1.2);
+   NeoHookeanQFunction<DIM> qf{1.5, 5.0, 1.2};
+   // The integration rule of HyperelasticNLFIntegrator
+   const IntegrationRule &ir =
+      IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 3);
+
+   NonlinearForm nlf_ref(&fes);
+   nlf_ref.AddDomainIntegrator(new HyperelasticNLFIntegrator(&model));
+
+   NonlinearForm nlf_ad(&fes);
+   if (pa) { nlf_ad.SetAssemblyLevel(AssemblyLevel::PARTIAL); }
+   nlf_ad.AddDomainIntegrator(
+      new ADNonlinearFormIntegrator<NeoHookeanQFunction<DIM>,DIM,DIM>(qf, &ir));
+   if (pa) { nlf_ad.Setup(); }
+
+   double difference = 0.0;
+
+   Vector y_ref(fes.GetVSize()), y_ad(fes.GetVSize());
+   nlf_ref.Mult(x, y_ref);
+   nlf_ad.Mult(x, y_ad);
+   y_ad -= y_ref;
+   difference = std::max(difference, y_ad.Normlinf()/y_ref.Normlinf());
+
+   Operator &grad_ref = nlf_ref.GetGradient(x);
+   Operator &grad_ad = nlf_ad.GetGradient(x);
+   grad_ref.Mult(v, y_ref);
+   grad_ad.Mult(v, y_ad);
+   y_ad -= y_ref;
+   difference = std::max(difference, y_ad.Normlinf()/y_ref.Normlinf());
+
+   dynamic_cast<SparseMatrix&>(grad_ref).GetDiag(y_ref);
+   if (pa)
+   {
+      grad_ad.AssembleDiagonal(y_ad);
+   }
+   else
+   {
+      dynamic_cast<SparseMatrix&>(grad_ad).GetDiag(y_ad);
+   }
+   y_ad -= y_ref;
+   difference = std::max(difference, y_ad.Normlinf()/y_ref.Normlinf());
+
+   delete mesh;
+
+   return difference;
+}
+
+TEST_CASE("AD Nonlinear Integrator", "[AD], [NonlinearPA]")
+{
+   auto pa = GENERATE(false, true);
+   CAPTURE(pa);
+   REQUIRE(test_ad_hyperelastic<2>(pa) == MFEM_Approx(0.0));
+   REQUIRE(test_ad_hyperelastic<3>(pa) == MFEM_Approx(0.0));
+}
+
+} // namespace nonlininteg_ad
@@ -11,6 +11,7 @@
 
 #include "unit_tests.hpp"
 #include "mfem.hpp"
+#include "fem/bilininteg_diffusion_kernels.hpp"
 #include <fstream>
 #include <iostream>
 
@@ -268,6 +269,210 @@ TEST_CASE("Nonlinear Convection", "[PartialAssembly], [NonlinearPA]")
    }
 }
 
+static void hyperelastic_deformation(const Vector &X, Vector &x)
+{
+   x = X;
+   x(0) += 0.05*sin(M_PI*X(1));
+   x(1) += 0.05*X(0)*X(0);
+   if (X.Size() == 3) { x(2) += 0.05*X(0)*X(1); }
+}
+
+static void hyperelastic_mesh_map(const Vector &X, Vector &Y)
+{
+   Y = X;
+   Y(0) += 0.1*X(1)*X(1);
+   Y(1) += 0.1*X(0);
+}
+
+static double hyperelastic_mu(const Vector &X) { return 1.0 + X(0)*X(1); }
+
+// Compare the PA residual, gradient action, gradient diagonal and energy of the
+// hyperelastic Neo-Hookean integrator against full assembly.
+double test_nl_hyperelastic_nd(int dim, bool variable_mu)
+{
+   Mesh *mesh = nullptr;
+   if (dim == 2)
+   {
+      mesh = new Mesh(3, 2, Element::QUADRILATERAL, 0, 1.0, 2.0);
+   }
+   if (dim == 3)
+   {
+      mesh = new Mesh(2, 2, 2, Element::HEXAHEDRON, 0, 1.0, 1.0, 2.0);
+   }
+   mesh->EnsureNodes();
+   mesh->Transform(hyperelastic_mesh_map);
+
+   int order = 2;
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim);
+
+   VectorFunctionCoefficient deform(dim, hyperelastic_deformation);
+   GridFunction x(&fes), v(&fes);
+   x.ProjectCoefficient(deform);
+   v.Randomize(7);
+
+   FunctionCoefficient mu_coeff(hyperelastic_mu);
+   ConstantCoefficient K_coeff(5.0);
+   NeoHookeanModel model_c(1.5, 5.0, 1.2);
+   NeoHookeanModel model_v(mu_coeff, K_coeff);
+   NeoHookeanModel *model = variable_mu ? &model_v : &model_c;
+
+   NonlinearForm nlf_fa(&fes);
+   nlf_fa.AddDomainIntegrator(new HyperelasticNLFIntegrator(model));
+
+   NonlinearForm nlf_pa(&fes);
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf_pa.AddDomainIntegrator(new HyperelasticNLFIntegrator(model));
+   nlf_pa.Setup();
+
+   double difference = 0.0;
+
+   Vector y_fa(fes.GetVSize()), y_pa(fes.GetVSize());
+   nlf_fa.Mult(x, y_fa);
+   nlf_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   difference = std::max(difference, y_pa.Normlinf()/y_fa.Normlinf());
+
+   Operator &grad_fa = nlf_fa.GetGradient(x);
+   Operator &grad_pa = nlf_pa.GetGradient(x);
+   grad_fa.Mult(v, y_fa);
+   grad_pa.Mult(v, y_pa);
+   y_pa -= y_fa;
+   difference = std::max(difference, y_pa.Normlinf()/y_fa.Normlinf());
+
+   dynamic_cast<SparseMatrix&>(grad_fa).GetDiag(y_fa);
+   grad_pa.AssembleDiagonal(y_pa);
+   y_pa -= y_fa;
+   difference = std::max(difference, y_pa.Normlinf()/y_fa.Normlinf());
+
+   const double energy_fa = nlf_fa.GetGridFunctionEnergy(x);
+   const double energy_pa = nlf_pa.GetGridFunctionEnergy(x);
+   difference = std::max(difference, fabs(energy_pa - energy_fa)/energy_fa);
+
+   delete mesh;
+
+   return difference;
+}
+
+TEST_CASE("Nonlinear Hyperelastic", "[PartialAssembly], [NonlinearPA]")
+{
+   auto dim = GENERATE(2, 3);
+   auto variable_mu = GENERATE(false, true);
+   CAPTURE(dim, variable_mu);
+   REQUIRE(test_nl_hyperelastic_nd(dim, variable_mu) == MFEM_Approx(0.0));
+}
+
+static double tmop_lim_dist(const Vector &X) { return 0.5 + X(0)*X(0); }
+
+// Compare the PA residual, gradient action, gradient diagonal and energy of the
+// TMOP integrator against full assembly.
+double test_nl_tmop_nd(int dim, int metric_id, int target_id, bool limiting)
+{
+   Mesh *mesh = nullptr;
+   if (dim == 2)
+   {
+      mesh = new Mesh(3, 2, Element::QUADRILATERAL, 0, 1.0, 2.0);
+   }
+   if (dim == 3)
+   {
+      mesh = new Mesh(2, 2, 2, Element::HEXAHEDRON, 0, 1.0, 1.0, 2.0);
+   }
+   const int order = 2;
+   mesh->SetCurvature(order);
+   mesh->Transform(hyperelastic_mesh_map);
+
+   FiniteElementSpace &fes = *mesh->GetNodes()->FESpace();
+   GridFunction x0(*mesh->GetNodes()), x(&fes), v(&fes);
+   VectorFunctionCoefficient deform(dim, hyperelastic_deformation);
+   x.ProjectCoefficient(deform);
+   v.Randomize(7);
+
+   H1_FECollection fec_d(order, dim);
+   FiniteElementSpace fes_d(mesh, &fec_d);
+   GridFunction dist(&fes_d);
+   FunctionCoefficient dist_coeff(tmop_lim_dist);
+   dist.ProjectCoefficient(dist_coeff);
+
+   TMOP_QualityMetric *metric = nullptr;
+   switch (metric_id)
+   {
+      case 1: metric = new TMOP_Metric_001; break;
+      case 2: metric = new TMOP_Metric_002; break;
+      case 302: metric = new TMOP_Metric_302; break;
+      case 303: metric = new TMOP_Metric_303; break;
+      case 321: metric = new TMOP_Metric_321; break;
+   }
+   TargetConstructor::TargetType target_t =
+      (target_id == 1) ? TargetConstructor::IDEAL_SHAPE_UNIT_SIZE
+      : TargetConstructor::IDEAL_SHAPE_EQUAL_SIZE;
+   TargetConstructor target_c(target_t);
+   target_c.SetNodes(x0);
+
+   ConstantCoefficient metric_w(0.7), lim_w(3.0);
+   NonlinearForm nlf_fa(&fes), nlf_pa(&fes);
+   for (NonlinearForm *nlf : {&nlf_fa, &nlf_pa})
+   {
+      TMOP_Integrator *tmop = new TMOP_Integrator(metric, &target_c);
+      tmop->SetCoefficient(metric_w);
+      if (limiting) { tmop->EnableLimiting(x0, dist, lim_w); }
+      nlf->AddDomainIntegrator(tmop);
+   }
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf_pa.Setup();
+
+   double difference = 0.0;
+
+   Vector y_fa(fes.GetVSize()), y_pa(fes.GetVSize());
+   nlf_fa.Mult(x, y_fa);
+   nlf_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   difference = std::max(difference, y_pa.Normlinf()/y_fa.Normlinf());
+
+   Operator &grad_fa = nlf_fa.GetGradient(x);
+   Operator &grad_pa = nlf_pa.GetGradient(x);
+   grad_fa.Mult(v, y_fa);
+   grad_pa.Mult(v, y_pa);
+   y_pa -= y_fa;
+   difference = std::max(difference, y_pa.Normlinf()/y_fa.Normlinf());
+
+   dynamic_cast<SparseMatrix&>(grad_fa).GetDiag(y_fa);
+   grad_pa.AssembleDiagonal(y_pa);
+   y_pa -= y_fa;
+   difference = std::max(difference, y_pa.Normlinf()/y_fa.Normlinf());
+
+   const double energy_fa = nlf_fa.GetGridFunctionEnergy(x);
+   const double energy_pa = nlf_pa.GetGridFunctionEnergy(x);
+   difference = std::max(difference, fabs(energy_pa - energy_fa)/energy_fa);
+
+   delete metric;
+   delete mesh;
+
+   return difference;
+}
+
+TEST_CASE("Nonlinear TMOP", "[PartialAssembly], [NonlinearPA]")
+{
+   auto target_id = GENERATE(1, 2);
+   auto limiting = GENERATE(false, true);
+   CAPTURE(target_id, limiting);
+
+   SECTION("2D")
+   {
+      auto metric_id = GENERATE(1, 2);
+      CAPTURE(metric_id);
+      REQUIRE(test_nl_tmop_nd(2, metric_id, target_id, limiting) ==
+              MFEM_Approx(0.0));
+   }
+
+   SECTION("3D")
+   {
+      auto metric_id = GENERATE(302, 303, 321);
+      CAPTURE(metric_id);
+      REQUIRE(test_nl_tmop_nd(3, metric_id, target_id, limiting) ==
+              MFEM_Approx(0.0));
+   }
+}
+
 template <typename INTEGRATOR>
 double test_vector_pa_integrator(int dim)
 {
@@ -459,4 +664,67 @@ TEST_CASE("PA Convection", "[PartialAssembly]")
 
 } // test case
 
+TEST_CASE("PA Kernel Registry", "[PartialAssembly]")
+{
+   // Order 9 in 2D: D1D = Q1D = 10, which has no default specialization
+   const int order = 9, D1D = 10, Q1D = 10;
+   DiffusionIntegrator::AddSpecialization<2,D1D,Q1D>();
+   DiffusionIntegrator::ApplyKernelRegistry &kernels =
+      DiffusionIntegrator::ApplyPAKernels();
+   REQUIRE(kernels.Has(2, D1D, Q1D));
+
+   Mesh mesh(3, 3, Element::QUADRILATERAL);
+   H1_FECollection fec(order, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+
+   BilinearForm a_fa(&fes), a_pa(&fes);
+   a_fa.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a_pa.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_fa.Assemble();
+   a_fa.Finalize();
+   a_pa.Assemble();
+
+   GridFunction x(&fes), y_fa(&fes), y_pa(&fes);
+   x.Randomize(1);
+   a_fa.Mult(x, y_fa);
+
+   const char *cache = "pa_kernel_registry.cache";
+   std::remove(cache);
+
+   // The first action tunes the kernel and records the selection
+   PAKernelTuning::Enable(cache);
+   a_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() < 1.e-10);
+   REQUIRE(kernels.GetSelection(2, D1D, Q1D) != NULL);
+   const std::string selected = kernels.GetSelection(2, D1D, Q1D);
+   {
+      std::ifstream in(cache);
+      std::string line;
+      REQUIRE(std::getline(in, line));
+      REQUIRE(line == std::string("DiffusionApply 2 10 10 ") +
+              Device::GetBackendName() + " " + selected);
+   }
+
+   // A selection in the cache file is used without tuning
+   PAKernelTuning::Clear();
+   REQUIRE(kernels.GetSelection(2, D1D, Q1D) == NULL);
+   {
+      std::ofstream out(cache);
+      out << "DiffusionApply 2 10 10 " << Device::GetBackendName()
+          << " basic\n";
+   }
+   PAKernelTuning::Enable(cache);
+   a_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() < 1.e-10);
+   REQUIRE(std::string(kernels.GetSelection(2, D1D, Q1D)) == "basic");
+
+   PAKernelTuning::Disable();
+   PAKernelTuning::Clear();
+   std::remove(cache);
+}
+
 } // namespace pa_kernels
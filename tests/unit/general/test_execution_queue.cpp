@@ -0,0 +1,131 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "unit_tests.hpp"
+
+// The operations run concurrently with the Device option 'async', e.g. with
+// MFEM_DEVICE=threads:async, and in program order otherwise.
+TEST_CASE("ExecutionQueue", "[General]")
+{
+   SECTION("Dependencies")
+   {
+      const int N = 1000;
+      Vector a(N), b(N), c(N);
+      a.UseDevice(true);
+      b.UseDevice(true);
+      c.UseDevice(true);
+      double *A = a.Write(), *B = b.Write(), *C = c.Write();
+
+      ExecutionQueue q1, q2;
+      const Event ea = MFEM_FORALL_ASYNC(q1, {}, i, N, A[i] = i;);
+      const Event eb = MFEM_FORALL_ASYNC(q2, {}, i, N, B[i] = 2*i;);
+      const std::vector<Event> deps({ea, eb});
+      const Event ec = MFEM_FORALL_ASYNC(q1, deps, i, N, C[i] = A[i] + B[i];);
+      ec.Wait();
+      REQUIRE(ec.IsComplete());
+      REQUIRE(ea.IsComplete());
+      REQUIRE(eb.IsComplete());
+      q1.Synchronize();
+      q2.Synchronize();
+
+      c.HostRead();
+      for (int i = 0; i < N; i++) { REQUIRE(c(i) == 3*i); }
+      REQUIRE(Event().IsComplete());
+   }
+
+   SECTION("Chain")
+   {
+      // Each operation depends on the previous one
+      std::vector<int> order;
+      ExecutionQueue queue;
+      Event e;
+      for (int k = 0; k < 20; k++)
+      {
+         e = queue.Enqueue([&order, k]() { order.push_back(k); }, {e});
+      }
+      queue.Synchronize();
+      REQUIRE(order.size() == 20);
+      for (int k = 0; k < 20; k++) { REQUIRE(order[k] == k); }
+   }
+
+   SECTION("Operators")
+   {
+      // Diagonal blocks A1 = diag(a1), A2 = diag(a2), and x = [x1; x2]
+      const int n = 7;
+      double a1[n], a2[n], x1[n], x2[n];
+      Vector d1(n), d2(n), x(2*n), y(2*n), z(n);
+      for (int i = 0; i < n; i++)
+      {
+         a1[i] = d1(i) = 1.0 + i;
+         a2[i] = d2(i) = 2.0 - i;
+         x1[i] = x(i) = 0.5 + i;
+         x2[i] = x(n + i) = 3.0 - 2*i;
+      }
+      SparseMatrix A1(d1), A2(d2);
+      A1.BuildTranspose();
+      A2.BuildTranspose();
+      Vector xb;
+      xb.MakeRef(x, 0, n);
+
+      // SumOperator: 2 A1 - 3 A2
+      SumOperator sum(&A1, 2.0, &A2, -3.0, false, false);
+      sum.Mult(xb, z);
+      z.HostRead();
+      for (int i = 0; i < n; i++)
+      {
+         REQUIRE(z(i) == MFEM_Approx((2.0*a1[i] - 3.0*a2[i])*x1[i]));
+      }
+      sum.MultTranspose(xb, z);
+      z.HostRead();
+      for (int i = 0; i < n; i++)
+      {
+         REQUIRE(z(i) == MFEM_Approx((2.0*a1[i] - 3.0*a2[i])*x1[i]));
+      }
+
+      // BlockOperator [A1 A2; 0 A1]
+      Array<int> offsets(3);
+      offsets[0] = 0;
+      offsets[1] = n;
+      offsets[2] = 2*n;
+      BlockOperator block(offsets);
+      block.SetBlock(0, 0, &A1);
+      block.SetBlock(0, 1, &A2);
+      block.SetBlock(1, 1, &A1);
+      block.Mult(x, y);
+      y.HostRead();
+      for (int i = 0; i < n; i++)
+      {
+         REQUIRE(y(i) == MFEM_Approx(a1[i]*x1[i] + a2[i]*x2[i]));
+         REQUIRE(y(n + i) == MFEM_Approx(a1[i]*x2[i]));
+      }
+      block.MultTranspose(x, y);
+      y.HostRead();
+      for (int i = 0; i < n; i++)
+      {
+         REQUIRE(y(i) == MFEM_Approx(a1[i]*x1[i]));
+         REQUIRE(y(n + i) == MFEM_Approx(a2[i]*x1[i] + a1[i]*x2[i]));
+      }
+
+      // BlockDiagonalPreconditioner diag(A1, I)
+      BlockDiagonalPreconditioner prec(offsets);
+      prec.SetDiagonalBlock(0, &A1);
+      prec.Mult(x, y);
+      y.HostRead();
+      for (int i = 0; i < n; i++)
+      {
+         REQUIRE(y(i) == MFEM_Approx(a1[i]*x1[i]));
+         REQUIRE(y(n + i) == x2[i]);
+      }
+   }
+}
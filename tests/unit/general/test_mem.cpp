@@ -14,6 +14,8 @@
 
 #ifndef _WIN32
 #include <unistd.h>
+#include <sys/mman.h>
+#include <thread>
 
 using namespace mfem;
 
@@ -111,4 +113,219 @@ TEST_CASE("MemoryManager", "[MemoryManager]")
    }
 }
 
+TEST_CASE("MemoryPool", "[MemoryManager]")
+{
+   const int N = 1000;
+   const size_t bytes = 8192; // size class of N doubles
+
+   SECTION("Host")
+   {
+      Device device("cpu:pool");
+      REQUIRE(Device::GetHostMemoryType() == MemoryType::HOST_POOL);
+      const MemoryPoolStats s0 = mm.GetPoolStats(MemoryType::HOST_POOL);
+      for (int i = 0; i < 10; i++)
+      {
+         Vector x(N);
+         x = 1.0;
+         REQUIRE(x*x == MFEM_Approx(N));
+      }
+      MemoryPoolStats s1 = mm.GetPoolStats(MemoryType::HOST_POOL);
+      REQUIRE(s1.allocs == s0.allocs + 10);
+      REQUIRE(s1.reuses >= s0.reuses + 9);
+      REQUIRE(s1.used == s0.used);
+      REQUIRE(s1.cached >= bytes);
+      REQUIRE(s1.peak >= s0.used + bytes);
+
+      // Blocks freed above the high-water mark are returned to the backend
+      const size_t hwm = mm.GetPoolHighWaterMark();
+      mm.SetPoolHighWaterMark(s1.cached);
+      {
+         Vector x(N), y(N);
+      }
+      MemoryPoolStats s2 = mm.GetPoolStats(MemoryType::HOST_POOL);
+      REQUIRE(s2.releases == s1.releases + 1);
+      REQUIRE(s2.cached == s1.cached);
+      mm.SetPoolHighWaterMark(hwm);
+
+      mm.ReleasePool();
+      REQUIRE(mm.GetPoolStats(MemoryType::HOST_POOL).cached == 0);
+   }
+
+   SECTION("Debug")
+   {
+      Device device("debug:pool");
+      REQUIRE(Device::GetHostMemoryType() == MemoryType::HOST_POOL);
+      REQUIRE(Device::GetDeviceMemoryType() == MemoryType::DEVICE_POOL);
+      // If MFEM_MEMORY is set, some memory may already be in use
+      const MemoryPoolStats h0 = mm.GetPoolStats(MemoryType::HOST_POOL);
+      const MemoryPoolStats d0 = mm.GetPoolStats(MemoryType::DEVICE_POOL);
+      for (int n = 1; n < 4*N; n += 331) { Aliases(n); }
+      ScanMemoryTypes();
+      const MemoryPoolStats h = mm.GetPoolStats(MemoryType::HOST_POOL);
+      const MemoryPoolStats d = mm.GetPoolStats(MemoryType::DEVICE_POOL);
+      REQUIRE(h.reuses > h0.reuses);
+      REQUIRE(d.reuses > d0.reuses);
+      REQUIRE(h.used == h0.used);
+      REQUIRE(d.used == d0.used);
+   }
+}
+
+// STREAM triad a = b + s c on HOST_NUMA vectors of size N, in an MFEM_FORALL
+// loop using the partition the pages were first touched with.
+static void NumaTriad(const int N)
+{
+   Vector a(N, MemoryType::HOST_NUMA), b(N, MemoryType::HOST_NUMA),
+          c(N, MemoryType::HOST_NUMA);
+   a.UseDevice(true);
+   b.UseDevice(true);
+   c.UseDevice(true);
+   b = 1.0;
+   c = 2.0;
+   const double s = 3.0;
+   const double *B = b.Read(), *C = c.Read();
+   double *A = a.Write();
+   MFEM_FORALL(i, N, A[i] = B[i] + s*C[i];);
+   a.HostRead();
+   REQUIRE(a.Min() == 7.0);
+   REQUIRE(a.Max() == 7.0);
+}
+
+TEST_CASE("NumaMemory", "[MemoryManager]")
+{
+   const long pagesize = sysconf(_SC_PAGE_SIZE);
+   REQUIRE(pagesize > 0);
+   const int N = 64*pagesize/sizeof(double);
+   const MemoryNumaPolicy policy = mm.GetNumaPolicy();
+
+   SECTION("FirstTouch")
+   {
+      Device device("threads:3");
+      mm.SetNumaPolicy(MemoryNumaPolicy::FIRST_TOUCH);
+      Vector x(N, MemoryType::HOST_NUMA);
+      REQUIRE(x.GetMemory().GetMemoryType() == MemoryType::HOST_NUMA);
+      const double *h_x = x.HostRead();
+      REQUIRE(reinterpret_cast<uintptr_t>(h_x) % pagesize == 0);
+#ifdef __linux__
+      // All the pages are touched at allocation
+      std::vector<unsigned char> resident(64);
+      REQUIRE(mincore(const_cast<double*>(h_x), N*sizeof(double),
+                      resident.data()) == 0);
+      for (unsigned char r : resident) { REQUIRE((r & 1)); }
+#endif
+      // Small blocks are allocated from the heap
+      Vector y(10, MemoryType::HOST_NUMA);
+      y = 1.0;
+      REQUIRE(y*y == MFEM_Approx(10.0));
+      for (int n = 1; n < 4*N; n = 3*n + 1) { NumaTriad(n); }
+   }
+
+   SECTION("Interleave")
+   {
+      Device device("cpu");
+      mm.SetNumaPolicy(MemoryNumaPolicy::INTERLEAVE);
+      for (int n = 1; n < 4*N; n = 3*n + 1) { NumaTriad(n); }
+   }
+
+   SECTION("Device")
+   {
+      Device device("cpu:numa+interleave");
+      REQUIRE(Device::GetHostMemoryType() == MemoryType::HOST_NUMA);
+      REQUIRE(Device::GetDeviceMemoryType() == MemoryType::HOST_NUMA);
+      REQUIRE(mm.GetNumaPolicy() == MemoryNumaPolicy::INTERLEAVE);
+      ScanMemoryTypes();
+      TestMemoryTypes(MemoryType::HOST_NUMA, true, N);
+      NumaTriad(N);
+   }
+   mm.SetNumaPolicy(policy);
+}
+
+TEST_CASE("TransferTrace", "[MemoryManager]")
+{
+   Device device("debug");
+   const bool profiling = Profiler::IsEnabled();
+   Profiler::Enable();
+   mm.ResetTransferTrace();
+   mm.EnableTransferTrace();
+   const int N = 1000;
+   const size_t bytes = N*sizeof(double);
+   {
+      MFEM_PROFILE_REGION("TransferTrace");
+      Vector x(N);
+      x.UseDevice(true);
+      x = 1.0;
+      x.HostRead();        // D->H
+      x.HostReadWrite();   // invalidates the device data, but does not modify
+      x.Read();            // redundant H->D
+      x.HostReadWrite()[0] = 2.0;
+      x.Read();            // H->D
+      x.ReadWrite();       // invalidates the host data, but does not modify
+      x.HostRead();        // redundant D->H
+   }
+   mm.DisableTransferTrace();
+   const MemoryTransferStats total = mm.GetTransferStats();
+   REQUIRE(total.htod == 2);
+   REQUIRE(total.htod_bytes == 2*bytes);
+   REQUIRE(total.dtoh == 2);
+   REQUIRE(total.dtoh_bytes == 2*bytes);
+   REQUIRE(total.redundant == 2);
+   REQUIRE(total.redundant_bytes == 2*bytes);
+   const MemoryTransferStats site = mm.GetTransferStats("TransferTrace");
+   REQUIRE(site.htod == 2);
+   REQUIRE(site.redundant == 2);
+   REQUIRE(mm.GetTransferStats("none").htod == 0);
+   std::ostringstream report;
+   mm.PrintTransfers(report);
+   REQUIRE(report.str().find("TransferTrace") != std::string::npos);
+   mm.ResetTransferTrace();
+   REQUIRE(mm.GetTransferStats().htod == 0);
+   if (!profiling)
+   {
+      Profiler::Disable();
+      Profiler::Reset();
+   }
+}
+
+// Registration and removal of vectors and aliases by concurrent threads
+TEST_CASE("MemoryThreads", "[MemoryManager]")
+{
+   Device device("cpu");
+   NullBuf null_buffer;
+   std::ostream dev_null(&null_buffer);
+   const int n_ptr = mm.PrintPtrs(dev_null);
+   const int n_alias = mm.PrintAliases(dev_null);
+   const int num_threads = 4, n = 40;
+   const MemoryType mts[2] = { MemoryType::HOST_64, MemoryType::HOST_POOL };
+   Vector base(num_threads*n, MemoryType::HOST_64);
+   base = 0.0;
+   std::vector<int> errors(num_threads, 0);
+
+   auto work = [&](int t)
+   {
+      Array<int> offsets(5);
+      for (int b = 0; b < 5; b++) { offsets[b] = b*n/4; }
+      for (int i = 0; i < 500; i++)
+      {
+         Vector x(n + i % 7, mts[i % 2]);
+         x = 1.0;
+         // All the threads alias the same base Vector
+         Vector r;
+         r.MakeRef(base, t*n + i % (n/2), n/2);
+         r += 1.0;
+         BlockVector bv(offsets, mts[(i + t) % 2]);
+         bv = 0.0;
+         bv.GetBlock(3) = 2.0;
+         if (x*x != n + i % 7 || bv.Norml1() != n/2) { errors[t]++; }
+      }
+   };
+   std::vector<std::thread> threads;
+   for (int t = 1; t < num_threads; t++) { threads.emplace_back(work, t); }
+   work(0);
+   for (auto &thread : threads) { thread.join(); }
+
+   for (int t = 0; t < num_threads; t++) { REQUIRE(errors[t] == 0); }
+   REQUIRE(base.Sum() == num_threads*500*n/2);
+   REQUIRE(mm.PrintPtrs(dev_null) == n_ptr + 1);
+   REQUIRE(mm.PrintAliases(dev_null) == n_alias);
+}
+
 #endif // _WIN32
@@ -0,0 +1,80 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "general/forall.hpp"
+using namespace mfem;
+
+#include "unit_tests.hpp"
+
+#include <sstream>
+
+static void profiler_test_kernel(Vector &x)
+{
+   const int N = x.Size();
+   auto X = x.Write();
+   MFEM_FORALL(i, N, X[i] = i;);
+}
+
+static int count(const std::string &s, const std::string &sub)
+{
+   int n = 0;
+   for (auto p = s.find(sub); p != std::string::npos; p = s.find(sub, p + 1))
+   {
+      n++;
+   }
+   return n;
+}
+
+TEST_CASE("Profiler", "[General]")
+{
+   Vector x(100);
+   x.UseDevice(true);
+
+   Profiler::Reset();
+   Profiler::Enable(true);
+   for (int k = 0; k < 2; k++)
+   {
+      MFEM_PROFILE_REGION("outer");
+      {
+         MFEM_PROFILE_REGION("inner");
+         MFEM_PROFILE_COUNTERS(100.0, 50.0);
+      }
+      profiler_test_kernel(x);
+   }
+   Profiler::Disable();
+   {
+      // Not recorded
+      MFEM_PROFILE_REGION("disabled");
+   }
+
+   std::ostringstream json, trace, text;
+   Profiler::Print(json, Profiler::JSON);
+   Profiler::Print(trace, Profiler::TRACE);
+   Profiler::Print(text, Profiler::TEXT);
+
+   REQUIRE(count(json.str(), "{\"name\": \"outer\", \"calls\": 2,") == 1);
+   REQUIRE(count(json.str(), "{\"name\": \"inner\", \"calls\": 2,") == 1);
+   REQUIRE(count(json.str(),
+                 "{\"name\": \"profiler_test_kernel\", \"calls\": 2,") == 1);
+   REQUIRE(count(json.str(), "\"bytes\": 200, \"flops\": 100") == 3);
+   REQUIRE(count(json.str(), "disabled") == 0);
+   REQUIRE(count(trace.str(), "\"ph\": \"X\"") == 6);
+   REQUIRE(count(text.str(), "\n  outer ") == 1);
+   REQUIRE(count(text.str(), "\n    inner ") == 1);
+
+   Profiler::Reset();
+   std::ostringstream reset;
+   Profiler::Print(reset, Profiler::JSON);
+   REQUIRE(count(reset.str(), "outer") == 0);
+
+   REQUIRE(SumFactorizationFlops(2, 3, 4) == 2.0*(3*3*4 + 3*4*4));
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "unit_tests.hpp"
+
+#include <atomic>
+#include <thread>
+
+TEST_CASE("ThreadPool", "[General]")
+{
+   ThreadPool::SetNumThreads(4);
+   REQUIRE(ThreadPool::GetNumThreads() == 4);
+   REQUIRE(!ThreadPool::InWorker());
+
+   SECTION("For")
+   {
+      const int N = 10007;
+      for (int grain : {0, 1, 7, 100000})
+      {
+         Array<int> count(N);
+         count = 0;
+         ThreadPool::For(N, [&](int i)
+         {
+            // Unbalanced work, to exercise the stealing
+            volatile double s = 0.0;
+            for (int k = 0; k < (i < N/4 ? 100 : 1); k++) { s += k; }
+            count[i]++;
+         }, grain);
+         REQUIRE(count.Min() == 1);
+         REQUIRE(count.Max() == 1);
+      }
+   }
+
+   SECTION("Reduce")
+   {
+      const int N = 123456;
+      auto body = [](int i, double &s) { s += 1.0/(1.0 + i); };
+      auto sum = [](double a, double b) { return a + b; };
+      const double s1 = ThreadPool::Reduce(N, 0.0, body, sum);
+      const double s2 = ThreadPool::Reduce(N, 0.0, body, sum);
+      double s = 0.0;
+      for (int i = 0; i < N; i++) { body(i, s); }
+      REQUIRE(s1 == s2);
+      REQUIRE(s1 == MFEM_Approx(s));
+
+      auto imax = [](int i, int &m) { m = std::max(m, (i*37) % 1001); };
+      auto max = [](int a, int b) { return std::max(a, b); };
+      REQUIRE(ThreadPool::Reduce(N, 0, imax, max) == 1000);
+      REQUIRE(ThreadPool::Reduce(0, -1, imax, max) == -1);
+   }
+
+   SECTION("Nested")
+   {
+      // Nested loops run sequentially on the thread of the outer chunk
+      const int N = 64;
+      std::atomic<int> count(0);
+      ThreadPool::For(N, [&](int)
+      {
+         ThreadPool::For(N, [&](int) { count++; });
+      });
+      REQUIRE(count == N*N);
+   }
+
+   SECTION("TaskGroup")
+   {
+      std::atomic<int> count(0);
+      {
+         TaskGroup group;
+         for (int t = 0; t < 20; t++)
+         {
+            group.Run([&]
+            {
+               // Tasks can spawn tasks and run parallel loops
+               TaskGroup inner;
+               inner.Run([&] { count++; });
+               ThreadPool::For(100, [&](int) { count++; });
+               inner.Wait();
+            });
+         }
+         group.Wait();
+         REQUIRE(count == 20*101);
+      }
+   }
+
+   SECTION("UserThreads")
+   {
+      // Loops from several user threads share the pool without deadlocks
+      const int N = 1000;
+      std::atomic<int> count(0);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 4; t++)
+      {
+         threads.emplace_back([&]
+         {
+            for (int k = 0; k < 20; k++)
+            {
+               ThreadPool::For(N, [&](int) { count++; }, 10);
+            }
+         });
+      }
+      for (auto &t : threads) { t.join(); }
+      REQUIRE(count == 4*20*N);
+   }
+
+   ThreadPool::SetNumThreads(0);
+}
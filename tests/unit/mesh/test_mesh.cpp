@@ -145,3 +145,107 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
       }
    }
 }
+
+TEST_CASE("MeshPointLocator", "[Mesh]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order += 2)
+      {
+         Mesh *mesh_ptr = (dim == 2) ?
+                          new Mesh(6, 5, Element::TRIANGLE, true, 2.0, 1.0) :
+                          new Mesh(3, 4, 2, Element::HEXAHEDRON, true,
+                                   1.0, 2.0, 1.0);
+         Mesh &mesh = *mesh_ptr;
+         mesh.SetCurvature(order);
+
+         // Map the center of every element to physical space.
+         const int NE = mesh.GetNE();
+         DenseMatrix points(dim, NE);
+         Vector pt;
+         for (int e = 0; e < NE; e++)
+         {
+            const IntegrationPoint &c =
+               Geometries.GetCenter(mesh.GetElementBaseGeometry(e));
+            pt.SetDataAndSize(points.GetColumn(e), dim);
+            mesh.GetElementTransformation(e)->Transform(c, pt);
+         }
+
+         MeshPointLocator locator(mesh);
+         Array<int> elem_ids;
+         Array<IntegrationPoint> ips;
+         REQUIRE(locator.FindPoints(points, elem_ids, ips) == NE);
+         for (int e = 0; e < NE; e++)
+         {
+            REQUIRE(elem_ids[e] == e);
+         }
+
+         // Reusing the previous hits gives the same result.
+         REQUIRE(locator.FindPoints(points, elem_ids, ips, true) == NE);
+         for (int e = 0; e < NE; e++)
+         {
+            REQUIRE(elem_ids[e] == e);
+         }
+
+         // Points outside of the mesh are not found.
+         DenseMatrix outside(dim, 1);
+         outside = 10.0;
+         REQUIRE(locator.FindPoints(outside, elem_ids, ips) == 0);
+         REQUIRE(elem_ids[0] == -1);
+
+         REQUIRE(mesh.FindPoints(points, elem_ids, ips, false) == NE);
+         delete mesh_ptr;
+      }
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("ParMesh::LoadDistributed", "[Parallel], [ParMesh]")
+{
+   int rank;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   const char *fname = "pmesh_load_distributed.mesh";
+
+   for (int type = (int) Element::TRIANGLE;
+        type <= (int) Element::HEXAHEDRON; type++)
+   {
+      const bool dim3 = (type >= (int) Element::TETRAHEDRON);
+      Mesh *mesh = dim3 ?
+                   new Mesh(3, 4, 2, (Element::Type) type, true, 1., 2., 3.) :
+                   new Mesh(5, 4, (Element::Type) type, true, 1., 2.);
+      if (rank == 0)
+      {
+         std::ofstream mesh_ofs(fname);
+         mesh_ofs.precision(16);
+         mesh->Print(mesh_ofs);
+      }
+      MPI_Barrier(MPI_COMM_WORLD);
+
+      ParMesh *pmesh = ParMesh::LoadDistributed(MPI_COMM_WORLD, fname);
+      REQUIRE(pmesh->GetGlobalNE() == mesh->GetNE());
+      REQUIRE(pmesh->ReduceInt(pmesh->GetNBE()) == mesh->GetNBE());
+
+      double vol = 0.0, glob_vol;
+      for (int e = 0; e < pmesh->GetNE(); e++)
+      {
+         vol += pmesh->GetElementVolume(e);
+      }
+      MPI_Allreduce(&vol, &glob_vol, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      REQUIRE(glob_vol == MFEM_Approx(dim3 ? 6.0 : 2.0));
+
+      // The shared vertices, edges and faces are consistent if the number of
+      // true dofs matches the serial space.
+      H1_FECollection fec(3, mesh->Dimension());
+      FiniteElementSpace fes(mesh, &fec);
+      ParFiniteElementSpace pfes(pmesh, &fec);
+      REQUIRE(pfes.GlobalTrueVSize() == fes.GetTrueVSize());
+
+      delete pmesh;
+      delete mesh;
+      MPI_Barrier(MPI_COMM_WORLD);
+   }
+   if (rank == 0) { std::remove(fname); }
+}
+
+#endif // MFEM_USE_MPI
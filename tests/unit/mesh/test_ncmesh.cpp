@@ -111,6 +111,45 @@ TEST_CASE("NCMesh PA diagonal", "[NCMesh]")
 
 } // test case
 
+// Test case: Verify that a batch of anisotropic refinements, where forced
+//            refinements are merged with the pending ones, gives a valid mesh
+//            that interpolates linear functions exactly.
+TEST_CASE("NCMesh batched refinement", "[NCMesh]")
+{
+   Mesh mesh(3, 3, 3, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+   mesh.EnsureNCMesh();
+
+   for (int it = 0; it < 3; it++)
+   {
+      Array<Refinement> refs;
+      for (int i = 0; i < mesh.GetNE(); i += 2)
+      {
+         refs.Append(Refinement(i, 1 + (i/2) % 7));
+      }
+      mesh.GeneralRefinement(refs);
+   }
+
+   double volume = 0.0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      volume += mesh.GetElementVolume(i);
+   }
+   REQUIRE(volume == MFEM_Approx(1.0, EPS));
+
+   H1_FECollection fec(1, 3);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient linear([](const Vector &x)
+   { return x(0) + 2.0*x(1) + 3.0*x(2); });
+   GridFunction x(&fes);
+   Vector tx(fes.GetTrueVSize());
+   x.ProjectCoefficient(linear);
+   fes.GetRestrictionMatrix()->Mult(x, tx);
+   fes.GetProlongationMatrix()->Mult(tx, x);
+   REQUIRE(x.ComputeL2Error(linear) == MFEM_Approx(0.0, EPS));
+
+   REQUIRE(mesh.ncmesh->MemoryUsagePerElement() > 0.0);
+}
+
 #ifdef MFEM_USE_MPI
 
 // Test case: Verify that a conforming mesh yields the same norm for the